@@ -9,7 +9,16 @@
 #include "DetectorStats.hpp"
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <tuple>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <algorithm>
+#include <iterator>
 #include "TFile.h"
 #include "TDirectory.h"
 #include "TCanvas.h"
@@ -19,6 +28,112 @@
 #include "misc.h"
 
 
+///@brief Parse the statistics files for a list of readout units, using a pool of threads.
+///       Each thread takes the next unparsed RU from the list until all are done. The
+///       results are stored at the same index as in the list. The output from parsing
+///       each RU is printed by the calling thread in RU order, as soon as that RU and all
+///       RUs before it are done, and is then released. If parsing a RU fails, the
+///       remaining RUs are not parsed, and the first error is rethrown after all the
+///       threads have been joined.
+///@param layer_staves Layer and RU number of each readout unit
+///@param num_threads Number of threads to use
+///@param sim_time_ns Simulation time (in nanoseconds)
+///@param sim_type "pct" or "its"
+///@param path Path to simulation data directory
+///@param event_data Pointer to event data (time of events, number of hits/multiplicities)
+///@return Parsed RU data, in the same order as layer_staves
+static std::vector<std::unique_ptr<ReadoutUnitStats>>
+parseReadoutUnits(const std::vector<std::pair<unsigned int, unsigned int>>& layer_staves,
+                  unsigned int num_threads, unsigned long sim_time_ns, std::string sim_type,
+                  const char* path, std::shared_ptr<EventData> event_data)
+{
+  std::vector<std::unique_ptr<ReadoutUnitStats>> ru_stats(layer_staves.size());
+  std::atomic<size_t> next_ru(0);
+
+  // Protects ru_done and error, and is used with ru_done_cond to
+  // signal the calling thread when a RU is done
+  std::mutex ru_done_mutex;
+  std::condition_variable ru_done_cond;
+  std::vector<bool> ru_done(layer_staves.size(), false);
+  std::exception_ptr error;
+
+  size_t print_cursor = 0;
+
+  // Print the output of the RUs that are done, in RU order, and release it.
+  // When wait is true, waits until all RUs are printed or parsing has failed.
+  auto print_done = [&](bool wait) {
+    std::unique_lock<std::mutex> lock(ru_done_mutex);
+
+    while(print_cursor < layer_staves.size() && !error) {
+      if(!ru_done[print_cursor]) {
+        if(!wait)
+          return;
+        ru_done_cond.wait(lock);
+        continue;
+      }
+
+      lock.unlock();
+      std::cout << ru_stats[print_cursor]->getLog();
+      ru_stats[print_cursor]->clearLog();
+      print_cursor++;
+      lock.lock();
+    }
+  };
+
+  // The calling thread is one of the workers, and also prints the output
+  auto worker = [&](bool print_output) {
+    for(size_t ru = next_ru++; ru < layer_staves.size(); ru = next_ru++) {
+      std::exception_ptr ru_error;
+
+      try {
+        ru_stats[ru].reset(new ReadoutUnitStats(layer_staves[ru].first, layer_staves[ru].second,
+                                                sim_time_ns, path, sim_type, event_data));
+      } catch(...) {
+        ru_error = std::current_exception();
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(ru_done_mutex);
+        ru_done[ru] = true;
+        if(ru_error && !error)
+          error = ru_error;
+      }
+      ru_done_cond.notify_one();
+
+      if(ru_error) {
+        // Stop the other threads from starting on new RUs
+        next_ru = layer_staves.size();
+        break;
+      }
+
+      if(print_output)
+        print_done(false);
+    }
+
+    if(print_output)
+      print_done(true);
+  };
+
+  if(num_threads > layer_staves.size())
+    num_threads = layer_staves.size();
+
+  std::vector<std::thread> threads;
+
+  for(unsigned int i = 1; i < num_threads; i++)
+    threads.emplace_back(worker, false);
+
+  worker(true);
+
+  for(auto it = threads.begin(); it != threads.end(); it++)
+    it->join();
+
+  if(error)
+    std::rethrow_exception(error);
+
+  return ru_stats;
+}
+
+
 ///@brief Constructor for DetectorStats class.
 ///@param sim_params Simulation parameters that should be stored in root file.
 ///                  Key: name of parameter, value: simulation parameter value
@@ -27,12 +142,15 @@
 ///@param sim_type "pct" or "its"
 ///@param sim_run_data_path Path to directory with simulation data.
 ///@param event_data Pointer to event data (time of events, number of hits/multiplicities)
+///@param num_threads Number of threads used to parse the RU data.
+///                   Zero uses one thread per hardware thread.
 DetectorStats::DetectorStats(Detector::DetectorConfigBase config,
                              std::map<std::string, double> sim_params,
                              unsigned long sim_time_ns,
                              std::string sim_type,
                              const char* sim_run_data_path,
-                             std::shared_ptr<EventData> event_data)
+                             std::shared_ptr<EventData> event_data,
+                             unsigned int num_threads)
   : mConfig(config)
   , mSimParams(sim_params)
   , mSimTimeNs(sim_time_ns)
@@ -44,14 +162,48 @@ DetectorStats::DetectorStats(Detector::DetectorConfigBase config,
 
   mLayerStats.resize(ITS::N_LAYERS, nullptr);
 
+  if(num_threads == 0)
+    num_threads = std::max(1U, std::thread::hardware_concurrency());
+
+  // Parse the RUs in all layers in one go, so the threads are kept
+  // busy also when the layers have different numbers of RUs
+  std::vector<std::pair<unsigned int, unsigned int>> layer_staves;
+
+  for(unsigned int layer_num = 0; layer_num < config.num_layers; layer_num++) {
+    unsigned int num_readout_units = 0;
+    if(config.layer[layer_num].num_staves > 0)
+      num_readout_units = ITSLayerStats::getNumReadoutUnits(config.layer[layer_num].num_staves, sim_type);
+
+    for(unsigned int RU_num = 0; RU_num < num_readout_units; RU_num++)
+      layer_staves.push_back(std::make_pair(layer_num, RU_num));
+  }
+
+  std::cout << "Parsing data for " << layer_staves.size() << " RUs using ";
+  std::cout << num_threads << " threads." << std::endl;
+
+  std::vector<std::unique_ptr<ReadoutUnitStats>> ru_stats =
+    parseReadoutUnits(layer_staves, num_threads, sim_time_ns, sim_type, sim_run_data_path, event_data);
+
+  // The histograms and sums for each layer and the whole detector are
+  // calculated from the parsed RUs in layer and RU order afterwards
+  auto ru_stats_it = ru_stats.begin();
+
   for(unsigned int layer_num = 0; layer_num < config.num_layers; layer_num++) {
     if(config.layer[layer_num].num_staves > 0) {
+      unsigned int num_readout_units =
+        ITSLayerStats::getNumReadoutUnits(config.layer[layer_num].num_staves, sim_type);
+
+      std::vector<std::unique_ptr<ReadoutUnitStats>> layer_ru_stats(std::make_move_iterator(ru_stats_it),
+                                                                    std::make_move_iterator(ru_stats_it + num_readout_units));
+      ru_stats_it += num_readout_units;
+
       mLayerStats[layer_num] = new ITSLayerStats(layer_num,
                                                  config.layer[layer_num].num_staves,
                                                  sim_time_ns,
                                                  sim_type,
                                                  sim_run_data_path,
-                                                 event_data);
+                                                 event_data,
+                                                 std::move(layer_ru_stats));
       mNumLayers++;
     }
   }
@@ -367,10 +519,11 @@ void DetectorStats::plotDetector(bool create_png, bool create_pdf)
          Layer_abort_link_count.size( )!= num_triggers ||
          Layer_fatal_link_count.size( )!= num_triggers)
       {
-        std::cout << "Error: Number of triggers in busy/busyv/flush/abort/fatal";
-        std::cout << "link count vectors from Layer " << layer;
-        std::cout << " does not matched expected number of triggers. " << std::endl;
-        exit(-1);
+        std::stringstream error_msg;
+        error_msg << "Number of triggers in busy/busyv/flush/abort/fatal ";
+        error_msg << "link count vectors from Layer " << layer;
+        error_msg << " does not match expected number of triggers.";
+        throw std::runtime_error(error_msg.str());
       }
 
       for(uint64_t trigger_id = 0; trigger_id < num_triggers; trigger_id++) {
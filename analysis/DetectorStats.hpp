@@ -51,7 +51,8 @@ public:
                 unsigned long sim_time_ns,
                 std::string sim_type,
                 const char* sim_run_data_path,
-                std::shared_ptr<EventData> event_data);
+                std::shared_ptr<EventData> event_data,
+                unsigned int num_threads = 0);
 
   void plotDetector(bool create_png, bool create_pdf);
 };
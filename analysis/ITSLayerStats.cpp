@@ -20,6 +20,26 @@
 #include "misc.h"
 
 
+///@brief Get the number of readout units for a layer
+///@param num_staves Number of staves simulated in the layer
+///@param sim_type "pct" or "its"
+unsigned int ITSLayerStats::getNumReadoutUnits(unsigned int num_staves, std::string sim_type)
+{
+  if(sim_type == "pct") {
+    // Several staves per RU for pCT
+    unsigned int num_staves_per_readout_unit = PCT::STAVES_PER_LAYER/PCT::READOUT_UNITS_PER_LAYER;
+    return ceil(num_staves/(double)num_staves_per_readout_unit);
+  } else if (sim_type == "its")
+  {
+    // Only 1 stave per RU for ITS, regardless of layer
+    return num_staves;
+  } else {
+    std::cout << "Error: Unknown simulation type \"" << sim_type << "\"" << std::endl;
+    exit(-1);
+  }
+}
+
+
 ///@brief Constructor for ITSLayerStats
 ///@param layer_num ITS Layer number
 ///@param num_staves Number of staves simulated in this layer
@@ -27,37 +47,33 @@
 ///       Used for data rate calculations.
 ///@param sim_type "pct" or "its"
 ///@param path Path to simulation data directory
-///@param sim_type "pct" or "its"
 ///@param event_data Pointer to event data (time of events, number of hits/multiplicities)
+///@param ru_stats Parsed RU data for the readout units in this layer, ordered by RU number.
+///       See DetectorStats, which parses the RUs for all layers in parallel.
 ITSLayerStats::ITSLayerStats(unsigned int layer_num, unsigned int num_staves,
                              unsigned long sim_time_ns, std::string sim_type,
-                             const char* path, std::shared_ptr<EventData> event_data)
+                             const char* path, std::shared_ptr<EventData> event_data,
+                             std::vector<std::unique_ptr<ReadoutUnitStats>> ru_stats)
   : mLayer(layer_num)
   , mNumStaves(num_staves)
+  , mNumReadoutUnits(getNumReadoutUnits(num_staves, sim_type))
   , mSimTimeNs(sim_time_ns)
   , mSimType(sim_type)
   , mSimDataPath(path)
   , mEventData(event_data)
+  , mRUStats(std::move(ru_stats))
   , mNumTriggers(0)
 {
-  if(sim_type == "pct") {
-    // Several staves per RU for pCT
-    unsigned int num_staves_per_readout_unit = PCT::STAVES_PER_LAYER/PCT::READOUT_UNITS_PER_LAYER;
-    mNumReadoutUnits = ceil(num_staves/(double)num_staves_per_readout_unit);
-  } else if (sim_type == "its")
-  {
-    // Only 1 stave per RU for ITS, regardless of layer
-    mNumReadoutUnits = num_staves;
-  } else {
-    std::cout << "Error: Unknown simulation type \"" << sim_type << "\"" << std::endl;
+  if(mRUStats.size() != mNumReadoutUnits) {
+    std::cout << "Error: Expected data for " << mNumReadoutUnits << " RUs in layer " << mLayer;
+    std::cout << ", got " << mRUStats.size() << std::endl;
     exit(-1);
   }
 
-  // Create and parse RU data
+  // The output from parsing the RU data was printed by DetectorStats
   for(unsigned int RU_num = 0; RU_num < mNumReadoutUnits; RU_num++) {
-    mRUStats.emplace_back(layer_num, RU_num, sim_time_ns, path, sim_type, event_data);
-    mProtocolRatesMbps.push_back(mRUStats.back().getProtocolRateMbps());
-    mDataRatesMbps.push_back(mRUStats.back().getDataRateMbps());
+    mProtocolRatesMbps.push_back(mRUStats[RU_num]->getProtocolRateMbps());
+    mDataRatesMbps.push_back(mRUStats[RU_num]->getDataRateMbps());
   }
 }
 
@@ -79,7 +95,7 @@ void ITSLayerStats::plotLayer(bool create_png, bool create_pdf)
     // Keep changing back to this layer's directory,
     // because the plotRU() function changes the current directory.
     current_dir->cd(Form("Layer_%i", mLayer));
-    mRUStats[RU_num].plotRU(create_png, create_pdf);
+    mRUStats[RU_num]->plotRU(create_png, create_pdf);
   }
 
   current_dir->cd(Form("Layer_%i", mLayer));
@@ -90,7 +106,7 @@ void ITSLayerStats::plotLayer(bool create_png, bool create_pdf)
 
 
   // Todo: check that we have the same number of triggers in all RUs?
-  mNumTriggers = mRUStats[0].getNumTriggers();
+  mNumTriggers = mRUStats[0]->getNumTriggers();
 
   mTrigSentCoverage.resize(mNumTriggers);
   mTrigSentExclFilteringCoverage.resize(mNumTriggers);
@@ -120,10 +136,10 @@ void ITSLayerStats::plotLayer(bool create_png, bool create_pdf)
     double trig_readout_coverage = 0.0;
     double trig_readout_excl_filter_coverage = 0.0;
     for(unsigned int RU_num = 0; RU_num < mNumReadoutUnits; RU_num++) {
-      trig_sent_coverage += mRUStats[RU_num].getTrigSentCoverage(trigger_id);
-      trig_sent_excl_filter_coverage += mRUStats[RU_num].getTrigSentExclFilteringCoverage(trigger_id);
-      trig_readout_coverage += mRUStats[RU_num].getTrigReadoutCoverage(trigger_id);
-      trig_readout_excl_filter_coverage += mRUStats[RU_num].getTrigReadoutExclFilteringCoverage(trigger_id);
+      trig_sent_coverage += mRUStats[RU_num]->getTrigSentCoverage(trigger_id);
+      trig_sent_excl_filter_coverage += mRUStats[RU_num]->getTrigSentExclFilteringCoverage(trigger_id);
+      trig_readout_coverage += mRUStats[RU_num]->getTrigReadoutCoverage(trigger_id);
+      trig_readout_excl_filter_coverage += mRUStats[RU_num]->getTrigReadoutExclFilteringCoverage(trigger_id);
     }
 
     mTrigSentCoverage[trigger_id] = trig_sent_coverage/mNumReadoutUnits;
@@ -244,10 +260,10 @@ void ITSLayerStats::plotLayer(bool create_png, bool create_pdf)
 
   for(unsigned int RU_num = 0; RU_num < mNumReadoutUnits; RU_num++) {
     for(uint64_t trigger_id = 0; trigger_id < mNumTriggers; trigger_id++) {
-      h5->Fill(trigger_id, RU_num, mRUStats[RU_num].getTrigSentCoverage(trigger_id));
-      h6->Fill(trigger_id, RU_num, mRUStats[RU_num].getTrigSentExclFilteringCoverage(trigger_id));
-      h7->Fill(trigger_id, RU_num, mRUStats[RU_num].getTrigReadoutCoverage(trigger_id));
-      h8->Fill(trigger_id, RU_num, mRUStats[RU_num].getTrigReadoutExclFilteringCoverage(trigger_id));
+      h5->Fill(trigger_id, RU_num, mRUStats[RU_num]->getTrigSentCoverage(trigger_id));
+      h6->Fill(trigger_id, RU_num, mRUStats[RU_num]->getTrigSentExclFilteringCoverage(trigger_id));
+      h7->Fill(trigger_id, RU_num, mRUStats[RU_num]->getTrigReadoutCoverage(trigger_id));
+      h8->Fill(trigger_id, RU_num, mRUStats[RU_num]->getTrigReadoutExclFilteringCoverage(trigger_id));
     }
   }
 
@@ -356,11 +372,11 @@ void ITSLayerStats::plotLayer(bool create_png, bool create_pdf)
   mFatalLinkCount.resize(mNumTriggers, 0);
 
   for(unsigned int RU_num = 0; RU_num < mNumReadoutUnits; RU_num++) {
-    std::vector<unsigned int> RU_busy_link_count = mRUStats[RU_num].getBusyLinkCount();
-    std::vector<unsigned int> RU_busyv_link_count = mRUStats[RU_num].getBusyVLinkCount();
-    std::vector<unsigned int> RU_flush_link_count = mRUStats[RU_num].getFlushLinkCount();
-    std::vector<unsigned int> RU_abort_link_count = mRUStats[RU_num].getAbortLinkCount();
-    std::vector<unsigned int> RU_fatal_link_count = mRUStats[RU_num].getFatalLinkCount();
+    std::vector<unsigned int> RU_busy_link_count = mRUStats[RU_num]->getBusyLinkCount();
+    std::vector<unsigned int> RU_busyv_link_count = mRUStats[RU_num]->getBusyVLinkCount();
+    std::vector<unsigned int> RU_flush_link_count = mRUStats[RU_num]->getFlushLinkCount();
+    std::vector<unsigned int> RU_abort_link_count = mRUStats[RU_num]->getAbortLinkCount();
+    std::vector<unsigned int> RU_fatal_link_count = mRUStats[RU_num]->getFatalLinkCount();
 
     if(RU_busy_link_count.size() != mNumTriggers || RU_busyv_link_count.size() != mNumTriggers) {
       std::cout << "Error: Number of triggers in busy/busyv link count vectors from RU " << RU_num;
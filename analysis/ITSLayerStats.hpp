@@ -11,6 +11,8 @@
 
 
 #include "ReadoutUnitStats.hpp"
+#include <memory>
+#include <vector>
 
 
 class ITSLayerStats {
@@ -22,7 +24,7 @@ class ITSLayerStats {
   std::string mSimDataPath;
   std::shared_ptr<EventData> mEventData;
 
-  std::vector<ReadoutUnitStats> mRUStats;
+  std::vector<std::unique_ptr<ReadoutUnitStats>> mRUStats;
 
   uint64_t mNumTriggers;
 
@@ -90,7 +92,9 @@ class ITSLayerStats {
 public:
   ITSLayerStats(unsigned int layer_num, unsigned int num_staves,
                 unsigned long sim_time_ns, std::string sim_type,
-                const char* path, std::shared_ptr<EventData> event_data);
+                const char* path, std::shared_ptr<EventData> event_data,
+                std::vector<std::unique_ptr<ReadoutUnitStats>> ru_stats);
+  static unsigned int getNumReadoutUnits(unsigned int num_staves, std::string sim_type);
   void plotLayer(bool create_png, bool create_pdf);
   double getTriggerCoverage(uint64_t trigger_id) const;
   uint64_t getNumTriggers(void) {return mNumTriggers;}
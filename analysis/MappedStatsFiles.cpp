@@ -0,0 +1,176 @@
+/**
+ * @file   MappedStatsFiles.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Memory mapped, read-only views of the binary statistics files written
+ *         by the ReadoutUnit.
+ */
+
+#include "MappedStatsFiles.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+///@brief Map a file for reading
+///@param filename File name
+///@throw std::runtime_error if the file could not be opened or mapped
+MappedFile::MappedFile(const std::string& filename)
+  : mFilename(filename)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+
+  if(fd < 0)
+    throw std::runtime_error("Error opening file " + filename);
+
+  struct stat file_stat;
+  if(fstat(fd, &file_stat) != 0) {
+    close(fd);
+    throw std::runtime_error("Error getting size of file " + filename);
+  }
+
+  mSize = file_stat.st_size;
+
+  // Empty files can not be mapped, and are left with a null pointer
+  if(mSize > 0) {
+    void* addr = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if(addr == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Error mapping file " + filename);
+    }
+
+    // The files are walked from start to end
+    madvise(addr, mSize, MADV_SEQUENTIAL);
+
+    mData = static_cast<const uint8_t*>(addr);
+  }
+
+  // The mapping stays valid after the file descriptor is closed
+  close(fd);
+}
+
+
+MappedFile::~MappedFile()
+{
+  if(mData != nullptr)
+    munmap(const_cast<uint8_t*>(mData), mSize);
+}
+
+
+///@brief Check that an array of values starting at an offset is within the file
+///@param offset Offset of first value
+///@param count Number of values
+///@param element_size Size of each value
+///@throw std::runtime_error if the range goes past the end of the file
+void MappedFile::checkRange(size_t offset, uint64_t count, size_t element_size) const
+{
+  if(offset > mSize || count > (mSize - offset) / element_size)
+    throw std::runtime_error("Unexpected end of file " + mFilename);
+}
+
+
+TrigActionsFileView::TrigActionsFileView(const std::string& filename)
+  : mFile(filename)
+{
+  mFile.checkRange(0, HEADER_SIZE);
+
+  mNumTriggers = mFile.read<uint64_t>(0);
+  mNumCtrlLinks = mFile.read<uint8_t>(sizeof(uint64_t));
+
+  // Without control links the file only has the header, there are no actions to check
+  if(mNumCtrlLinks > 0)
+    mFile.checkRange(HEADER_SIZE, mNumTriggers, mNumCtrlLinks);
+}
+
+
+BusyEventsFileView::BusyEventsFileView(const std::string& filename)
+  : mFile(filename)
+{
+  mFile.checkRange(0, sizeof(uint8_t));
+
+  unsigned int num_links = mFile.read<uint8_t>(0);
+  size_t offset = sizeof(uint8_t);
+
+  for(unsigned int link = 0; link < num_links; link++) {
+    mFile.checkRange(offset, sizeof(uint64_t));
+    uint64_t num_events = mFile.read<uint64_t>(offset);
+    offset += sizeof(uint64_t);
+
+    mFile.checkRange(offset, num_events, sizeof(BusyEventRecord));
+    mLinks.push_back(std::make_pair(num_events, offset));
+    offset += num_events*sizeof(BusyEventRecord);
+  }
+}
+
+
+ChipEventsFileView::ChipEventsFileView(const std::string& filename)
+  : mFile(filename)
+{
+  mFile.checkRange(0, sizeof(uint8_t));
+
+  unsigned int num_links = mFile.read<uint8_t>(0);
+  size_t offset = sizeof(uint8_t);
+
+  mLinks.resize(num_links);
+
+  for(unsigned int link = 0; link < num_links; link++) {
+    mFile.checkRange(offset, sizeof(uint8_t));
+    unsigned int num_chips = mFile.read<uint8_t>(offset);
+    offset += sizeof(uint8_t);
+
+    for(unsigned int chip = 0; chip < num_chips; chip++) {
+      ChipEventsView chip_events;
+
+      mFile.checkRange(offset, sizeof(uint8_t) + sizeof(uint64_t));
+      chip_events.mChipId = mFile.read<uint8_t>(offset);
+      chip_events.mNumEvents = mFile.read<uint64_t>(offset + sizeof(uint8_t));
+      offset += sizeof(uint8_t) + sizeof(uint64_t);
+
+      mFile.checkRange(offset, chip_events.mNumEvents, sizeof(uint64_t));
+      chip_events.mTriggerIds = mFile.data() + offset;
+      offset += chip_events.mNumEvents*sizeof(uint64_t);
+
+      mLinks[link].push_back(chip_events);
+    }
+  }
+}
+
+
+///@brief Map all the binary statistics files for one readout unit
+///@param sim_data_path Path to simulation run data directory
+///@param layer Layer id of readout unit
+///@param stave Stave id of readout unit
+ReadoutUnitFileViews::ReadoutUnitFileViews(const std::string& sim_data_path,
+                                           unsigned int layer, unsigned int stave)
+  : mLayer(layer)
+  , mStave(stave)
+  , mTrigActions(sim_data_path + "/RU_" + std::to_string(layer) + "_" + std::to_string(stave) + "_trigger_actions.dat")
+  , mBusyEvents(sim_data_path + "/RU_" + std::to_string(layer) + "_" + std::to_string(stave) + "_busy_events.dat")
+  , mBusyVEvents(sim_data_path + "/RU_" + std::to_string(layer) + "_" + std::to_string(stave) + "_busyv_events.dat")
+  , mFlushEvents(sim_data_path + "/RU_" + std::to_string(layer) + "_" + std::to_string(stave) + "_flush_events.dat")
+  , mAbortEvents(sim_data_path + "/RU_" + std::to_string(layer) + "_" + std::to_string(stave) + "_ro_abort_events.dat")
+  , mFatalEvents(sim_data_path + "/RU_" + std::to_string(layer) + "_" + std::to_string(stave) + "_fatal_events.dat")
+{
+}
+
+
+///@brief Map the binary statistics files for many readout units at once. Only the
+///       file headers are read, the data is paged in from the files when it is accessed.
+///@param sim_data_path Path to simulation run data directory
+///@param layer_staves Layer and stave id of each readout unit
+///@return Views of the files for each readout unit, in the same order as layer_staves
+std::vector<std::shared_ptr<ReadoutUnitFileViews>>
+mapReadoutUnitFiles(const std::string& sim_data_path,
+                    const std::vector<std::pair<unsigned int, unsigned int>>& layer_staves)
+{
+  std::vector<std::shared_ptr<ReadoutUnitFileViews>> views;
+
+  for(auto it = layer_staves.begin(); it != layer_staves.end(); it++)
+    views.push_back(std::make_shared<ReadoutUnitFileViews>(sim_data_path, it->first, it->second));
+
+  return views;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file   MappedStatsFiles.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Memory mapped, read-only views of the binary statistics files written
+ *         by the ReadoutUnit (RU_<layer>_<stave>_trigger_actions.dat, _busy_events.dat,
+ *         and the _busyv/_flush/_ro_abort/_fatal_events.dat files).
+ *
+ *         The files are mapped and walked in place. Only the headers are parsed
+ *         when a file is opened (to index where the data for each link/chip starts),
+ *         the records are read directly from the mapping when they are accessed.
+ *         See ReadoutUnit::writeSimulationStats() for the file formats.
+ */
+
+#ifndef MAPPED_STATS_FILES_HPP
+#define MAPPED_STATS_FILES_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+///@brief Read-only memory mapping of a whole file
+class MappedFile {
+  const uint8_t* mData = nullptr;
+  size_t mSize = 0;
+  std::string mFilename;
+
+public:
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const uint8_t* data(void) const {return mData;}
+  size_t size(void) const {return mSize;}
+  const std::string& getFilename(void) const {return mFilename;}
+
+  ///@brief Read a value at an offset in the file. The files are written without
+  ///       padding, so values are not necessarily aligned.
+  template<class T>
+  T read(size_t offset) const {
+    T value;
+    std::memcpy(&value, mData + offset, sizeof(T));
+    return value;
+  }
+
+  void checkRange(size_t offset, uint64_t count, size_t element_size = 1) const;
+};
+
+
+///@brief View of a _trigger_actions.dat file, one action byte per control link per trigger
+class TrigActionsFileView {
+  MappedFile mFile;
+  uint64_t mNumTriggers;
+  unsigned int mNumCtrlLinks;
+
+  static const size_t HEADER_SIZE = sizeof(uint64_t) + sizeof(uint8_t);
+
+public:
+  explicit TrigActionsFileView(const std::string& filename);
+
+  uint64_t getNumTriggers(void) const {return mNumTriggers;}
+  unsigned int getNumCtrlLinks(void) const {return mNumCtrlLinks;}
+
+  ///@brief Get pointer to the actions for a trigger, one byte per control link.
+  ///       Nothing should be read from it when there are no control links.
+  const uint8_t* getTriggerActions(uint64_t trigger_id) const {
+    return mFile.data() + HEADER_SIZE + trigger_id*mNumCtrlLinks;
+  }
+};
+
+
+struct BusyEventRecord {
+  uint64_t mBusyOnTime;
+  uint64_t mBusyOffTime;
+  uint64_t mBusyOnTriggerId;
+  uint64_t mBusyOffTriggerId;
+};
+
+
+///@brief View of a _busy_events.dat file, with busy on/off events per data link
+class BusyEventsFileView {
+  MappedFile mFile;
+
+  ///@brief Number of events and offset of first event for each data link
+  std::vector<std::pair<uint64_t, size_t>> mLinks;
+
+public:
+  explicit BusyEventsFileView(const std::string& filename);
+
+  unsigned int getNumLinks(void) const {return mLinks.size();}
+  uint64_t getNumEvents(unsigned int link) const {return mLinks[link].first;}
+  BusyEventRecord getEvent(unsigned int link, uint64_t event) const {
+    return mFile.read<BusyEventRecord>(mLinks[link].second + event*sizeof(BusyEventRecord));
+  }
+};
+
+
+///@brief Trigger ids for one chip in a ChipEventsFileView
+struct ChipEventsView {
+  unsigned int mChipId;
+  uint64_t mNumEvents;
+  const uint8_t* mTriggerIds;
+
+  uint64_t getTriggerId(uint64_t event) const {
+    uint64_t trigger_id;
+    std::memcpy(&trigger_id, mTriggerIds + event*sizeof(uint64_t), sizeof(uint64_t));
+    return trigger_id;
+  }
+};
+
+
+///@brief View of a file with trigger ids per chip per data link. Used for the
+///       _busyv_events.dat, _flush_events.dat, _ro_abort_events.dat and
+///       _fatal_events.dat files, which all have the same format.
+class ChipEventsFileView {
+  MappedFile mFile;
+  std::vector<std::vector<ChipEventsView>> mLinks;
+
+public:
+  explicit ChipEventsFileView(const std::string& filename);
+
+  unsigned int getNumLinks(void) const {return mLinks.size();}
+  const std::vector<ChipEventsView>& getChips(unsigned int link) const {return mLinks[link];}
+};
+
+
+///@brief Views of all the binary statistics files for one readout unit
+struct ReadoutUnitFileViews {
+  unsigned int mLayer;
+  unsigned int mStave;
+  TrigActionsFileView mTrigActions;
+  BusyEventsFileView mBusyEvents;
+  ChipEventsFileView mBusyVEvents;
+  ChipEventsFileView mFlushEvents;
+  ChipEventsFileView mAbortEvents;
+  ChipEventsFileView mFatalEvents;
+
+  ReadoutUnitFileViews(const std::string& sim_data_path, unsigned int layer, unsigned int stave);
+};
+
+
+std::vector<std::shared_ptr<ReadoutUnitFileViews>>
+mapReadoutUnitFiles(const std::string& sim_data_path,
+                    const std::vector<std::pair<unsigned int, unsigned int>>& layer_staves);
+
+
+#endif
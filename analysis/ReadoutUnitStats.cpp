@@ -17,6 +17,7 @@
 #include <iostream>
 #include <cstdlib>
 #include <algorithm>
+#include <stdexcept>
 
 #include "TCanvas.h"
 #include "TROOT.h"
@@ -43,93 +44,105 @@
 ReadoutUnitStats::ReadoutUnitStats(unsigned int layer, unsigned int stave,
                                    unsigned long sim_time_ns, const char* path,
                                    std::string sim_type, std::shared_ptr<EventData> event_data)
-  : mLayer(layer)
-  , mStave(stave)
+  : ReadoutUnitStats(mapFiles(path, layer, stave), sim_time_ns, path, sim_type, event_data)
+{
+}
+
+
+///@brief Constructor for ReadoutUnitStats, using binary statistics files that are already
+///       mapped (see mapReadoutUnitFiles(), which maps the files for many RUs at once).
+///@param files Mapped statistics files for this RU
+///@param sim_time_ns Simulation time (in nanoseconds).
+///                   Used to calculate data rates.
+///@param path Path to simulation data directory
+///@param sim_type "pct" or "its"
+///@param event_data Pointer to event data (time of events, number of hits/multiplicities)
+ReadoutUnitStats::ReadoutUnitStats(std::shared_ptr<const ReadoutUnitFileViews> files,
+                                   unsigned long sim_time_ns, const char* path,
+                                   std::string sim_type, std::shared_ptr<EventData> event_data)
+  : mLayer(files->mLayer)
+  , mStave(files->mStave)
   , mSimTimeNs(sim_time_ns)
   , mSimDataPath(path)
   , mSimType(sim_type)
   , mEventData(event_data)
 {
   std::stringstream ss_file_path_base;
-  ss_file_path_base << path << "/" << "RU_" << layer << "_" << stave;
+  ss_file_path_base << path << "/" << "RU_" << mLayer << "_" << mStave;
+
+  mLog << "Opening files: " << ss_file_path_base.str() << "_*.dat" << std::endl;
 
-  readTrigActionsFile(ss_file_path_base.str());
-  readBusyEventFiles(ss_file_path_base.str());
+  readTrigActionsFile(files->mTrigActions);
+  readBusyEventFiles(*files);
   readProtocolUtilizationFile(ss_file_path_base.str());
   readDataRateFile(ss_file_path_base.str());
   calcDataRates();
 }
 
 
-void ReadoutUnitStats::readTrigActionsFile(std::string file_path_base)
+///@brief Map the binary statistics files for a RU. Throws std::runtime_error if that fails.
+std::shared_ptr<const ReadoutUnitFileViews> ReadoutUnitStats::mapFiles(const char* path,
+                                                                       unsigned int layer,
+                                                                       unsigned int stave)
 {
-  std::stringstream ss_filename;
-  ss_filename  << file_path_base << "_trigger_actions.dat";
-  std::string filename = ss_filename.str();
-
-  std::cout << "Opening file: " << filename << std::endl;
-  std::ifstream ru_stats_file(filename.c_str(), std::ios_base::in | std::ios_base::binary);
-
-  if(!ru_stats_file.is_open()) {
-    std::cerr << "Error opening file " << filename << std::endl;
-    exit(-1);
-  }
-
-  uint64_t num_triggers;
-  uint8_t num_ctrl_links;
+  return std::make_shared<const ReadoutUnitFileViews>(path, layer, stave);
+}
 
-  std::cout << "sizeof(uint8_t): " << sizeof(uint8_t) << std::endl;
 
-  ru_stats_file.read((char*)&num_triggers, sizeof(num_triggers));
-  ru_stats_file.read((char*)&num_ctrl_links, sizeof(num_ctrl_links));
+///@brief Read the trigger actions (sent, filtered, not sent due to busy) for each
+///       trigger and control link, and calculate the trigger coverage
+///@param ru_stats_file Mapped trigger actions file for this RU
+void ReadoutUnitStats::readTrigActionsFile(const TrigActionsFileView& ru_stats_file)
+{
+  uint64_t num_triggers = ru_stats_file.getNumTriggers();
+  uint8_t num_ctrl_links = ru_stats_file.getNumCtrlLinks();
 
   mNumTriggers = num_triggers;
   mNumCtrlLinks = num_ctrl_links;
 
-  std::cout << "Num triggers: " << num_triggers << std::endl;
-  std::cout << "Num links: " << mNumCtrlLinks << std::endl;
+  mLog << "Num triggers: " << num_triggers << std::endl;
+  mLog << "Num links: " << mNumCtrlLinks << std::endl;
 
   mTrigSentCoverage.resize(num_triggers);
   mTrigSentExclFilteringCoverage.resize(num_triggers);
   mTriggerActions.resize(num_triggers);
 
-  uint64_t trigger_id = 0;
-  uint8_t trig_action = 0;
   uint64_t unknown_trig_action_count = 0;
 
   // Read trigger action byte, one per link, for each trigger ID,
   // and calculate coverage etc.
-  while(trigger_id < num_triggers && ru_stats_file.good()) {
+  for(uint64_t trigger_id = 0; trigger_id < num_triggers; trigger_id++) {
     uint8_t coverage = 0;
     uint8_t links_filtered = 0;
+    const uint8_t* trig_actions = ru_stats_file.getTriggerActions(trigger_id);
+
+    mTriggerActions[trigger_id].assign(trig_actions, trig_actions + num_ctrl_links);
 
     for(unsigned int link_id = 0; link_id < num_ctrl_links; link_id++) {
-      ru_stats_file.read((char*)&trig_action, sizeof(uint8_t));
-      //mTriggerActions[trigger_id][link_id] = trig_action;
-      mTriggerActions[trigger_id].push_back(trig_action);
+      uint8_t trig_action = trig_actions[link_id];
 
-      std::cout << "Trigger " << trigger_id;
-      std::cout << ": RU" << mLayer << "." << mStave << ": ";
+      mLog << "Trigger " << trigger_id;
+      mLog << ": RU" << mLayer << "." << mStave << ": ";
 
       switch(trig_action) {
       case TRIGGER_SENT:
-        std::cout << "TRIGGER_SENT" << std::endl;
+        mLog << "TRIGGER_SENT" << std::endl;
         coverage++;
         //links_included++;
         break;
 
       case TRIGGER_NOT_SENT_BUSY:
-        std::cout << "TRIGGER_NOT_SENT_BUSY" << std::endl;
+        mLog << "TRIGGER_NOT_SENT_BUSY" << std::endl;
         //links_included++;
         break;
 
       case TRIGGER_FILTERED:
-        std::cout << "TRIGGER_FILTERED" << std::endl;
+        mLog << "TRIGGER_FILTERED" << std::endl;
         links_filtered++;
         break;
       default:
         // This should never happen
-        std::cout << "UNKNOWN" << std::endl;
+        mLog << "UNKNOWN" << std::endl;
         unknown_trig_action_count++;
         break;
       }
@@ -141,35 +154,28 @@ void ReadoutUnitStats::readTrigActionsFile(std::string file_path_base)
     mTrigSentMeanCoverage += mTrigSentCoverage[trigger_id];
     mTrigSentExclFilteringMeanCoverage += mTrigSentExclFilteringCoverage[trigger_id];
 
-    std::cout << "Trigger " << trigger_id << std::endl;
-    std::cout << "Coverage: " << mTrigSentCoverage[trigger_id] << std::endl;
-    std::cout << "Coverage excluding filtered triggers: "<< mTrigSentExclFilteringCoverage[trigger_id] << std::endl;
+    mLog << "Trigger " << trigger_id << std::endl;
+    mLog << "Coverage: " << mTrigSentCoverage[trigger_id] << std::endl;
+    mLog << "Coverage excluding filtered triggers: "<< mTrigSentExclFilteringCoverage[trigger_id] << std::endl;
 
     // Keep a record of those triggers that were filtered for some, but not all control links
     if(links_filtered != 0 && links_filtered != num_ctrl_links)
       mTriggerMismatch.push_back(trigger_id);
-
-    trigger_id++;
   }
 
   mTrigSentMeanCoverage /= mNumTriggers;
   mTrigSentExclFilteringMeanCoverage /= mNumTriggers;
 
-  if(trigger_id != num_triggers) {
-    std::cerr << "Error reading " << num_triggers << ", got only " << trigger_id << std::endl;
-    exit(-1);
-  }
-
-  std::cout << "Number of unknown trigger actions: " << unknown_trig_action_count << std::endl;
+  mLog << "Number of unknown trigger actions: " << unknown_trig_action_count << std::endl;
 
-  std::cout << "Links with filter mismatch: ";
+  mLog << "Links with filter mismatch: ";
   for(auto it = mTriggerMismatch.begin(); it != mTriggerMismatch.end(); it++) {
     if(it == mTriggerMismatch.begin())
-       std::cout << *it;
+       mLog << *it;
     else
-      std::cout << ", " << *it;
+      mLog << ", " << *it;
   }
-  std::cout << std::endl;
+  mLog << std::endl;
 }
 
 
@@ -177,111 +183,44 @@ void ReadoutUnitStats::readTrigActionsFile(std::string file_path_base)
 ///       found with the various busy event data.
 ///       Expects readTrigActionsFile() to have been called first, because the
 ///       mTrigSentCoverage vector needs to have been set up for some of the calculations here.
-///@todo  Should have added a function for reading the busyv/flush/ro_abort/fatal
-///       event files, since they all share the same format, but that required
-///       some structural changes and I was too lazy to do it..
-///@param file_path_base Path to simulation run data directory
-void ReadoutUnitStats::readBusyEventFiles(std::string file_path_base)
+///@param files Mapped statistics files for this RU
+void ReadoutUnitStats::readBusyEventFiles(const ReadoutUnitFileViews& files)
 {
-  std::stringstream ss_busy_events;
-  std::stringstream ss_busyv_events;
-  std::stringstream ss_flush_events;
-  std::stringstream ss_abort_events;
-  std::stringstream ss_fatal_events;
-
-  ss_busy_events  << file_path_base << "_busy_events.dat";
-  ss_busyv_events << file_path_base << "_busyv_events.dat";
-  ss_flush_events << file_path_base << "_flush_events.dat";
-  ss_abort_events << file_path_base << "_ro_abort_events.dat";
-  ss_fatal_events << file_path_base << "_fatal_events.dat";
-
-  std::string busy_events_filename = ss_busy_events.str();
-  std::string busyv_events_filename = ss_busyv_events.str();
-  std::string flush_events_filename = ss_flush_events.str();
-  std::string abort_events_filename = ss_abort_events.str();
-  std::string fatal_events_filename = ss_fatal_events.str();
-
-  std::cout << "Opening file: " << busy_events_filename << std::endl;
-  std::ifstream busy_file(busy_events_filename, std::ios_base::in | std::ios_base::binary);
-
-  if(!busy_file.is_open()) {
-    std::cerr << "Error opening file " << busy_events_filename << std::endl;
-    exit(-1);
-  }
-
-  std::cout << "Opening file: " << busyv_events_filename << std::endl;
-  std::ifstream busyv_file(busyv_events_filename, std::ios_base::in | std::ios_base::binary);
-
-  if(!busyv_file.is_open()) {
-    std::cerr << "Error opening file " << busyv_events_filename << std::endl;
-    exit(-1);
-  }
+  const BusyEventsFileView& busy_file = files.mBusyEvents;
+  unsigned int num_data_links = busy_file.getNumLinks();
 
-  std::cout << "Opening file: " << flush_events_filename << std::endl;
-  std::ifstream flush_file(flush_events_filename, std::ios_base::in | std::ios_base::binary);
-
-  if(!flush_file.is_open()) {
-    std::cerr << "Error opening file " << flush_events_filename << std::endl;
-    exit(-1);
-  }
-
-  std::cout << "Opening file: " << abort_events_filename << std::endl;
-  std::ifstream abort_file(abort_events_filename, std::ios_base::in | std::ios_base::binary);
-
-  if(!abort_file.is_open()) {
-    std::cerr << "Error opening file " << abort_events_filename << std::endl;
-    exit(-1);
-  }
-
-  std::cout << "Opening file: " << fatal_events_filename << std::endl;
-  std::ifstream fatal_file(fatal_events_filename, std::ios_base::in | std::ios_base::binary);
-
-  if(!fatal_file.is_open()) {
-    std::cerr << "Error opening file " << fatal_events_filename << std::endl;
-    exit(-1);
-  }
-
-  uint8_t num_data_links_busy_file = 0;
-  uint8_t num_data_links_busyv_file = 0;
-  uint8_t num_data_links_flush_file = 0;
-  uint8_t num_data_links_abort_file = 0;
-  uint8_t num_data_links_fatal_file = 0;
-
-  busy_file.read((char*)&num_data_links_busy_file, sizeof(uint8_t));
-  busyv_file.read((char*)&num_data_links_busyv_file, sizeof(uint8_t));
-  flush_file.read((char*)&num_data_links_flush_file, sizeof(uint8_t));
-  abort_file.read((char*)&num_data_links_abort_file, sizeof(uint8_t));
-  fatal_file.read((char*)&num_data_links_fatal_file, sizeof(uint8_t));
-
-  if(num_data_links_busy_file != num_data_links_busyv_file ||
-     num_data_links_busy_file != num_data_links_flush_file ||
-     num_data_links_busy_file != num_data_links_abort_file ||
-     num_data_links_busy_file != num_data_links_fatal_file)
+  if(num_data_links != files.mBusyVEvents.getNumLinks() ||
+     num_data_links != files.mFlushEvents.getNumLinks() ||
+     num_data_links != files.mAbortEvents.getNumLinks() ||
+     num_data_links != files.mFatalEvents.getNumLinks())
   {
-    std::cerr << "Error: number of data links in busy/busyv/flush/abort/fatal ";
-    std::cerr << "files does not match." << std::endl;
-    exit(-1);
+    std::stringstream error_msg;
+    error_msg << "Number of data links in busy/busyv/flush/abort/fatal ";
+    error_msg << "files does not match.";
+    throw std::runtime_error(error_msg.str());
   }
 
-  std::cout << std::endl << std::endl;
-  std::cout << "Number of data links: ";
-  std::cout << int(num_data_links_busy_file);
-  std::cout << std::endl;
-  std::cout << "-------------------------------------------------" << std::endl;
+  mLog << std::endl << std::endl;
+  mLog << "Number of data links: ";
+  mLog << num_data_links;
+  mLog << std::endl;
+  mLog << "-------------------------------------------------" << std::endl;
 
+  // Resize vector and initialize each element to number of data links
+  mTrigReadoutCoverage.resize(mNumTriggers, num_data_links);
+  mTrigReadoutExclFilteringCoverage.resize(mNumTriggers, num_data_links);
 
   // Iterate through data for each link
-  for(uint8_t link_count = 0; link_count < num_data_links_busy_file; link_count++) {
+  for(unsigned int link_count = 0; link_count < num_data_links; link_count++) {
 
-    std::cout << "Data link " << int(link_count) << std::endl;
+    mLog << "Data link " << link_count << std::endl;
 
     // Add a new LinkStats entry
     mLinkStats.emplace_back(mLayer, mStave, link_count);
 
     // Number of busy events for this link
-    uint64_t num_busy_events = 0;
-    busy_file.read((char*)&num_busy_events, sizeof(uint64_t));
-    std::cout << "Number of busy events: " << num_busy_events << std::endl;
+    uint64_t num_busy_events = busy_file.getNumEvents(link_count);
+    mLog << "Number of busy events: " << num_busy_events << std::endl;
 
 
     //--------------------------------------------------------------------------
@@ -290,21 +229,19 @@ void ReadoutUnitStats::readBusyEventFiles(std::string file_path_base)
 
     // Iterate through busy events for this link
     for(uint64_t event_count = 0; event_count < num_busy_events; event_count++) {
+      BusyEventRecord busy_event = busy_file.getEvent(link_count, event_count);
       BusyTime busy_time;
-      uint64_t busy_on_trigger = 0;
-      uint64_t busy_off_trigger = 0;
+      uint64_t busy_on_trigger = busy_event.mBusyOnTriggerId;
+      uint64_t busy_off_trigger = busy_event.mBusyOffTriggerId;
 
-      busy_file.read((char*)&busy_time.mStartTimeNs, sizeof(uint64_t));
-      busy_file.read((char*)&busy_time.mEndTimeNs, sizeof(uint64_t));
+      busy_time.mStartTimeNs = busy_event.mBusyOnTime;
+      busy_time.mEndTimeNs = busy_event.mBusyOffTime;
 
       busy_time.mBusyTimeNs = busy_time.mEndTimeNs - busy_time.mStartTimeNs;
 
       // Keep track of busy time for all links, as well as for individual links (below)
       mAllBusyTime.push_back(busy_time.mBusyTimeNs);
 
-      busy_file.read((char*)&busy_on_trigger, sizeof(uint64_t));
-      busy_file.read((char*)&busy_off_trigger, sizeof(uint64_t));
-
       // Add entry with data about when the link went busy,
       // and when it went out of busy, for this busy event
       mLinkStats.back().mBusyTime.push_back(busy_time);
@@ -323,261 +260,121 @@ void ReadoutUnitStats::readBusyEventFiles(std::string file_path_base)
       mLinkStats.back().mBusyTriggerLengths.push_back(1 + (busy_off_trigger-busy_on_trigger));
       mAllBusyTriggerLengths.push_back(1 + (busy_off_trigger-busy_on_trigger));
 
-      std::cout << "Busy event " << event_count << std::endl;
-      std::cout << "\tBusy on time: " << busy_time.mStartTimeNs << std::endl;
-      std::cout << "\tBusy off time: " << busy_time.mEndTimeNs << std::endl;
-      std::cout << "\tBusy time: " << busy_time.mBusyTimeNs << std::endl;
-
-      std::cout << "\tBusy on trigger: " << busy_on_trigger << std::endl;
-      std::cout << "\tBusy off trigger: " << busy_off_trigger << std::endl;
-    }
-
-
-    //--------------------------------------------------------------------------
-    // Read busy violation event file
-    //--------------------------------------------------------------------------
-      
-    // get number of chips with busy v events in this link
-    uint64_t num_busyv_chips = 0;
-    busyv_file.read((char*) &num_busyv_chips, sizeof(uint8_t));
-    std::cout << "Number of chips with busyv events: " << num_busyv_chips << std::endl;
-
-    uint64_t busyv_sequence_count = 0;
-
-    // Resize vector and initialize each element to number of data links
-    mTrigReadoutCoverage.resize(mNumTriggers, num_data_links_busyv_file);
-    mTrigReadoutExclFilteringCoverage.resize(mNumTriggers, num_data_links_busyv_file);
-  
-    for(uint64_t chip_count = 0; chip_count < num_busyv_chips; chip_count++){
-
-    uint64_t chip_id = 0;
-    busyv_file.read((char*) &chip_id, sizeof(uint8_t));
-    uint64_t num_busyv_event_chip = 0;
-    busyv_file.read((char*) &num_busyv_event_chip, sizeof(uint64_t));
-    std::cout << "Number of busyv events for chip id " << chip_id <<": " << num_busyv_event_chip << std::endl;
-
-    // Iterate through busy violation events for this link
-    for(uint64_t event_count = 0; event_count < num_busyv_event_chip; event_count++) {
-    
-      
-      uint64_t busyv_trigger_id = 0;
-
-      // get busyv trigger id
-      busyv_file.read((char*)&busyv_trigger_id, sizeof(uint64_t));
-
-      // Subtract one link per trigger id, for each busyv event
-      mTrigReadoutCoverage[busyv_trigger_id]--;
-      mTrigReadoutExclFilteringCoverage[busyv_trigger_id]--;
-
-      // If this is not the first busy violation event, calculate how
-      // many triggers since the previous busy violation, and calculate
-      // lengths of busy violation sequences
-      if(event_count > 0) {
-        uint64_t prev_busyv_trigger = mLinkStats.back().mBusyVTriggers.back();
-        uint64_t busyv_distance = busyv_trigger_id - prev_busyv_trigger;
-
-        // Keep track of busyv distances per link, and for all links
-        mLinkStats.back().mBusyVTriggerDistances.push_back(busyv_distance);
-        mAllBusyVTriggerDistances.push_back(busyv_distance);
-
-        if(busyv_sequence_count > 0 && busyv_distance > 1) {
-          // Keep track of busyv sequences per link, and for all links
-          mLinkStats.back().mBusyVTriggerSequences.push_back(busyv_sequence_count);
-          mAllBusyVTriggerSequences.push_back(busyv_sequence_count);
-
-          busyv_sequence_count = 0;
-        }
-      }
-
-      busyv_sequence_count++;
-
-      mLinkStats.back().mBusyVTriggers.push_back(busyv_trigger_id);
-
-      std::cout << "Busy violation event " << event_count << std::endl;
-      std::cout << "\tTrigger id: " << busyv_trigger_id << std::endl ;
-    }
-
-    if(busyv_sequence_count > 0) {
-      // Keep track of busyv sequences per link, and for all links
-      mLinkStats.back().mBusyVTriggerSequences.push_back(busyv_sequence_count);
-      mAllBusyVTriggerSequences.push_back(busyv_sequence_count);
-    }
+      mLog << "Busy event " << event_count << std::endl;
+      mLog << "\tBusy on time: " << busy_time.mStartTimeNs << std::endl;
+      mLog << "\tBusy off time: " << busy_time.mEndTimeNs << std::endl;
+      mLog << "\tBusy time: " << busy_time.mBusyTimeNs << std::endl;
 
+      mLog << "\tBusy on trigger: " << busy_on_trigger << std::endl;
+      mLog << "\tBusy off trigger: " << busy_off_trigger << std::endl;
     }
 
-    //--------------------------------------------------------------------------
-    // Read flushed incomplete event file
-    //--------------------------------------------------------------------------
-
-    // Number of busy violation events for this link
-    uint64_t num_flush_events = 0;
-    flush_file.read((char*)&num_flush_events, sizeof(uint8_t));
-
-    std::cout << "Number of flushed incomplete events: ";
-    std::cout << num_flush_events << std::endl;
+    LinkStats& link_stats = mLinkStats.back();
 
-    uint64_t flush_sequence_count = 0;
+    readChipEvents(files.mBusyVEvents.getChips(link_count), "Busy violation",
+                   link_stats.mBusyVTriggers,
+                   link_stats.mBusyVTriggerDistances, mAllBusyVTriggerDistances,
+                   link_stats.mBusyVTriggerSequences, mAllBusyVTriggerSequences);
 
-    // Iterate through flushed incomplete events for this link
-    for(uint64_t event_count = 0; event_count < num_flush_events; event_count++) {
-      uint64_t flush_trigger_id = 0;
-
-      flush_file.read((char*)&flush_trigger_id, sizeof(uint64_t));
-
-      // Subtract one link per trigger id, for each flush event
-      mTrigReadoutCoverage[flush_trigger_id]--;
-      mTrigReadoutExclFilteringCoverage[flush_trigger_id]--;
-
-      // If this is not the first flushed incomplete event, calculate how
-      // many triggers since the previous flushed event, and calculate
-      // lengths of flushed incomplete sequences
-      if(event_count > 0) {
-        uint64_t prev_flush_trigger = mLinkStats.back().mFlushTriggers.back();
-        uint64_t flush_distance = flush_trigger_id - prev_flush_trigger;
+    readChipEvents(files.mFlushEvents.getChips(link_count), "Flushed incomplete",
+                   link_stats.mFlushTriggers,
+                   link_stats.mFlushTriggerDistances, mAllFlushTriggerDistances,
+                   link_stats.mFlushTriggerSequences, mAllFlushTriggerSequences);
 
-        // Keep track of flush incomplete distances per link, and for all links
-        mLinkStats.back().mFlushTriggerDistances.push_back(flush_distance);
-        mAllFlushTriggerDistances.push_back(flush_distance);
+    readChipEvents(files.mAbortEvents.getChips(link_count), "Readout abort",
+                   link_stats.mAbortTriggers,
+                   link_stats.mAbortTriggerDistances, mAllAbortTriggerDistances,
+                   link_stats.mAbortTriggerSequences, mAllAbortTriggerSequences);
 
-        if(flush_sequence_count > 0 && flush_distance > 1) {
-          // Keep track of flush incomplete sequences per link and for all links
-          mLinkStats.back().mFlushTriggerSequences.push_back(flush_sequence_count);
-          mAllFlushTriggerSequences.push_back(flush_sequence_count);
+    readChipEvents(files.mFatalEvents.getChips(link_count), "Fatal",
+                   link_stats.mFatalTriggers,
+                   link_stats.mFatalTriggerDistances, mAllFatalTriggerDistances,
+                   link_stats.mFatalTriggerSequences, mAllFatalTriggerSequences);
+  } // iterate through each data link
 
-          flush_sequence_count = 0;
-        }
-      }
 
-      flush_sequence_count++;
+  // Finish calculation of readout trigger coverage
+  for(uint64_t trig_id = 0; trig_id < mNumTriggers; trig_id++) {
+    mTrigReadoutCoverage[trig_id] -= (1 - mTrigSentCoverage[trig_id]) * num_data_links;
+    mTrigReadoutCoverage[trig_id] /= num_data_links;
 
-      mLinkStats.back().mFlushTriggers.push_back(flush_trigger_id);
+    mTrigReadoutExclFilteringCoverage[trig_id] -=
+      (1 - mTrigSentExclFilteringCoverage[trig_id]) * num_data_links;
 
-      std::cout << "Flushed incomplete event " << event_count << std::endl;
-      std::cout << "\tTrigger id: " << flush_trigger_id << std::endl ;
-    }
+    mTrigReadoutExclFilteringCoverage[trig_id] /= num_data_links;
 
+    mTrigReadoutMeanCoverage += mTrigReadoutCoverage[trig_id];
+    mTrigReadoutExclFilteringMeanCoverage += mTrigReadoutExclFilteringCoverage[trig_id];
+  }
 
-    //--------------------------------------------------------------------------
-    // Read readout abort event file
-    //--------------------------------------------------------------------------
+  mTrigReadoutMeanCoverage /= mNumTriggers;
+  mTrigReadoutExclFilteringMeanCoverage += mNumTriggers;
+}
 
-    // Number of readout abort events for this link
-    uint64_t num_abort_events = 0;
-    abort_file.read((char*)&num_abort_events, sizeof(uint8_t));
 
-    std::cout << "Number of readout abort events: ";
-    std::cout << num_abort_events << std::endl;
+///@brief Read the busy violation, flushed incomplete, readout abort or fatal events
+///       for one link (from a file with events per chip), update the readout trigger
+///       coverage, and calculate the distances between events and lengths of sequences
+///       of events for the link and for all links.
+///@param chips Events for each chip in the link
+///@param event_name Name of event type, used for printing
+///@param link_triggers Trigger ids with events for this link
+///@param link_distances Distances between events for this link
+///@param all_distances Distances between events for all links
+///@param link_sequences Lengths of sequences of events for this link
+///@param all_sequences Lengths of sequences of events for all links
+void ReadoutUnitStats::readChipEvents(const std::vector<ChipEventsView>& chips,
+                                      const char* event_name,
+                                      std::vector<uint64_t>& link_triggers,
+                                      std::vector<uint64_t>& link_distances,
+                                      std::vector<uint64_t>& all_distances,
+                                      std::vector<uint64_t>& link_sequences,
+                                      std::vector<uint64_t>& all_sequences)
+{
+  mLog << "Number of chips with " << event_name << " events: " << chips.size() << std::endl;
 
-    uint64_t abort_sequence_count = 0;
+  for(auto chip_it = chips.begin(); chip_it != chips.end(); chip_it++) {
+    uint64_t sequence_count = 0;
 
-    // Iterate through flushed incomplete events for this link
-    for(uint64_t event_count = 0; event_count < num_abort_events; event_count++) {
-      uint64_t abort_trigger_id = 0;
+    mLog << "Number of " << event_name << " events for chip id " << chip_it->mChipId;
+    mLog << ": " << chip_it->mNumEvents << std::endl;
 
-      abort_file.read((char*)&abort_trigger_id, sizeof(uint64_t));
+    for(uint64_t event_count = 0; event_count < chip_it->mNumEvents; event_count++) {
+      uint64_t trigger_id = chip_it->getTriggerId(event_count);
 
-      // Subtract one link per trigger id, for each readout abort event
-      mTrigReadoutCoverage[abort_trigger_id]--;
-      mTrigReadoutExclFilteringCoverage[abort_trigger_id]--;
+      // Subtract one link per trigger id, for each event
+      mTrigReadoutCoverage[trigger_id]--;
+      mTrigReadoutExclFilteringCoverage[trigger_id]--;
 
-      // If this is not the first readout abort event, calculate how
-      // many triggers since the readout abort event, and calculate
-      // lengths of readout abort sequences
+      // If this is not the first event, calculate how many triggers
+      // since the previous event, and calculate lengths of sequences
       if(event_count > 0) {
-        uint64_t prev_abort_trigger = mLinkStats.back().mAbortTriggers.back();
-        uint64_t abort_distance = abort_trigger_id - prev_abort_trigger;
+        uint64_t distance = trigger_id - link_triggers.back();
 
-        // Keep track of readout abort distances per link, and for all links
-        mLinkStats.back().mAbortTriggerDistances.push_back(abort_distance);
-        mAllAbortTriggerDistances.push_back(abort_distance);
+        link_distances.push_back(distance);
+        all_distances.push_back(distance);
 
-        if(abort_sequence_count > 0 && abort_distance > 1) {
-          // Keep track of abort sequences per link and for all links
-          mLinkStats.back().mAbortTriggerSequences.push_back(abort_sequence_count);
-          mAllAbortTriggerSequences.push_back(abort_sequence_count);
+        if(sequence_count > 0 && distance > 1) {
+          link_sequences.push_back(sequence_count);
+          all_sequences.push_back(sequence_count);
 
-          abort_sequence_count = 0;
+          sequence_count = 0;
         }
       }
 
-      abort_sequence_count++;
+      sequence_count++;
 
-      mLinkStats.back().mAbortTriggers.push_back(abort_trigger_id);
+      link_triggers.push_back(trigger_id);
 
-      std::cout << "Readout abort event " << event_count << std::endl;
-      std::cout << "\tTrigger id: " << abort_trigger_id << std::endl ;
+      mLog << event_name << " event " << event_count << std::endl;
+      mLog << "\tTrigger id: " << trigger_id << std::endl;
     }
 
-
-    //--------------------------------------------------------------------------
-    // Read fatal event file
-    //--------------------------------------------------------------------------
-
-    // Number of fatal events for this link
-    uint64_t num_fatal_events = 0;
-    fatal_file.read((char*)&num_fatal_events, sizeof(uint64_t));
-
-    std::cout << "Number of fatal events: ";
-    std::cout << num_fatal_events << std::endl;
-
-    uint64_t fatal_sequence_count = 0;
-
-    // Iterate through fatal events for this link
-    for(uint64_t event_count = 0; event_count < num_fatal_events; event_count++) {
-      uint64_t fatal_trigger_id = 0;
-
-      fatal_file.read((char*)&fatal_trigger_id, sizeof(uint64_t));
-
-      // Subtract one link per trigger id, for each fatal event
-      mTrigReadoutCoverage[fatal_trigger_id]--;
-      mTrigReadoutExclFilteringCoverage[fatal_trigger_id]--;
-
-      // If this is not the first fatal event, calculate how
-      // many triggers since the last fatal event, and calculate
-      // lengths of fatal sequences
-      if(event_count > 0) {
-        uint64_t prev_fatal_trigger = mLinkStats.back().mFatalTriggers.back();
-        uint64_t fatal_distance = fatal_trigger_id - prev_fatal_trigger;
-
-        // Keep track of fatal distances per link, and for all links
-        mLinkStats.back().mFatalTriggerDistances.push_back(fatal_distance);
-        mAllFatalTriggerDistances.push_back(fatal_distance);
-
-        if(fatal_sequence_count > 0 && fatal_distance > 1) {
-          // Keep track of fatal sequences per link and for all links
-          mLinkStats.back().mFatalTriggerSequences.push_back(fatal_sequence_count);
-          mAllFatalTriggerSequences.push_back(fatal_sequence_count);
-
-          fatal_sequence_count = 0;
-        }
-      }
-
-      fatal_sequence_count++;
-
-      mLinkStats.back().mFatalTriggers.push_back(fatal_trigger_id);
-
-      std::cout << "Fatal event " << event_count << std::endl;
-      std::cout << "\tTrigger id: " << fatal_trigger_id << std::endl ;
+    if(sequence_count > 0) {
+      link_sequences.push_back(sequence_count);
+      all_sequences.push_back(sequence_count);
     }
-  } // iterate through each data link
-
-
-  // Finish calculation of readout trigger coverage
-  for(uint64_t trig_id = 0; trig_id < mNumTriggers; trig_id++) {
-    mTrigReadoutCoverage[trig_id] -= (1 - mTrigSentCoverage[trig_id]) * num_data_links_busyv_file;
-    mTrigReadoutCoverage[trig_id] /= num_data_links_busyv_file;
-
-    mTrigReadoutExclFilteringCoverage[trig_id] -=
-      (1 - mTrigSentExclFilteringCoverage[trig_id]) * num_data_links_busyv_file;
-
-    mTrigReadoutExclFilteringCoverage[trig_id] /= num_data_links_busyv_file;
-
-    mTrigReadoutMeanCoverage += mTrigReadoutCoverage[trig_id];
-    mTrigReadoutExclFilteringMeanCoverage += mTrigReadoutExclFilteringCoverage[trig_id];
   }
-
-  mTrigReadoutMeanCoverage /= mNumTriggers;
-  mTrigReadoutExclFilteringMeanCoverage += mNumTriggers;
 }
 
 
@@ -587,9 +384,10 @@ void ReadoutUnitStats::readBusyEventFiles(std::string file_path_base)
 void ReadoutUnitStats::readProtocolUtilizationFile(std::string file_path_base)
 {
   if(mLinkStats.empty()) {
-    std::cout << "ReadoutUnitStats::readProtocolUtilizationFile(): called without";
-    std::cout << " initializing LinkStats objects first." << std::endl;
-    exit(-1);
+    std::stringstream error_msg;
+    error_msg << "ReadoutUnitStats::readProtocolUtilizationFile(): called without";
+    error_msg << " initializing LinkStats objects first.";
+    throw std::runtime_error(error_msg.str());
   }
 
   unsigned int num_data_links = mLinkStats.size();
@@ -601,21 +399,23 @@ void ReadoutUnitStats::readProtocolUtilizationFile(std::string file_path_base)
 
   std::string prot_util_filename = ss_prot_util.str();
 
-  std::cout << "Opening file: " << prot_util_filename << std::endl;
+  mLog << "Opening file: " << prot_util_filename << std::endl;
   std::ifstream prot_util_file(prot_util_filename, std::ios_base::in);
 
   if(!prot_util_file.is_open()) {
-    std::cerr << "Error opening file " << prot_util_filename << std::endl;
-    exit(-1);
+    std::stringstream error_msg;
+    error_msg << "Error opening file " << prot_util_filename;
+    throw std::runtime_error(error_msg.str());
   }
 
   std::string csv_header;
   std::getline(prot_util_file, csv_header);
 
   if(csv_header.length() == 0) {
-    std::cout << "ReadoutUnitStats::readProtocolUtilizationFile(): ";
-    std::cout << "Error reading or empty CSV header read." << std::endl;
-    exit(-1);
+    std::stringstream error_msg;
+    error_msg << "ReadoutUnitStats::readProtocolUtilizationFile(): ";
+    error_msg << "Error reading or empty CSV header read.";
+    throw std::runtime_error(error_msg.str());
   }
 
   unsigned int index = 0;
@@ -625,7 +425,7 @@ void ReadoutUnitStats::readProtocolUtilizationFile(std::string file_path_base)
     mProtocolUtilization[header_field] = 0;
     mProtUtilIndex[index] = header_field;
 
-    std::cout << "Found field: " << header_field << std::endl;
+    mLog << "Found field: " << header_field << std::endl;
 
     // Remove the current field, accounting for both with
     // or without semicolon at the end
@@ -640,8 +440,8 @@ void ReadoutUnitStats::readProtocolUtilizationFile(std::string file_path_base)
 
   for(unsigned int link_count = 0; link_count < num_data_links; link_count++) {
     if(prot_util_file.good() == false) {
-      std::cout << "ReadoutUnitStats::readProtocolUtilizationFile(): CSV file not ";
-      std::cout << "good before " << num_data_links << "links have been read." << std::endl;
+      std::cerr << "ReadoutUnitStats::readProtocolUtilizationFile(): CSV file not ";
+      std::cerr << "good before " << num_data_links << "links have been read." << std::endl;
     }
 
     mLinkStats[link_count].mProtUtilIndex = mProtUtilIndex;
@@ -670,32 +470,33 @@ void ReadoutUnitStats::readProtocolUtilizationFile(std::string file_path_base)
     }
 
     if(index != mProtUtilIndex.size()) {
-      std::cout << "Incorrect number of fields on line " << link_count+1;
-      std::cout << " in file " << prot_util_filename << std::endl;
-      exit(-1);
+      std::stringstream error_msg;
+      error_msg << "Incorrect number of fields on line " << link_count+1;
+      error_msg << " in file " << prot_util_filename;
+      throw std::runtime_error(error_msg.str());
     }
   }
 
 
-  std::cout << std::endl << std::endl;
-  std::cout << "Printing link utilization stats - totals:" << std::endl;
-  std::cout << "-----------------------------------------" << std::endl;
+  mLog << std::endl << std::endl;
+  mLog << "Printing link utilization stats - totals:" << std::endl;
+  mLog << "-----------------------------------------" << std::endl;
 
   for(auto it = mProtUtilIndex.begin(); it != mProtUtilIndex.end(); it++) {
-    std::cout << it->second << ": " << mProtocolUtilization[it->second] << std::endl;
+    mLog << it->second << ": " << mProtocolUtilization[it->second] << std::endl;
   }
 
-  std::cout << std::endl << std::endl;
+  mLog << std::endl << std::endl;
 
   for(unsigned int link_count = 0; link_count < num_data_links; link_count++) {
-    std::cout << std::endl << std::endl;
-    std::cout << "Printing link utilization stats - link " << link_count << ":" << std::endl;
-    std::cout << "-----------------------------------------" << std::endl;
+    mLog << std::endl << std::endl;
+    mLog << "Printing link utilization stats - link " << link_count << ":" << std::endl;
+    mLog << "-----------------------------------------" << std::endl;
 
     for(auto it = mProtUtilIndex.begin(); it != mProtUtilIndex.end(); it++) {
-      std::cout << it->second << ": " << mLinkStats[link_count].mProtocolUtilization[it->second] << std::endl;
+      mLog << it->second << ": " << mLinkStats[link_count].mProtocolUtilization[it->second] << std::endl;
     }
-    std::cout << std::endl << std::endl;
+    mLog << std::endl << std::endl;
   }
 }
 
@@ -706,9 +507,10 @@ void ReadoutUnitStats::readProtocolUtilizationFile(std::string file_path_base)
 void ReadoutUnitStats::readDataRateFile(std::string file_path_base)
 {
   if(mLinkStats.empty()) {
-    std::cout << "ReadoutUnitStats::readDataRateFile(): called without";
-    std::cout << " initializing LinkStats objects first." << std::endl;
-    exit(-1);
+    std::stringstream error_msg;
+    error_msg << "ReadoutUnitStats::readDataRateFile(): called without";
+    error_msg << " initializing LinkStats objects first.";
+    throw std::runtime_error(error_msg.str());
   }
 
   std::stringstream ss_data_rate;
@@ -717,21 +519,23 @@ void ReadoutUnitStats::readDataRateFile(std::string file_path_base)
 
   std::string data_rate_filename = ss_data_rate.str();
 
-  std::cout << "Opening file: " << data_rate_filename << std::endl;
+  mLog << "Opening file: " << data_rate_filename << std::endl;
   std::ifstream data_rate_file(data_rate_filename, std::ios_base::in);
 
   if(!data_rate_file.is_open()) {
-    std::cerr << "Error opening file " << data_rate_filename << std::endl;
-    exit(-1);
+    std::stringstream error_msg;
+    error_msg << "Error opening file " << data_rate_filename;
+    throw std::runtime_error(error_msg.str());
   }
 
   std::string csv_header;
   std::getline(data_rate_file, csv_header);
 
   if(csv_header.length() == 0) {
-    std::cout << "ReadoutUnitStats::readDataRateFile(): ";
-    std::cout << "Error reading or empty CSV header read." << std::endl;
-    exit(-1);
+    std::stringstream error_msg;
+    error_msg << "ReadoutUnitStats::readDataRateFile(): ";
+    error_msg << "Error reading or empty CSV header read.";
+    throw std::runtime_error(error_msg.str());
   }
 
   unsigned int index = 0;
@@ -745,7 +549,7 @@ void ReadoutUnitStats::readDataRateFile(std::string file_path_base)
     // Index used to find correct field when reading in data later
     mDataRateIndex[index] = header_field;
 
-    std::cout << "Found field: " << header_field << std::endl;
+    mLog << "Found field: " << header_field << std::endl;
 
     // Remove the current field, accounting for both with
     // or without semicolon at the end
@@ -783,9 +587,10 @@ void ReadoutUnitStats::readDataRateFile(std::string file_path_base)
     }
 
     if(index != mDataRateIndex.size()) {
-      std::cout << "Incorrect number of fields on line " << line_num;
-      std::cout << " in file " << data_rate_filename << std::endl;
-      exit(-1);
+      std::stringstream error_msg;
+      error_msg << "Incorrect number of fields on line " << line_num;
+      error_msg << " in file " << data_rate_filename;
+      throw std::runtime_error(error_msg.str());
     }
   }
 }
@@ -808,15 +613,15 @@ void ReadoutUnitStats::calcDataRates(void)
 
   double sim_time = mSimTimeNs/(1.0E9);
 
-  std::cout << "data_bytes: " << data_bytes << std::endl;
-  std::cout << "protocol_bytes: " << protocol_bytes << std::endl;
-  std::cout << "sim_time: " << sim_time << std::endl;
+  mLog << "data_bytes: " << data_bytes << std::endl;
+  mLog << "protocol_bytes: " << protocol_bytes << std::endl;
+  mLog << "sim_time: " << sim_time << std::endl;
 
   mDataRateMbps = 8*(data_bytes/sim_time)/(1E6);
   mProtocolRateMbps = 8*(protocol_bytes/sim_time)/(1E6);
 
-  std::cout << "mDataRateMbps: " << mDataRateMbps << std::endl;
-  std::cout << "mProtocolRateMbps: " << mProtocolRateMbps << std::endl;
+  mLog << "mDataRateMbps: " << mDataRateMbps << std::endl;
+  mLog << "mProtocolRateMbps: " << mProtocolRateMbps << std::endl;
 }
 
 
@@ -11,9 +11,11 @@
 
 #include "LinkStats.hpp"
 #include "EventData.hpp"
+#include "MappedStatsFiles.hpp"
 //#include <cstdint>
 #include <stdint.h>
 #include <memory>
+#include <sstream>
 #include <vector>
 #include <map>
 #include <string>
@@ -172,8 +174,23 @@ class ReadoutUnitStats {
 
   std::shared_ptr<EventData> mEventData;
 
-  void readTrigActionsFile(std::string file_path_base);
-  void readBusyEventFiles(std::string file_path_base);
+  // Output from parsing the statistics files. It is buffered so that several
+  // RUs can be parsed in parallel and their output printed in RU order, and is
+  // released with clearLog() once it has been printed.
+  std::ostringstream mLog;
+
+  static std::shared_ptr<const ReadoutUnitFileViews> mapFiles(const char* path,
+                                                              unsigned int layer,
+                                                              unsigned int stave);
+  void readTrigActionsFile(const TrigActionsFileView& ru_stats_file);
+  void readBusyEventFiles(const ReadoutUnitFileViews& files);
+  void readChipEvents(const std::vector<ChipEventsView>& chips,
+                      const char* event_name,
+                      std::vector<uint64_t>& link_triggers,
+                      std::vector<uint64_t>& link_distances,
+                      std::vector<uint64_t>& all_distances,
+                      std::vector<uint64_t>& link_sequences,
+                      std::vector<uint64_t>& all_sequences);
   void readProtocolUtilizationFile(std::string file_path_base);
   void readDataRateFile(std::string file_path_base);
   void calcDataRates(void);
@@ -192,6 +209,9 @@ public:
   ReadoutUnitStats(unsigned int layer, unsigned int stave,
                    unsigned long sim_time_ns, const char* path,
                    std::string sim_type, std::shared_ptr<EventData> event_data);
+  ReadoutUnitStats(std::shared_ptr<const ReadoutUnitFileViews> files,
+                   unsigned long sim_time_ns, const char* path,
+                   std::string sim_type, std::shared_ptr<EventData> event_data);
   double getTrigSentCoverage(uint64_t trigger_id) const;
   double getTrigSentExclFilteringCoverage(uint64_t trigger_id) const;
   double getTrigReadoutCoverage(uint64_t trigger_id) const;
@@ -232,6 +252,12 @@ public:
   double getProtocolRateMbps(void) const {
     return mProtocolRateMbps;
   }
+  std::string getLog(void) const {
+    return mLog.str();
+  }
+  void clearLog(void) {
+    std::ostringstream().swap(mLog);
+  }
 
   void plotRU(bool create_png, bool create_pdf);
 };
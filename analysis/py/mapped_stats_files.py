@@ -0,0 +1,143 @@
+import numpy as np
+
+
+# Memory mapped readers for the binary statistics files written by the ReadoutUnit.
+# The files are mapped with numpy.memmap, and the arrays returned here are views
+# into the mapping, so the data is only read from disk when it is accessed and
+# is never copied. The layout of the records in the files is not aligned, numpy
+# handles that transparently.
+#
+# See read_trig_action_files.py and read_busy_event_files.py for the file formats.
+
+BUSY_EVENT_DTYPE = np.dtype([('busy_on_time_ns', '<u8'),
+                             ('busy_off_time_ns', '<u8'),
+                             ('busy_on_trig_id', '<u8'),
+                             ('busy_off_trig_id', '<u8')])
+
+# Event files with trigger ids per chip per data link, all with the same format
+CHIP_EVENT_FILE_TYPES = ['busyv', 'flush', 'ro_abort', 'fatal']
+
+
+def _map_file(filename: str) -> np.ndarray:
+    return np.memmap(filename, dtype=np.uint8, mode='r')
+
+
+def _read_u64(data: np.ndarray, idx: int) -> int:
+    return int(data[idx:idx+8].view('<u8')[0])
+
+
+def _check_range(data: np.ndarray, idx: int, size: int, filename: str):
+    if idx + size > len(data):
+        raise ValueError('Unexpected end of file ' + filename)
+
+
+def map_trig_actions_file(filename: str) -> np.ndarray:
+    """Map a file with trigger actions (sent, filtered, not sent due to busy)
+    Parameters:
+        filename: full path of filename to read
+    Return:
+        uint8 array with shape (number of triggers, number of control links)
+    """
+    data = _map_file(filename)
+    _check_range(data, 0, 9, filename)
+
+    num_triggers = _read_u64(data, 0)
+    num_ctrl_links = int(data[8])
+
+    # Without control links the file only has the header
+    if num_ctrl_links == 0:
+        return np.zeros((num_triggers, 0), dtype=np.uint8)
+
+    _check_range(data, 9, num_triggers*num_ctrl_links, filename)
+
+    return data[9:9+num_triggers*num_ctrl_links].reshape(num_triggers, num_ctrl_links)
+
+
+def map_busy_event_file(filename: str) -> list:
+    """Map a file with busy on/off events
+    Parameters:
+        filename: full path of filename to read
+    Return:
+        List with one structured array (BUSY_EVENT_DTYPE) per data link
+    """
+    data = _map_file(filename)
+    _check_range(data, 0, 1, filename)
+
+    num_data_links = int(data[0])
+    idx = 1
+    links = list()
+
+    for data_link_id in range(0, num_data_links):
+        _check_range(data, idx, 8, filename)
+        num_events = _read_u64(data, idx)
+        idx += 8
+
+        size = num_events*BUSY_EVENT_DTYPE.itemsize
+        _check_range(data, idx, size, filename)
+        links.append(data[idx:idx+size].view(BUSY_EVENT_DTYPE))
+        idx += size
+
+    return links
+
+
+def map_chip_event_file(filename: str) -> list:
+    """Map a file with busy violation, flush incomplete, readout abort or fatal events
+    Parameters:
+        filename: full path of filename to read
+    Return:
+        List with one entry per data link. Each entry is a list of (chip id, uint64 array
+        with trigger ids) tuples, one per chip that had events on the link.
+    """
+    data = _map_file(filename)
+    _check_range(data, 0, 1, filename)
+
+    num_data_links = int(data[0])
+    idx = 1
+    links = list()
+
+    for data_link_id in range(0, num_data_links):
+        _check_range(data, idx, 1, filename)
+        num_chips_with_data = int(data[idx])
+        idx += 1
+
+        chips = list()
+
+        for chip_num in range(0, num_chips_with_data):
+            _check_range(data, idx, 9, filename)
+            chip_id = int(data[idx])
+            num_events = _read_u64(data, idx+1)
+            idx += 9
+
+            _check_range(data, idx, num_events*8, filename)
+            chips.append((chip_id, data[idx:idx+num_events*8].view('<u8')))
+            idx += num_events*8
+
+        links.append(chips)
+
+    return links
+
+
+def map_ru_files(sim_data_path: str, layer_staves: list) -> dict:
+    """Map the binary statistics files for many readout units at once. Only the file
+    headers are read here, the data is paged in when the arrays are accessed.
+    Parameters:
+        sim_data_path: path to simulation run data directory
+        layer_staves: list of (layer, stave) tuples for the readout units
+    Return:
+        Dictionary with (layer, stave) as keys. Each entry is a dictionary with
+        'trigger_actions', 'busy' and the CHIP_EVENT_FILE_TYPES as keys, and the
+        mapped data for those files.
+    """
+    ru_files = dict()
+
+    for layer, stave in layer_staves:
+        base = sim_data_path + '/RU_' + str(layer) + '_' + str(stave) + '_'
+        files = {'trigger_actions': map_trig_actions_file(base + 'trigger_actions.dat'),
+                 'busy': map_busy_event_file(base + 'busy_events.dat')}
+
+        for filetype in CHIP_EVENT_FILE_TYPES:
+            files[filetype] = map_chip_event_file(base + filetype + '_events.dat')
+
+        ru_files[(layer, stave)] = files
+
+    return ru_files
@@ -1,6 +1,6 @@
-import struct
 import read_settings
 from its_chip_position import *
+from mapped_stats_files import map_busy_event_file, map_chip_event_file
 
 # File format for busy event file:
 #
@@ -24,37 +24,15 @@ def read_busy_event_file(filename: str):
     """
     event_data = list()
 
-    with open(filename, 'rb') as file:
-        file_data = file.read()
+    for data_link_id, events in enumerate(map_busy_event_file(filename)):
+        link_data = [{'busy_on_time_ns': busy_on_time_ns,
+                      'busy_off_time_ns': busy_off_time_ns,
+                      'busy_on_trig_id': busy_on_trig_id,
+                      'busy_off_trig_id': busy_off_trig_id}
+                     for busy_on_time_ns, busy_off_time_ns, busy_on_trig_id, busy_off_trig_id
+                     in events.tolist()]
 
-        num_data_links = int(file_data[0])
-        idx = 1
-
-        for data_link_id in range(0, num_data_links):
-            link_data = list()
-
-            num_events = struct.unpack('Q', file_data[idx:idx+8])[0] # uint64_t
-            idx += 8
-
-            for event_num in range(0, num_events):
-                busy_on_time_ns = struct.unpack('Q', file_data[idx:idx+8])[0]  # uint64_t
-                idx += 8
-
-                busy_off_time_ns = struct.unpack('Q', file_data[idx:idx + 8])[0]  # uint64_t
-                idx += 8
-
-                busy_on_trig_id = struct.unpack('Q', file_data[idx:idx + 8])[0]  # uint64_t
-                idx += 8
-
-                busy_off_trig_id = struct.unpack('Q', file_data[idx:idx + 8])[0]  # uint64_t
-                idx += 8
-
-                link_data.append({'busy_on_time_ns': busy_on_time_ns,
-                                  'busy_off_time_ns': busy_off_time_ns,
-                                  'busy_on_trig_id': busy_on_trig_id,
-                                  'busy_off_trig_id': busy_off_trig_id})
-
-            event_data.append({'link_id': data_link_id, 'event_data': link_data})
+        event_data.append({'link_id': data_link_id, 'event_data': link_data})
 
     return event_data
 
@@ -114,51 +92,26 @@ def read_busyv_event_file(filename: str, layer: int, stave: int):
     """
     event_data = list()
 
-    with open(filename, 'rb') as file:
-        file_data = file.read()
-
-        num_data_links = int(file_data[0])
-        idx = 1
-
-        for data_link_id in range(0, num_data_links):
-            link_data = list()
-
-            num_chips_with_data = int(file_data[idx])
-            idx += 1
-
-            print('num chips with data: ', num_chips_with_data)
-
-            for chip_num in range(0,num_chips_with_data):
-                chip_event_data = list()
-
-                chip_id = int(file_data[idx])
-                idx += 1
-
-                sub_stave_and_module_id = data_link_id_to_sub_stave_and_module_id(data_link_id, layer)
-                position = {'layer_id': layer,
-                            'stave_id': stave,
-                            'sub_stave_id': sub_stave_and_module_id['sub_stave_id'],
-                            'module_id': sub_stave_and_module_id['module_id'],
-                            'module_chip_id': 0}
-
-                # Due to a bug in the SystemC code, the chips send out the lower 4 bits of the
-                # global chip ID, instead of their local chip ID. This function repairs it
-                chip_id = fix_position_and_chip_id(position, data_link_id, chip_id)
-
-                global_chip_id = position_to_global_chip_id(position)
+    for data_link_id, chips in enumerate(map_chip_event_file(filename)):
+        link_data = list()
 
-                num_events = struct.unpack('Q', file_data[idx:idx+8])[0] # uint64_t
-                idx += 8
+        for chip_id, trig_ids in chips:
+            sub_stave_and_module_id = data_link_id_to_sub_stave_and_module_id(data_link_id, layer)
+            position = {'layer_id': layer,
+                        'stave_id': stave,
+                        'sub_stave_id': sub_stave_and_module_id['sub_stave_id'],
+                        'module_id': sub_stave_and_module_id['module_id'],
+                        'module_chip_id': 0}
 
-                for event_num in range(0, num_events):
-                    event_trig_num = struct.unpack('Q', file_data[idx:idx+8])[0]  # uint64_t
-                    idx += 8
+            # Due to a bug in the SystemC code, the chips send out the lower 4 bits of the
+            # global chip ID, instead of their local chip ID. This function repairs it
+            chip_id = fix_position_and_chip_id(position, data_link_id, chip_id)
 
-                    chip_event_data.append(event_trig_num)
+            global_chip_id = position_to_global_chip_id(position)
 
-                link_data.append({'global_chip_id': global_chip_id, 'trig_id': chip_event_data})
+            link_data.append({'global_chip_id': global_chip_id, 'trig_id': trig_ids.tolist()})
 
-            event_data.append({'link_id': data_link_id, 'event_data': link_data})
+        event_data.append({'link_id': data_link_id, 'event_data': link_data})
 
     return event_data
 
@@ -0,0 +1,166 @@
+import struct
+import sys
+import numpy as np
+
+
+# File format for columnar run statistics file (run_stats.acol), see
+# src/common/ColumnarFormat.hpp for details:
+#
+#   Header:
+#   8 bytes: magic "ALPCOL01"
+#
+#   Blocks:
+#     uint8_t:  block type (1 = table definition, 2 = chunk)
+#     uint32_t: table id
+#     uint64_t: payload size
+#     payload
+#
+#   Table definition payload:
+#     varint: name length, name
+#     varint: number of columns
+#     For each column:
+#       uint8_t: column type (0 = uint64, 1 = int64, 2 = double)
+#       varint:  name length, name
+#
+#   Chunk payload:
+#     varint: number of rows
+#     For each column:
+#       uint8_t: encoding (0 = raw 8 byte values, 1 = delta + zigzag + varint)
+#       varint:  encoded size
+#       encoded data
+
+FILE_MAGIC = b'ALPCOL01'
+
+BLOCK_TABLE = 1
+BLOCK_CHUNK = 2
+
+COLUMN_DTYPES = {0: np.uint64, 1: np.int64, 2: np.float64}
+
+ENCODING_RAW = 0
+ENCODING_DELTA_VARINT = 1
+
+
+def _read_varint(data, idx: int):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[idx]
+        idx += 1
+        value |= (byte & 0x7F) << shift
+        if byte < 0x80:
+            return value, idx
+        shift += 7
+
+
+def _read_string(data, idx: int):
+    length, idx = _read_varint(data, idx)
+    return data[idx:idx+length].decode('utf-8'), idx+length
+
+
+def _decode_delta_varint(buf: np.ndarray, num_rows: int) -> np.ndarray:
+    """Vectorized decoding of delta + zigzag + LEB128 varint encoded values
+    Parameters:
+        buf: encoded column data (uint8 array)
+        num_rows: number of values in data
+    Return:
+        Numpy uint64 array with values (two's complement for int64 columns)
+    """
+    if num_rows == 0:
+        return np.zeros(0, dtype=np.uint64)
+
+    # The last byte of each varint has the most significant bit cleared
+    is_last = buf < 0x80
+    if np.count_nonzero(is_last) != num_rows or not is_last[-1]:
+        raise ValueError('Unexpected number of values in column')
+
+    value_index = np.concatenate(([0], np.cumsum(is_last[:-1]))).astype(np.int64)
+    value_start = np.concatenate(([0], np.flatnonzero(is_last)[:-1] + 1))
+    byte_pos = np.arange(len(buf)) - value_start[value_index]
+
+    groups = (buf & 0x7F).astype(np.uint64) << (7*byte_pos).astype(np.uint64)
+    zigzag = np.zeros(num_rows, dtype=np.uint64)
+    np.bitwise_or.at(zigzag, value_index, groups)
+
+    deltas = (zigzag >> np.uint64(1)) ^ (np.uint64(0) - (zigzag & np.uint64(1)))
+
+    # Unsigned cumulative sum wraps around like the uint64 arithmetic in the writer
+    return np.cumsum(deltas, dtype=np.uint64)
+
+
+def read_columnar_file(filename: str) -> dict:
+    """Read a columnar run statistics file written by the simulation
+    Parameters:
+        filename: full path of filename to read
+    Return:
+        Dictionary with table names as keys, each table is a dictionary
+        with column names as keys and numpy arrays with the column data
+    """
+    with open(filename, 'rb') as file:
+        file_data = file.read()
+
+    if file_data[0:8] != FILE_MAGIC:
+        raise ValueError(filename + ' is not a columnar file')
+
+    buf = np.frombuffer(file_data, dtype=np.uint8)
+    idx = 8
+
+    table_names = []
+    table_columns = []
+    table_chunks = []
+
+    while idx < len(file_data):
+        block_type, table_id, payload_size = struct.unpack('<BIQ', file_data[idx:idx+13])
+        idx += 13
+        payload_end = idx + payload_size
+
+        if block_type == BLOCK_TABLE:
+            name, pos = _read_string(file_data, idx)
+            num_columns, pos = _read_varint(file_data, pos)
+            columns = []
+            for col in range(0, num_columns):
+                col_type = file_data[pos]
+                col_name, pos = _read_string(file_data, pos+1)
+                columns.append((col_name, col_type))
+            table_names.append(name)
+            table_columns.append(columns)
+            table_chunks.append([[] for col in columns])
+
+        elif block_type == BLOCK_CHUNK:
+            num_rows, pos = _read_varint(file_data, idx)
+            for col_num, (col_name, col_type) in enumerate(table_columns[table_id]):
+                encoding = file_data[pos]
+                size, pos = _read_varint(file_data, pos+1)
+                col_buf = buf[pos:pos+size]
+                pos += size
+
+                if encoding == ENCODING_RAW:
+                    values = col_buf.view('<u8')
+                elif encoding == ENCODING_DELTA_VARINT:
+                    values = _decode_delta_varint(col_buf, num_rows)
+                else:
+                    raise ValueError('Unknown encoding in column ' + col_name)
+
+                table_chunks[table_id][col_num].append(values.view(COLUMN_DTYPES[col_type]))
+
+        idx = payload_end
+
+    tables = dict()
+
+    for name, columns, chunks in zip(table_names, table_columns, table_chunks):
+        table = dict()
+        for (col_name, col_type), col_chunks in zip(columns, chunks):
+            if col_chunks:
+                table[col_name] = np.concatenate(col_chunks)
+            else:
+                table[col_name] = np.zeros(0, dtype=COLUMN_DTYPES[col_type])
+        tables[name] = table
+
+    return tables
+
+
+if __name__ == '__main__':
+    tables = read_columnar_file(sys.argv[1])
+    for table_name, table in tables.items():
+        print(table_name)
+        for col_name, values in table.items():
+            print('  ', col_name, values.dtype, len(values), values[0:5])
@@ -0,0 +1,142 @@
+import sys
+import numpy as np
+
+
+# File format for the binary physics event log (physics_events_data.evl), see
+# src/Event/EventLogFormat.hpp for details. All values after the magic are
+# LEB128 varints:
+#
+#   Header:
+#   8 bytes: magic "ALPEVL01"
+#   number of layer columns, layer id for each
+#   number of chip columns, chip id for each
+#
+#   One record per event:
+#     t_delta
+#     pixel hit count for the event
+#     pixel hit count for each layer column
+#     number of chip columns with hits, followed by for each of them:
+#       column index delta (to previous column with hits in the event)
+#       pixel hit count
+
+FILE_MAGIC = b'ALPEVL01'
+
+
+def _decode_varints(buf: np.ndarray) -> np.ndarray:
+    """Vectorized decoding of a sequence of LEB128 varints
+    Parameters:
+        buf: encoded data (uint8 array)
+    Return:
+        Numpy uint64 array with values
+    """
+    if len(buf) == 0:
+        return np.zeros(0, dtype=np.uint64)
+
+    # The last byte of each varint has the most significant bit cleared
+    is_last = buf < 0x80
+    if not is_last[-1]:
+        raise ValueError('Truncated varint at end of event log')
+
+    num_values = np.count_nonzero(is_last)
+    value_index = np.concatenate(([0], np.cumsum(is_last[:-1]))).astype(np.int64)
+    value_start = np.concatenate(([0], np.flatnonzero(is_last)[:-1] + 1))
+    byte_pos = np.arange(len(buf)) - value_start[value_index]
+
+    groups = (buf & 0x7F).astype(np.uint64) << (7*byte_pos).astype(np.uint64)
+    values = np.zeros(num_values, dtype=np.uint64)
+    np.bitwise_or.at(values, value_index, groups)
+    return values
+
+
+def read_event_log(filename: str) -> dict:
+    """Read a binary physics event log written by the simulation
+    Parameters:
+        filename: full path of filename to read
+    Return:
+        Dictionary with:
+          layer_ids:    layer id of each layer column
+          chip_ids:     chip id of each chip column
+          t_delta:      time until next event, per event
+          hit_count:    pixel hit count, per event
+          layer_counts: pixel hit counts, array of shape (events, layer columns)
+          chip_event, chip_column, chip_count: pixel hit counts for the chips with
+                        hits, as event index, chip column and count for each
+    """
+    with open(filename, 'rb') as file:
+        file_data = file.read()
+
+    if file_data[0:8] != FILE_MAGIC:
+        raise ValueError(filename + ' is not an event log file')
+
+    values = _decode_varints(np.frombuffer(file_data, dtype=np.uint8)[8:])
+    idx = 0
+
+    num_layers = int(values[idx])
+    layer_ids = values[idx+1:idx+1+num_layers]
+    idx += 1 + num_layers
+
+    num_chips = int(values[idx])
+    chip_ids = values[idx+1:idx+1+num_chips]
+    idx += 1 + num_chips
+
+    # Find the start of each record. The records have variable length, so this is
+    # done with a loop over events, the values are then gathered with numpy.
+    record_start = []
+    chips_start = []
+    while idx < len(values):
+        record_start.append(idx)
+        idx += 2 + num_layers
+        chips_start.append(idx)
+        idx += 1 + 2*int(values[idx])
+
+    if idx != len(values):
+        raise ValueError('Truncated record at end of event log ' + filename)
+
+    record_start = np.array(record_start, dtype=np.int64)
+    chips_start = np.array(chips_start, dtype=np.int64)
+    num_events = len(record_start)
+
+    layer_index = record_start[:, np.newaxis] + 2 + np.arange(num_layers)
+    num_event_chips = values[chips_start].astype(np.int64) if num_events else np.zeros(0, np.int64)
+
+    chip_event = np.repeat(np.arange(num_events), num_event_chips)
+    first_pair = np.repeat(chips_start + 1, num_event_chips)
+    pair_num = np.arange(len(chip_event)) - np.repeat(np.cumsum(num_event_chips) - num_event_chips,
+                                                      num_event_chips)
+    pair_index = first_pair + 2*pair_num
+
+    # Column deltas are relative to the previous pair in the same event
+    column_delta = values[pair_index].astype(np.int64)
+    column = np.cumsum(column_delta)
+    event_first = np.repeat(np.cumsum(num_event_chips) - num_event_chips, num_event_chips)
+    column_before_event = np.concatenate(([0], column))[event_first]
+
+    return {'layer_ids': layer_ids,
+            'chip_ids': chip_ids,
+            't_delta': values[record_start] if num_events else np.zeros(0, np.uint64),
+            'hit_count': values[record_start+1] if num_events else np.zeros(0, np.uint64),
+            'layer_counts': values[layer_index] if num_events else np.zeros((0, num_layers), np.uint64),
+            'chip_event': chip_event,
+            'chip_column': column - column_before_event,
+            'chip_count': values[pair_index + 1]}
+
+
+def chip_counts_dense(event_log: dict) -> np.ndarray:
+    """Pixel hit counts for all chip columns, as in the CSV file
+    Parameters:
+        event_log: dictionary returned by read_event_log()
+    Return:
+        Numpy array of shape (events, chip columns)
+    """
+    counts = np.zeros((len(event_log['t_delta']), len(event_log['chip_ids'])), dtype=np.uint64)
+    counts[event_log['chip_event'], event_log['chip_column']] = event_log['chip_count']
+    return counts
+
+
+if __name__ == '__main__':
+    event_log = read_event_log(sys.argv[1])
+    print('Events:', len(event_log['t_delta']))
+    print('Layers:', event_log['layer_ids'])
+    print('Chip columns:', len(event_log['chip_ids']))
+    for key in ['t_delta', 'hit_count', 'layer_counts', 'chip_count']:
+        print('  ', key, event_log[key][0:5])
@@ -1,6 +1,7 @@
-import struct
 from enum import IntEnum
+import numpy as np
 import pandas as pd
+from mapped_stats_files import map_trig_actions_file
 
 
 class TrigActions(IntEnum):
@@ -32,39 +33,14 @@ def read_trig_actions_file(filename: str) -> pd.DataFrame:
         Pandas dataframe with trigger actions per link
     """
 
-    with open(filename, 'rb') as file:
-        file_data = file.read()
+    trig_actions = map_trig_actions_file(filename)
 
-        num_triggers = struct.unpack('Q', file_data[0:8])[0]  # uint64_t
-        idx = 8
+    trig_actions_df = pd.DataFrame({'trig_id': np.arange(trig_actions.shape[0], dtype=np.int64)})
 
-        num_ctrl_links = int(file_data[idx])
-        idx += 1
-
-        df_headers = ['trig_id']
-
-        # Note: Only care about first link currently (as they are all the same..)
-        #for link_id in range(0, num_ctrl_links):
-            #link_str = 'link_' + str(link_id) + '_trig_action'
-            #df_headers.append(link_str)
-        df_headers.append('link_0_trig_action')
-
-        df_rows = []
-
-        for trig_id in range(0, num_triggers):
-            df_row = [trig_id]
-
-            for link_num in range(0, num_ctrl_links):
-                trig_action = file_data[idx]
-                idx += 1
-
-                # Note: Only care about first link currently (as they are all the same..)
-                if link_num == 0:
-                    df_row.append(trig_action)
-
-            df_rows.append(df_row)
-
-        trig_actions_df = pd.DataFrame(df_rows, columns=df_headers)
+    # Note: Only care about first link currently (as they are all the same..)
+    # There is no action column when the RU has no control links.
+    if trig_actions.shape[1] > 0:
+        trig_actions_df['link_0_trig_action'] = trig_actions[:, 0].astype(np.int64)
 
     return trig_actions_df
 
@@ -10,6 +10,8 @@
 #include "Alpide.hpp"
 #include "alpide_constants.hpp"
 #include "../misc/vcd_trace.hpp"
+#include "../common/Log.hpp"
+#include "../common/ProcessProfiler.hpp"
 #include <string>
 #include <sstream>
 
@@ -35,6 +37,11 @@ Alpide::Alpide(sc_core::sc_module_name name, const int global_chip_id, const int
   , s_chip_ready_out("chip_ready_out")
   , s_local_bus_data_in(outer_barrel_slave_count)
   , s_local_busy_in(outer_barrel_slave_count)
+  , s_region_fifo_empty(chip_cfg.compact_elaboration ? 0 : N_REGIONS)
+  , s_region_valid(chip_cfg.compact_elaboration ? 0 : N_REGIONS)
+  , s_region_data_read(chip_cfg.compact_elaboration ? 0 : N_REGIONS)
+  , s_region_data(chip_cfg.compact_elaboration ? 0 : N_REGIONS)
+  , s_frame_readout_done(chip_cfg.compact_elaboration ? 0 : N_REGIONS)
   , s_dmu_fifo(DMU_FIFO_SIZE)
   , s_dtu_delay_fifo(chip_cfg.dtu_delay_cycles+1)
   , s_dtu_delay_fifo_trig(chip_cfg.dtu_delay_cycles+1)
@@ -83,37 +90,51 @@ Alpide::Alpide(sc_core::sc_module_name name, const int global_chip_id, const int
 
   mDataWordCount = std::make_shared<std::map<AlpideDataType, uint64_t>>();
 
-  mTRU = new TopReadoutUnit("TRU", global_chip_id, local_chip_id, mDataWordCount);
-
-  // Allocate/create/name SystemC FIFOs for the regions and connect the
-  // Region Readout Units (RRU) FIFO outputs to Top Readout Unit (TRU) FIFO inputs
-  mRRUs.reserve(N_REGIONS);
-  for(int i = 0; i < N_REGIONS; i++) {
-    std::stringstream ss;
-    ss << "RRU_" << i;
-    mRRUs[i] = new RegionReadoutUnit(ss.str().c_str(),
-                                     this,
-                                     i,
-                                     REGION_FIFO_SIZE,
-                                     chip_cfg.matrix_readout_speed,
-                                     chip_cfg.data_long_en);
-
-    mRRUs[i]->s_system_clk_in(s_system_clk_in);
-    mRRUs[i]->s_frame_readout_start_in(s_frame_readout_start);
-    mRRUs[i]->s_readout_abort_in(s_readout_abort);
-    mRRUs[i]->s_region_event_start_in(s_region_event_start);
-    mRRUs[i]->s_region_event_pop_in(s_region_event_pop);
-    mRRUs[i]->s_region_data_read_in(s_region_data_read[i]);
-
-    mRRUs[i]->s_frame_readout_done_out(s_frame_readout_done[i]);
-    mRRUs[i]->s_region_fifo_empty_out(s_region_fifo_empty[i]);
-    mRRUs[i]->s_region_valid_out(s_region_valid[i]);
-    mRRUs[i]->s_region_data_out(s_region_data[i]);
-
-    mTRU->s_region_fifo_empty_in[i](s_region_fifo_empty[i]);
-    mTRU->s_region_valid_in[i](s_region_valid[i]);
-    mTRU->s_region_data_in[i](s_region_data[i]);
-    mTRU->s_region_data_read_out[i](s_region_data_read[i]);
+  if(chip_cfg.compact_elaboration) {
+    // All regions in one object, read directly by the TRU. No RRU modules or signals.
+    mRegionBank.reset(new RegionReadoutBank(this,
+                                            global_chip_id,
+                                            REGION_FIFO_SIZE,
+                                            chip_cfg.matrix_readout_speed,
+                                            chip_cfg.data_long_en));
+
+    mTRU = new TopReadoutUnit("TRU", global_chip_id, local_chip_id, mDataWordCount,
+                              mRegionBank.get());
+
+    s_frame_readout_done_regions = false;
+  } else {
+    mTRU = new TopReadoutUnit("TRU", global_chip_id, local_chip_id, mDataWordCount);
+
+    // Allocate/create/name SystemC FIFOs for the regions and connect the
+    // Region Readout Units (RRU) FIFO outputs to Top Readout Unit (TRU) FIFO inputs
+    mRRUs.resize(N_REGIONS);
+    for(int i = 0; i < N_REGIONS; i++) {
+      std::stringstream ss;
+      ss << "RRU_" << i;
+      mRRUs[i] = new RegionReadoutUnit(ss.str().c_str(),
+                                       this,
+                                       i,
+                                       REGION_FIFO_SIZE,
+                                       chip_cfg.matrix_readout_speed,
+                                       chip_cfg.data_long_en);
+
+      mRRUs[i]->s_system_clk_in(s_system_clk_in);
+      mRRUs[i]->s_frame_readout_start_in(s_frame_readout_start);
+      mRRUs[i]->s_readout_abort_in(s_readout_abort);
+      mRRUs[i]->s_region_event_start_in(s_region_event_start);
+      mRRUs[i]->s_region_event_pop_in(s_region_event_pop);
+      mRRUs[i]->s_region_data_read_in(s_region_data_read[i]);
+
+      mRRUs[i]->s_frame_readout_done_out(s_frame_readout_done[i]);
+      mRRUs[i]->s_region_fifo_empty_out(s_region_fifo_empty[i]);
+      mRRUs[i]->s_region_valid_out(s_region_valid[i]);
+      mRRUs[i]->s_region_data_out(s_region_data[i]);
+
+      mTRU->s_region_fifo_empty_in[i](s_region_fifo_empty[i]);
+      mTRU->s_region_valid_in[i](s_region_valid[i]);
+      mTRU->s_region_data_in[i](s_region_data[i]);
+      mTRU->s_region_data_read_out[i](s_region_data_read[i]);
+    }
   }
 
   mTRU->s_clk_in(s_system_clk_in);
@@ -156,6 +177,15 @@ Alpide::Alpide(sc_core::sc_module_name name, const int global_chip_id, const int
     dont_initialize();
   }
 
+  if(mRegionBank) {
+    SC_METHOD(regionReadoutMethod);
+    sensitive_pos << s_system_clk_in;
+
+    SC_METHOD(regionWakeMethod);
+    sensitive << s_frame_readout_start << s_readout_abort << s_region_event_start;
+    dont_initialize();
+  }
+
   // Test waht is giong on but whatt
 
   // SC_METHOD(strobeAndFramingMethod);
@@ -207,6 +237,8 @@ ControlResponsePayload Alpide::processCommand(ControlRequestPayload const &reque
 ///       There is not automatic trigger/strobe synthesizer implemented here.
 void Alpide::triggerMethod(void)
 {
+  PROFILE_PROCESS(ALPIDE_TRIGGER_AND_STROBE);
+
   uint64_t time_now = sc_time_stamp().value();
 
   mTriggersReceived++;
@@ -241,6 +273,8 @@ void Alpide::triggerMethod(void)
 
 void Alpide::strobeDurationMethod(void)
 {
+  PROFILE_PROCESS(ALPIDE_TRIGGER_AND_STROBE);
+
   if(s_strobe_n.read() == true) {
     // Strobe was inactive - start of strobing interval
     s_strobe_n = false;
@@ -261,6 +295,8 @@ void Alpide::strobeDurationMethod(void)
 ///       It will not be "dangerous" if it is not, but it will deviate from the real chip implementation.
 void Alpide::strobeInput(void)
 {
+  PROFILE_PROCESS(ALPIDE_STROBE_INPUT);
+
   int64_t time_now = sc_time_stamp().value();
 
   if(s_strobe_n.read() == false && mStrobeActive == false) {   // Strobe falling edge - start of frame/event, strobe is active low
@@ -377,8 +413,8 @@ void Alpide::strobeInput(void)
     // (ie go out of data overrun mode) when the frame fifo has been cleared.
     if(frame_start_fifo_empty && frame_end_fifo_empty) {
       if(s_readout_abort == true) {
-        std::cout << "@ " << time_now << " ns:\t" << "Alpide global chip ID: " << mGlobalChipId;
-        std::cout << " exited data overrun mode." << std::endl;
+        LOG(ALPIDE, INFO) << "@ " << time_now << " ns:\t" << "Alpide global chip ID: " << mGlobalChipId
+                          << " exited data overrun mode.";
       }
 
       s_frame_fifo_busy = false;
@@ -389,8 +425,8 @@ void Alpide::strobeInput(void)
       s_readout_abort = true;
 
       if(s_fatal_state == false) {
-        std::cout << "@ " << time_now << " ns:\t" << "Alpide global chip ID: " << mGlobalChipId;
-        std::cout << " entered fatal mode." << std::endl;
+        LOG(ALPIDE, INFO) << "@ " << time_now << " ns:\t" << "Alpide global chip ID: " << mGlobalChipId
+                          << " entered fatal mode.";
       }
 
       ///@todo The FATAL overflow bit/signal has to be cleared by a RORST/GRST command
@@ -401,8 +437,8 @@ void Alpide::strobeInput(void)
       ///@todo Need to clear RRU FIFOs, and MEBs when entering this state
 
       if(s_readout_abort == false) {
-        std::cout << "@ " << time_now << " ns:\t" << "Alpide global chip ID: " << mGlobalChipId;
-        std::cout << " entered data overrun mode." << std::endl;
+        LOG(ALPIDE, INFO) << "@ " << time_now << " ns:\t" << "Alpide global chip ID: " << mGlobalChipId
+                          << " entered data overrun mode.";
       }
 
       s_frame_fifo_busy = true;
@@ -424,6 +460,8 @@ void Alpide::strobeInput(void)
 ///       does the same job as the FROMU (Frame Read Out Management Unit) in the Alpide chip.
 void Alpide::frameReadout(void)
 {
+  PROFILE_PROCESS(ALPIDE_FRAME_READOUT);
+
   uint64_t time_now = sc_time_stamp().value();
   int MEBs_in_use = getNumEvents();
   int frame_start_fifo_size = s_frame_start_fifo.used();
@@ -523,6 +561,8 @@ void Alpide::frameReadout(void)
 ///       Should be called one time per clock cycle.
 void Alpide::dataTransmission(void)
 {
+  PROFILE_PROCESS(ALPIDE_DATA_TRANSMISSION);
+
   uint64_t time_now = sc_time_stamp().value();
 
   // Trace signals for fifo sizes
@@ -742,6 +782,9 @@ void Alpide::dataTransmission(void)
 ///@return True when frame_readout_done is set in all regions
 bool Alpide::getFrameReadoutDone(void)
 {
+  if(mRegionBank)
+    return s_frame_readout_done_regions;
+
   bool done = true;
 
   for(int i = 0; i < N_REGIONS; i++)
@@ -754,6 +797,8 @@ bool Alpide::getFrameReadoutDone(void)
 ///@brief Update internal busy status signals
 void Alpide::updateBusyStatus(void)
 {
+  PROFILE_PROCESS(ALPIDE_BUSY_STATUS);
+
   if(mChipContinuousMode) {
     if(getNumEvents() > 1) {
       s_multi_event_buffers_busy = true;
@@ -805,6 +850,8 @@ void Alpide::updateBusyStatus(void)
 
 void Alpide::busyFifoMethod(void)
 {
+  PROFILE_PROCESS(ALPIDE_TRIGGER_AND_STROBE);
+
   AlpideDataWord dw_busy;
 
   if(s_busy_status) {
@@ -829,6 +876,49 @@ void Alpide::busyFifoMethod(void)
 }
 
 
+///@brief Region readout for all regions in compact elaboration mode, does the
+///       same as the RRU modules' clocked processes. Like the RRUs, it stops being
+///       sensitive to the clock when all the regions are idle, and starts again on
+///       the first clock edge after one of the signals that wake them up change.
+void Alpide::regionReadoutMethod(void)
+{
+  PROFILE_PROCESS(REGION_READOUT_UNIT);
+
+  if(mRegionReadoutIdle) {
+    // Revert to static sensitivity (clocked), and wait till next clock cycle,
+    // like RegionReadoutUnit::regionUnitProcess()
+    next_trigger();
+    mRegionReadoutIdle = false;
+    return;
+  }
+
+  RegionReadoutBank::Inputs inputs = {s_frame_readout_start.read(),
+                                      s_readout_abort.read(),
+                                      s_region_event_start.read(),
+                                      s_region_event_pop.read()};
+
+  bool all_idle = mRegionBank->process(inputs, sc_time_stamp().value(), sc_delta_count());
+
+  s_frame_readout_done_regions = mRegionBank->getFrameReadoutDone();
+
+  if(all_idle) {
+    mRegionReadoutIdle = true;
+    next_trigger(s_readout_abort.value_changed_event() |
+                 s_frame_readout_start.value_changed_event() |
+                 s_region_event_start.value_changed_event());
+  }
+}
+
+
+///@brief Registers changes on the signals that wake up idle regions in compact
+///       elaboration mode, so that RegionReadoutBank::process() knows which regions
+///       have to be processed even though they were idle.
+void Alpide::regionWakeMethod(void)
+{
+  mRegionBank->wake(sc_delta_count());
+}
+
+
 ///@brief Add SystemC signals to log in VCD trace file.
 ///@param[in,out] wf Pointer to VCD trace file object
 ///@param[in] name_prefix Name prefix to be added to all the trace names
@@ -876,7 +966,8 @@ void Alpide::addTraces(sc_trace_file *wf, std::string name_prefix) const
 
   mTRU->addTraces(wf, alpide_name_prefix);
 
-  for(int i = 0; i < N_REGIONS; i++)
-    mRRUs[i]->addTraces(wf, alpide_name_prefix);
+  // Region internals can not be traced in compact elaboration mode (no RRUs)
+  for(auto rru : mRRUs)
+    rru->addTraces(wf, alpide_name_prefix);
 
 }
@@ -17,6 +17,7 @@
 #include "PixelMatrix.hpp"
 #include "PixelFrontEnd.hpp"
 #include "RegionReadoutUnit.hpp"
+#include "RegionReadoutBank.hpp"
 #include "TopReadoutUnit.hpp"
 
 // Ignore warnings about use of auto_ptr and unused parameters in SystemC library
@@ -28,6 +29,7 @@
 
 #include <vector>
 #include <list>
+#include <memory>
 #include <string>
 
 
@@ -87,17 +89,22 @@ private:
   ///@brief Number of hits in oldest multi event buffer
   sc_signal<sc_uint<32> > s_oldest_event_number_of_hits;
 
-  sc_signal<bool> s_region_fifo_empty[N_REGIONS];
-  sc_signal<bool> s_region_valid[N_REGIONS];
+  ///@brief Signals between RRUs and TRU, one per region.
+  ///       Empty in compact elaboration mode, where there are no RRU modules.
+  std::vector<sc_signal<bool>> s_region_fifo_empty;
+  std::vector<sc_signal<bool>> s_region_valid;
 
-  sc_signal<bool> s_region_data_read[N_REGIONS];
+  std::vector<sc_signal<bool>> s_region_data_read;
   sc_signal<bool> s_region_event_start;
   sc_signal<bool> s_region_event_pop;
-  sc_signal<AlpideDataWord> s_region_data[N_REGIONS];
+  std::vector<sc_signal<AlpideDataWord>> s_region_data;
 
   ///@brief Frame Readout Managment Unit (FROMU) signals
   sc_signal<bool> s_frame_readout_start;
-  sc_signal<bool> s_frame_readout_done[N_REGIONS];
+  std::vector<sc_signal<bool>> s_frame_readout_done;
+
+  ///@brief AND of all regions' frame_readout_done, used in compact elaboration mode
+  sc_signal<bool> s_frame_readout_done_regions;
   sc_signal<bool> s_frame_readout_done_all;
   sc_signal<bool> s_frame_fifo_busy;
   sc_signal<bool> s_multi_event_buffers_busy;
@@ -143,6 +150,13 @@ private:
   std::vector<RegionReadoutUnit*> mRRUs;
   TopReadoutUnit* mTRU;
 
+  ///@brief Used instead of the RRUs in compact elaboration mode, null otherwise
+  std::unique_ptr<RegionReadoutBank> mRegionBank;
+
+  ///@brief All regions in mRegionBank were idle on the last clock cycle
+  ///       (used to disable sensitivity to clock to save simulation time)
+  bool mRegionReadoutIdle = false;
+
   FrameEndFifoWord mNextFrameEndWord;
 
   enum FROMU_readout_state_t {
@@ -238,6 +252,8 @@ private:
   void triggerMethod(void);
   void strobeDurationMethod(void);
   void busyFifoMethod(void);
+  void regionReadoutMethod(void);
+  void regionWakeMethod(void);
 
   void strobeInput(void);
   void frameReadout(void); // FROMU
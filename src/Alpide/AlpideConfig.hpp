@@ -34,6 +34,10 @@ struct AlpideConfig {
 
   ///@brief True for fast readout (2 clock cycles), false is slow (4 cycles).
   bool matrix_readout_speed;
+
+  ///@brief Compact elaboration: the regions are simulated by one RegionReadoutBank
+  ///       object per chip, instead of RegionReadoutUnit modules and signals.
+  bool compact_elaboration = false;
 };
 
 
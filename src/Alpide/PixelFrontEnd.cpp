@@ -24,6 +24,25 @@ void PixelFrontEnd::pixelFrontEndInput(const std::shared_ptr<PixelHit>& p)
 }
 
 
+///@brief Input a range of pixels for this chip to the pixel front end.
+///       Pixels are added to the end of the "pixel queue", in the same order.
+///@param begin Iterator to first pixel hit
+///@param end Iterator past the last pixel hit
+void PixelFrontEnd::pixelFrontEndInput(HitIterator begin, HitIterator end)
+{
+  mHitQueue.insert(mHitQueue.end(), begin, end);
+
+#ifdef PIXEL_DEBUG
+  std::uint64_t time_now = sc_time_stamp().value();
+
+  for(HitIterator it = begin; it != end; it++) {
+    (*it)->mPixInput = true;
+    (*it)->mPixInputTime = time_now;
+  }
+#endif
+}
+
+
 ///@brief Remove old hits.
 ///       Start at the front of the hit queue, and pop (remove)
 ///       hits from the front while the hits are no longer active at current simulation time,
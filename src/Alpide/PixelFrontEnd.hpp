@@ -22,9 +22,18 @@ protected:
                            uint64_t event_id) const;
 
 public:
+  typedef std::vector<std::shared_ptr<PixelHit>>::const_iterator HitIterator;
+
   PixelFrontEnd() {}
   void pixelFrontEndInput(const std::shared_ptr<PixelHit>& p);
+  void pixelFrontEndInput(HitIterator begin, HitIterator end);
   void removeInactiveHits(uint64_t time_now);
+
+  ///@brief Get an estimate of the memory used by the hit queue in bytes,
+  ///       not including the PixelHit objects
+  uint64_t getHitQueueMemoryUsage(void) const {
+    return mHitQueue.size() * sizeof(std::shared_ptr<PixelHit>);
+  }
 };
 
 
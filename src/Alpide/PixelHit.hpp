@@ -18,6 +18,7 @@
 #endif
 
 #include "PixelReadoutStats.hpp"
+#include <atomic>
 #include <cstdint>
 #include <algorithm>
 #include <memory>
@@ -38,6 +39,18 @@ class PixelHit
   friend class PixelPriorityEncoder;
 
 private:
+  ///@brief Updates the live PixelHit count when the PixelHit it belongs to is created
+  ///       and destroyed. Remembers if it was counted, so that hits created before
+  ///       counting was enabled are not subtracted. Not changed by assignment.
+  class LiveCounter {
+    bool mCounted;
+  public:
+    LiveCounter(void);
+    LiveCounter(const LiveCounter&) : LiveCounter() {}
+    LiveCounter& operator=(const LiveCounter&) { return *this; }
+    ~LiveCounter();
+  };
+
   int mCol;
   int mRow;
   unsigned int mChipId;
@@ -45,6 +58,7 @@ private:
   uint64_t mActiveTimeStartNs = 0;
   uint64_t mActiveTimeEndNs = 0;
   unsigned int mReadoutCount = 0;
+  LiveCounter mLiveCounter;
   std::shared_ptr<PixelReadoutStats> mPixelReadoutStats;
   std::vector<std::shared_ptr<PixelHit>> mDuplicatePixels;
 
@@ -98,6 +112,20 @@ public:
   bool isActive(uint64_t strobe_start_time_ns, uint64_t strobe_end_time_ns) const;
 
   void addDuplicatePixel(const std::shared_ptr<PixelHit>& pixel);
+
+  ///@brief Number of PixelHit objects that currently exist, used for memory accounting.
+  ///       Only hits created after liveCountEnabled() was set are counted.
+  static std::atomic<uint64_t>& liveCount(void) {
+    static std::atomic<uint64_t> count(0);
+    return count;
+  }
+
+  ///@brief Enables counting of live PixelHit objects. Set by MemoryAccountant when
+  ///       the memory profile is enabled, so that other runs skip the atomic update.
+  static std::atomic<bool>& liveCountEnabled(void) {
+    static std::atomic<bool> enabled(false);
+    return enabled;
+  }
 };
 
 const PixelHit NoPixelHit(-1,-1);
@@ -148,6 +176,21 @@ inline PixelHit::PixelHit(const PixelHit& p)
 }
 
 
+inline PixelHit::LiveCounter::LiveCounter(void)
+  : mCounted(liveCountEnabled().load(std::memory_order_relaxed))
+{
+  if(mCounted)
+    liveCount().fetch_add(1, std::memory_order_relaxed);
+}
+
+
+inline PixelHit::LiveCounter::~LiveCounter()
+{
+  if(mCounted)
+    liveCount().fetch_sub(1, std::memory_order_relaxed);
+}
+
+
 inline PixelHit::~PixelHit()
 {
   if(mPixelReadoutStats) {
@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include "PixelMatrix.hpp"
+#include "../common/MemoryUsage.hpp"
 
 
 ///@brief Indicate to the Alpide that we are starting on a new event. If the call is
@@ -307,3 +308,23 @@ int PixelMatrix::getHitTotalAllEvents(void)
 
   return hit_sum;
 }
+
+
+///@brief Get an estimate of the heap memory used by the multi event buffers, ie. the
+///       double columns of all events in the MEBs and the pixel hits stored in them.
+///       The PixelHit objects themselves are not included, they are shared with the
+///       front end and accounted for separately.
+///@return Memory usage in bytes
+std::uint64_t PixelMatrix::getMEBMemoryUsage(void) const
+{
+  std::uint64_t num_events = mColumnBuffs.size();
+  std::uint64_t num_hits = 0;
+
+  for(auto it = mColumnBuffsPixelsLeft.begin(); it != mColumnBuffsPixelsLeft.end(); it++)
+    num_hits += *it;
+
+  return num_events * (N_PIXEL_COLS/2) * sizeof(PixelDoubleColumn)
+    + num_events * list_node_bytes<int>()
+    + num_hits * tree_node_bytes<std::shared_ptr<PixelHit>>()
+    + mMEBHistogram.size() * tree_node_bytes<std::pair<unsigned int, std::uint64_t>>();
+}
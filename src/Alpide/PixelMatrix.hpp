@@ -80,6 +80,7 @@ public:
   }
   std::uint64_t getLatchedPixelHitCount(void) const {return mLatchedPixelHitCount;}
   std::uint64_t getDuplicatePixelHitCount(void) const {return mDuplicatePixelHitCount;}
+  std::uint64_t getMEBMemoryUsage(void) const;
 };
 
 
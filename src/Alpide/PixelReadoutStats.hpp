@@ -34,12 +34,31 @@ private:
   /// The sum of values for mReadoutStats[1..N] equals the total number of hits that were read out
   std::map<unsigned int, std::map<unsigned int, std::uint64_t>> mReadoutStats;
 
+  /// Total number of pixel hits, for all chips
+  std::uint64_t mHitCountTotal = 0;
+
+  /// Total number of pixel hits that were read out at least once, for all chips
+  std::uint64_t mReadOutCountTotal = 0;
+
 public:
   ///@brief Add readout count for a pixel hits.
   ///@param[in] count The number of times a particular pixel hit was read out
   ///@param[in] chip_id The chip that this pixel belonged to
   inline void addReadoutCount(unsigned int count, unsigned int chip_id) {
     mReadoutStats[chip_id][count]++;
+    mHitCountTotal++;
+    if(count != 0)
+      mReadOutCountTotal++;
+  }
+
+  ///@brief Get the total number of pixel hits registered so far, for all chips
+  inline std::uint64_t getHitCountTotal(void) const {
+    return mHitCountTotal;
+  }
+
+  ///@brief Get the total number of pixel hits that were read out so far, for all chips
+  inline std::uint64_t getReadOutCountTotal(void) const {
+    return mReadOutCountTotal;
   }
 
   ///@brief Get the number of pixel hits that were not read out
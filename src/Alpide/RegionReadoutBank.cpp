@@ -0,0 +1,498 @@
+/**
+ * @file   RegionReadoutBank.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Region readout for all the regions of an Alpide chip in one object, used
+ *         instead of the RegionReadoutUnit modules in compact elaboration mode.
+ */
+
+#include "RegionReadoutBank.hpp"
+#include "RegionReadoutUnit.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+
+///@brief Region header words for all regions, shared by all chips
+static const std::vector<AlpideDataWord>& getRegionHeaders(void)
+{
+  static std::vector<AlpideDataWord> headers;
+
+  if(headers.empty()) {
+    for(int i = 0; i < N_REGIONS; i++)
+      headers.push_back(AlpideRegionHeader(i));
+  }
+
+  return headers;
+}
+
+
+///@brief Constructor for RegionReadoutBank
+///@param[in] matrix Pointer to pixel matrix
+///@param[in] global_chip_id Global chip ID, used in error messages
+///@param[in] fifo_size Size limit on the region FIFOs
+///@param[in] matrix_readout_speed True for fast readout (2 clock cycles), false is slow (4 cycles).
+///@param[in] cluster_enable Enable/disable clustering and use of DATA LONG data words
+RegionReadoutBank::RegionReadoutBank(PixelMatrix* matrix, int global_chip_id,
+                                     unsigned int fifo_size, bool matrix_readout_speed,
+                                     bool cluster_enable)
+  : mPixelMatrix(matrix)
+  , mGlobalChipId(global_chip_id)
+  , mMatrixReadoutSpeed(matrix_readout_speed)
+  , mClusteringEnabled(cluster_enable)
+  , mRegionDataOut(N_REGIONS, AlpideIdle())
+  , mRegionFifo(N_REGIONS, ClockedFifo<AlpideDataWord>(fifo_size))
+{
+  // Make sure the shared header words are created before the simulation starts
+  getRegionHeaders();
+
+  for(int i = 0; i < N_REGIONS; i++) {
+    mReadoutState[i] = RO_FSM::IDLE;
+    mValidState[i] = VALID_FSM::IDLE;
+    mHeaderState[i] = HEADER_FSM::HEADER;
+    mMatrixReadoutDelayCounter[i] = 0;
+    mGenerateRegionHeader[i] = false;
+    mClusterStartedDelayed[i] = false;
+
+    mFrameReadoutDone[i] = false;
+    mRegionFifoEmpty[i] = false;
+    mRegionValid[i] = false;
+    mRegionDataOutIsHeader[i] = false;
+    mRegionDataRead[i] = false;
+
+    mClusterStarted[i] = false;
+    mPixelHitBaseAddr[i] = 0;
+    mPixelHitEncoderId[i] = 0;
+    mPixelHitmap[i] = 0;
+    mRegionDataOutIsTrailer[i] = false;
+
+    mIdle[i] = false;
+    mIdleDeltaCount[i] = 0;
+  }
+}
+
+
+///@brief Clock all regions that are not idle. Should be called once per clock cycle,
+///       on the rising edge of the system clock (40MHz).
+///@param[in] in Signals from the FROMU and TRU
+///@param[in] time_now Simulation time (ns)
+///@param[in] delta_count Delta cycle count (sc_delta_count())
+///@return True if all regions are idle, and will stay idle until wake() is called
+bool RegionReadoutBank::process(const Inputs& in, uint64_t time_now, uint64_t delta_count)
+{
+  // A region that went idle is woken by the first change of the signals after it
+  // went idle, and is clocked again in the clock cycle after the change. Changes in
+  // this delta cycle are not seen until the next clock cycle.
+  uint64_t wake_delta_count = mLastWakeDeltaCount < delta_count ? mLastWakeDeltaCount
+                                                                 : mPrevWakeDeltaCount;
+  bool all_idle = true;
+
+  for(unsigned int region = 0; region < N_REGIONS; region++) {
+    if(mIdle[region] && wake_delta_count <= mIdleDeltaCount[region])
+      continue;
+
+    mIdle[region] = processRegion(region, in, time_now);
+
+    if(mIdle[region])
+      mIdleDeltaCount[region] = delta_count;
+    else
+      all_idle = false;
+  }
+
+  return all_idle;
+}
+
+
+///@brief Register a change of the signals that bring regions out of idle
+///       (readout abort, frame readout start and region event start)
+///@param[in] delta_count Delta cycle count (sc_delta_count()) when the signals changed
+void RegionReadoutBank::wake(uint64_t delta_count)
+{
+  if(delta_count != mLastWakeDeltaCount) {
+    mPrevWakeDeltaCount = mLastWakeDeltaCount;
+    mLastWakeDeltaCount = delta_count;
+  }
+}
+
+
+///@brief Get logical AND of all regions' frame readout done outputs.
+///@return True when frame readout is done in all regions
+bool RegionReadoutBank::getFrameReadoutDone(void) const
+{
+  for(int i = 0; i < N_REGIONS; i++) {
+    if(!mFrameReadoutDone[i])
+      return false;
+  }
+
+  return true;
+}
+
+
+///@brief Get data output of a region: the region header, or the next word in the
+///       region FIFO.
+const AlpideDataWord& RegionReadoutBank::getRegionData(unsigned int region) const
+{
+  if(mRegionDataOutIsHeader[region])
+    return getRegionHeaders()[region];
+  else
+    return mRegionDataOut[region];
+}
+
+
+///@brief Clock one region. See RegionReadoutUnit::regionUnitProcess().
+///@return True if the region is idle
+bool RegionReadoutBank::processRegion(unsigned int region, const Inputs& in, uint64_t time_now)
+{
+  // Registers that are read by the valid FSM after the readout FSM has updated them
+  std::uint8_t readout_state = mReadoutState[region];
+  bool cluster_started = mClusterStartedDelayed[region];
+
+  updateRegionDataOut(region, in, time_now);
+
+  mRegionFifoEmpty[region] = (mRegionFifo[region].used() == 0);
+
+  bool idle = regionMatrixReadoutFSM(region, in, time_now);
+  idle &= regionValidFSM(region, in, readout_state, cluster_started);
+  regionHeaderFSM(region, in);
+
+  mRegionFifo[region].update();
+
+  return idle;
+}
+
+
+///@brief Update data output with region header or region data, and read out data and
+///       pop region trailer when requested. See RegionReadoutUnit::updateRegionDataOut().
+void RegionReadoutBank::updateRegionDataOut(unsigned int region, const Inputs& in,
+                                            uint64_t time_now)
+{
+  bool read_dataword = (mRegionDataRead[region] && mRegionValid[region]);
+  bool pop_trailer = in.region_event_pop && !in.readout_abort;
+
+  if((read_dataword && !mGenerateRegionHeader[region]) || pop_trailer) {
+    AlpideDataWord data;
+
+    if(mRegionFifo[region].get(data)) {
+      if(!pop_trailer && data.data[0] == DW_REGION_TRAILER) {
+        std::cerr << "@" << time_now << " ns: ";
+        std::cerr << "Global chip ID " << mGlobalChipId;
+        std::cerr << ", region " << region;
+        std::cerr << ": Oops read out REGION_TRAILER" << std::endl;
+      } else if(pop_trailer && data.data[0] != DW_REGION_TRAILER) {
+        std::cerr << "@" << time_now << " ns: ";
+        std::cerr << "Global chip ID " << mGlobalChipId;
+        std::cerr << ", region " << region;
+        std::cerr << ": Oops popped something else than REGION_TRAILER" << std::endl;
+      }
+    }
+  }
+
+  // Check if next data word is REGION TRAILER
+  if(mRegionFifo[region].peek(mRegionDataOut[region]))
+    mRegionDataOutIsTrailer[region] = (mRegionDataOut[region].data[0] == DW_REGION_TRAILER);
+  else
+    mRegionDataOutIsTrailer[region] = false;
+
+  mRegionDataOutIsHeader[region] = mGenerateRegionHeader[region] && !read_dataword;
+}
+
+
+///@brief State machine that controls readout from the multi event buffers into the
+///       region FIFO. See RegionReadoutUnit::regionMatrixReadoutFSM().
+///@return Idle state. True if FSM is in idle and will be idle the next state.
+bool RegionReadoutBank::regionMatrixReadoutFSM(unsigned int region, const Inputs& in,
+                                               uint64_t time_now)
+{
+  bool matrix_readout_ready = false;
+  bool idle_state = false;
+  std::uint8_t delay_counter = mMatrixReadoutDelayCounter[region];
+  std::uint8_t current_state = mReadoutState[region];
+  std::uint8_t next_state = current_state;
+
+  if(mMatrixReadoutSpeed && delay_counter > 0)
+    matrix_readout_ready = true;
+  else if(!mMatrixReadoutSpeed && delay_counter >= 2)
+    matrix_readout_ready = true;
+
+  switch(current_state) {
+  case RO_FSM::IDLE:
+    if(in.readout_abort) {
+      flushRegionFifo(region);
+      next_state = RO_FSM::IDLE;
+      idle_state = true;
+    }
+    else if(in.frame_readout_start) {
+      if(!mPixelMatrix->regionEmpty(region)) {
+        mMatrixReadoutDelayCounter[region] = 0;
+        next_state = RO_FSM::START_READOUT;
+      } else {
+        next_state = RO_FSM::REGION_TRAILER;
+      }
+    }
+    else {
+      next_state = RO_FSM::IDLE;
+      idle_state = true;
+    }
+    mFrameReadoutDone[region] = !in.frame_readout_start;
+    break;
+
+  case RO_FSM::START_READOUT:
+    if(in.readout_abort)
+      next_state = RO_FSM::IDLE;
+    else if(matrix_readout_ready)
+      next_state = RO_FSM::READOUT_AND_CLUSTERING;
+    else
+      mMatrixReadoutDelayCounter[region] = delay_counter + 1;
+
+    mFrameReadoutDone[region] = false;
+    break;
+
+  case RO_FSM::READOUT_AND_CLUSTERING:
+    if(in.readout_abort) {
+      mClusterStarted[region] = false;
+      mPixelClusterVec[region].clear();
+
+      next_state = RO_FSM::IDLE;
+    } else if(matrix_readout_ready) {
+      if(mRegionFifo[region].canPut()) {
+        bool region_matrix_empty = readoutNextPixel(region, time_now);
+        mMatrixReadoutDelayCounter[region] = 0;
+        if(region_matrix_empty) {
+          next_state = RO_FSM::REGION_TRAILER;
+        }
+      }
+    } else {
+      mMatrixReadoutDelayCounter[region] = delay_counter + 1;
+    }
+    mFrameReadoutDone[region] = false;
+    break;
+
+  case RO_FSM::REGION_TRAILER:
+    if(in.readout_abort)
+      next_state = RO_FSM::IDLE;
+    else if(mRegionFifo[region].canPut()) {
+      if(mRegionFifo[region].put(AlpideRegionTrailer()) == false) {
+        std::cerr << "@" << time_now << " ns: ";
+        std::cerr << "Global chip ID " << mGlobalChipId;
+        std::cerr << ", region " << region;
+        std::cerr << ": Oops writing REGION_TRAILER to fifo failed" << std::endl;
+      }
+
+      next_state = RO_FSM::IDLE;
+    }
+    mFrameReadoutDone[region] = false;
+    break;
+  }
+
+  mReadoutState[region] = next_state;
+
+  return idle_state;
+}
+
+
+///@brief State machine that determines if the region is valid (has data this frame).
+///       See RegionReadoutUnit::regionValidFSM().
+///@param[in] readout_state State of readout FSM at the start of the clock cycle
+///@param[in] cluster_started Delayed cluster started flag at the start of the clock cycle
+///@return Idle state. True if FSM is in idle and will be idle the next state.
+bool RegionReadoutBank::regionValidFSM(unsigned int region, const Inputs& in,
+                                       std::uint8_t readout_state, bool cluster_started)
+{
+  bool region_fifo_empty = mRegionFifo[region].used() == 0;
+  bool data_out_is_trailer = mRegionDataOutIsTrailer[region];
+  bool idle_state = false;
+  std::uint8_t current_state = mValidState[region];
+  std::uint8_t next_state = current_state;
+
+  switch(current_state) {
+  case VALID_FSM::IDLE:
+    if(in.region_event_start && !in.readout_abort)
+      next_state = VALID_FSM::EMPTY;
+    else
+      idle_state = true;
+
+    mRegionValid[region] = false;
+    break;
+
+  case VALID_FSM::EMPTY:
+    if(in.readout_abort)
+      next_state = VALID_FSM::IDLE;
+    else if(!region_fifo_empty && data_out_is_trailer)
+      next_state = VALID_FSM::POP;
+    else if(!region_fifo_empty && !data_out_is_trailer)
+      next_state = VALID_FSM::VALID;
+
+    mRegionValid[region] = ((!region_fifo_empty ||
+                             cluster_started ||
+                             readout_state == RO_FSM::READOUT_AND_CLUSTERING ||
+                             readout_state == RO_FSM::START_READOUT) &&
+                            !data_out_is_trailer);
+    break;
+
+  case VALID_FSM::VALID:
+    if(in.readout_abort)
+      next_state = VALID_FSM::IDLE;
+    else if(data_out_is_trailer)
+      next_state = VALID_FSM::POP;
+
+    mRegionValid[region] = !data_out_is_trailer;
+    break;
+
+  case VALID_FSM::POP:
+    if(in.region_event_pop || in.readout_abort)
+      next_state = VALID_FSM::IDLE;
+
+    mRegionValid[region] = false;
+    break;
+
+  default:
+    next_state = VALID_FSM::IDLE;
+    break;
+  }
+
+  mValidState[region] = next_state;
+
+  return idle_state;
+}
+
+
+///@brief State machine that determines when the region header should be outputted.
+///       See RegionReadoutUnit::regionHeaderFSM() and regionHeaderFSMOutput().
+void RegionReadoutBank::regionHeaderFSM(unsigned int region, const Inputs& in)
+{
+  std::uint8_t current_state = mHeaderState[region];
+  std::uint8_t next_state = current_state;
+
+  switch(current_state) {
+  case HEADER_FSM::HEADER:
+    if(!in.readout_abort && mRegionDataRead[region])
+      next_state = HEADER_FSM::DATA;
+    break;
+
+  case HEADER_FSM::DATA:
+    if(in.readout_abort || in.region_event_pop)
+      next_state = HEADER_FSM::HEADER;
+    break;
+
+  default:
+    next_state = HEADER_FSM::HEADER;
+    break;
+  }
+
+  mHeaderState[region] = next_state;
+
+  // The header output follows the state with a delay, and is seen in the next cycle
+  mGenerateRegionHeader[region] = (next_state != HEADER_FSM::DATA);
+}
+
+
+///@brief Read out the next pixel from the region's priority encoder, and put DATA SHORT
+///       or DATA LONG words in the region FIFO. See RegionReadoutUnit::readoutNextPixel().
+///@return True if matrix is empty and no pixel was read out
+bool RegionReadoutBank::readoutNextPixel(unsigned int region, uint64_t time_now)
+{
+  bool region_matrix_empty = false;
+  ClockedFifo<AlpideDataWord>& fifo = mRegionFifo[region];
+  std::vector<std::shared_ptr<PixelHit>>& cluster_vec = mPixelClusterVec[region];
+
+  std::shared_ptr<PixelHit> p = mPixelMatrix->readPixelRegion(region, time_now);
+
+#ifdef EXCEPTION_CHECKS
+  if(*p == NoPixelHit && mPixelMatrix->regionEmpty(region) == false)
+    throw std::runtime_error(std::string("Region: ") +
+                             std::to_string(region) +
+                             std::string("Got NoPixelHit but region not empty."));
+#endif
+
+#ifdef PIXEL_DEBUG
+  if(*p != NoPixelHit) {
+    p->mRRU = true;
+    p->mRRUTime = time_now;
+  }
+#endif
+
+  if(mClusteringEnabled) {
+    if(mClusterStarted[region] == false) {
+      if(*p == NoPixelHit)
+        region_matrix_empty = true;
+      else {
+        mClusterStarted[region] = true;
+        mPixelHitEncoderId[region] = p->getPriEncNumInRegion();
+        mPixelHitBaseAddr[region] = p->getPriEncPixelAddress();
+        mPixelHitmap[region] = 0;
+        cluster_vec.clear();
+        cluster_vec.push_back(p);
+        region_matrix_empty = false;
+      }
+    } else { // Cluster already started
+      if(*p == NoPixelHit) {
+        if(mPixelHitmap[region] == 0)
+          fifo.put(AlpideDataShort(mPixelHitEncoderId[region], mPixelHitBaseAddr[region],
+                                   cluster_vec[0]));
+        else
+          fifo.put(AlpideDataLong(mPixelHitEncoderId[region], mPixelHitBaseAddr[region],
+                                  mPixelHitmap[region], cluster_vec));
+
+        cluster_vec.clear();
+        mClusterStarted[region] = false;
+        region_matrix_empty = true;
+      }
+      // Is this pixel within the current cluster?
+      else if(p->getPriEncNumInRegion() == mPixelHitEncoderId[region] &&
+              p->getPriEncPixelAddress() <= (mPixelHitBaseAddr[region]+DATA_LONG_PIXMAP_SIZE)) {
+        unsigned int hitmap_pixel_num = (p->getPriEncPixelAddress() - mPixelHitBaseAddr[region]) - 1;
+        mPixelHitmap[region] |= 1 << hitmap_pixel_num;
+
+        cluster_vec.push_back(p);
+
+        // Transmit cluster if this was the last pixel in cluster
+        if(hitmap_pixel_num == DATA_LONG_PIXMAP_SIZE-1) {
+          fifo.put(AlpideDataLong(mPixelHitEncoderId[region], mPixelHitBaseAddr[region],
+                                  mPixelHitmap[region], cluster_vec));
+
+          cluster_vec.clear();
+          mClusterStarted[region] = false;
+        }
+        region_matrix_empty = false;
+      } else { // New pixel not in same cluster as previous pixels
+        if(mPixelHitmap[region] == 0)
+          fifo.put(AlpideDataShort(mPixelHitEncoderId[region], mPixelHitBaseAddr[region],
+                                   cluster_vec[0]));
+        else
+          fifo.put(AlpideDataLong(mPixelHitEncoderId[region], mPixelHitBaseAddr[region],
+                                  mPixelHitmap[region], cluster_vec));
+
+        cluster_vec.clear();
+        cluster_vec.push_back(p);
+        mClusterStarted[region] = true;
+        mPixelHitEncoderId[region] = p->getPriEncNumInRegion();
+        mPixelHitBaseAddr[region] = p->getPriEncPixelAddress();
+        mPixelHitmap[region] = 0;
+        region_matrix_empty = false;
+      }
+    }
+  } else { // Clustering not enabled
+    if(*p == NoPixelHit) {
+      region_matrix_empty = true;
+    } else {
+      unsigned int encoder_id = p->getPriEncNumInRegion();
+      unsigned int base_addr = p->getPriEncPixelAddress();
+      fifo.put(AlpideDataShort(encoder_id, base_addr, p));
+      region_matrix_empty = false;
+    }
+  }
+
+  // Delayed version of cluster started, needed by valid FSM.
+  mClusterStartedDelayed[region] = mClusterStarted[region];
+
+  return region_matrix_empty;
+}
+
+
+///@brief Flush the region fifo. Used in data overrun mode.
+void RegionReadoutBank::flushRegionFifo(unsigned int region)
+{
+  AlpideDataWord data;
+
+  while(mRegionFifo[region].get(data)) {}
+}
@@ -0,0 +1,116 @@
+/**
+ * @file   RegionReadoutBank.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Region readout for all the regions of an Alpide chip in one object, used
+ *         instead of the RegionReadoutUnit modules in compact elaboration mode.
+ *
+ *         The state of the regions is kept in arrays indexed by region id, and the
+ *         region FIFOs are ring buffers that only grow to the number of words they
+ *         actually hold. There are no SystemC modules, processes or signals per
+ *         region, the Alpide calls process() from one clocked process for all the
+ *         regions, and the TRU reads the region outputs directly from this object.
+ *
+ *         The state machines are the same as in RegionReadoutUnit, and the timing is
+ *         the same: outputs and registers written in a clock cycle are seen by the
+ *         regions and the TRU in the next cycle. Changes to the state machines in
+ *         RegionReadoutUnit must be made here as well.
+ */
+
+
+///@addtogroup region_readout
+///@{
+#ifndef REGION_READOUT_BANK_HPP
+#define REGION_READOUT_BANK_HPP
+
+#include "AlpideDataWord.hpp"
+#include "PixelMatrix.hpp"
+#include "alpide_constants.hpp"
+#include "../common/ClockedFifo.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+class RegionReadoutBank
+{
+public:
+  ///@brief Signals from the FROMU and TRU that are common to all regions
+  struct Inputs {
+    bool frame_readout_start;
+    bool readout_abort;
+    bool region_event_start;
+    bool region_event_pop;
+  };
+
+private:
+  PixelMatrix* mPixelMatrix;
+  int mGlobalChipId;
+
+  ///@brief True for fast readout (2 clock cycles), false is slow (4 cycles).
+  bool mMatrixReadoutSpeed;
+
+  ///@brief Enable clustering and use of DATA LONG words
+  bool mClusteringEnabled;
+
+  ///@brief Registers, corresponding to the internal signals in RegionReadoutUnit
+  std::uint8_t mReadoutState[N_REGIONS];
+  std::uint8_t mValidState[N_REGIONS];
+  std::uint8_t mHeaderState[N_REGIONS];
+  std::uint8_t mMatrixReadoutDelayCounter[N_REGIONS];
+  bool mGenerateRegionHeader[N_REGIONS];
+  bool mClusterStartedDelayed[N_REGIONS];
+
+  ///@brief Region outputs
+  bool mFrameReadoutDone[N_REGIONS];
+  bool mRegionFifoEmpty[N_REGIONS];
+  bool mRegionValid[N_REGIONS];
+  bool mRegionDataOutIsHeader[N_REGIONS];
+
+  ///@brief Region data read inputs, written by the TRU
+  bool mRegionDataRead[N_REGIONS];
+
+  ///@brief Clustering state, see RegionReadoutUnit::readoutNextPixel()
+  bool mClusterStarted[N_REGIONS];
+  std::uint16_t mPixelHitBaseAddr[N_REGIONS];
+  std::uint8_t mPixelHitEncoderId[N_REGIONS];
+  std::uint8_t mPixelHitmap[N_REGIONS];
+  std::vector<std::shared_ptr<PixelHit>> mPixelClusterVec[N_REGIONS];
+
+  bool mRegionDataOutIsTrailer[N_REGIONS];
+  std::vector<AlpideDataWord> mRegionDataOut;
+  std::vector<ClockedFifo<AlpideDataWord>> mRegionFifo;
+
+  ///@brief Idle regions are skipped until one of the signals that would bring them
+  ///       out of idle changes, like the RegionReadoutUnit with dynamic sensitivity.
+  ///       The changes are registered with wake(), with the delta cycle count.
+  bool mIdle[N_REGIONS];
+  std::uint64_t mIdleDeltaCount[N_REGIONS];
+  std::uint64_t mLastWakeDeltaCount = 0;
+  std::uint64_t mPrevWakeDeltaCount = 0;
+
+  bool processRegion(unsigned int region, const Inputs& in, uint64_t time_now);
+  void updateRegionDataOut(unsigned int region, const Inputs& in, uint64_t time_now);
+  bool regionMatrixReadoutFSM(unsigned int region, const Inputs& in, uint64_t time_now);
+  bool regionValidFSM(unsigned int region, const Inputs& in,
+                      std::uint8_t readout_state, bool cluster_started);
+  void regionHeaderFSM(unsigned int region, const Inputs& in);
+  bool readoutNextPixel(unsigned int region, uint64_t time_now);
+  void flushRegionFifo(unsigned int region);
+
+public:
+  RegionReadoutBank(PixelMatrix* matrix, int global_chip_id, unsigned int fifo_size,
+                    bool matrix_readout_speed, bool cluster_enable);
+  bool process(const Inputs& in, uint64_t time_now, uint64_t delta_count);
+  void wake(uint64_t delta_count);
+  bool getFrameReadoutDone(void) const;
+
+  bool getRegionValid(unsigned int region) const {return mRegionValid[region];}
+  bool getRegionFifoEmpty(unsigned int region) const {return mRegionFifoEmpty[region];}
+  const AlpideDataWord& getRegionData(unsigned int region) const;
+  void setRegionDataRead(unsigned int region, bool value) {mRegionDataRead[region] = value;}
+};
+
+
+#endif
+///@}
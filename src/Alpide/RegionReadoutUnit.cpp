@@ -9,6 +9,7 @@
 #include <iostream>
 #include "RegionReadoutUnit.hpp"
 #include "../misc/vcd_trace.hpp"
+#include "../common/ProcessProfiler.hpp"
 
 
 
@@ -59,6 +60,8 @@ RegionReadoutUnit::RegionReadoutUnit(sc_core::sc_module_name name,
 ///       Region Readout Unit (RRU). NOTE: Should run at system clock frequency (40MHz).
 void RegionReadoutUnit::regionUnitProcess(void)
 {
+  PROFILE_PROCESS(REGION_READOUT_UNIT);
+
   if(mIdle) {
     // Revert to static sensitivity (clocked), and wait till next clock cycle
     // because dynamic sensitivity to signal changes triggers the method
@@ -442,6 +445,8 @@ void RegionReadoutUnit::regionHeaderFSM(void)
 ///       Moore FSM style combinatorial output from region header FSM
 void RegionReadoutUnit::regionHeaderFSMOutput(void)
 {
+  PROFILE_PROCESS(REGION_READOUT_UNIT);
+
   // Next state logic
   switch(s_rru_header_state.read()) {
   case HEADER_FSM::HEADER:
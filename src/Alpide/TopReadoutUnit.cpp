@@ -7,6 +7,7 @@
 
 #include "TopReadoutUnit.hpp"
 #include "../misc/vcd_trace.hpp"
+#include "../common/ProcessProfiler.hpp"
 
 
 SC_HAS_PROCESS(TopReadoutUnit);
@@ -14,15 +15,24 @@ SC_HAS_PROCESS(TopReadoutUnit);
 ///@param[in] name SystemC module name
 //////@param[in] global_chip_id Global chip ID that uniquely identifies chip in simulation
 ///@param[in] local_chip_id Chip ID that identifies chip in the stave or module
+///@param[in] data_word_count Counts of transmitted data words, shared with the Alpide object
+///@param[in] region_bank Regions to read from in compact elaboration mode. When it is
+///           null the regions are connected with the region ports.
 TopReadoutUnit::TopReadoutUnit(sc_core::sc_module_name name,
                                const unsigned int global_chip_id,
                                const unsigned int local_chip_id,
-                               std::shared_ptr<std::map<AlpideDataType, uint64_t>> data_word_count)
+                               std::shared_ptr<std::map<AlpideDataType, uint64_t>> data_word_count,
+                               RegionReadoutBank* region_bank)
   : sc_core::sc_module(name)
+  , s_region_fifo_empty_in(region_bank ? 0 : N_REGIONS)
+  , s_region_valid_in(region_bank ? 0 : N_REGIONS)
+  , s_region_data_in(region_bank ? 0 : N_REGIONS)
+  , s_region_data_read_out(region_bank ? 0 : N_REGIONS)
   , mGlobalChipId(global_chip_id)
   , mLocalChipId(local_chip_id)
-  , mIdle(false)
   , mDataWordCount(data_word_count)
+  , mRegionBank(region_bank)
+  , mIdle(false)
 {
   s_tru_current_state = IDLE;
   s_tru_next_state = IDLE;
@@ -45,7 +55,7 @@ TopReadoutUnit::TopReadoutUnit(sc_core::sc_module_name name,
 bool TopReadoutUnit::getNextRegion(unsigned int& region_out)
 {
   for(int i = 0; i < N_REGIONS; i++) {
-    if(s_region_valid_in[i] == true) {
+    if(getRegionValid(i)) {
       region_out = i;
       return true;
     }
@@ -62,7 +72,7 @@ bool TopReadoutUnit::getNoRegionsEmpty(void)
   bool or_empty = false;
 
   for(int i = 0; i < N_REGIONS; i++) {
-    or_empty = or_empty || s_region_fifo_empty_in[i];
+    or_empty = or_empty || getRegionFifoEmpty(i);
   }
 
   return !or_empty;
@@ -72,6 +82,8 @@ bool TopReadoutUnit::getNoRegionsEmpty(void)
 ///@brief SystemC method for updating the current state of the TRU's FSM
 void TopReadoutUnit::topRegionReadoutStateUpdate(void)
 {
+  PROFILE_PROCESS(TOP_READOUT_UNIT);
+
   s_tru_current_state = s_tru_next_state;
 
   E_update_fsm.notify(12.5, SC_NS);
@@ -117,6 +129,8 @@ void TopReadoutUnit::topRegionReadoutStateUpdate(void)
 ///@image html TRU_state_machine.png
 void TopReadoutUnit::topRegionReadoutOutputNextState(void)
 {
+  PROFILE_PROCESS(TOP_READOUT_UNIT);
+
   std::uint64_t time_now = sc_time_stamp().value();
   // If we were idle with dynamic sensitivity enabled,
   // revert back to static sensitivity now that something happened.
@@ -150,8 +164,8 @@ void TopReadoutUnit::topRegionReadoutOutputNextState(void)
   bool region_readout_allowed =
     !dmu_data_fifo_full &&
     !no_regions_valid &&
-    !s_region_fifo_empty_in[current_region] &&
-    s_region_valid_in[current_region];
+    !getRegionFifoEmpty(current_region) &&
+    getRegionValid(current_region);
 
   s_no_regions_empty_debug = no_regions_empty;
   s_no_regions_valid_debug = no_regions_valid;
@@ -160,7 +174,7 @@ void TopReadoutUnit::topRegionReadoutOutputNextState(void)
 
   // New region? Make sure region data read signal for previous region was set low then
   if(current_region != s_previous_region.read())
-    s_region_data_read_out[s_previous_region.read()] = false;
+    setRegionDataRead(s_previous_region.read(), false);
 
   s_write_dmu_fifo = false;
 
@@ -176,7 +190,7 @@ void TopReadoutUnit::topRegionReadoutOutputNextState(void)
     }
     s_region_event_pop_out = !frame_end_fifo_empty;
     s_region_event_start_out = false;
-    s_region_data_read_out[current_region] = false;
+    setRegionDataRead(current_region, false);
     s_region_data_read_debug = false;
     s_write_dmu_fifo = false;
     break;
@@ -194,7 +208,7 @@ void TopReadoutUnit::topRegionReadoutOutputNextState(void)
     }
     s_region_event_start_out = !frame_start_fifo_empty;
     s_region_event_pop_out = false;
-    s_region_data_read_out[current_region] = false;
+    setRegionDataRead(current_region, false);
     s_region_data_read_debug = false;
     s_write_dmu_fifo = false;
     break;
@@ -207,7 +221,7 @@ void TopReadoutUnit::topRegionReadoutOutputNextState(void)
 
     s_region_event_pop_out = false;
     s_region_event_start_out = false;
-    s_region_data_read_out[current_region] = false;
+    setRegionDataRead(current_region, false);
     s_region_data_read_debug = false;
     s_write_dmu_fifo = false;
     break;
@@ -242,10 +256,10 @@ void TopReadoutUnit::topRegionReadoutOutputNextState(void)
     s_region_event_pop_out = false;
     s_region_event_start_out = false;
 
-    s_region_data_read_out[current_region] =
-      !dmu_data_fifo_full &&
-      !no_regions_valid &&
-      no_regions_empty;
+    setRegionDataRead(current_region,
+                      !dmu_data_fifo_full &&
+                      !no_regions_valid &&
+                      no_regions_empty);
 
     s_region_data_read_debug =
       !dmu_data_fifo_full &&
@@ -265,7 +279,7 @@ void TopReadoutUnit::topRegionReadoutOutputNextState(void)
 
     s_region_event_pop_out = false;
     s_region_event_start_out = false;
-    s_region_data_read_out[current_region] = false;
+    setRegionDataRead(current_region, false);
     s_region_data_read_debug = false;
     s_write_dmu_fifo = true;
     break;
@@ -273,14 +287,14 @@ void TopReadoutUnit::topRegionReadoutOutputNextState(void)
   case REGION_DATA:
     if(s_readout_abort_in || no_regions_valid) {
       s_tru_next_state = CHIP_TRAILER;
-    } else if(dmu_data_fifo_full || s_region_fifo_empty_in[current_region]) {
+    } else if(dmu_data_fifo_full || getRegionFifoEmpty(current_region)) {
       s_tru_next_state = WAIT;
     }
 
-    s_tru_data = s_region_data_in[current_region];
+    s_tru_data = getRegionData(current_region);
     s_region_event_pop_out = false;
     s_region_event_start_out = false;
-    s_region_data_read_out[current_region] = region_readout_allowed;
+    setRegionDataRead(current_region, region_readout_allowed);
     s_region_data_read_debug = region_readout_allowed;
     //s_write_dmu_fifo = true;
     s_write_dmu_fifo = region_readout_allowed;
@@ -290,15 +304,15 @@ void TopReadoutUnit::topRegionReadoutOutputNextState(void)
   case WAIT: // Data FIFO full or waiting for more region data
     if(s_readout_abort_in || no_regions_valid)
       s_tru_next_state = CHIP_TRAILER;
-    else if(dmu_data_fifo_full || s_region_fifo_empty_in[current_region])
+    else if(dmu_data_fifo_full || getRegionFifoEmpty(current_region))
       s_tru_next_state = WAIT;
     else
       s_tru_next_state = REGION_DATA;
 
-    s_tru_data = s_region_data_in[current_region];
+    s_tru_data = getRegionData(current_region);
     s_region_event_pop_out = false;
     s_region_event_start_out = false;
-    s_region_data_read_out[current_region] = region_readout_allowed;
+    setRegionDataRead(current_region, region_readout_allowed);
     s_region_data_read_debug = region_readout_allowed;
     s_write_dmu_fifo = region_readout_allowed;
     break;
@@ -323,7 +337,7 @@ void TopReadoutUnit::topRegionReadoutOutputNextState(void)
 
     s_region_event_pop_out = !frame_end_fifo_empty && !dmu_data_fifo_full;
     s_region_event_start_out = false;
-    s_region_data_read_out[current_region] = false;
+    setRegionDataRead(current_region, false);
     s_region_data_read_debug = false;
     s_write_dmu_fifo = !dmu_data_fifo_full && !frame_end_fifo_empty;
     break;
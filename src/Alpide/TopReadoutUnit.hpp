@@ -12,6 +12,7 @@
 #define TOP_READOUT_H
 
 #include "RegionReadoutUnit.hpp"
+#include "RegionReadoutBank.hpp"
 #include "AlpideDataWord.hpp"
 #include "alpide_constants.hpp"
 #include <string>
@@ -44,13 +45,16 @@ public:
 
   sc_in<bool> s_readout_abort_in;
   sc_in<bool> s_fatal_state_in;
-  sc_in<bool> s_region_fifo_empty_in[N_REGIONS];
-  sc_in<bool> s_region_valid_in[N_REGIONS];
-  sc_in<AlpideDataWord> s_region_data_in[N_REGIONS];
+
+  ///@brief Region inputs and outputs. Not used (empty) in compact elaboration mode,
+  ///       where the regions are read from the RegionReadoutBank object instead.
+  std::vector<sc_in<bool>> s_region_fifo_empty_in;
+  std::vector<sc_in<bool>> s_region_valid_in;
+  std::vector<sc_in<AlpideDataWord>> s_region_data_in;
 
   sc_out<bool> s_region_event_pop_out;
   sc_out<bool> s_region_event_start_out;
-  sc_out<bool> s_region_data_read_out[N_REGIONS];
+  std::vector<sc_out<bool>> s_region_data_read_out;
 
   // Outputs from the FIFO, not outputs from the TRU module/class
   sc_port<tlm::tlm_nonblocking_get_peek_if<FrameStartFifoWord>> s_frame_start_fifo_output;
@@ -96,6 +100,9 @@ private:
   ///@brief Counts of how many data words of each type has been transmitted
   std::shared_ptr<std::map<AlpideDataType, uint64_t>> mDataWordCount;
 
+  ///@brief Regions in compact elaboration mode, null when the region ports are used
+  RegionReadoutBank* mRegionBank;
+
   /// Indicates that the TRU was/is IDLE
   /// (Used to disable sensitivity to clock to save simulation time);
   bool mIdle;
@@ -117,10 +124,27 @@ private:
   bool getNextRegion(unsigned int& region_out);
   bool getNoRegionsEmpty(void);
 
+  bool getRegionValid(unsigned int region) const {
+    return mRegionBank ? mRegionBank->getRegionValid(region) : s_region_valid_in[region].read();
+  }
+  bool getRegionFifoEmpty(unsigned int region) const {
+    return mRegionBank ? mRegionBank->getRegionFifoEmpty(region) : s_region_fifo_empty_in[region].read();
+  }
+  const AlpideDataWord& getRegionData(unsigned int region) const {
+    return mRegionBank ? mRegionBank->getRegionData(region) : s_region_data_in[region].read();
+  }
+  void setRegionDataRead(unsigned int region, bool value) {
+    if(mRegionBank)
+      mRegionBank->setRegionDataRead(region, value);
+    else
+      s_region_data_read_out[region] = value;
+  }
+
 public:
   TopReadoutUnit(sc_core::sc_module_name name,
                  const unsigned int global_chip_id, const unsigned int local_chip_id,
-                 std::shared_ptr<std::map<AlpideDataType, uint64_t>> data_word_count);
+                 std::shared_ptr<std::map<AlpideDataType, uint64_t>> data_word_count,
+                 RegionReadoutBank* region_bank = nullptr);
   void addTraces(sc_trace_file *wf, std::string name_prefix) const;
 };
 
@@ -9,6 +9,8 @@
  */
 
 #include "misc/vcd_trace.hpp"
+#include "common/ProcessProfiler.hpp"
+#include "common/MemoryUsage.hpp"
 #include "AlpideDataParser.hpp"
 #include <cstddef>
 #include <iostream>
@@ -119,6 +121,38 @@ const AlpideEventFrame* AlpideEventBuilder::getNextEvent(void) const
 }
 
 
+///@brief Get an estimate of the memory used by the event frames, busy events and
+///       the lists of triggers with readout flags set (busy violation etc.)
+///@return Memory usage in bytes
+uint64_t AlpideEventBuilder::getEventMemoryUsage(void) const
+{
+  uint64_t bytes = mEvents.capacity() * sizeof(AlpideEventFrame);
+
+  for(auto it = mEvents.begin(); it != mEvents.end(); it++)
+    bytes += it->getEventSize() * tree_node_bytes<PixelHit>();
+
+  bytes += mBusyEvents.capacity() * sizeof(BusyEvent);
+
+  for(auto trig_map : {&mFatalTriggers, &mReadoutAbortTriggers,
+                       &mBusyViolationTriggers, &mFlushedIncomplTriggers}) {
+    for(auto it = trig_map->begin(); it != trig_map->end(); it++) {
+      bytes += tree_node_bytes<std::pair<unsigned int, std::vector<uint64_t>>>();
+      bytes += it->second.capacity() * sizeof(uint64_t);
+    }
+  }
+
+  return bytes;
+}
+
+
+///@brief Get an estimate of the memory used by the data rate interval byte counts
+///@return Memory usage in bytes
+uint64_t AlpideEventBuilder::getIntervalMemoryUsage(void) const
+{
+  return mDataIntervalByteCounts.size() * tree_node_bytes<std::pair<uint64_t, unsigned int>>();
+}
+
+
 ///@brief Pop/remove the oldest event (if there are any events, otherwise do nothing).
 void AlpideEventBuilder::popEvent(void)
 {
@@ -413,6 +447,8 @@ AlpideDataParser::AlpideDataParser(sc_core::sc_module_name name, bool word_mode,
 ///       A busy signal indicates if the parser has detected BUSY ON/OFF words.
 void AlpideDataParser::parserInputProcess(void)
 {
+  PROFILE_PROCESS(ALPIDE_DATA_PARSER);
+
   uint64_t time_now = sc_time_stamp().value();
 
   sc_uint<24> dw = s_serial_data_in.read();
@@ -154,6 +154,8 @@ public:
 
   unsigned int getNumEvents(void) const;
   const AlpideEventFrame* getNextEvent(void) const;
+  uint64_t getEventMemoryUsage(void) const;
+  uint64_t getIntervalMemoryUsage(void) const;
 
   unsigned int getDataIntervalNs(void) const {
     return mDataIntervalNs;
@@ -180,6 +182,11 @@ public:
   std::vector<BusyEvent>& getBusyEvents(void) {
     return mBusyEvents;
   }
+
+  ///@brief True between BUSY_ON and BUSY_OFF, when the last busy event is not finished
+  bool getBusyStatus(void) const {
+    return mBusyStatus;
+  }
 };
 
 
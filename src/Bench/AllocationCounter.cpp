@@ -0,0 +1,124 @@
+/**
+ * @file   AllocationCounter.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Replacement of the global operator new and delete which counts
+ *         heap allocations. Only linked into the alpide_bench program.
+ */
+
+#include "AllocationCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> g_allocations(0);
+static std::atomic<uint64_t> g_deallocations(0);
+static std::atomic<uint64_t> g_allocated_bytes(0);
+
+
+///@brief Get number of allocations, deallocations and allocated bytes since the program started
+AllocationCounts getAllocationCounts(void)
+{
+  AllocationCounts counts;
+
+  counts.allocations = g_allocations.load(std::memory_order_relaxed);
+  counts.deallocations = g_deallocations.load(std::memory_order_relaxed);
+  counts.allocated_bytes = g_allocated_bytes.load(std::memory_order_relaxed);
+
+  return counts;
+}
+
+
+static void* counted_alloc(std::size_t size)
+{
+  if(size == 0)
+    size = 1;
+
+  void* ptr = std::malloc(size);
+
+  if(ptr == nullptr)
+    throw std::bad_alloc();
+
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  return ptr;
+}
+
+
+static void counted_free(void* ptr)
+{
+  if(ptr == nullptr)
+    return;
+
+  g_deallocations.fetch_add(1, std::memory_order_relaxed);
+  std::free(ptr);
+}
+
+
+void* operator new(std::size_t size)
+{
+  return counted_alloc(size);
+}
+
+
+void* operator new[](std::size_t size)
+{
+  return counted_alloc(size);
+}
+
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  try {
+    return counted_alloc(size);
+  } catch(std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  try {
+    return counted_alloc(size);
+  } catch(std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+
+void operator delete(void* ptr) noexcept
+{
+  counted_free(ptr);
+}
+
+
+void operator delete[](void* ptr) noexcept
+{
+  counted_free(ptr);
+}
+
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  counted_free(ptr);
+}
+
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+  counted_free(ptr);
+}
+
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+  counted_free(ptr);
+}
+
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+  counted_free(ptr);
+}
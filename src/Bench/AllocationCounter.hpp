@@ -0,0 +1,29 @@
+/**
+ * @file   AllocationCounter.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Counters for heap allocations, used by the alpide_bench program.
+ *
+ *         AllocationCounter.cpp replaces the global operator new and delete
+ *         with versions that count the number of allocations, deallocations and
+ *         allocated bytes. It is only linked into alpide_bench, not into the
+ *         simulation itself.
+ */
+
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstdint>
+
+
+struct AllocationCounts {
+  uint64_t allocations;
+  uint64_t deallocations;
+  uint64_t allocated_bytes;
+};
+
+
+AllocationCounts getAllocationCounts(void);
+
+
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @file   MicroBenchmark.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Minimal timing loop for microbenchmarks, without external dependencies.
+ *
+ *         Each sample calls an untimed setup function followed by the timed body,
+ *         which returns the number of items (pixels, bytes, calls) it processed.
+ *         Samples are collected until both a minimum number of samples and a
+ *         minimum total timed duration is reached, after a few warmup samples.
+ *         The results are reported as median, median absolute deviation (MAD)
+ *         and minimum time per item, which are robust to the occasional outlier
+ *         caused by interrupts, page faults or frequency scaling.
+ */
+
+#ifndef MICRO_BENCHMARK_HPP
+#define MICRO_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+struct MicroBenchmarkResult {
+  std::string name;
+  unsigned int samples;
+
+  ///@brief Average number of items processed per sample
+  double items_per_sample;
+
+  ///@brief Median time per item [ns]
+  double median_ns;
+
+  ///@brief Median absolute deviation of time per item [ns], scaled with 1.4826 to be
+  ///       comparable with the standard deviation for normally distributed samples
+  double mad_ns;
+
+  ///@brief Fastest sample, time per item [ns]
+  double min_ns;
+
+  ///@brief Items per second, based on the median
+  double items_per_s;
+};
+
+
+///@brief Store a value so the compiler can not optimize away the computation of it
+template<class T>
+inline void microBenchmarkSink(const T& value)
+{
+  static volatile T sink;
+  sink = value;
+  (void) sink;
+}
+
+
+class MicroBenchmark {
+private:
+  unsigned int mWarmupSamples;
+  unsigned int mMinSamples;
+  unsigned int mMaxSamples;
+  double mMinTimeS;
+
+  static double median(std::vector<double> values) {
+    if(values.empty())
+      return 0.0;
+
+    std::size_t mid = values.size()/2;
+    std::nth_element(values.begin(), values.begin()+mid, values.end());
+    double upper = values[mid];
+
+    if(values.size() % 2 == 1)
+      return upper;
+
+    double lower = *std::max_element(values.begin(), values.begin()+mid);
+    return (lower+upper)/2;
+  }
+
+public:
+  ///@param[in] min_samples Minimum number of timed samples
+  ///@param[in] min_time_s Minimum total timed duration [s]
+  ///@param[in] max_samples Stop after this many samples even if min_time_s is not reached
+  ///@param[in] warmup_samples Number of untimed samples before the timed samples
+  MicroBenchmark(unsigned int min_samples = 30,
+                 double min_time_s = 0.5,
+                 unsigned int max_samples = 1000000,
+                 unsigned int warmup_samples = 3)
+    : mWarmupSamples(warmup_samples)
+    , mMinSamples(std::max(1u, min_samples))
+    , mMaxSamples(std::max(mMinSamples, max_samples))
+    , mMinTimeS(min_time_s)
+  {
+  }
+
+  ///@brief Run a benchmark
+  ///@param[in] name Name of benchmark
+  ///@param[in] setup Function called before each sample, not timed
+  ///@param[in] body Function to time. Returns the number of items it processed,
+  ///           the results are reported per item.
+  ///@return Result with timing statistics
+  template<class Setup, class Body>
+  MicroBenchmarkResult run(const std::string& name, Setup setup, Body body) const
+  {
+    for(unsigned int i = 0; i < mWarmupSamples; i++) {
+      setup();
+      body();
+    }
+
+    std::vector<double> item_ns;
+    double total_time_s = 0.0;
+    double total_items = 0.0;
+
+    while(item_ns.size() < mMaxSamples &&
+          (item_ns.size() < mMinSamples || total_time_s < mMinTimeS))
+    {
+      setup();
+
+      auto start_time = std::chrono::steady_clock::now();
+      uint64_t items = body();
+      auto end_time = std::chrono::steady_clock::now();
+
+      std::chrono::duration<double> duration = end_time - start_time;
+      total_time_s += duration.count();
+      total_items += items;
+      item_ns.push_back(1E9*duration.count()/std::max<uint64_t>(1, items));
+    }
+
+    double median_ns = median(item_ns);
+
+    std::vector<double> abs_dev;
+    for(auto it = item_ns.begin(); it != item_ns.end(); it++)
+      abs_dev.push_back(std::fabs(*it - median_ns));
+
+    MicroBenchmarkResult result;
+    result.name = name;
+    result.samples = item_ns.size();
+    result.items_per_sample = total_items/item_ns.size();
+    result.median_ns = median_ns;
+    result.mad_ns = 1.4826*median(abs_dev);
+    result.min_ns = *std::min_element(item_ns.begin(), item_ns.end());
+    result.items_per_s = result.median_ns > 0 ? 1E9/result.median_ns : 0.0;
+
+    return result;
+  }
+};
+
+
+#endif
@@ -0,0 +1,448 @@
+/**
+ * @file   alpide_bench.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Reproducible performance benchmark for the Alpide Dataflow Simulation.
+ *
+ *         alpide_bench runs a fixed set of simulation scenarios, each with a
+ *         fixed random seed and number of events, and reports wall time,
+ *         simulated time per wall second, pixel hits per wall second, peak
+ *         resident memory and heap allocation counts as JSON.
+ *
+ *         Since SystemC can only elaborate one design per process, every
+ *         scenario is run in a child process. The child is this same
+ *         executable started with --run-scenario, which runs the normal
+ *         simulation main function (main.cpp is compiled with ALPIDE_BENCH,
+ *         which renames sc_main to alpide_sim_main), and writes the simulated
+ *         time and allocation counts to a result file afterwards. Wall time and
+ *         peak RSS are measured by the parent for the whole child process.
+ *
+ *         Must be run from the top directory of the repository, since the
+ *         scenarios use the multiplicity distribution and Monte Carlo files
+ *         in config/.
+ */
+
+#include "Settings/Settings.hpp"
+#include "Bench/AllocationCounter.hpp"
+#include "version.hpp"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Ignore warnings about use of auto_ptr and unused parameters in SystemC library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#include <systemc.h>
+#pragma GCC diagnostic pop
+
+
+// Simulation main function from main.cpp (renamed from sc_main when compiled with ALPIDE_BENCH)
+int alpide_sim_main(int argc, char** argv);
+
+
+static const char* RUN_SCENARIO_ARG = "--run-scenario";
+static const unsigned int BENCH_RANDOM_SEED = 1337;
+
+
+struct BenchScenario {
+  std::string name;
+  std::string description;
+  unsigned int num_events;
+
+  ///@brief Settings that differ from the default settings
+  std::vector<std::pair<QString, QString>> settings;
+};
+
+
+struct BenchResult {
+  bool success;
+  int exit_status;
+  double wall_time_s;
+  uint64_t sim_time_ns;
+  uint64_t hits;
+  long peak_rss_kb;
+  AllocationCounts alloc_counts;
+};
+
+
+///@brief Settings for an ITS simulation with only the given staves in the layers
+static std::vector<std::pair<QString, QString>> its_staves(unsigned int layer0,
+                                                           unsigned int layer1,
+                                                           unsigned int layer2,
+                                                           unsigned int layer3)
+{
+  return {{"simulation/type", "its"},
+          {"simulation/single_chip", "false"},
+          {"its/layer0_num_staves", QString::number(layer0)},
+          {"its/layer1_num_staves", QString::number(layer1)},
+          {"its/layer2_num_staves", QString::number(layer2)},
+          {"its/layer3_num_staves", QString::number(layer3)},
+          {"its/layer4_num_staves", "0"},
+          {"its/layer5_num_staves", "0"},
+          {"its/layer6_num_staves", "0"}};
+}
+
+
+///@brief Settings for a single chip ITS simulation with the given hit density
+static std::vector<std::pair<QString, QString>> single_chip(const QString& hit_density)
+{
+  return {{"simulation/type", "its"},
+          {"simulation/single_chip", "true"},
+          {"its/hit_density_layer0", hit_density}};
+}
+
+
+///@brief The fixed set of benchmark scenarios. Changing a scenario makes the results
+///       incomparable with earlier results, so add a new scenario instead.
+static std::vector<BenchScenario> get_scenarios(void)
+{
+  std::vector<BenchScenario> scenarios;
+
+  scenarios.push_back({"single_chip_low", "Single chip, 2.6 hits/cm^2 (outer barrel occupancy)",
+                       10000, single_chip("2.6")});
+  scenarios.push_back({"single_chip_medium", "Single chip, 9.1 hits/cm^2 (layer 2 occupancy)",
+                       10000, single_chip("9.1")});
+  scenarios.push_back({"single_chip_high", "Single chip, 18.6 hits/cm^2 (layer 0 occupancy)",
+                       10000, single_chip("18.6")});
+  scenarios.push_back({"single_chip_extreme", "Single chip, 50 hits/cm^2",
+                       10000, single_chip("50")});
+  scenarios.push_back({"ib_stave", "One inner barrel stave (layer 0, 9 chips)",
+                       2000, its_staves(1, 0, 0, 0)});
+  scenarios.push_back({"ob_stave", "One middle barrel stave (layer 3, 8 modules of 14 chips)",
+                       500, its_staves(0, 0, 0, 1)});
+  scenarios.push_back({"full_layer", "Full layer 0 (12 staves), random events",
+                       500, its_staves(12, 0, 0, 0)});
+  scenarios.push_back({"pct_scanning_beam", "pCT with random scanning beam",
+                       200, {{"simulation/type", "pct"},
+                             {"event/random_hit_generation", "true"}}});
+#ifdef ROOT_ENABLED
+  scenarios.push_back({"focal", "Focal with Monte Carlo events from ROOT file",
+                       100, {{"simulation/type", "focal"}}});
+#endif
+
+  return scenarios;
+}
+
+
+///@brief Write settings file for a scenario. Starts from the default settings,
+///       so that the scenarios do not depend on config/settings.txt.
+static void write_scenario_settings(const BenchScenario& scenario, const QString& filename)
+{
+  QFile::remove(filename);
+
+  QSettings settings(filename, QSettings::IniFormat);
+
+  setDefaultSimSettings(&settings);
+
+  settings.setValue("simulation/random_seed", QString::number(BENCH_RANDOM_SEED));
+  settings.setValue("simulation/n_events", QString::number(scenario.num_events));
+  settings.setValue("simulation/stop_ci_rel_width", "0");
+  settings.setValue("simulation/wall_clock_budget_s", "0");
+  settings.setValue("data_output/write_vcd", "false");
+  settings.setValue("data_output/write_vcd_clock", "false");
+  settings.setValue("data_output/write_event_csv", "false");
+  settings.setValue("data_output/write_process_profile", "false");
+
+  for(auto it = scenario.settings.begin(); it != scenario.settings.end(); it++)
+    settings.setValue(it->first, it->second);
+
+  settings.sync();
+}
+
+
+///@brief Sum the "Latched pixel hits" column in Alpide_stats.csv
+///@return Total number of latched pixel hits, or 0 if the file could not be read
+static uint64_t read_latched_hits(const QString& output_prefix)
+{
+  QDir prefix_dir(output_prefix);
+  QStringList run_dirs = prefix_dir.entryList({"run_*"}, QDir::Dirs);
+
+  if(run_dirs.empty())
+    return 0;
+
+  std::ifstream stats_file((output_prefix + "/" + run_dirs.first() + "/Alpide_stats.csv").toStdString());
+  std::string line;
+
+  if(!std::getline(stats_file, line))
+    return 0;
+
+  QStringList header = QString::fromStdString(line).split(";");
+  int hits_column = -1;
+
+  for(int i = 0; i < header.size(); i++) {
+    if(header[i].trimmed() == "Latched pixel hits")
+      hits_column = i;
+  }
+
+  if(hits_column < 0)
+    return 0;
+
+  uint64_t hits = 0;
+
+  while(std::getline(stats_file, line)) {
+    QStringList columns = QString::fromStdString(line).split(";");
+    if(columns.size() > hits_column)
+      hits += columns[hits_column].trimmed().toULongLong();
+  }
+
+  return hits;
+}
+
+
+///@brief Run one scenario in a child process
+static BenchResult run_scenario(const BenchScenario& scenario, const QString& work_dir)
+{
+  BenchResult result = {};
+
+  QString scenario_dir = work_dir + "/" + QString::fromStdString(scenario.name);
+  QString settings_file = scenario_dir + "/settings.txt";
+  QString result_file = scenario_dir + "/result.txt";
+  QString output_prefix = scenario_dir + "/sim_output";
+
+  // Start from an empty directory, so that the simulation output ends up in run_0
+  QDir(scenario_dir).removeRecursively();
+  QDir().mkpath(scenario_dir);
+
+  write_scenario_settings(scenario, settings_file);
+
+  std::vector<std::string> args = {"/proc/self/exe",
+                                   RUN_SCENARIO_ARG,
+                                   result_file.toStdString(),
+                                   "-cfg", settings_file.toStdString(),
+                                   "-o", output_prefix.toStdString()};
+
+  std::vector<char*> argv;
+  for(auto it = args.begin(); it != args.end(); it++)
+    argv.push_back(&(*it)[0]);
+  argv.push_back(nullptr);
+
+  std::string log_filename = (scenario_dir + "/sim_log.txt").toStdString();
+
+  auto start_time = std::chrono::steady_clock::now();
+
+  pid_t pid = fork();
+
+  if(pid < 0) {
+    std::cerr << "Error: fork() failed for scenario " << scenario.name << std::endl;
+    return result;
+  } else if(pid == 0) {
+    // Redirect simulation output to a log file, to keep the JSON on stdout clean
+    if(freopen(log_filename.c_str(), "w", stdout) == nullptr)
+      _exit(127);
+    dup2(fileno(stdout), fileno(stderr));
+
+    execv(argv[0], argv.data());
+    _exit(127);
+  }
+
+  int status = 0;
+  struct rusage usage;
+
+  wait4(pid, &status, 0, &usage);
+
+  std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - start_time;
+
+  result.wall_time_s = wall_time.count();
+  result.peak_rss_kb = usage.ru_maxrss; // In kilobytes on Linux
+  result.exit_status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+
+  std::ifstream result_stream(result_file.toStdString());
+  std::string key;
+
+  while(result_stream >> key) {
+    if(key == "sim_time_ns")
+      result_stream >> result.sim_time_ns;
+    else if(key == "allocations")
+      result_stream >> result.alloc_counts.allocations;
+    else if(key == "deallocations")
+      result_stream >> result.alloc_counts.deallocations;
+    else if(key == "allocated_bytes")
+      result_stream >> result.alloc_counts.allocated_bytes;
+  }
+
+  result.success = (result.exit_status == 0 && result.sim_time_ns > 0);
+  result.hits = read_latched_hits(output_prefix);
+
+  return result;
+}
+
+
+///@brief Format the result of a scenario as a JSON object
+static std::string result_to_json(const BenchScenario& scenario, const BenchResult& result)
+{
+  std::ostringstream json;
+
+  double sim_rate = result.wall_time_s > 0 ? result.sim_time_ns / result.wall_time_s : 0.0;
+  double hit_rate = result.wall_time_s > 0 ? result.hits / result.wall_time_s : 0.0;
+
+  json << "    {\n";
+  json << "      \"name\": \"" << scenario.name << "\",\n";
+  json << "      \"description\": \"" << scenario.description << "\",\n";
+  json << "      \"status\": \"" << (result.success ? "ok" : "failed") << "\",\n";
+  json << "      \"exit_status\": " << result.exit_status << ",\n";
+  json << "      \"events\": " << scenario.num_events << ",\n";
+  json << "      \"random_seed\": " << BENCH_RANDOM_SEED << ",\n";
+  json << "      \"wall_time_s\": " << result.wall_time_s << ",\n";
+  json << "      \"sim_time_ns\": " << result.sim_time_ns << ",\n";
+  json << "      \"sim_ns_per_wall_s\": " << sim_rate << ",\n";
+  json << "      \"hits\": " << result.hits << ",\n";
+  json << "      \"hits_per_wall_s\": " << hit_rate << ",\n";
+  json << "      \"peak_rss_kb\": " << result.peak_rss_kb << ",\n";
+  json << "      \"allocations\": " << result.alloc_counts.allocations << ",\n";
+  json << "      \"deallocations\": " << result.alloc_counts.deallocations << ",\n";
+  json << "      \"allocated_bytes\": " << result.alloc_counts.allocated_bytes << "\n";
+  json << "    }";
+
+  return json.str();
+}
+
+
+///@brief Child process: run the simulation and write simulated time and allocation counts
+///       to the result file. Arguments: <program> --run-scenario <result file> <simulation args>
+static int run_child(int argc, char** argv)
+{
+  std::string result_filename = argv[2];
+
+  // Remove --run-scenario and result file from the arguments passed on to the simulation
+  std::vector<char*> sim_argv;
+  sim_argv.push_back(argv[0]);
+  for(int i = 3; i < argc; i++)
+    sim_argv.push_back(argv[i]);
+  sim_argv.push_back(nullptr);
+
+  int sim_argc = sim_argv.size()-1;
+  int retval = alpide_sim_main(sim_argc, sim_argv.data());
+
+  AllocationCounts counts = getAllocationCounts();
+
+  std::ofstream result_file(result_filename);
+  result_file << "sim_time_ns " << sc_time_stamp().value() << std::endl;
+  result_file << "allocations " << counts.allocations << std::endl;
+  result_file << "deallocations " << counts.deallocations << std::endl;
+  result_file << "allocated_bytes " << counts.allocated_bytes << std::endl;
+
+  return retval;
+}
+
+
+int sc_main(int argc, char** argv)
+{
+  if(argc >= 3 && strcmp(argv[1], RUN_SCENARIO_ARG) == 0)
+    return run_child(argc, argv);
+
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("Alpide Dataflow Simulation Benchmark");
+  QCoreApplication::setApplicationVersion(QString::number(VERSION_MAJOR) + "." +
+                                          QString::number(VERSION_MINOR));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("\nRuns a fixed set of Alpide Dataflow Simulation scenarios "
+                                   "and reports performance as JSON");
+
+  const QCommandLineOption listOption({"l", "list"}, "List the benchmark scenarios and exit.");
+
+  const QCommandLineOption scenarioOption({"s", "scenario"},
+                                          "Only run scenarios with this name. "
+                                          "Can be given multiple times. Default is all scenarios.",
+                                          "name");
+
+  const QCommandLineOption workDirOption({"w", "work_dir"},
+                                         "Directory for settings and simulation output of the scenarios.",
+                                         "path",
+                                         "bench_output");
+
+  const QCommandLineOption outputFileOption({"f", "output_file"},
+                                            "JSON file to write the results to, "
+                                            "in addition to standard output. "
+                                            "Default is bench_results.json in the work directory.",
+                                            "file");
+
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addOption(listOption);
+  parser.addOption(scenarioOption);
+  parser.addOption(workDirOption);
+  parser.addOption(outputFileOption);
+
+  parser.process(app);
+
+  std::vector<BenchScenario> all_scenarios = get_scenarios();
+
+  if(parser.isSet(listOption)) {
+    for(auto it = all_scenarios.begin(); it != all_scenarios.end(); it++)
+      std::cout << it->name << ": " << it->description << ", " << it->num_events << " events" << std::endl;
+    return 0;
+  }
+
+  std::vector<BenchScenario> scenarios;
+  QStringList selected = parser.values(scenarioOption);
+
+  for(auto it = all_scenarios.begin(); it != all_scenarios.end(); it++) {
+    if(selected.empty() || selected.contains(QString::fromStdString(it->name)))
+      scenarios.push_back(*it);
+  }
+
+  if(scenarios.empty()) {
+    std::cerr << "Error: no scenarios matching the given names. Use --list to list scenarios." << std::endl;
+    return -1;
+  }
+
+  QString work_dir = parser.value(workDirOption);
+
+  if(QDir().mkpath(work_dir) == false) {
+    std::cerr << "Error creating work directory " << work_dir.toStdString() << std::endl;
+    return -1;
+  }
+
+  std::ostringstream json;
+  bool all_ok = true;
+
+  json << "{\n";
+  json << "  \"version\": \"" << VERSION_MAJOR << "." << VERSION_MINOR << "\",\n";
+  json << "  \"scenarios\": [\n";
+
+  for(auto it = scenarios.begin(); it != scenarios.end(); it++) {
+    std::cerr << "Running scenario " << it->name << "..." << std::endl;
+
+    BenchResult result = run_scenario(*it, work_dir);
+    all_ok = all_ok && result.success;
+
+    std::cerr << "  " << (result.success ? "done" : "FAILED") << " in " << result.wall_time_s << " s" << std::endl;
+
+    json << result_to_json(*it, result);
+    json << (it+1 != scenarios.end() ? ",\n" : "\n");
+  }
+
+  json << "  ]\n";
+  json << "}\n";
+
+  std::cout << json.str();
+
+  QString output_filename = parser.isSet(outputFileOption) ? parser.value(outputFileOption)
+                                                           : work_dir + "/bench_results.json";
+  std::ofstream output_file(output_filename.toStdString());
+
+  if(!output_file.is_open()) {
+    std::cerr << "Error opening output file " << output_filename.toStdString() << std::endl;
+    return -1;
+  }
+
+  output_file << json.str();
+
+  return all_ok ? 0 : 1;
+}
@@ -0,0 +1,569 @@
+/**
+ * @file   alpide_microbench.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Microbenchmarks for the pixel matrix and data parser classes of the
+ *         Alpide model, without SystemC elaboration.
+ *
+ *         Frames are generated with a fixed random seed, for a set of occupancies
+ *         (particle hits per cm^2) and cluster sizes (pixels per particle hit). For
+ *         each combination the following are benchmarked:
+ *         - PixelMatrix::setPixel, readPixel, readPixelRegion and regionEmpty
+ *         - PixelDoubleColumn setPixel and readPixel (priority encoder ordering)
+ *         - Strobe latch: PixelFrontEnd::getEventFrame and feeding the frame to the
+ *           pixel matrix, with the hits from the previous events still in the front end
+ *         - AlpideEventBuilder::inputDataByte on the encoded data stream of the frames
+ *
+ *         A recorded link data stream (raw bytes, as sent by the chip) can also be
+ *         parsed, and the generated stream can be written to a file so the same
+ *         stream can be replayed later.
+ */
+
+#include "Alpide/PixelMatrix.hpp"
+#include "Alpide/PixelFrontEnd.hpp"
+#include "Alpide/AlpideDataWord.hpp"
+#include "AlpideDataParser/AlpideDataParser.hpp"
+#include "Bench/MicroBenchmark.hpp"
+#include "version.hpp"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QStringList>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+static const unsigned int MICROBENCH_RANDOM_SEED = 1337;
+
+///@brief Number of different frames generated for each occupancy and cluster size.
+///       The benchmarks cycle through them, so the same frame is not used every sample.
+static const unsigned int NUM_FRAMES = 64;
+
+///@brief Time between events, and pixel active time (same as the simulation default) [ns]
+static const uint64_t EVENT_SPACING_NS = 1000;
+static const uint64_t PIXEL_ACTIVE_TIME_NS = 6000;
+static const uint64_t STROBE_LENGTH_NS = 100;
+
+///@brief Number of events that are kept in the front end for the strobe latch benchmark
+static const unsigned int FRONT_END_EVENTS = PIXEL_ACTIVE_TIME_NS/EVENT_SPACING_NS + 2;
+
+///@brief Number of times all regions are checked per sample in the regionEmpty benchmark
+static const unsigned int REGION_EMPTY_REPEAT = 100;
+
+
+///@brief Exposes the protected getEventFrame(), which is normally called by the Alpide class
+class BenchPixelFrontEnd : public PixelFrontEnd {
+public:
+  using PixelFrontEnd::getEventFrame;
+};
+
+
+///@brief A generated frame, hits are unique and the active time is set for the frame number
+struct BenchFrame {
+  std::vector<std::shared_ptr<PixelHit>> hits;
+  uint64_t event_time_ns;
+};
+
+
+///@brief Parse a comma separated list of values from the command line
+///@param[in] parser Command line parser
+///@param[in] option Option to parse values for
+///@param[out] values Vector that the values will be appended to
+///@return True on success, false if any value could not be parsed or was not positive
+static bool parse_list_option(const QCommandLineParser& parser,
+                              const QCommandLineOption& option,
+                              std::vector<double>& values)
+{
+  QStringList value_list = parser.value(option).split(",", QString::SkipEmptyParts);
+
+  for(auto it = value_list.begin(); it != value_list.end(); it++) {
+    bool conversion_ok = false;
+    double value = it->trimmed().toDouble(&conversion_ok);
+
+    if(conversion_ok == false || value <= 0) {
+      std::cout << "Error parsing value \"" << it->toStdString() << "\" for option ";
+      std::cout << option.names().last().toStdString() << std::endl;
+      return false;
+    }
+    values.push_back(value);
+  }
+
+  return values.empty() == false;
+}
+
+
+///@brief Offsets of the pixels in a cluster, in order of increasing distance from the
+///       center. The first N offsets are used for a cluster of N pixels.
+static std::vector<std::pair<int, int>> get_cluster_offsets(void)
+{
+  const int max_offset = 8;
+  std::vector<std::pair<int, int>> offsets;
+
+  for(int dx = -max_offset; dx <= max_offset; dx++)
+    for(int dy = -max_offset; dy <= max_offset; dy++)
+      offsets.push_back(std::make_pair(dx, dy));
+
+  std::stable_sort(offsets.begin(), offsets.end(),
+                   [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                     return a.first*a.first + a.second*a.second < b.first*b.first + b.second*b.second;
+                   });
+
+  return offsets;
+}
+
+
+///@brief Generate frames with clusters of pixels at random positions
+///@param[in] occupancy Mean number of particle hits per cm^2
+///@param[in] cluster_size Number of pixels per particle hit (rounded to nearest integer)
+///@return Vector of NUM_FRAMES frames
+static std::vector<BenchFrame> generate_frames(double occupancy, double cluster_size)
+{
+  static const std::vector<std::pair<int, int>> cluster_offsets = get_cluster_offsets();
+
+  std::mt19937 rand_gen(MICROBENCH_RANDOM_SEED);
+  std::uniform_int_distribution<int> rand_col(0, N_PIXEL_COLS-1);
+  std::uniform_int_distribution<int> rand_row(0, N_PIXEL_ROWS-1);
+  std::poisson_distribution<unsigned int> rand_hits(occupancy*CHIP_WIDTH_CM*CHIP_HEIGHT_CM);
+
+  unsigned int pixels_per_cluster = std::max(1, int(std::round(cluster_size)));
+  pixels_per_cluster = std::min<unsigned int>(pixels_per_cluster, cluster_offsets.size());
+
+  std::vector<BenchFrame> frames(NUM_FRAMES);
+
+  for(unsigned int frame_num = 0; frame_num < NUM_FRAMES; frame_num++) {
+    BenchFrame& frame = frames[frame_num];
+    frame.event_time_ns = frame_num*EVENT_SPACING_NS;
+
+    std::set<std::pair<int, int>> pixels;
+    unsigned int num_hits = rand_hits(rand_gen);
+
+    for(unsigned int hit = 0; hit < num_hits; hit++) {
+      int center_col = rand_col(rand_gen);
+      int center_row = rand_row(rand_gen);
+
+      for(unsigned int i = 0; i < pixels_per_cluster; i++) {
+        int col = center_col + cluster_offsets[i].first;
+        int row = center_row + cluster_offsets[i].second;
+
+        if(col >= 0 && col < N_PIXEL_COLS && row >= 0 && row < N_PIXEL_ROWS)
+          pixels.insert(std::make_pair(col, row));
+      }
+    }
+
+    for(auto it = pixels.begin(); it != pixels.end(); it++) {
+      auto pixel = std::make_shared<PixelHit>(it->first, it->second);
+      pixel->setActiveTimeStart(frame.event_time_ns);
+      pixel->setActiveTimeEnd(frame.event_time_ns + PIXEL_ACTIVE_TIME_NS);
+      frame.hits.push_back(pixel);
+    }
+  }
+
+  return frames;
+}
+
+
+///@brief Append the bytes of a data word to a data stream
+static void append_data_word(const AlpideDataWord& dw, std::vector<uint8_t>& stream)
+{
+  for(unsigned int i = 0; i < dw.size; i++)
+    stream.push_back(dw.data[2-i]);
+}
+
+
+///@brief Encode the frames as the Alpide data stream that would be sent on the data link,
+///       with one chip header, region headers, DATA SHORT/LONG words and a chip trailer
+///       per frame. Frames are padded with IDLE to a multiple of 3 bytes (inner barrel word).
+static std::vector<uint8_t> encode_frames(const std::vector<BenchFrame>& frames)
+{
+  std::vector<uint8_t> stream;
+
+  for(unsigned int frame_num = 0; frame_num < frames.size(); frame_num++) {
+    const BenchFrame& frame = frames[frame_num];
+
+    if(frame.hits.empty()) {
+      append_data_word(AlpideChipEmptyFrame(0, frame_num << 3, frame_num), stream);
+    } else {
+      // Key: region, value: set of (priority encoder, address)
+      std::map<unsigned int, std::set<std::pair<unsigned int, unsigned int>>> region_hits;
+
+      for(auto it = frame.hits.begin(); it != frame.hits.end(); it++) {
+        unsigned int region = (*it)->getCol() / N_PIXEL_COLS_PER_REGION;
+        region_hits[region].insert(std::make_pair((*it)->getPriEncNumInRegion(),
+                                                  (*it)->getPriEncPixelAddress()));
+      }
+
+      append_data_word(AlpideChipHeader(0, frame_num << 3, frame_num), stream);
+
+      for(auto region_it = region_hits.begin(); region_it != region_hits.end(); region_it++) {
+        append_data_word(AlpideRegionHeader(region_it->first), stream);
+
+        auto hit_it = region_it->second.begin();
+
+        while(hit_it != region_it->second.end()) {
+          unsigned int pri_enc = hit_it->first;
+          unsigned int addr = hit_it->second;
+          uint8_t hitmap = 0;
+
+          hit_it++;
+
+          // Following hits within DATA_LONG_PIXMAP_SIZE addresses go in the hitmap
+          while(hit_it != region_it->second.end() &&
+                hit_it->first == pri_enc &&
+                hit_it->second <= addr + DATA_LONG_PIXMAP_SIZE)
+          {
+            hitmap |= 1 << (hit_it->second - addr - 1);
+            hit_it++;
+          }
+
+          if(hitmap == 0)
+            append_data_word(AlpideDataShort(pri_enc, addr, nullptr), stream);
+          else
+            append_data_word(AlpideDataLong(pri_enc, addr, hitmap, {}), stream);
+        }
+      }
+
+      append_data_word(AlpideChipTrailer(0), stream);
+    }
+
+    while(stream.size() % 3 != 0)
+      stream.push_back(DW_IDLE);
+  }
+
+  return stream;
+}
+
+
+///@brief Run the pixel matrix, front end and parser benchmarks for one occupancy
+///       and cluster size, and append the results
+static void run_pixel_benchmarks(const MicroBenchmark& bench,
+                                 const QString& filter,
+                                 double occupancy,
+                                 double cluster_size,
+                                 std::vector<std::pair<std::string, MicroBenchmarkResult>>& results)
+{
+  std::vector<BenchFrame> frames = generate_frames(occupancy, cluster_size);
+
+  std::ostringstream params;
+  params << "occupancy=" << occupancy << " cluster_size=" << cluster_size;
+
+  unsigned int frame_num = 0;
+  PixelMatrix matrix;
+
+  // Time passed to the pixel matrix, must increase for the MEB histogram
+  uint64_t time_now = 0;
+
+  auto next_frame = [&]() -> const BenchFrame& {
+    frame_num = (frame_num+1) % NUM_FRAMES;
+    return frames[frame_num];
+  };
+
+  auto clear_matrix = [&]() {
+    time_now += EVENT_SPACING_NS;
+    while(matrix.getNumEvents() > 0)
+      matrix.deleteEvent(time_now);
+  };
+
+  auto fill_matrix = [&]() {
+    const BenchFrame& frame = next_frame();
+    clear_matrix();
+    matrix.newEvent(time_now);
+    for(auto it = frame.hits.begin(); it != frame.hits.end(); it++)
+      matrix.setPixel(*it);
+  };
+
+  auto enabled = [&](const char* name) {
+    return filter.isEmpty() || QString(name).contains(filter);
+  };
+
+  if(enabled("PixelMatrix::setPixel")) {
+    const BenchFrame* frame = nullptr;
+
+    results.push_back({params.str(), bench.run("PixelMatrix::setPixel",
+      [&]() {
+        frame = &next_frame();
+        clear_matrix();
+        matrix.newEvent(time_now);
+      },
+      [&]() -> uint64_t {
+        for(auto it = frame->hits.begin(); it != frame->hits.end(); it++)
+          matrix.setPixel(*it);
+        return frame->hits.size();
+      })});
+  }
+
+  if(enabled("PixelMatrix::readPixel")) {
+    results.push_back({params.str(), bench.run("PixelMatrix::readPixel",
+      fill_matrix,
+      [&]() -> uint64_t {
+        uint64_t pixels = 0;
+        while(matrix.readPixel(time_now)->getCol() != -1)
+          pixels++;
+        return pixels;
+      })});
+  }
+
+  if(enabled("PixelMatrix::readPixelRegion")) {
+    results.push_back({params.str(), bench.run("PixelMatrix::readPixelRegion",
+      fill_matrix,
+      [&]() -> uint64_t {
+        uint64_t pixels = 0;
+        for(int region = 0; region < N_REGIONS; region++) {
+          while(matrix.readPixelRegion(region, time_now)->getCol() != -1)
+            pixels++;
+        }
+        return pixels;
+      })});
+  }
+
+  if(enabled("PixelMatrix::regionEmpty")) {
+    results.push_back({params.str(), bench.run("PixelMatrix::regionEmpty",
+      fill_matrix,
+      [&]() -> uint64_t {
+        unsigned int empty_regions = 0;
+        for(unsigned int i = 0; i < REGION_EMPTY_REPEAT; i++) {
+          for(int region = 0; region < N_REGIONS; region++)
+            empty_regions += matrix.regionEmpty(region);
+        }
+        microBenchmarkSink(empty_regions);
+        return REGION_EMPTY_REPEAT*N_REGIONS;
+      })});
+  }
+
+  if(enabled("PixelDoubleColumn::setPixel+readPixel")) {
+    std::vector<PixelDoubleColumn> double_cols(N_PIXEL_COLS/2);
+    const BenchFrame* frame = nullptr;
+
+    results.push_back({params.str(), bench.run("PixelDoubleColumn::setPixel+readPixel",
+      [&]() {
+        frame = &next_frame();
+      },
+      [&]() -> uint64_t {
+        for(auto it = frame->hits.begin(); it != frame->hits.end(); it++)
+          double_cols[(*it)->getCol()/2].setPixel(*it);
+
+        uint64_t pixels = 0;
+        for(auto it = double_cols.begin(); it != double_cols.end(); it++) {
+          while(it->pixelHitsRemaining() > 0) {
+            it->readPixel();
+            pixels++;
+          }
+        }
+        return pixels;
+      })});
+  }
+
+  if(enabled("PixelFrontEnd::strobeLatch")) {
+    std::unique_ptr<BenchPixelFrontEnd> front_end;
+    unsigned int latch_frame = 0;
+
+    results.push_back({params.str(), bench.run("PixelFrontEnd::strobeLatch",
+      [&]() {
+        // Front end with the hits from the latched event, and the previous
+        // events whose hits may still be active
+        latch_frame = FRONT_END_EVENTS + (latch_frame+1) % (NUM_FRAMES-FRONT_END_EVENTS);
+        front_end.reset(new BenchPixelFrontEnd());
+
+        for(unsigned int i = latch_frame-FRONT_END_EVENTS+1; i <= latch_frame; i++) {
+          for(auto it = frames[i].hits.begin(); it != frames[i].hits.end(); it++)
+            front_end->pixelFrontEndInput(*it);
+        }
+        clear_matrix();
+      },
+      [&]() -> uint64_t {
+        uint64_t strobe_start = frames[latch_frame].event_time_ns + STROBE_LENGTH_NS;
+        EventFrame event = front_end->getEventFrame(strobe_start,
+                                                    strobe_start + STROBE_LENGTH_NS,
+                                                    latch_frame);
+        matrix.newEvent(time_now);
+        event.feedHitsToPixelMatrix(matrix);
+        return event.getEventSize();
+      })});
+  }
+
+  if(enabled("AlpideEventBuilder::inputDataByte")) {
+    std::vector<uint8_t> stream = encode_frames(frames);
+    std::unique_ptr<AlpideEventBuilder> builder;
+
+    results.push_back({params.str(), bench.run("AlpideEventBuilder::inputDataByte",
+      [&]() {
+        builder.reset(new AlpideEventBuilder(10000, false));
+      },
+      [&]() -> uint64_t {
+        for(uint64_t i = 0; i < stream.size(); i++)
+          builder->inputDataByte(stream[i], 0, 25*(i/3));
+        return stream.size();
+      })});
+  }
+
+  clear_matrix();
+}
+
+
+///@brief Run the parser benchmark on a recorded link data stream
+static bool run_stream_benchmark(const MicroBenchmark& bench,
+                                 const std::string& filename,
+                                 std::vector<std::pair<std::string, MicroBenchmarkResult>>& results)
+{
+  std::ifstream stream_file(filename, std::ios::binary);
+
+  if(!stream_file.is_open()) {
+    std::cout << "Error opening link stream file " << filename << std::endl;
+    return false;
+  }
+
+  std::vector<uint8_t> stream((std::istreambuf_iterator<char>(stream_file)),
+                              std::istreambuf_iterator<char>());
+  std::unique_ptr<AlpideEventBuilder> builder;
+
+  results.push_back({"link_stream=" + filename, bench.run("AlpideEventBuilder::inputDataByte",
+    [&]() {
+      builder.reset(new AlpideEventBuilder(10000, false));
+    },
+    [&]() -> uint64_t {
+      for(uint64_t i = 0; i < stream.size(); i++)
+        builder->inputDataByte(stream[i], 0, 25*(i/3));
+      return stream.size();
+    })});
+
+  return true;
+}
+
+
+int sc_main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("Alpide Microbenchmarks");
+  QCoreApplication::setApplicationVersion(QString::number(VERSION_MAJOR) + "." +
+                                          QString::number(VERSION_MINOR));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("\nMicrobenchmarks for the pixel matrix, front end "
+                                   "and data parser classes of the Alpide model");
+
+  const QCommandLineOption occupancyOption({"o", "occupancy"},
+                                           "Comma separated list of occupancies [hits/cm^2].",
+                                           "occupancies",
+                                           "2.6,18.6,50");
+
+  const QCommandLineOption clusterSizeOption({"c", "cluster_size"},
+                                             "Comma separated list of cluster sizes [pixels].",
+                                             "cluster sizes",
+                                             "1,4,9");
+
+  const QCommandLineOption minTimeOption({"t", "min_time"},
+                                         "Minimum timed duration per benchmark [s].",
+                                         "seconds",
+                                         "0.2");
+
+  const QCommandLineOption minSamplesOption({"n", "min_samples"},
+                                            "Minimum number of samples per benchmark.",
+                                            "samples",
+                                            "30");
+
+  const QCommandLineOption filterOption({"b", "benchmark"},
+                                        "Only run benchmarks with names containing this string.",
+                                        "name");
+
+  const QCommandLineOption linkStreamOption({"ls", "link_stream"},
+                                            "Benchmark the parser on a recorded link data "
+                                            "stream (raw bytes) instead of generated frames.",
+                                            "file");
+
+  const QCommandLineOption writeLinkStreamOption({"wls", "write_link_stream"},
+                                                 "Write the generated data stream for the first "
+                                                 "occupancy and cluster size to a file.",
+                                                 "file");
+
+  const QCommandLineOption outputFileOption({"f", "output_file"},
+                                            "CSV file to write the results to.",
+                                            "file");
+
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addOption(occupancyOption);
+  parser.addOption(clusterSizeOption);
+  parser.addOption(minTimeOption);
+  parser.addOption(minSamplesOption);
+  parser.addOption(filterOption);
+  parser.addOption(linkStreamOption);
+  parser.addOption(writeLinkStreamOption);
+  parser.addOption(outputFileOption);
+
+  parser.process(app);
+
+  std::vector<double> occupancies;
+  std::vector<double> cluster_sizes;
+
+  if(parse_list_option(parser, occupancyOption, occupancies) == false ||
+     parse_list_option(parser, clusterSizeOption, cluster_sizes) == false)
+    return -1;
+
+  MicroBenchmark bench(parser.value(minSamplesOption).toUInt(),
+                       parser.value(minTimeOption).toDouble());
+
+  std::vector<std::pair<std::string, MicroBenchmarkResult>> results;
+
+  if(parser.isSet(writeLinkStreamOption)) {
+    std::vector<uint8_t> stream = encode_frames(generate_frames(occupancies[0], cluster_sizes[0]));
+    std::ofstream stream_file(parser.value(writeLinkStreamOption).toStdString(), std::ios::binary);
+    stream_file.write(reinterpret_cast<const char*>(stream.data()), stream.size());
+  }
+
+  if(parser.isSet(linkStreamOption)) {
+    if(run_stream_benchmark(bench, parser.value(linkStreamOption).toStdString(), results) == false)
+      return -1;
+  } else {
+    for(auto occ_it = occupancies.begin(); occ_it != occupancies.end(); occ_it++) {
+      for(auto cs_it = cluster_sizes.begin(); cs_it != cluster_sizes.end(); cs_it++) {
+        run_pixel_benchmarks(bench, parser.value(filterOption), *occ_it, *cs_it, results);
+      }
+    }
+  }
+
+  std::cout << std::left << std::setw(40) << "benchmark" << std::setw(36) << "parameters";
+  std::cout << std::right << std::setw(8) << "samples" << std::setw(12) << "items";
+  std::cout << std::setw(12) << "median_ns" << std::setw(10) << "mad_ns";
+  std::cout << std::setw(10) << "min_ns" << std::setw(14) << "Mitems/s" << std::endl;
+
+  for(auto it = results.begin(); it != results.end(); it++) {
+    const MicroBenchmarkResult& r = it->second;
+    std::cout << std::left << std::setw(40) << r.name << std::setw(36) << it->first;
+    std::cout << std::right << std::fixed << std::setprecision(1);
+    std::cout << std::setw(8) << r.samples << std::setw(12) << r.items_per_sample;
+    std::cout << std::setprecision(2);
+    std::cout << std::setw(12) << r.median_ns << std::setw(10) << r.mad_ns;
+    std::cout << std::setw(10) << r.min_ns << std::setw(14) << r.items_per_s/1E6 << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+  }
+
+  if(parser.isSet(outputFileOption)) {
+    std::string output_filename = parser.value(outputFileOption).toStdString();
+    std::ofstream output_file(output_filename);
+
+    if(!output_file.is_open()) {
+      std::cout << "Error opening output file " << output_filename << std::endl;
+      return -1;
+    }
+
+    output_file << "benchmark;parameters;samples;items_per_sample;median_ns;mad_ns;min_ns;items_per_s" << std::endl;
+
+    for(auto it = results.begin(); it != results.end(); it++) {
+      const MicroBenchmarkResult& r = it->second;
+      output_file << r.name << ";" << it->first << ";" << r.samples << ";";
+      output_file << r.items_per_sample << ";" << r.median_ns << ";" << r.mad_ns << ";";
+      output_file << r.min_ns << ";" << r.items_per_s << std::endl;
+    }
+  }
+
+  return 0;
+}
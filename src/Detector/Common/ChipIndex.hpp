@@ -0,0 +1,84 @@
+/**
+ * @file   ChipIndex.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Dense lookup of chip objects by global chip id, used to dispatch pixel
+ *         hits to the chips in a detector.
+ *
+ *         The chips are held in a vector indexed by global chip id, with a bitmap
+ *         of the chip ids that are included in the simulation. The bitmap is small
+ *         (3 kB for the full ITS), so the check for chips that are not included
+ *         stays in cache.
+ */
+
+#ifndef CHIP_INDEX_HPP
+#define CHIP_INDEX_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+
+namespace Detector {
+
+  template<class Chip>
+  class ChipIndex {
+    std::vector<Chip*> mChips;
+    std::vector<std::uint64_t> mPresent;
+
+  public:
+    ///@brief Add a chip to the index. The index does not own the chip object.
+    void add(unsigned int chip_id, Chip* chip) {
+      if(chip_id >= mChips.size()) {
+        mChips.resize(chip_id+1, nullptr);
+        mPresent.resize(chip_id/64+1, 0);
+      }
+
+      mChips[chip_id] = chip;
+      mPresent[chip_id/64] |= std::uint64_t(1) << (chip_id%64);
+    }
+
+    bool contains(unsigned int chip_id) const {
+      return chip_id/64 < mPresent.size() && ((mPresent[chip_id/64] >> (chip_id%64)) & 1);
+    }
+
+    ///@return Pointer to chip object, or nullptr if the chip is not in the index
+    Chip* get(unsigned int chip_id) const {
+      return contains(chip_id) ? mChips[chip_id] : nullptr;
+    }
+
+    ///@brief Input pixel hits to the chips' front ends. Each range of consecutive
+    ///       hits for the same chip is passed to the chip in one call, so events
+    ///       should be grouped by chip id (see EventGenBase::groupHitsByChip()).
+    ///       The order of the hits for each chip is kept.
+    ///@param begin Iterator to first hit (pointer to object with getChipId())
+    ///@param end Iterator past the last hit
+    ///@return Number of hits for chips that are not in the index (which are skipped)
+    template<class HitIterator>
+    unsigned int pixelInput(HitIterator begin, HitIterator end) const {
+      unsigned int skipped_hits = 0;
+
+      while(begin != end) {
+        unsigned int chip_id = (*begin)->getChipId();
+        HitIterator range_end = begin;
+
+        while(++range_end != end && (*range_end)->getChipId() == chip_id) {}
+
+        Chip* chip = get(chip_id);
+
+        if(chip != nullptr)
+          chip->pixelFrontEndInput(begin, range_end);
+        else
+          skipped_hits += std::distance(begin, range_end);
+
+        begin = range_end;
+      }
+
+      return skipped_hits;
+    }
+  };
+
+}
+
+
+#endif
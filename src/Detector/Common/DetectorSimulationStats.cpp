@@ -7,6 +7,7 @@
 
 #include "DetectorSimulationStats.hpp"
 #include "DetectorConfig.hpp"
+#include "common/ColumnarWriter.hpp"
 
 #include "TTree.h"
 #include "TFile.h"
@@ -133,6 +134,57 @@ void Detector::writeAlpideStatsToFile(std::string output_path,
     }
   }
 
+  // One row per chip with the final counter values. The rows are only known at the
+  // end of the simulation, unlike the readout units' busy events and data rate
+  // intervals which are appended to the columnar file during the simulation.
+  if(ColumnarWriter::getRunWriter() != nullptr) {
+    static const std::vector<std::string> column_names =
+      {"layer_id", "stave_id", "sub_stave_id", "module_id", "module_chip_id", "global_chip_id",
+       "triggers_received", "triggers_accepted", "triggers_rejected",
+       "busy", "busy_violations", "flushed_incompletes",
+       "latched_pixel_hits", "duplicate_pixel_hits",
+       "ALPIDE_IDLE", "ALPIDE_CHIP_HEADER", "ALPIDE_CHIP_TRAILER",
+       "ALPIDE_CHIP_EMPTY_FRAME", "ALPIDE_REGION_HEADER",
+       "ALPIDE_REGION_TRAILER", "ALPIDE_DATA_SHORT", "ALPIDE_DATA_LONG",
+       "ALPIDE_BUSY_ON", "ALPIDE_BUSY_OFF", "ALPIDE_COMMA", "ALPIDE_UNKNOWN"};
+    static const AlpideDataType data_word_types[] =
+      {ALPIDE_IDLE, ALPIDE_CHIP_HEADER, ALPIDE_CHIP_TRAILER,
+       ALPIDE_CHIP_EMPTY_FRAME, ALPIDE_REGION_HEADER,
+       ALPIDE_REGION_TRAILER, ALPIDE_DATA_SHORT, ALPIDE_DATA_LONG,
+       ALPIDE_BUSY_ON, ALPIDE_BUSY_OFF, ALPIDE_COMMA, ALPIDE_UNKNOWN};
+
+    std::vector<Columnar::ColumnDef> columns;
+    for(auto it = column_names.begin(); it != column_names.end(); it++)
+      columns.push_back({*it, Columnar::COLUMN_UINT64});
+
+    ColumnarTable& table = ColumnarWriter::getRunWriter()->addTable("alpide_stats", columns);
+
+    for(auto const & chip_it : alpide_map) {
+      if(chip_it.second != nullptr) {
+        unsigned int unique_chip_id = chip_it.second->getGlobalChipId();
+        DetectorPosition pos = (*global_chip_id_to_position_func)(unique_chip_id);
+        std::vector<uint64_t> values =
+          {pos.layer_id, pos.stave_id, pos.sub_stave_id, pos.module_id, pos.module_chip_id,
+           unique_chip_id,
+           chip_it.second->getTriggersReceivedCount(),
+           chip_it.second->getTriggersAcceptedCount(),
+           chip_it.second->getTriggersRejectedCount(),
+           chip_it.second->getBusyCount(),
+           chip_it.second->getBusyViolationCount(),
+           chip_it.second->getFlushedIncompleteCount(),
+           chip_it.second->getLatchedPixelHitCount(),
+           chip_it.second->getDuplicatePixelHitCount()};
+
+        for(auto type_it = std::begin(data_word_types); type_it != std::end(data_word_types); type_it++)
+          values.push_back(chip_it.second->getDataWordCount(*type_it));
+
+        for(unsigned int col = 0; col < values.size(); col++)
+          table.append(col, values[col]);
+        table.endRow();
+      }
+    }
+  }
+
   // Writing alpide stats root file
   std::string rootfile_outputpath = output_path + std::string("/AlpideStats.root");
   TFile *rootfile =  new TFile(rootfile_outputpath.c_str(), "RECREATE");
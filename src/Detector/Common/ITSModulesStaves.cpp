@@ -52,6 +52,14 @@ void SingleChip::pixelInput(const std::shared_ptr<PixelHit>& p)
 }
 
 
+///@brief Input all the hits in an event to the Alpide chip
+///@param hits Vector of pixel hits
+void SingleChip::pixelInput(const std::vector<std::shared_ptr<PixelHit>>& hits)
+{
+  mChip->pixelFrontEndInput(hits.begin(), hits.end());
+}
+
+
 ///@brief Add SystemC signals to log in VCD trace file.
 ///@param[in,out] wf Pointer to VCD trace file object
 ///@param[in] name_prefix Name prefix to be added to all the trace names
@@ -70,6 +70,7 @@ namespace ITS {
         return vec;
       }
     void pixelInput(const std::shared_ptr<PixelHit>& p);
+    void pixelInput(const std::vector<std::shared_ptr<PixelHit>>& hits);
 
   private:
     ControlResponsePayload processCommand(ControlRequestPayload const &request);
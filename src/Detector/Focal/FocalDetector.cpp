@@ -11,6 +11,8 @@
 #include "Detector/Focal/FocalDetector.hpp"
 #include "Detector/Common/DetectorSimulationStats.hpp"
 #include "Detector/Focal/Focal_creator.hpp"
+#include "common/Log.hpp"
+#include "common/ProcessProfiler.hpp"
 #include <misc/vcd_trace.hpp>
 
 using namespace Focal;
@@ -187,6 +189,7 @@ void FocalDetector::buildDetector(const FocalDetectorConfig& config,
         }
 
         mChipMap[chip_id] = *chip_it;
+        mChipIndex.add(chip_id, chip_it->get());
         mNumChips++;
       }
     }
@@ -200,11 +203,22 @@ void FocalDetector::buildDetector(const FocalDetectorConfig& config,
 void FocalDetector::pixelInput(const std::shared_ptr<PixelHit>& pix)
 {
   // Does the chip exist in our detector/simulation configuration?
-  if(mChipMap.find(pix->getChipId()) != mChipMap.end()) {
-    mChipMap[pix->getChipId()]->pixelFrontEndInput(pix);
-  } //else {
-  //  std::cout << "Chip " << pix->getChipId() << " does not exist." << std::endl;
-  //}
+  Alpide* chip = mChipIndex.get(pix->getChipId());
+
+  if(chip != nullptr) {
+    chip->pixelFrontEndInput(pix);
+  }
+}
+
+
+///@brief Input the pixel hits for an event to the front ends of the detector's
+///       Alpide chips. Each chip gets its range of hits in one call, so the hits
+///       should be grouped by chip id (see EventGenBase::groupHitsByChip()).
+///       Hits for chips that are not in the detector configuration are skipped.
+///@param hits Vector of pixel hits
+void FocalDetector::pixelInput(const std::vector<std::shared_ptr<PixelHit>>& hits)
+{
+  mChipIndex.pixelInput(hits.begin(), hits.end());
 }
 
 
@@ -219,8 +233,10 @@ void FocalDetector::pixelInput(const std::shared_ptr<PixelHit>& pix)
 void FocalDetector::setPixel(unsigned int chip_id, unsigned int col, unsigned int row)
 {
   // Does the chip exist in our detector/simulation configuration?
-  if(mChipMap.find(chip_id) != mChipMap.end()) {
-    mChipMap[chip_id]->setPixel(col, row);
+  Alpide* chip = mChipIndex.get(chip_id);
+
+  if(chip != nullptr) {
+    chip->setPixel(col, row);
   }
 }
 
@@ -248,8 +264,10 @@ void FocalDetector::setPixel(const Detector::DetectorPosition& pos,
 void FocalDetector::setPixel(const std::shared_ptr<PixelHit>& p)
 {
   // Does the chip exist in our detector/simulation configuration?
-  if(mChipMap.find(p->getChipId()) != mChipMap.end()) {
-    mChipMap[p->getChipId()]->setPixel(p);
+  Alpide* chip = mChipIndex.get(p->getChipId());
+
+  if(chip != nullptr) {
+    chip->setPixel(p);
   }
 }
 
@@ -257,8 +275,10 @@ void FocalDetector::setPixel(const std::shared_ptr<PixelHit>& p)
 ///@brief SystemC METHOD for distributing triggers to all readout units
 void FocalDetector::triggerMethod(void)
 {
+  PROFILE_PROCESS(DETECTOR);
+
   int64_t time_now = sc_time_stamp().value();
-  std::cout << "@ " << time_now << " ns: \tFocal Detector triggered!" << std::endl;
+  LOG(DETECTOR, DEBUG) << "@ " << time_now << " ns: \tFocal Detector triggered!";
 
   for(unsigned int i = 0; i < N_LAYERS; i++) {
     for(auto RU = mReadoutUnits[i].begin(); RU != mReadoutUnits[i].end(); RU++) {
@@ -290,6 +310,35 @@ void FocalDetector::addTraces(sc_trace_file *wf, std::string name_prefix) const
 }
 
 
+///@brief Set up the readout units to write statistics that become final during the
+///       simulation to file while the simulation is running. Should be called before
+///       the end of elaboration. Does nothing if the StatsWriter thread is not enabled.
+///@param[in] output_path Path to simulation output directory
+void FocalDetector::initStatsStreaming(const std::string output_path)
+{
+  for(unsigned int layer = 0; layer < N_LAYERS; layer++) {
+    for(unsigned int stave = 0; stave < mDetectorStaves[layer].size(); stave++){
+      std::stringstream ss;
+      ss << output_path << "/RU_" << layer << "_" << stave;
+
+      mReadoutUnits[layer][stave].setStreamingOutputPath(ss.str());
+    }
+  }
+}
+
+
+///@brief Move the readout units' remaining events to the streaming spill files at the
+///       end of the simulation. Must be called before writeSimulationStats().
+void FocalDetector::finishStatsStreaming(void)
+{
+  for(unsigned int layer = 0; layer < N_LAYERS; layer++) {
+    for(unsigned int stave = 0; stave < mDetectorStaves[layer].size(); stave++){
+      mReadoutUnits[layer][stave].finishStatsStreaming();
+    }
+  }
+}
+
+
 ///@brief Write simulation stats/data to file
 ///@param[in] output_path Path to simulation output directory
 void FocalDetector::writeSimulationStats(const std::string output_path) const
@@ -15,6 +15,7 @@
 #include <memory>
 
 #include "FocalDetectorConfig.hpp"
+#include "Detector/Common/ChipIndex.hpp"
 #include "Detector/Common/ITSModulesStaves.hpp"
 #include "ReadoutUnit/ReadoutUnit.hpp"
 #include <Alpide/PixelHit.hpp>
@@ -33,6 +34,9 @@ namespace Focal {
     /// Key: unique chip id, value: chip pointer
     std::map<unsigned int, std::shared_ptr<Alpide>> mChipMap;
 
+    /// Chips indexed by chip id, for dispatching pixel hits (the chips are owned by mChipMap)
+    Detector::ChipIndex<Alpide> mChipIndex;
+
     sc_vector<sc_vector<ReadoutUnit>> mReadoutUnits;
     sc_vector<sc_vector<ITS::StaveInterface>> mDetectorStaves;
 
@@ -52,12 +56,25 @@ namespace Focal {
                   bool trigger_filter_enable,
                   unsigned int data_rate_interval_ns);
     void pixelInput(const std::shared_ptr<PixelHit>& pix);
+    void pixelInput(const std::vector<std::shared_ptr<PixelHit>>& hits);
     void setPixel(const std::shared_ptr<PixelHit>& p);
     void setPixel(unsigned int chip_id, unsigned int row, unsigned int col);
     void setPixel(const Detector::DetectorPosition& pos,
                   unsigned int row, unsigned int col);
     unsigned int getNumChips(void) const { return mNumChips; }
+    const std::map<unsigned int, std::shared_ptr<Alpide>>& getChipMap(void) const {
+      return mChipMap;
+    }
+    std::vector<const ReadoutUnit*> getReadoutUnits(void) const {
+      std::vector<const ReadoutUnit*> readout_units;
+      for(unsigned int i = 0; i < mReadoutUnits.size(); i++)
+        for(unsigned int j = 0; j < mReadoutUnits[i].size(); j++)
+          readout_units.push_back(&mReadoutUnits[i][j]);
+      return readout_units;
+    }
     void addTraces(sc_trace_file *wf, std::string name_prefix) const;
+    void initStatsStreaming(const std::string output_path);
+    void finishStatsStreaming(void);
     void writeSimulationStats(const std::string output_path) const;
   };
 
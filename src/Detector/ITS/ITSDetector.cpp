@@ -11,6 +11,8 @@
 #include "Detector/ITS/ITSDetector.hpp"
 #include "Detector/Common/DetectorSimulationStats.hpp"
 #include "Detector/ITS/ITS_creator.hpp"
+#include "common/Log.hpp"
+#include "common/ProcessProfiler.hpp"
 #include <misc/vcd_trace.hpp>
 
 using namespace ITS;
@@ -172,6 +174,7 @@ void ITSDetector::buildDetector(const ITSDetectorConfig& config,
         }
 
         mChipMap[chip_id] = *chip_it;
+        mChipIndex.add(chip_id, chip_it->get());
         mNumChips++;
       }
     }
@@ -185,14 +188,30 @@ void ITSDetector::buildDetector(const ITSDetectorConfig& config,
 void ITSDetector::pixelInput(const std::shared_ptr<PixelHit>& pix)
 {
   // Does the chip exist in our detector/simulation configuration?
-  if(mChipMap.find(pix->getChipId()) != mChipMap.end()) {
-    mChipMap[pix->getChipId()]->pixelFrontEndInput(pix);
+  Alpide* chip = mChipIndex.get(pix->getChipId());
+
+  if(chip != nullptr) {
+    chip->pixelFrontEndInput(pix);
   } else {
     std::cout << "Chip " << pix->getChipId() << " does not exist." << std::endl;
   }
 }
 
 
+///@brief Input the pixel hits for an event to the front ends of the detector's
+///       Alpide chips. Each chip gets its range of hits in one call, so the hits
+///       should be grouped by chip id (see EventGenBase::groupHitsByChip()).
+///       Hits for chips that are not in the detector configuration are skipped.
+///@param hits Vector of pixel hits
+void ITSDetector::pixelInput(const std::vector<std::shared_ptr<PixelHit>>& hits)
+{
+  unsigned int skipped_hits = mChipIndex.pixelInput(hits.begin(), hits.end());
+
+  if(skipped_hits > 0)
+    std::cout << skipped_hits << " pixel hits for chips that do not exist." << std::endl;
+}
+
+
 ///@brief Set a pixel in one of the detector's Alpide chip's (if it exists in the
 ///       detector configuration).
 ///       This function will call the chip object's setPixel() function, which directly sets
@@ -204,8 +223,10 @@ void ITSDetector::pixelInput(const std::shared_ptr<PixelHit>& pix)
 void ITSDetector::setPixel(unsigned int chip_id, unsigned int col, unsigned int row)
 {
   // Does the chip exist in our detector/simulation configuration?
-  if(mChipMap.find(chip_id) != mChipMap.end()) {
-    mChipMap[chip_id]->setPixel(col, row);
+  Alpide* chip = mChipIndex.get(chip_id);
+
+  if(chip != nullptr) {
+    chip->setPixel(col, row);
   }
 }
 
@@ -233,8 +254,10 @@ void ITSDetector::setPixel(const Detector::DetectorPosition& pos,
 void ITSDetector::setPixel(const std::shared_ptr<PixelHit>& p)
 {
   // Does the chip exist in our detector/simulation configuration?
-  if(mChipMap.find(p->getChipId()) != mChipMap.end()) {
-    mChipMap[p->getChipId()]->setPixel(p);
+  Alpide* chip = mChipIndex.get(p->getChipId());
+
+  if(chip != nullptr) {
+    chip->setPixel(p);
   }
 }
 
@@ -242,8 +265,10 @@ void ITSDetector::setPixel(const std::shared_ptr<PixelHit>& p)
 ///@brief SystemC METHOD for distributing triggers to all readout units
 void ITSDetector::triggerMethod(void)
 {
+  PROFILE_PROCESS(DETECTOR);
+
   int64_t time_now = sc_time_stamp().value();
-  std::cout << "@ " << time_now << " ns: \tITS Detector triggered!" << std::endl;
+  LOG(DETECTOR, DEBUG) << "@ " << time_now << " ns: \tITS Detector triggered!";
 
   for(unsigned int i = 0; i < N_LAYERS; i++) {
     for(auto RU = mReadoutUnits[i].begin(); RU != mReadoutUnits[i].end(); RU++) {
@@ -275,6 +300,35 @@ void ITSDetector::addTraces(sc_trace_file *wf, std::string name_prefix) const
 }
 
 
+///@brief Set up the readout units to write statistics that become final during the
+///       simulation to file while the simulation is running. Should be called before
+///       the end of elaboration. Does nothing if the StatsWriter thread is not enabled.
+///@param[in] output_path Path to simulation output directory
+void ITSDetector::initStatsStreaming(const std::string output_path)
+{
+  for(unsigned int layer = 0; layer < N_LAYERS; layer++) {
+    for(unsigned int stave = 0; stave < mDetectorStaves[layer].size(); stave++){
+      std::stringstream ss;
+      ss << output_path << "/RU_" << layer << "_" << stave;
+
+      mReadoutUnits[layer][stave].setStreamingOutputPath(ss.str());
+    }
+  }
+}
+
+
+///@brief Move the readout units' remaining events to the streaming spill files at the
+///       end of the simulation. Must be called before writeSimulationStats().
+void ITSDetector::finishStatsStreaming(void)
+{
+  for(unsigned int layer = 0; layer < N_LAYERS; layer++) {
+    for(unsigned int stave = 0; stave < mDetectorStaves[layer].size(); stave++){
+      mReadoutUnits[layer][stave].finishStatsStreaming();
+    }
+  }
+}
+
+
 ///@brief Write simulation stats/data to file
 ///@param[in] output_path Path to simulation output directory
 void ITSDetector::writeSimulationStats(const std::string output_path) const
@@ -0,0 +1,607 @@
+/**
+ * @file   BusyEstimator.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Analytic (queueing model) estimate of Multi Event Buffer occupancy,
+ *         busy probability and trigger efficiency for an Alpide chip.
+ *         See BusyEstimator.hpp for a description of the model and its approximations.
+ */
+
+#include "BusyEstimator.hpp"
+#include "Alpide/alpide_constants.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+///@brief Period of the 40 MHz clock, which is the time unit used in the queue models
+static const double c_clock_period_ns = 25.0;
+
+///@brief Clock cycles from the last pixel has been read out from the matrix until
+///       the region readout is done, and the MEB is freed
+static const unsigned int c_matrix_readout_overhead_cycles = 2;
+
+///@brief Number of Multi Event Buffers in the chip
+static const unsigned int c_num_mebs = 3;
+
+///@brief Maximum number of time bins per strobe period in the periodic Markov chain
+static const unsigned int c_periodic_bins_per_period = 64;
+
+///@brief Service times longer than this number of strobe periods are truncated in the
+///       periodic Markov chain. The chip is saturated long before this anyway.
+static const unsigned int c_periodic_max_service_periods = 16;
+
+static const unsigned int c_periodic_max_iterations = 20000;
+static const double c_periodic_tolerance = 1E-12;
+
+
+///@brief Poisson probability mass function, calculated in log space to
+///       avoid overflow for large means
+static double poisson_pmf(unsigned int k, double mean)
+{
+  if(mean <= 0)
+    return k == 0 ? 1.0 : 0.0;
+
+  return std::exp(k*std::log(mean) - mean - std::lgamma(k+1.0));
+}
+
+
+///@brief Mean value of a probability mass function, index is the value
+static double pmf_mean(const std::vector<double>& pmf)
+{
+  double mean = 0.0;
+  for(unsigned int i = 0; i < pmf.size(); i++)
+    mean += i*pmf[i];
+  return mean;
+}
+
+
+///@brief Constructor for BusyEstimator. Calculates the hit and readout time distributions
+///       for the configuration, but does not solve the queue models (see estimate()).
+///@param[in] config Configuration for chip and event/trigger rates
+///@throw runtime_error If the configuration is invalid
+BusyEstimator::BusyEstimator(const BusyEstimatorConfig& config)
+  : mConfig(config)
+{
+  if(mConfig.average_event_rate_ns == 0)
+    throw std::runtime_error("Busy estimator: average event rate must be larger than zero.");
+
+  if(mConfig.system_continuous_mode && mConfig.system_continuous_period_ns == 0)
+    throw std::runtime_error("Busy estimator: system continuous period must be larger than zero.");
+
+  if(mConfig.cluster_size <= 0 || mConfig.hits_per_event < 0)
+    throw std::runtime_error("Busy estimator: invalid cluster size or hits per event.");
+
+  if(mConfig.chips_per_link == 0 || mConfig.link_bytes_per_cycle == 0)
+    throw std::runtime_error("Busy estimator: invalid data link configuration.");
+
+  if(mConfig.system_continuous_mode &&
+     mConfig.chip_cfg.strobe_length_ns > mConfig.system_continuous_period_ns)
+    throw std::runtime_error("Busy estimator: strobe length > system continuous period.");
+
+  mEventRate = c_clock_period_ns / mConfig.average_event_rate_ns;
+
+  if(mConfig.system_continuous_mode) {
+    mStrobeRate = c_clock_period_ns / mConfig.system_continuous_period_ns;
+  } else if(mConfig.trigger_filter_enable) {
+    // Triggers arriving within the filter time of the previous
+    // (accepted) trigger are filtered away. Non-paralyzable dead time.
+    double filter_time_cycles = mConfig.trigger_filter_time_ns / c_clock_period_ns;
+    mStrobeRate = mEventRate / (1.0 + mEventRate*filter_time_cycles);
+  } else {
+    mStrobeRate = mEventRate;
+  }
+
+  // A frame contains the hits from events that occured within the shaping active
+  // time before, or during, the strobe. In triggered mode the event that caused the
+  // trigger is always included.
+  double frame_window_cycles = (mConfig.pixel_shaping_active_time_ns +
+                                mConfig.chip_cfg.strobe_length_ns) / c_clock_period_ns;
+
+  double events_per_frame = mEventRate * frame_window_cycles;
+
+  if(mConfig.system_continuous_mode == false)
+    events_per_frame += 1.0;
+
+  mMeanHitsPerFrame = mConfig.hits_per_event * events_per_frame;
+
+  calcReadoutTimeDistributions();
+
+  if(mConfig.readout_time_histo_ns.empty() == false)
+    calcMeasuredReadoutTimeDistribution();
+}
+
+
+///@brief Expected number of hits in the region with most hits, when the hits
+///       are distributed uniformly over the regions.
+///@param[in] hits Number of hits (clusters) in the frame
+double BusyEstimator::getMaxRegionHitsMean(double hits) const
+{
+  if(hits <= 0)
+    return 0.0;
+
+  double region_mean = hits / N_REGIONS;
+  double max_mean = 0.0;
+  double cdf = 0.0;
+
+  // Upper limit for k, the probability of any region having more hits is negligible
+  unsigned int k_max = std::ceil(region_mean + 20*std::sqrt(region_mean) + 20);
+
+  // E[max] = sum over k >= 0 of P(max > k) = sum of 1 - F(k)^N_REGIONS
+  for(unsigned int k = 0; k < k_max; k++) {
+    cdf += poisson_pmf(k, region_mean);
+    double p_max_above = 1.0 - std::pow(std::min(cdf, 1.0), N_REGIONS);
+
+    if(p_max_above < 1E-12)
+      break;
+
+    max_mean += p_max_above;
+  }
+
+  return max_mean;
+}
+
+
+///@brief Number of bytes transmitted by the chip for a frame with a given number of hits.
+///       Idle and busy words are not included.
+double BusyEstimator::getFrameBytes(double hits) const
+{
+  if(hits <= 0)
+    return 2.0; // CHIP_EMPTY_FRAME
+
+  double regions_with_hits = N_REGIONS*(1.0 - std::pow(1.0 - 1.0/N_REGIONS, hits));
+  double cluster_bytes;
+
+  if(mConfig.chip_cfg.data_long_en && mConfig.cluster_size >= 2) {
+    // A 2x2 cluster fits in one DATA_LONG word if it is within one double column,
+    // and needs two words when it spans two double columns. Average is 1.5 words.
+    cluster_bytes = 3 * 1.5 * std::max(1.0, mConfig.cluster_size/4);
+  } else {
+    cluster_bytes = 2 * mConfig.cluster_size;
+  }
+
+  // CHIP_HEADER + CHIP_TRAILER + REGION_HEADERs + data words
+  return 2 + 1 + regions_with_hits + hits*cluster_bytes;
+}
+
+
+///@brief Calculate the distributions of matrix readout time and data link transmission time,
+///       based on a Poisson distributed number of hits in each frame.
+void BusyEstimator::calcReadoutTimeDistributions(void)
+{
+  double pe_cycles = mConfig.chip_cfg.matrix_readout_speed ? 2 : 4;
+  unsigned int max_hits = std::ceil(mMeanHitsPerFrame + 10*std::sqrt(mMeanHitsPerFrame) + 10);
+  double total_prob = 0.0;
+
+  mReadoutTimePmf.clear();
+  mLinkTimePmf.clear();
+  mMeanPixelsPerFrame = 0.0;
+  mMeanBytesPerFrame = 0.0;
+
+  for(unsigned int hits = 0; hits <= max_hits; hits++) {
+    double prob = poisson_pmf(hits, mMeanHitsPerFrame);
+
+    double max_region_pixels = getMaxRegionHitsMean(hits) * mConfig.cluster_size;
+    unsigned int readout_cycles = std::round(pe_cycles * max_region_pixels) +
+                                  c_matrix_readout_overhead_cycles;
+
+    double bytes = getFrameBytes(hits);
+    unsigned int link_cycles = std::ceil(bytes * mConfig.chips_per_link /
+                                         mConfig.link_bytes_per_cycle);
+
+    if(mReadoutTimePmf.size() <= readout_cycles)
+      mReadoutTimePmf.resize(readout_cycles+1, 0.0);
+    if(mLinkTimePmf.size() <= link_cycles)
+      mLinkTimePmf.resize(link_cycles+1, 0.0);
+
+    mReadoutTimePmf[readout_cycles] += prob;
+    mLinkTimePmf[link_cycles] += prob;
+    mMeanPixelsPerFrame += prob * hits * mConfig.cluster_size;
+    mMeanBytesPerFrame += prob * bytes;
+    total_prob += prob;
+  }
+
+  // Normalize to account for the truncated tail of the Poisson distribution
+  for(auto it = mReadoutTimePmf.begin(); it != mReadoutTimePmf.end(); it++)
+    *it /= total_prob;
+  for(auto it = mLinkTimePmf.begin(); it != mLinkTimePmf.end(); it++)
+    *it /= total_prob;
+
+  mMeanPixelsPerFrame /= total_prob;
+  mMeanBytesPerFrame /= total_prob;
+}
+
+
+///@brief Replace the analytic matrix readout time distribution with the measured
+///       readout time histogram from the configuration.
+///@throw runtime_error If the histogram is empty (zero counts)
+void BusyEstimator::calcMeasuredReadoutTimeDistribution(void)
+{
+  double total_counts = 0.0;
+
+  mReadoutTimePmf.clear();
+
+  for(auto it = mConfig.readout_time_histo_ns.begin(); it != mConfig.readout_time_histo_ns.end(); it++) {
+    unsigned int cycles = std::max(1.0, std::round(it->first / c_clock_period_ns));
+
+    if(mReadoutTimePmf.size() <= cycles)
+      mReadoutTimePmf.resize(cycles+1, 0.0);
+
+    mReadoutTimePmf[cycles] += it->second;
+    total_counts += it->second;
+  }
+
+  if(total_counts <= 0)
+    throw std::runtime_error("Busy estimator: measured readout time histogram has no counts.");
+
+  for(auto it = mReadoutTimePmf.begin(); it != mReadoutTimePmf.end(); it++)
+    *it /= total_counts;
+}
+
+
+///@brief Solve the M/G/1/K queue with exceptional first service, using the embedded
+///       Markov chain at departure epochs.
+///@param[in] arrival_rate Poisson arrival rate, per time unit
+///@param[in] first_service_pmf Service time pmf for a customer that arrives to an empty queue
+///@param[in] service_pmf Service time pmf for the other customers
+///@param[in] K Capacity of the queue, including the customer in service
+///@return Time-averaged probability of having 0 to K customers in the queue (K+1 values).
+///        Since the arrivals are Poisson, this is also the distribution seen by arrivals,
+///        and the last value is the blocking probability.
+///@throw runtime_error If K is zero
+std::vector<double> BusyEstimator::solveMG1K(double arrival_rate,
+                                             const std::vector<double>& first_service_pmf,
+                                             const std::vector<double>& service_pmf,
+                                             unsigned int K)
+{
+  if(K == 0)
+    throw std::runtime_error("Busy estimator: queue capacity must be larger than zero.");
+
+  std::vector<double> occupancy(K+1, 0.0);
+
+  if(arrival_rate <= 0) {
+    occupancy[0] = 1.0;
+    return occupancy;
+  }
+
+  // a[j]/b[j]: probability of j arrivals during a (first) service time
+  std::vector<double> a(K, 0.0);
+  std::vector<double> b(K, 0.0);
+
+  for(unsigned int t = 0; t < service_pmf.size(); t++) {
+    if(service_pmf[t] > 0) {
+      double p = std::exp(-arrival_rate*t);
+      for(unsigned int j = 0; j < K; j++) {
+        a[j] += service_pmf[t] * p;
+        p *= arrival_rate*t/(j+1);
+      }
+    }
+  }
+
+  for(unsigned int t = 0; t < first_service_pmf.size(); t++) {
+    if(first_service_pmf[t] > 0) {
+      double p = std::exp(-arrival_rate*t);
+      for(unsigned int j = 0; j < K; j++) {
+        b[j] += first_service_pmf[t] * p;
+        p *= arrival_rate*t/(j+1);
+      }
+    }
+  }
+
+  // Transition matrix for number of customers left behind at departures (0 to K-1).
+  // Arrivals that find the queue full are lost, which is handled by lumping the tail
+  // of the arrival distribution into the last state.
+  std::vector<std::vector<double>> P(K, std::vector<double>(K, 0.0));
+
+  for(unsigned int i = 0; i < K; i++) {
+    const std::vector<double>& arrivals = (i == 0) ? b : a;
+    unsigned int min_j = (i == 0) ? 0 : i-1;
+    double row_sum = 0.0;
+
+    for(unsigned int j = min_j; j < K-1; j++) {
+      P[i][j] = arrivals[j-min_j];
+      row_sum += P[i][j];
+    }
+    P[i][K-1] = std::max(0.0, 1.0 - row_sum);
+  }
+
+  // Solve pi = pi*P with sum(pi) = 1. Set up as A*pi = rhs, where A = P^T - I,
+  // and the last equation is replaced by the normalization condition.
+  std::vector<std::vector<double>> A(K, std::vector<double>(K+1, 0.0));
+
+  for(unsigned int i = 0; i < K; i++) {
+    for(unsigned int j = 0; j < K; j++)
+      A[i][j] = P[j][i] - (i == j ? 1.0 : 0.0);
+  }
+  for(unsigned int j = 0; j < K; j++)
+    A[K-1][j] = 1.0;
+  A[K-1][K] = 1.0;
+
+  // Gaussian elimination with partial pivoting
+  for(unsigned int col = 0; col < K; col++) {
+    unsigned int pivot = col;
+    for(unsigned int row = col+1; row < K; row++) {
+      if(std::fabs(A[row][col]) > std::fabs(A[pivot][col]))
+        pivot = row;
+    }
+    std::swap(A[col], A[pivot]);
+
+    if(A[col][col] == 0.0)
+      continue;
+
+    for(unsigned int row = 0; row < K; row++) {
+      if(row != col && A[row][col] != 0.0) {
+        double factor = A[row][col] / A[col][col];
+        for(unsigned int j = col; j <= K; j++)
+          A[row][j] -= factor*A[col][j];
+      }
+    }
+  }
+
+  std::vector<double> pi(K, 0.0);
+  for(unsigned int i = 0; i < K; i++)
+    pi[i] = (A[i][i] != 0.0) ? std::max(0.0, A[i][K]/A[i][i]) : 0.0;
+
+  // Mean time between departures gives the throughput, and the
+  // blocking probability follows from throughput = rate*(1-P_block)
+  double mean_interdeparture = pi[0]*(1.0/arrival_rate + pmf_mean(first_service_pmf)) +
+                               (1.0-pi[0])*pmf_mean(service_pmf);
+
+  double p_block = std::max(0.0, 1.0 - 1.0/(arrival_rate*mean_interdeparture));
+
+  for(unsigned int j = 0; j < K; j++)
+    occupancy[j] = pi[j]*(1.0-p_block);
+  occupancy[K] = p_block;
+
+  return occupancy;
+}
+
+
+///@brief Solve a queue with periodic arrivals (strobes), using a discrete time Markov chain
+///       where the state is the number of frames in the queue and the remaining service
+///       time of the frame being read out. The chain is iterated one strobe period at a
+///       time until the distribution at the strobe epochs has converged.
+///@param[in] period Strobe period, in time units (clock cycles)
+///@param[in] strobe_length Strobe length. The readout of a frame can not start before
+///           the end of its strobe.
+///@param[in] service_pmf Readout time pmf
+///@param[in] K Capacity of the queue (number of MEBs)
+///@param[in] flush_oldest If true the oldest frame is flushed when a strobe arrives with
+///           K-1 frames in the queue (Alpide continuous mode). A flushed frame is removed
+///           (almost) immediately, but occupies its buffer until then.
+///@return Distribution at strobe epochs, time-averaged distribution, and fraction of strobes
+///        that were rejected or caused a flush.
+///@throw runtime_error If period or K is zero
+PeriodicQueueResult BusyEstimator::solvePeriodic(unsigned int period,
+                                                 unsigned int strobe_length,
+                                                 const std::vector<double>& service_pmf,
+                                                 unsigned int K,
+                                                 bool flush_oldest)
+{
+  if(period == 0 || K == 0)
+    throw std::runtime_error("Busy estimator: strobe period and queue capacity must be larger than zero.");
+
+  // Use coarser time bins for long periods to keep the state space small
+  unsigned int bin_size = std::max(1.0, std::ceil(double(period)/c_periodic_bins_per_period));
+  unsigned int period_bins = std::max(1.0, std::round(double(period)/bin_size));
+  unsigned int strobe_bins = std::round(double(strobe_length)/bin_size);
+  unsigned int max_service_bins = c_periodic_max_service_periods*period_bins;
+
+  std::vector<double> service(2, 0.0);
+  for(unsigned int t = 0; t < service_pmf.size(); t++) {
+    if(service_pmf[t] > 0) {
+      unsigned int bin = std::max(1.0, std::round(double(t)/bin_size));
+      bin = std::min(bin, max_service_bins);
+      if(service.size() <= bin)
+        service.resize(bin+1, 0.0);
+      service[bin] += service_pmf[t];
+    }
+  }
+
+  // Residual service time, 0 means no frame in service
+  unsigned int R = strobe_bins + service.size();
+  std::vector<double> state((K+1)*R, 0.0);
+  std::vector<double> next((K+1)*R, 0.0);
+  std::vector<double> start;
+  std::vector<double> epoch(K+1, 0.0);
+  std::vector<double> time_occ(K+1, 0.0);
+
+  state[0] = 1.0;
+
+  for(unsigned int iteration = 0; iteration < c_periodic_max_iterations; iteration++) {
+    start = state;
+    std::fill(next.begin(), next.end(), 0.0);
+    std::fill(epoch.begin(), epoch.end(), 0.0);
+    std::fill(time_occ.begin(), time_occ.end(), 0.0);
+
+    // Strobe arrives
+    for(unsigned int x = 0; x <= K; x++) {
+      for(unsigned int r = 0; r < R; r++) {
+        double m = state[x*R+r];
+        if(m == 0.0)
+          continue;
+
+        epoch[x] += m;
+
+        if(x == K) {
+          next[x*R+r] += m;  // Rejected
+        } else if(flush_oldest && x > 0 && x == K-1) {
+          next[(x+1)*R+1] += m;  // Oldest frame flushed, read out right away
+        } else if(x == 0) {
+          for(unsigned int s = 1; s < service.size(); s++)
+            next[1*R + strobe_bins + s] += m*service[s];
+        } else {
+          next[(x+1)*R+r] += m;
+        }
+      }
+    }
+    std::swap(state, next);
+
+    // Readout during the strobe period
+    for(unsigned int bin = 0; bin < period_bins; bin++) {
+      std::fill(next.begin(), next.end(), 0.0);
+
+      next[0] = state[0];
+      time_occ[0] += state[0];
+
+      for(unsigned int x = 1; x <= K; x++) {
+        double completed = state[x*R+1];
+
+        for(unsigned int r = 1; r < R; r++) {
+          time_occ[x] += state[x*R+r];
+          if(r > 1)
+            next[x*R+r-1] += state[x*R+r];
+        }
+
+        if(completed > 0.0) {
+          if(x == 1) {
+            next[0] += completed;
+          } else {
+            // When only the frame from the current strobe is left, its
+            // readout can not start before the strobe has ended
+            unsigned int wait = (x == 2 && bin < strobe_bins) ? strobe_bins-bin : 0;
+
+            for(unsigned int s = 1; s < service.size(); s++)
+              next[(x-1)*R+wait+s] += completed*service[s];
+          }
+        }
+      }
+      std::swap(state, next);
+    }
+
+    // Average with the state at the start of the period. This has the same stationary
+    // distribution, but also converges when the chain is periodic (e.g. constant readout time)
+    double diff = 0.0;
+    for(unsigned int i = 0; i < state.size(); i++) {
+      diff += std::fabs(state[i]-start[i]);
+      state[i] = 0.5*(state[i]+start[i]);
+    }
+
+    if(diff < c_periodic_tolerance)
+      break;
+  }
+
+  PeriodicQueueResult result;
+  result.epoch_occupancy = epoch;
+  result.time_occupancy = time_occ;
+
+  for(auto it = result.time_occupancy.begin(); it != result.time_occupancy.end(); it++)
+    *it /= period_bins;
+
+  result.reject_prob = epoch[K];
+  result.flush_prob = (flush_oldest && K > 1) ? epoch[K-1] : 0.0;
+
+  return result;
+}
+
+
+///@brief Estimate MEB occupancy, busy probability and efficiency for the configuration
+BusyEstimate BusyEstimator::estimate(void) const
+{
+  BusyEstimate est;
+
+  est.trigger_rate_mhz = mStrobeRate * 1000.0 / c_clock_period_ns;
+  est.mean_hits_per_frame = mMeanHitsPerFrame;
+  est.mean_pixels_per_frame = mMeanPixelsPerFrame;
+  est.mean_bytes_per_frame = mMeanBytesPerFrame;
+  est.mean_readout_time_ns = pmf_mean(mReadoutTimePmf) * c_clock_period_ns;
+
+  unsigned int strobe_cycles = std::round(mConfig.chip_cfg.strobe_length_ns / c_clock_period_ns);
+
+  double meb_reject_prob;
+  double meb_busy_prob;
+
+  if(mConfig.system_continuous_mode == false && mConfig.chip_cfg.chip_continuous_mode == false) {
+    // Random triggers, and chip in triggered mode: M/G/1/K queue. The first frame after
+    // the chip has been idle is delayed by the strobe before readout starts.
+    std::vector<double> first_service_pmf(strobe_cycles, 0.0);
+    first_service_pmf.insert(first_service_pmf.end(), mReadoutTimePmf.begin(), mReadoutTimePmf.end());
+
+    est.meb_occupancy = solveMG1K(mStrobeRate, first_service_pmf, mReadoutTimePmf, c_num_mebs);
+    est.flush_prob = 0.0;
+    meb_reject_prob = est.meb_occupancy[c_num_mebs];
+    meb_busy_prob = est.meb_occupancy[c_num_mebs];
+  } else {
+    // Periodic strobes. With random triggers and the chip in continuous mode,
+    // the triggers are approximated as periodic with the same average rate.
+    unsigned int period = mConfig.system_continuous_mode ?
+      std::round(mConfig.system_continuous_period_ns / c_clock_period_ns) :
+      std::round(1.0 / mStrobeRate);
+
+    PeriodicQueueResult result = solvePeriodic(std::max(period, 1u), strobe_cycles,
+                                               mReadoutTimePmf, c_num_mebs,
+                                               mConfig.chip_cfg.chip_continuous_mode);
+
+    est.meb_occupancy = result.epoch_occupancy;
+    est.flush_prob = result.flush_prob;
+    meb_reject_prob = result.reject_prob;
+
+    // The chip signals busy when more than one MEB is in use in continuous mode,
+    // and when all MEBs are in use in triggered mode.
+    if(mConfig.chip_cfg.chip_continuous_mode)
+      meb_busy_prob = result.time_occupancy[c_num_mebs-1] + result.time_occupancy[c_num_mebs];
+    else
+      meb_busy_prob = result.time_occupancy[c_num_mebs];
+  }
+
+  double frame_rate = mStrobeRate * (1.0 - meb_reject_prob);
+
+  std::vector<double> fifo_occupancy = solveMG1K(frame_rate, mLinkTimePmf, mLinkTimePmf,
+                                                 TRU_FRAME_FIFO_ALMOST_FULL1);
+
+  est.frame_fifo_busy_prob = fifo_occupancy[TRU_FRAME_FIFO_ALMOST_FULL1];
+
+  // Strobes are rejected when the frame FIFO is above ALMOST_FULL1, in which
+  // case they do not cause a flush either
+  est.busy_violation_prob = 1.0 - (1.0-meb_reject_prob)*(1.0-est.frame_fifo_busy_prob);
+  est.flush_prob *= 1.0-est.frame_fifo_busy_prob;
+  est.busy_prob = 1.0 - (1.0-meb_busy_prob)*(1.0-est.frame_fifo_busy_prob);
+  est.trigger_efficiency = 1.0 - est.busy_violation_prob - est.flush_prob;
+
+  est.link_utilization = frame_rate * mMeanBytesPerFrame * mConfig.chips_per_link /
+    mConfig.link_bytes_per_cycle;
+
+  return est;
+}
+
+
+///@brief Read a histogram of readout times from file. Each line holds a readout time in
+///       nanoseconds and the number of counts, separated by semicolon, comma or whitespace.
+///       Empty lines and lines starting with # are ignored.
+///@param[in] filename Path to histogram file
+///@return Map with readout time (ns) as key and counts as value
+///@throw runtime_error If the file can not be opened, or a line can not be parsed
+std::map<unsigned int, double> BusyEstimator::readHistogramFile(const std::string& filename)
+{
+  std::ifstream file(filename);
+
+  if(!file.is_open())
+    throw std::runtime_error("Busy estimator: error opening readout time histogram file " + filename);
+
+  std::map<unsigned int, double> histo;
+  std::string line;
+  unsigned int line_num = 0;
+
+  while(std::getline(file, line)) {
+    line_num++;
+
+    std::replace(line.begin(), line.end(), ';', ' ');
+    std::replace(line.begin(), line.end(), ',', ' ');
+
+    std::istringstream line_stream(line);
+    double time_ns, counts;
+
+    if(line.find_first_not_of(" \t\r") == std::string::npos || line[line.find_first_not_of(" \t")] == '#')
+      continue;
+
+    if(!(line_stream >> time_ns >> counts) || time_ns < 0 || counts < 0) {
+      throw std::runtime_error("Busy estimator: error parsing line " + std::to_string(line_num) +
+                               " in readout time histogram file " + filename);
+    }
+
+    histo[std::round(time_ns)] += counts;
+  }
+
+  return histo;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file   BusyEstimator.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Analytic (queueing model) estimate of Multi Event Buffer occupancy,
+ *         busy probability and trigger efficiency for an Alpide chip.
+ *
+ *         The estimator is meant for quick first-pass design questions, where a
+ *         full simulation of a sweep would take too long. It uses the same
+ *         AlpideConfig and settings as the simulation, but replaces the cycle
+ *         accurate chip model with two queues:
+ *
+ *         - The Multi Event Buffers (MEBs), with 3 places. A frame occupies a MEB
+ *           from the start of its strobe until the matrix readout of the frame
+ *           is done. In triggered mode this is solved as an M/G/1/K queue, in
+ *           continuous mode (and with periodic strobes) as a discrete time Markov
+ *           chain over one strobe period, which includes the flushing of the
+ *           oldest frame when the chip is about to run out of MEBs.
+ *         - The TRU frame FIFO, which is filled at the rate of accepted frames and
+ *           emptied at the data link rate. The chip is busy when the FIFO is above
+ *           the ALMOST_FULL1 watermark, which is approximated as the blocking
+ *           probability of an M/G/1/K queue with K = ALMOST_FULL1.
+ *
+ *         The main approximations are:
+ *         - Number of particle hits in a frame is Poisson distributed
+ *           (the simulation uses a wider multiplicity distribution).
+ *         - Matrix readout time is given by the expected number of pixels in
+ *           the region with most pixels, read out at one pixel per priority encoder
+ *           cycle. Backpressure from full region FIFOs is ignored.
+ *         - In triggered mode, the strobe of a queued frame is assumed to be over
+ *           by the time its readout can start, only a frame arriving to an empty
+ *           chip has to wait for its strobe before readout starts.
+ *         - The link bandwidth of an outer barrel link is divided evenly between
+ *           the chips sharing the link.
+ *         - MEB and frame FIFO are independent when combining their busy probabilities.
+ */
+
+#ifndef BUSY_ESTIMATOR_HPP
+#define BUSY_ESTIMATOR_HPP
+
+#include "Alpide/AlpideConfig.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+
+struct BusyEstimatorConfig {
+  AlpideConfig chip_cfg;
+
+  ///@brief Periodic strobes (system continuous mode), or one strobe per (filtered) event
+  bool system_continuous_mode;
+  unsigned int system_continuous_period_ns;
+
+  unsigned int average_event_rate_ns;
+  bool trigger_filter_enable;
+  unsigned int trigger_filter_time_ns;
+  unsigned int pixel_shaping_active_time_ns;
+
+  ///@brief Mean number of particle hits (pixel clusters) per event on one chip
+  double hits_per_event;
+
+  ///@brief Mean number of pixels per particle hit
+  double cluster_size;
+
+  ///@brief Number of chips sharing a data link (1 for IB, 7 for OB)
+  unsigned int chips_per_link;
+
+  ///@brief Data link capacity in bytes per 40 MHz clock cycle (3 for IB, 1 for OB)
+  unsigned int link_bytes_per_cycle;
+
+  ///@brief Optional measured histogram of frame readout times, key is readout time
+  ///       in nanoseconds and value is number of counts. The analytic readout time
+  ///       model is used when this is empty.
+  std::map<unsigned int, double> readout_time_histo_ns;
+};
+
+
+struct BusyEstimate {
+  ///@brief Strobes received by the chip per microsecond (after trigger filtering)
+  double trigger_rate_mhz;
+
+  double mean_hits_per_frame;
+  double mean_pixels_per_frame;
+  double mean_readout_time_ns;
+  double mean_bytes_per_frame;
+
+  ///@brief Probability of 0, 1, 2 and 3 MEBs being in use when a strobe arrives
+  std::vector<double> meb_occupancy;
+
+  ///@brief Fraction of time the chip is busy (MEBs or frame FIFO)
+  double busy_prob;
+
+  ///@brief Fraction of strobes that are rejected (busy violations)
+  double busy_violation_prob;
+
+  ///@brief Fraction of strobes that cause the oldest frame to be flushed (continuous mode)
+  double flush_prob;
+
+  ///@brief Probability that the frame FIFO is above the ALMOST_FULL1 watermark
+  double frame_fifo_busy_prob;
+
+  ///@brief Fraction of strobes that result in a frame that is read out completely
+  double trigger_efficiency;
+
+  ///@brief Data link load (can be larger than 1 if the link is oversubscribed)
+  double link_utilization;
+};
+
+
+///@brief Result from the periodic strobe Markov chain
+struct PeriodicQueueResult {
+  ///@brief Distribution of number of frames in the queue when a strobe arrives
+  std::vector<double> epoch_occupancy;
+
+  ///@brief Time-averaged distribution of number of frames in the queue
+  std::vector<double> time_occupancy;
+
+  double reject_prob;
+  double flush_prob;
+};
+
+
+class BusyEstimator {
+private:
+  BusyEstimatorConfig mConfig;
+
+  ///@brief Strobe rate per clock cycle, after trigger filtering
+  double mStrobeRate;
+
+  ///@brief Rate of physics events per clock cycle
+  double mEventRate;
+
+  double mMeanHitsPerFrame;
+  double mMeanPixelsPerFrame;
+  double mMeanBytesPerFrame;
+
+  ///@brief Distribution (pmf) of time in clock cycles from the end of the strobe until
+  ///       a frame has been read out from the matrix, and the MEB is freed.
+  std::vector<double> mReadoutTimePmf;
+
+  ///@brief Distribution (pmf) of time in clock cycles to transmit a frame on the data link
+  std::vector<double> mLinkTimePmf;
+
+  void calcReadoutTimeDistributions(void);
+  void calcMeasuredReadoutTimeDistribution(void);
+  double getMaxRegionHitsMean(double hits) const;
+  double getFrameBytes(double hits) const;
+
+public:
+  BusyEstimator(const BusyEstimatorConfig& config);
+  BusyEstimate estimate(void) const;
+
+  static std::vector<double> solveMG1K(double arrival_rate,
+                                       const std::vector<double>& first_service_pmf,
+                                       const std::vector<double>& service_pmf,
+                                       unsigned int K);
+
+  static PeriodicQueueResult solvePeriodic(unsigned int period,
+                                           unsigned int strobe_length,
+                                           const std::vector<double>& service_pmf,
+                                           unsigned int K,
+                                           bool flush_oldest);
+
+  static std::map<unsigned int, double> readHistogramFile(const std::string& filename);
+};
+
+
+#endif
@@ -0,0 +1,265 @@
+/**
+ * @file   busy_estimator_main.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Standalone program for quick analytic estimates of MEB occupancy,
+ *         busy probability and trigger efficiency, for a sweep of event rates,
+ *         strobe lengths and cluster sizes.
+ *
+ *         Uses the same settings file and command line options as the simulation,
+ *         with some additional options for the sweep. See BusyEstimator.hpp for
+ *         a description of the model.
+ */
+
+#include "Settings/Settings.hpp"
+#include "Settings/parse_cmdline_args.hpp"
+#include "Estimator/BusyEstimator.hpp"
+#include "Alpide/alpide_constants.hpp"
+#include "Detector/ITS/ITS_constants.hpp"
+#include "version.hpp"
+#include <QCoreApplication>
+#include <QStringList>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+struct EstimatorLayer {
+  std::string name;
+  double hit_density;
+  unsigned int chips_per_link;
+  unsigned int link_bytes_per_cycle;
+};
+
+
+///@brief Parse a comma separated list of values from the command line
+///@param[in] parser Command line parser
+///@param[in] option Option to parse values for
+///@param[out] values Vector that the values will be appended to
+///@return True on success, false if any value could not be parsed or was not positive
+static bool parse_sweep_option(const QCommandLineParser& parser,
+                               const QCommandLineOption& option,
+                               std::vector<double>& values)
+{
+  QStringList value_list = parser.value(option).split(",", QString::SkipEmptyParts);
+
+  for(auto it = value_list.begin(); it != value_list.end(); it++) {
+    bool conversion_ok = false;
+    double value = it->trimmed().toDouble(&conversion_ok);
+
+    if(conversion_ok == false || value <= 0) {
+      std::cout << "Error parsing value \"" << it->toStdString() << "\" for option ";
+      std::cout << option.names().last().toStdString() << std::endl;
+      return false;
+    }
+    values.push_back(value);
+  }
+
+  return values.empty() == false;
+}
+
+
+int main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("Alpide Busy Estimator");
+  QCoreApplication::setApplicationVersion(QString::number(VERSION_MAJOR) + "." +
+                                          QString::number(VERSION_MINOR));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("\nAnalytic estimate of MEB occupancy, busy and trigger efficiency"
+                                   " for the Alpide Dataflow Simulation settings");
+
+  const QCommandLineOption rateSweepOption({"rs", "rate_sweep"},
+                                           "Comma separated list of average event rates [ns]. "
+                                           "Default is the rate from the settings.",
+                                           "rates");
+
+  const QCommandLineOption strobeSweepOption({"ss", "strobe_sweep"},
+                                             "Comma separated list of strobe active lengths [ns]. "
+                                             "Default is the strobe length from the settings.",
+                                             "strobe lengths");
+
+  const QCommandLineOption clusterSweepOption({"cs", "cluster_size_sweep"},
+                                              "Comma separated list of mean cluster sizes [pixels]. "
+                                              "Default is the cluster size from the settings.",
+                                              "cluster sizes");
+
+  const QCommandLineOption readoutHistoOption({"rt", "readout_time_histo"},
+                                              "File with measured histogram of frame readout times "
+                                              "(\"time_ns;counts\" per line), from end of strobe "
+                                              "until the MEB is freed. Replaces the analytic readout "
+                                              "time model.",
+                                              "file");
+
+  const QCommandLineOption outputFileOption({"f", "output_file"},
+                                            "CSV file to write the estimates to.",
+                                            "file",
+                                            "busy_estimate.csv");
+
+  parser.addOption(rateSweepOption);
+  parser.addOption(strobeSweepOption);
+  parser.addOption(clusterSweepOption);
+  parser.addOption(readoutHistoOption);
+  parser.addOption(outputFileOption);
+
+  // Reads the settings file, and the options that are common with the simulation
+  QSettings* settings = parseCommandLine(parser, app);
+
+  if(settings == nullptr)
+    return 0;
+
+  if(settings->value("simulation/type").toString() != "its") {
+    std::cout << "Error: the busy estimator only supports the ITS simulation type." << std::endl;
+    return -1;
+  }
+
+  BusyEstimatorConfig config;
+  config.chip_cfg.dtu_delay_cycles = settings->value("alpide/dtu_delay").toUInt();
+  config.chip_cfg.strobe_length_ns = settings->value("event/strobe_active_length_ns").toUInt();
+  config.chip_cfg.min_busy_cycles = settings->value("alpide/minimum_busy_cycles").toUInt();
+  config.chip_cfg.strobe_extension = settings->value("alpide/strobe_extension_enable").toBool();
+  config.chip_cfg.data_long_en = settings->value("alpide/data_long_enable").toBool();
+  config.chip_cfg.chip_continuous_mode = settings->value("alpide/chip_continuous_mode").toBool();
+  config.chip_cfg.matrix_readout_speed = settings->value("alpide/matrix_readout_speed_fast").toBool();
+  config.system_continuous_mode = settings->value("simulation/system_continuous_mode").toBool();
+  config.system_continuous_period_ns = settings->value("simulation/system_continuous_period_ns").toUInt();
+  config.average_event_rate_ns = settings->value("event/average_event_rate_ns").toUInt();
+  config.trigger_filter_enable = settings->value("event/trigger_filter_enable").toBool();
+  config.trigger_filter_time_ns = settings->value("event/trigger_filter_time_ns").toUInt();
+  config.pixel_shaping_active_time_ns = settings->value("alpide/pixel_shaping_active_time_ns").toUInt();
+
+  std::vector<double> rates;
+  std::vector<double> strobe_lengths;
+  std::vector<double> cluster_sizes;
+
+  if(parser.isSet(rateSweepOption)) {
+    if(parse_sweep_option(parser, rateSweepOption, rates) == false)
+      return -1;
+  } else {
+    rates.push_back(config.average_event_rate_ns);
+  }
+
+  if(parser.isSet(strobeSweepOption)) {
+    if(parse_sweep_option(parser, strobeSweepOption, strobe_lengths) == false)
+      return -1;
+  } else {
+    strobe_lengths.push_back(config.chip_cfg.strobe_length_ns);
+  }
+
+  if(parser.isSet(clusterSweepOption)) {
+    if(parse_sweep_option(parser, clusterSweepOption, cluster_sizes) == false)
+      return -1;
+  } else if(settings->value("event/random_cluster_generation").toBool()) {
+    cluster_sizes.push_back(settings->value("event/random_cluster_size_mean").toDouble());
+  } else {
+    cluster_sizes.push_back(4); // 2x2 clusters
+  }
+
+  if(parser.isSet(readoutHistoOption)) {
+    try {
+      config.readout_time_histo_ns = BusyEstimator::readHistogramFile(parser.value(readoutHistoOption).toStdString());
+    } catch(std::runtime_error& e) {
+      std::cout << "Error: " << e.what() << std::endl;
+      return -1;
+    }
+  }
+
+  std::vector<EstimatorLayer> layers;
+
+  if(settings->value("simulation/single_chip").toBool()) {
+    layers.push_back({"single_chip",
+                      settings->value("its/hit_density_layer0").toDouble(),
+                      1, 3});
+  } else {
+    for(unsigned int layer = 0; layer < ITS::N_LAYERS; layer++) {
+      QString layer_str = QString::number(layer);
+
+      if(settings->value("its/layer" + layer_str + "_num_staves").toUInt() == 0)
+        continue;
+
+      bool inner_barrel = layer < 3;
+
+      layers.push_back({"layer_" + layer_str.toStdString(),
+                        settings->value("its/hit_density_layer" + layer_str).toDouble(),
+                        inner_barrel ? 1 : ITS::CHIPS_PER_HALF_MODULE,
+                        inner_barrel ? 3u : 1u});
+    }
+  }
+
+  std::string output_filename = parser.value(outputFileOption).toStdString();
+  std::ofstream output_file(output_filename);
+
+  if(!output_file.is_open()) {
+    std::cout << "Error opening output file " << output_filename << std::endl;
+    return -1;
+  }
+
+  output_file << "layer;event_rate_ns;strobe_length_ns;cluster_size;trigger_rate_mhz;";
+  output_file << "hits_per_frame;pixels_per_frame;readout_time_ns;bytes_per_frame;";
+  output_file << "meb_p0;meb_p1;meb_p2;meb_p3;busy;busy_violation;flushed_incomplete;";
+  output_file << "frame_fifo_busy;trigger_efficiency;link_utilization;compute_time_ms" << std::endl;
+
+  auto total_start_time = std::chrono::steady_clock::now();
+  unsigned int num_estimates = 0;
+
+  for(auto layer_it = layers.begin(); layer_it != layers.end(); layer_it++) {
+    for(auto rate_it = rates.begin(); rate_it != rates.end(); rate_it++) {
+      for(auto strobe_it = strobe_lengths.begin(); strobe_it != strobe_lengths.end(); strobe_it++) {
+        for(auto cluster_it = cluster_sizes.begin(); cluster_it != cluster_sizes.end(); cluster_it++) {
+          config.average_event_rate_ns = *rate_it;
+          config.chip_cfg.strobe_length_ns = *strobe_it;
+          config.cluster_size = *cluster_it;
+          config.hits_per_event = layer_it->hit_density * CHIP_WIDTH_CM * CHIP_HEIGHT_CM;
+          config.chips_per_link = layer_it->chips_per_link;
+          config.link_bytes_per_cycle = layer_it->link_bytes_per_cycle;
+
+          auto start_time = std::chrono::steady_clock::now();
+          BusyEstimate est;
+
+          try {
+            est = BusyEstimator(config).estimate();
+          } catch(std::runtime_error& e) {
+            std::cout << "Error: " << e.what() << std::endl;
+            return -1;
+          }
+
+          std::chrono::duration<double, std::milli> compute_time = std::chrono::steady_clock::now() - start_time;
+
+          output_file << layer_it->name << ";";
+          output_file << *rate_it << ";";
+          output_file << *strobe_it << ";";
+          output_file << *cluster_it << ";";
+          output_file << est.trigger_rate_mhz << ";";
+          output_file << est.mean_hits_per_frame << ";";
+          output_file << est.mean_pixels_per_frame << ";";
+          output_file << est.mean_readout_time_ns << ";";
+          output_file << est.mean_bytes_per_frame << ";";
+          for(auto it = est.meb_occupancy.begin(); it != est.meb_occupancy.end(); it++)
+            output_file << *it << ";";
+          output_file << est.busy_prob << ";";
+          output_file << est.busy_violation_prob << ";";
+          output_file << est.flush_prob << ";";
+          output_file << est.frame_fifo_busy_prob << ";";
+          output_file << est.trigger_efficiency << ";";
+          output_file << est.link_utilization << ";";
+          output_file << compute_time.count() << std::endl;
+
+          num_estimates++;
+        }
+      }
+    }
+  }
+
+  std::chrono::duration<double, std::milli> total_time = std::chrono::steady_clock::now() - total_start_time;
+
+  std::cout << "Calculated " << num_estimates << " estimates in " << total_time.count() << " ms." << std::endl;
+  std::cout << "Results written to " << output_filename << std::endl;
+
+  delete settings;
+
+  return 0;
+}
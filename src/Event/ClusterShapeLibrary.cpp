@@ -0,0 +1,174 @@
+/**
+ * @file   ClusterShapeLibrary.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Library of pixel cluster shapes with frequencies, used to create random
+ *         clusters with one alias table draw per cluster (see EventGenBase::createCluster()).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include "ClusterShapeLibrary.hpp"
+
+
+///@brief Build the library by sampling the cluster model used by EventGenBase::createCluster():
+///       a gaussian cluster size, and gaussian distributed x/y offsets for each pixel, where
+///       offsets that are already in the cluster are drawn again. Identical shapes are merged,
+///       and the number of samples of a shape is used as its frequency.
+///@param cluster_size_mean Mean cluster size (number of pixels)
+///@param cluster_size_stddev Standard deviation of cluster size
+///@param num_samples Number of clusters to sample
+///@param random_seed Seed for the random number generator used for sampling
+ClusterShapeLibrary::ClusterShapeLibrary(double cluster_size_mean, double cluster_size_stddev,
+                                         unsigned int num_samples, std::uint32_t random_seed)
+{
+  boost::random::mt19937 rand_gen(random_seed);
+  boost::random::normal_distribution<double> size_dist(cluster_size_mean-1, cluster_size_stddev);
+  boost::random::normal_distribution<double> offset_dist(0, sqrt(cluster_size_mean));
+
+  std::map<std::vector<ClusterPixelOffset>, unsigned int> shape_counts;
+  std::vector<ClusterPixelOffset> shape;
+
+  for(unsigned int sample = 0; sample < num_samples; sample++) {
+    int cluster_size = round(size_dist(rand_gen)) + 1;
+
+    if(cluster_size < 1)
+      cluster_size = 1;
+
+    shape.assign(1, ClusterPixelOffset{0, 0});
+
+    for(int i = 1; i < cluster_size; i++) {
+      ClusterPixelOffset offset;
+
+      do {
+        offset.col = round(offset_dist(rand_gen));
+        offset.row = round(offset_dist(rand_gen));
+      } while(std::find(shape.begin(), shape.end(), offset) != shape.end());
+
+      shape.push_back(offset);
+    }
+
+    // Sort the pixels after the hit pixel, so that identical shapes are merged
+    std::sort(shape.begin()+1, shape.end());
+    shape_counts[shape]++;
+  }
+
+  for(auto it = shape_counts.begin(); it != shape_counts.end(); it++)
+    addShape(it->first, it->second);
+
+  mAliasTable = AliasTable(mFrequencies);
+}
+
+
+///@brief Load the library from a file with shape bitmaps (see ClusterShapeLibrary.hpp)
+///@param filename Path to cluster shape file
+///@throw std::runtime_error if the file can not be opened, or has an invalid format
+ClusterShapeLibrary::ClusterShapeLibrary(const std::string& filename)
+{
+  std::ifstream in(filename);
+
+  if(!in.is_open())
+    throw std::runtime_error("Cannot open cluster shape file " + filename);
+
+  std::string line;
+  unsigned int line_num = 0;
+  bool in_shape = false;
+  double frequency = 0;
+  int row = 0;
+  bool hit_pixel_found = false;
+  std::vector<ClusterPixelOffset> shape;
+  std::vector<ClusterPixelOffset> shape_pixels;
+  ClusterPixelOffset hit_pixel = {0, 0};
+
+  auto error = [&](const std::string& msg) {
+    return std::runtime_error("Cluster shape file " + filename + " line " +
+                              std::to_string(line_num) + ": " + msg);
+  };
+
+  auto end_shape = [&]() {
+    if(!hit_pixel_found)
+      throw error("shape has no hit pixel (O)");
+
+    // The hit pixel goes first, offsets are relative to it
+    shape.assign(1, ClusterPixelOffset{0, 0});
+    for(auto it = shape_pixels.begin(); it != shape_pixels.end(); it++)
+      shape.push_back(ClusterPixelOffset{it->col - hit_pixel.col, it->row - hit_pixel.row});
+
+    addShape(shape, frequency);
+    in_shape = false;
+  };
+
+  while(std::getline(in, line)) {
+    line_num++;
+
+    if(!line.empty() && line.back() == '\r')
+      line.pop_back();
+
+    if(!line.empty() && line[0] == '#')
+      continue;
+
+    if(line.empty()) {
+      if(in_shape)
+        end_shape();
+    } else if(!in_shape) {
+      try {
+        std::size_t pos;
+        frequency = std::stod(line, &pos);
+        if(pos != line.size() || frequency < 0)
+          throw std::invalid_argument(line);
+      } catch(const std::logic_error&) {
+        throw error("expected shape frequency, got \"" + line + "\"");
+      }
+
+      in_shape = true;
+      hit_pixel_found = false;
+      shape_pixels.clear();
+      row = 0;
+    } else {
+      for(int col = 0; col < int(line.size()); col++) {
+        if(line[col] == 'X') {
+          shape_pixels.push_back(ClusterPixelOffset{col, row});
+        } else if(line[col] == 'O') {
+          if(hit_pixel_found)
+            throw error("shape has more than one hit pixel (O)");
+          hit_pixel = ClusterPixelOffset{col, row};
+          hit_pixel_found = true;
+        } else if(line[col] != '.') {
+          throw error(std::string("invalid character '") + line[col] + "' in shape");
+        }
+      }
+      row++;
+    }
+  }
+
+  if(in_shape)
+    end_shape();
+
+  if(mFrequencies.empty())
+    throw std::runtime_error("No cluster shapes in cluster shape file " + filename);
+
+  try {
+    mAliasTable = AliasTable(mFrequencies);
+  } catch(const std::runtime_error&) {
+    throw std::runtime_error("All cluster shapes have zero frequency in " + filename);
+  }
+}
+
+
+///@brief Add a shape to the library
+///@param shape Pixel offsets of shape, starting with the hit pixel (0,0)
+///@param frequency Relative frequency of shape
+void ClusterShapeLibrary::addShape(const std::vector<ClusterPixelOffset>& shape, double frequency)
+{
+  if(mShapeStart.empty())
+    mShapeStart.push_back(0);
+
+  mOffsets.insert(mOffsets.end(), shape.begin(), shape.end());
+  mShapeStart.push_back(mOffsets.size());
+  mFrequencies.push_back(frequency);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file   ClusterShapeLibrary.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Library of pixel cluster shapes with frequencies, used to create random
+ *         clusters with one alias table draw per cluster (see EventGenBase::createCluster()).
+ *
+ *         The library is either built by sampling the gaussian cluster model used by
+ *         createCluster(), or loaded from a text file with measured shapes. The file has
+ *         one block per shape, separated by blank lines. Lines starting with # are comments.
+ *         The first line of a block is the relative frequency of the shape, followed by
+ *         the shape as a bitmap with one line per pixel row. '.' is an empty pixel,
+ *         'X' a pixel in the cluster, and 'O' the pixel that was hit, which must be
+ *         included exactly once:
+ *
+ *         # Frequency and bitmap
+ *         120
+ *         .X.
+ *         XOX
+ *         .X.
+ */
+
+#ifndef CLUSTER_SHAPE_LIBRARY_HPP
+#define CLUSTER_SHAPE_LIBRARY_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "common/AliasTable.hpp"
+
+
+struct ClusterPixelOffset {
+  int col;
+  int row;
+
+  bool operator==(const ClusterPixelOffset& other) const {
+    return col == other.col && row == other.row;
+  }
+
+  bool operator<(const ClusterPixelOffset& other) const {
+    return row < other.row || (row == other.row && col < other.col);
+  }
+};
+
+
+class ClusterShapeLibrary {
+  /// Pixel offsets of all shapes, relative to the hit pixel. The first offset of
+  /// each shape is the hit pixel itself (0,0).
+  std::vector<ClusterPixelOffset> mOffsets;
+
+  /// Index of first offset of each shape in mOffsets, with an extra end index
+  std::vector<std::uint32_t> mShapeStart;
+
+  std::vector<double> mFrequencies;
+
+  AliasTable mAliasTable;
+
+  void addShape(const std::vector<ClusterPixelOffset>& shape, double frequency);
+
+public:
+  ClusterShapeLibrary(double cluster_size_mean, double cluster_size_stddev,
+                      unsigned int num_samples, std::uint32_t random_seed);
+  explicit ClusterShapeLibrary(const std::string& filename);
+
+  unsigned int getNumShapes(void) const {return mFrequencies.size();}
+  double getShapeFrequency(unsigned int shape) const {return mFrequencies[shape];}
+  const ClusterPixelOffset* getShapeBegin(unsigned int shape) const {
+    return mOffsets.data() + mShapeStart[shape];
+  }
+  const ClusterPixelOffset* getShapeEnd(unsigned int shape) const {
+    return mOffsets.data() + mShapeStart[shape+1];
+  }
+
+  ///@brief Draw a random shape, with probability proportional to its frequency
+  ///@param rng Random number generator returning uniformly distributed 32-bit numbers
+  ///@return Shape number
+  template<class Rng>
+  unsigned int drawShape(Rng& rng) const {return mAliasTable(rng);}
+};
+
+
+#endif
@@ -6,9 +6,12 @@
  *         This class assumes that each discrete is stored in its own file.
  */
 
+#include <chrono>
 #include <iostream>
+#include <stdexcept>
 #include <boost/random/random_device.hpp>
 #include "EventBaseDiscrete.hpp"
+#include "common/Log.hpp"
 
 using boost::random::uniform_int_distribution;
 
@@ -27,6 +30,9 @@ using boost::random::uniform_int_distribution;
 ///@param random_seed Random seed for event sequence randomizer.
 ///@param load_all If set to true, load all event files into memory. If not they are read
 ///                from file as they are used, and do not persist in memory.
+///@param prefetch_events Number of events to read ahead of time in a background thread,
+///                       when the events are not all loaded into memory. The events are
+///                       used in the same order as without prefetching. 0 disables it.
 EventBaseDiscrete::EventBaseDiscrete(Detector::DetectorConfigBase config,
                                      Detector::t_global_chip_id_to_position_func global_chip_id_to_position_func,
                                      Detector::t_position_to_global_chip_id_func position_to_global_chip_id_func,
@@ -34,7 +40,8 @@ EventBaseDiscrete::EventBaseDiscrete(Detector::DetectorConfigBase config,
                                      const QStringList& event_filenames,
                                      bool random_event_order,
                                      int random_seed,
-                                     bool load_all)
+                                     bool load_all,
+                                     unsigned int prefetch_events)
   : mConfig(config)
   , mGlobalChipIdToPositionFunc(global_chip_id_to_position_func)
   , mPositionToGlobalChipIdFunc(position_to_global_chip_id_func)
@@ -45,6 +52,8 @@ EventBaseDiscrete::EventBaseDiscrete(Detector::DetectorConfigBase config,
   , mEventCount(0)
   , mNextEvent(0)
   , mLoadAllEvents(load_all)
+  , mPrefetchEvents(prefetch_events)
+  , mPrefetchStop(false)
 {
   if(random_seed == 0) {
     boost::random::random_device r;
@@ -93,6 +102,8 @@ EventBaseDiscrete::EventBaseDiscrete(Detector::DetectorConfigBase config,
 
 EventBaseDiscrete::~EventBaseDiscrete()
 {
+  stopPrefetch();
+
   for(unsigned int i = 0; i < mEvents.size(); i++)
     delete mEvents[i];
 
@@ -103,52 +114,165 @@ EventBaseDiscrete::~EventBaseDiscrete()
 }
 
 
-///@brief Get the next event. If the class was constructed with random_event_order
-///       set to true, then this will return a random event from the pool of events.
-///       If not they will be in sequential order.
-///@return Const pointer to EventDigits object for event.
-const EventDigits* EventBaseDiscrete::getNextEvent(void)
+///@brief Use counter-based random numbers for the random event order, so that the
+///       event used for the N'th call to getNextEvent() only depends on the seed and N.
+///       Must be called before the first call to getNextEvent().
+void EventBaseDiscrete::setCounterBasedRandom(bool counter_based)
 {
-  EventDigits* event = nullptr;
-  int current_event_index;
+  mRandEventIdGen.setCounterBased(counter_based);
+}
+
 
+///@brief Get the index of the next event to use. Random or sequential order
+///       depending on the random_event_order constructor argument.
+int EventBaseDiscrete::getNextEventIndex(void)
+{
+  int event_index;
 
   if(mRandomEventOrder) {
     // Generate random event here
-    current_event_index = (*mRandEventIdDist)(mRandEventIdGen);
+    mRandEventIdGen.setStream(mEventIndexCount++);
+    event_index = (*mRandEventIdDist)(mRandEventIdGen);
   } else { // Sequential event order if not random
-    current_event_index = mNextEvent;
+    event_index = mNextEvent;
     mNextEvent++;
-    mNextEvent = mNextEvent % mEventFileNames.size();
+    mNextEvent = mNextEvent % getNumEvents();
   }
 
+  return event_index;
+}
+
+
+///@brief Get the next event. If the class was constructed with random_event_order
+///       set to true, then this will return a random event from the pool of events.
+///       If not they will be in sequential order.
+///@return Const pointer to EventDigits object for event.
+///@throw std::runtime_error (or other exceptions from readEvent()) if the event could not
+///       be read. With prefetching, errors in the prefetch thread are rethrown here.
+const EventDigits* EventBaseDiscrete::getNextEvent(void)
+{
+  EventDigits* event = nullptr;
+  int current_event_index;
+
   if(mLoadAllEvents) {
+    current_event_index = getNextEventIndex();
+
     if(mEvents.empty() == false) {
       event = mEvents[current_event_index];
     } else {
-      std::cout << "Error: No MC events loaded into memory." << std::endl;
-      exit(-1);
+      throw std::runtime_error("No MC events loaded into memory.");
     }
   } else {
     if(mSingleEvent != nullptr)
       delete mSingleEvent;
 
-    mSingleEvent = readEventFile(mEventPath + QString("/") + mEventFileNames.at(current_event_index));
+    if(mPrefetchEvents > 0) {
+      // The thread is started on first use, because it calls readEvent(),
+      // which is not available before the derived class is constructed.
+      if(!mPrefetchThread.joinable()) {
+        mPrefetchQueue.reset(new SpscQueue<PrefetchedEvent>(mPrefetchEvents));
+        mPrefetchThread = std::thread(&EventBaseDiscrete::prefetchThread, this);
+      }
+
+      PrefetchedEvent prefetched = mPrefetchQueue->pop();
+
+      // Errors reading the event are passed on from the prefetch thread
+      mSingleEvent = nullptr;
+      if(prefetched.error)
+        std::rethrow_exception(prefetched.error);
+
+      current_event_index = prefetched.event_index;
+      mSingleEvent = prefetched.event;
+    } else {
+      current_event_index = getNextEventIndex();
+      mSingleEvent = readEvent(current_event_index);
+    }
+
     event = mSingleEvent;
   }
 
-  std::cout << "MC Event number: " << current_event_index << std::endl;
+  LOG(EVENT, INFO) << "MC Event number: " << current_event_index;
 
   return event;
 }
 
 
+///@brief Background thread that reads events ahead of time into the prefetch queue.
+///       The thread picks the event indexes, and is the only user of the event index
+///       generator while it runs, so the events come in the same order as without
+///       prefetching. If reading an event fails, the exception is passed through the
+///       queue and rethrown by getNextEvent(), and the thread stops.
+void EventBaseDiscrete::prefetchThread(void)
+{
+  while(!mPrefetchStop.load()) {
+    PrefetchedEvent prefetched = {0, nullptr, nullptr};
+
+    try {
+      prefetched.event_index = getNextEventIndex();
+      prefetched.event = readEvent(prefetched.event_index);
+    } catch(...) {
+      prefetched.error = std::current_exception();
+    }
+
+    bool last_event = bool(prefetched.error);
+
+    while(!mPrefetchQueue->tryPush(std::move(prefetched))) {
+      if(mPrefetchStop.load()) {
+        delete prefetched.event;
+        return;
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    if(last_event)
+      return;
+  }
+}
+
+
+///@brief Stop the prefetch thread and delete the events it read ahead.
+///       Classes that override readEvent() or readEventFile() must call this in
+///       their destructor, so that the thread is stopped before they are destroyed.
+///       No more events can be read after the thread has been stopped.
+void EventBaseDiscrete::stopPrefetch(void)
+{
+  if(!mPrefetchThread.joinable())
+    return;
+
+  mPrefetchStop.store(true);
+  mPrefetchThread.join();
+
+  PrefetchedEvent prefetched;
+  while(mPrefetchQueue->tryPop(prefetched))
+    delete prefetched.event;
+}
+
+
 ///@brief Create a uniform random distribution used to pick event ID,
 ///       with a range that matches the number of available events.
+///       Called from the constructor, and must be called again by derived classes
+///       that override getNumEvents().
 void EventBaseDiscrete::createEventIdDistribution(void)
 {
   if(mRandEventIdDist != nullptr)
     delete mRandEventIdDist;
 
-  mRandEventIdDist = new uniform_int_distribution<int>(0, mEventFileNames.size()-1);
+  mRandEventIdDist = new uniform_int_distribution<int>(0, getNumEvents()-1);
+}
+
+
+///@brief Get the number of available events. By default there is one event per file.
+int EventBaseDiscrete::getNumEvents(void) const
+{
+  return mEventFileNames.size();
+}
+
+
+///@brief Read one event, used when the events are not all loaded into memory.
+///       By default the event is read from its own file in the event file list.
+///@param event_index Index of event
+///@return Pointer to EventDigits object with the event. The caller takes ownership.
+EventDigits* EventBaseDiscrete::readEvent(int event_index)
+{
+  return readEventFile(mEventPath + QString("/") + mEventFileNames.at(event_index));
 }
@@ -9,16 +9,20 @@
 #ifndef EVENT_BASE_DISCRETE_H
 #define EVENT_BASE_DISCRETE_H
 
+#include <atomic>
+#include <exception>
 #include <map>
 #include <memory>
+#include <thread>
 #include <QString>
 #include <QStringList>
-#include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 #include "Alpide/PixelHit.hpp"
 #include "Alpide/PixelReadoutStats.hpp"
 #include "Detector/Common/DetectorConfig.hpp"
 #include "EventDigits.hpp"
+#include "common/RandomEngine.hpp"
+#include "common/SpscQueue.hpp"
 
 
 class EventBaseDiscrete {
@@ -46,10 +50,31 @@ protected:
   /// Load all events to memory if true, read one at a time from file if false
   bool mLoadAllEvents;
 
-  boost::random::mt19937 mRandEventIdGen;
+  RandomEngine mRandEventIdGen{RAND_PURPOSE_EVENT_ID};
   boost::random::uniform_int_distribution<int> *mRandEventIdDist;
 
+  /// Number of event indexes drawn so far, used as event number for
+  /// counter-based random numbers
+  uint64_t mEventIndexCount = 0;
+
+  struct PrefetchedEvent {
+    int event_index;
+    EventDigits* event;
+    std::exception_ptr error;
+  };
+
+  /// Number of events to read ahead in a background thread, 0 to read events
+  /// in getNextEvent(). Not used when all events are loaded to memory.
+  unsigned int mPrefetchEvents;
+  std::unique_ptr<SpscQueue<PrefetchedEvent>> mPrefetchQueue;
+  std::thread mPrefetchThread;
+  std::atomic<bool> mPrefetchStop;
+
   void createEventIdDistribution(void);
+  int getNextEventIndex(void);
+  void prefetchThread(void);
+  virtual int getNumEvents(void) const;
+  virtual EventDigits* readEvent(int event_index);
 
 public:
   EventBaseDiscrete(Detector::DetectorConfigBase config,
@@ -59,11 +84,14 @@ public:
             const QStringList& event_filenames,
             bool random_event_order = true,
             int random_seed = 0,
-            bool load_all = false);
-  ~EventBaseDiscrete();
+            bool load_all = false,
+            unsigned int prefetch_events = 0);
+  virtual ~EventBaseDiscrete();
+  void stopPrefetch(void);
   virtual void readEventFiles() = 0;
   virtual EventDigits* readEventFile(const QString& event_filename) = 0;
   const EventDigits* getNextEvent(void);
+  void setCounterBasedRandom(bool counter_based);
 };
 
 
@@ -8,10 +8,24 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <stdexcept>
 #include <boost/random/random_device.hpp>
 #include "EventBinaryITS.hpp"
 #include "EventBinaryITSFormat.hpp"
 
+
+///@brief Throw exception for an unexpected code in an event file
+///@throw std::runtime_error always
+static void throw_unexpected_code(std::uint8_t code_id, const std::string& event_filename)
+{
+  std::ostringstream error_msg;
+  error_msg << "unexpected code 0x" << std::hex << int(code_id);
+  error_msg << " in file " << event_filename;
+  throw std::runtime_error(error_msg.str());
+}
+
+
 ///@brief Constructor for EventBinaryITS class, which handles a set of events
 ///       stored in binary data files.
 ///@param config detectorConfig object which specifies which staves in ITS should
@@ -28,6 +42,8 @@
 ///@param random_seed Random seed for event sequence randomizer.
 ///@param load_all If set to true, load all event files into memory. If not they are read
 ///                from file as they are used, and do not persist in memory.
+///@param prefetch_events Number of events to read ahead in a background thread,
+///                       0 to read events when they are used (see EventBaseDiscrete).
 EventBinaryITS::EventBinaryITS(Detector::DetectorConfigBase config,
                                Detector::t_global_chip_id_to_position_func global_chip_id_to_position_func,
                                Detector::t_position_to_global_chip_id_func position_to_global_chip_id_func,
@@ -35,7 +51,8 @@ EventBinaryITS::EventBinaryITS(Detector::DetectorConfigBase config,
                                const QStringList& event_filenames,
                                bool random_event_order,
                                int random_seed,
-                               bool load_all)
+                               bool load_all,
+                               unsigned int prefetch_events)
   : EventBaseDiscrete(config,
                       global_chip_id_to_position_func,
                       position_to_global_chip_id_func,
@@ -43,13 +60,21 @@ EventBinaryITS::EventBinaryITS(Detector::DetectorConfigBase config,
                       event_filenames,
                       random_event_order,
                       random_seed,
-                      load_all)
+                      load_all,
+                      prefetch_events)
 {
   if(load_all)
     readEventFiles();
 }
 
 
+EventBinaryITS::~EventBinaryITS()
+{
+  // Stop reading events ahead before this object is destroyed
+  stopPrefetch();
+}
+
+
 ///@brief Read the whole list of event files into memory
 void EventBinaryITS::readEventFiles()
 {
@@ -65,6 +90,7 @@ void EventBinaryITS::readEventFiles()
 ///@brief Read a monte carlo event from a binary data file
 ///@param event_filename File name and path of binary data file
 ///@return Pointer to EventDigits object with the event that was read from file
+///@throw std::runtime_error if the file could not be read or has an invalid format
 EventDigits* EventBinaryITS::readEventFile(const QString& event_filename)
 {
   std::uint8_t code_id;
@@ -82,36 +108,34 @@ EventDigits* EventBinaryITS::readEventFile(const QString& event_filename)
     code_id = mFileBuffer[mFileBufferIdx++];
 
     if(code_id != DETECTOR_START) {
-      std::cerr << "Error: file " << event_filename.toStdString();
-      std::cerr << " did not start with DETECTOR_START code." << std::endl;
-      exit(-1);
+      throw std::runtime_error("file " + event_filename.toStdString() +
+                               " did not start with DETECTOR_START code.");
     }
 
     EventDigits* event = new EventDigits();
     bool done = false;
 
-    while(done == false && mFileBufferIdx < mFileBuffer.size()) {
-      code_id = mFileBuffer[mFileBufferIdx++];
-
-      if(code_id == LAYER_START) {
-        done = readLayer(event_filename.toStdString(), event);
-      } else if(code_id == DETECTOR_END) {
-        done = true;
-      } else {
-        std::cerr << "Error: unexpected code " << std::hex << code_id;
-        std::cerr << " in file " << event_filename.toStdString() << std::endl;
-        delete event;
-        exit(-1);
+    try {
+      while(done == false && mFileBufferIdx < mFileBuffer.size()) {
+        code_id = mFileBuffer[mFileBufferIdx++];
+
+        if(code_id == LAYER_START) {
+          done = readLayer(event_filename.toStdString(), event);
+        } else if(code_id == DETECTOR_END) {
+          done = true;
+        } else {
+          throw_unexpected_code(code_id, event_filename.toStdString());
+        }
       }
+    } catch(...) {
+      delete event;
+      throw;
     }
     return event;
   }
   else {
-    std::cerr << "Error reading from file " << event_filename.toStdString() << std::endl;
-    exit(-1);
+    throw std::runtime_error("could not read from file " + event_filename.toStdString());
   }
-
-  return nullptr;
 }
 
 
@@ -141,9 +165,7 @@ bool EventBinaryITS::readLayer(std::string event_filename, EventDigits* event)
     } else if(code_id == LAYER_END) {
       done = true;
     } else {
-      std::cerr << "Error: unexpected code " << std::hex << code_id;
-      std::cerr << " in file " << event_filename << std::endl;
-      exit(-1);
+      throw_unexpected_code(code_id, event_filename);
     }
   }
 
@@ -174,9 +196,7 @@ void EventBinaryITS::readStave(std::string event_filename,
     } else if(code_id == STAVE_END) {
       done = true;
     } else {
-      std::cerr << "Error: unexpected code " << std::hex << code_id;
-      std::cerr << " in file " << event_filename << std::endl;
-      exit(-1);
+      throw_unexpected_code(code_id, event_filename);
     }
   }
 }
@@ -201,9 +221,7 @@ void EventBinaryITS::readModule(std::string event_filename,
     } else if(code_id == MODULE_END) {
       done = true;
     } else {
-      std::cerr << "Error: unexpected code " << std::hex << code_id;
-      std::cerr << " in file " << event_filename << std::endl;
-      exit(-1);
+      throw_unexpected_code(code_id, event_filename);
     }
   }
 }
@@ -245,9 +263,7 @@ void EventBinaryITS::readChip(std::string event_filename,
     } else if(code_id == CHIP_END) {
       done = true;
     } else {
-      std::cerr << "Error: unexpected code " << std::hex << code_id;
-      std::cerr << " in file " << event_filename << std::endl;
-      exit(-1);
+      throw_unexpected_code(code_id, event_filename);
     }
   }
 }
@@ -53,7 +53,9 @@ public:
                  const QStringList& event_filenames,
                  bool random_event_order = true,
                  int random_seed = 0,
-                 bool load_all = false);
+                 bool load_all = false,
+                 unsigned int prefetch_events = 0);
+  ~EventBinaryITS();
 };
 
 
@@ -31,6 +31,8 @@ public:
 
   size_t size(void) const {return mHitDigits.size();}
 
+  void reserve(size_t num_hits) {mHitDigits.reserve(num_hits);}
+
   void printEvent(void) const {
     for(auto it = mHitDigits.begin(); it != mHitDigits.end(); it++) {
       std::cout << "Chip  " << it->getChipId() << "  ";
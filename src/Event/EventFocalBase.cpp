@@ -0,0 +1,273 @@
+/**
+ * @file   EventFocalBase.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Base class for handling Monte Carlo events for Focal, where the events
+ *         consist of hits in macro cells that are expanded to random pixel hits.
+ */
+
+#include <iostream>
+#include <cmath>
+#include <boost/random/random_device.hpp>
+#include "Alpide/alpide_constants.hpp"
+#include "Detector/Focal/Focal_constants.hpp"
+#include "Detector/Focal/FocalDetectorConfig.hpp"
+#include "EventFocalBase.hpp"
+#include "common/Log.hpp"
+
+using boost::random::uniform_real_distribution;
+using boost::random::uniform_int_distribution;
+
+bool macro_cell_coords_to_chip_coords(const unsigned int macro_cell_x, const unsigned int macro_cell_y,
+                                      const unsigned int layer, unsigned int staves_per_quadrant,
+                                      unsigned int& global_chip_id, double& chip_x_mm,
+                                      double& chip_y_mm);
+
+///@brief Constructor for EventFocalBase class. The derived class should open the event
+///       file and call setNumEntries() with the number of events.
+///@param config detectorConfig object which specifies which staves in Focal should
+///              be included.
+///@param global_chip_id_to_position_func Pointer to function used to determine global
+///                                       chip id based on position
+///@param position_to_global_chip_id_func Pointer to function used to determine position
+///                                       based on global chip id
+///@param staves_per_quadrant Number of staves per quadrant in simulation
+///@param random_seed Random seed used to generate random hits in macro cells
+///@param random_event_order Process monte carlo events in random order or not
+EventFocalBase::EventFocalBase(Detector::DetectorConfigBase config,
+                               Detector::t_global_chip_id_to_position_func global_chip_id_to_position_func,
+                               Detector::t_position_to_global_chip_id_func position_to_global_chip_id_func,
+                               unsigned int staves_per_quadrant,
+                               unsigned int random_seed,
+                               bool random_event_order)
+  : mConfig(config)
+  , mGlobalChipIdToPositionFunc(global_chip_id_to_position_func)
+  , mPositionToGlobalChipIdFunc(position_to_global_chip_id_func)
+  , mRandomEventOrder(random_event_order)
+  , mStavesPerQuadrant(staves_per_quadrant)
+{
+  if(random_seed == 0) {
+    boost::random::random_device r;
+
+    std::cout << "Boost random_device entropy: " << r.entropy() << std::endl;
+
+    unsigned int random_seed2 = r();
+    mRandHitGen.seed(random_seed2);
+    mRandEventIdGen.seed(random_seed2);
+    std::cout << "Random event ID generator random seed: " << random_seed << std::endl;
+  } else {
+    mRandHitGen.seed(random_seed);
+    mRandEventIdGen.seed(random_seed);
+  }
+
+  mRandHitMacroCellX = new uniform_real_distribution<double>(0, Focal::MACRO_CELL_SIZE_X_MM);
+  mRandHitMacroCellY = new uniform_real_distribution<double>(0, Focal::MACRO_CELL_SIZE_Y_MM);
+}
+
+
+EventFocalBase::~EventFocalBase()
+{
+  delete mEventDigits;
+  delete mRandHitMacroCellX;
+  delete mRandHitMacroCellY;
+  delete mRandEventIdDist;
+}
+
+
+///@brief Use counter-based random numbers for the event order and the hits in the
+///       macro cells. The hits for the N'th event then only depend on the seed and N.
+void EventFocalBase::setCounterBasedRandom(bool counter_based)
+{
+  mRandHitGen.setCounterBased(counter_based);
+  mRandEventIdGen.setCounterBased(counter_based);
+}
+
+
+///@brief Set the number of events available, and initialize the event id distribution
+///@param num_entries Number of events
+void EventFocalBase::setNumEntries(uint64_t num_entries)
+{
+  mNumEntries = num_entries;
+  mEntryCounter = 0;
+
+  delete mRandEventIdDist;
+  mRandEventIdDist = nullptr;
+
+  if(mNumEntries > 0)
+    mRandEventIdDist = new uniform_int_distribution<int>(0, mNumEntries-1);
+
+  mMoreEventsLeft = mNumEntries > 0;
+}
+
+
+///@brief Create a number of pixel hits for ALPIDE chips, based on number of hits within a
+///       macro cell in the monte carlo simulation data.
+///@param[in] macro_cell_col Macro cell column number
+///@param[in] macro_cell_row Macro cell row number
+///@param[in] layer Layer of the macro cell hit (0 or 1)
+///@param[out] event Pointer to EventDigits object to add hits to
+void EventFocalBase::createHits(unsigned int macro_cell_col, unsigned int macro_cell_row,
+                                unsigned int num_hits, unsigned int layer, EventDigits* event)
+{
+  unsigned int global_chip_id;
+  double chip_x_mm;
+  double chip_y_mm;
+
+  bool hit_valid = macro_cell_coords_to_chip_coords(macro_cell_col, macro_cell_row, layer,
+                                                    mStavesPerQuadrant, global_chip_id,
+                                                    chip_x_mm, chip_y_mm);
+
+  // Only has an effect with counter-based random numbers
+  mRandHitGen.setStream(mEventCount, mMacroCellCount++);
+
+  if(hit_valid) {
+    // Create specified number of random hits within macro cell
+    for(unsigned int hit_counter = 0; hit_counter < num_hits; hit_counter++) {
+      // Create a random hit within macro cell with uniform distribution
+      double rand_hit_x_mm = chip_x_mm + (*mRandHitMacroCellX)(mRandHitGen);
+      double rand_hit_y_mm = chip_y_mm + (*mRandHitMacroCellY)(mRandHitGen);
+
+      // Convert random coords in macro cell to coords in units of ALPIDE pixels
+      int chip_col = round(rand_hit_x_mm * ((double)N_PIXEL_COLS / (CHIP_WIDTH_CM*10)));
+      int chip_row = round(rand_hit_y_mm * ((double)N_PIXEL_ROWS / (CHIP_HEIGHT_CM*10)));
+
+      // Make sure that x and y coords are within chip boundaries
+      if(chip_col >= N_PIXEL_COLS)
+        chip_col = N_PIXEL_COLS-1;
+      else if(chip_col < 0)
+        chip_col = 0;
+
+      if(chip_row >= N_PIXEL_ROWS)
+        chip_row = N_PIXEL_ROWS-1;
+      else if(chip_row < 0)
+        chip_row = 0;
+
+      event->addHit(chip_col, chip_row, global_chip_id);
+    }
+  }
+}
+
+
+///@brief Get the next monte carlo event, with pixel hits created for the macro cells
+///@return Pointer to EventDigits object with the event. The object is owned by
+///        this class, and is valid until the next call to getNextEvent().
+EventDigits* EventFocalBase::getNextEvent(void)
+{
+  if(mEventDigits != nullptr)
+    delete mEventDigits;
+
+  mEventDigits = new EventDigits();
+
+  LOG(EVENT, DEBUG) << "Getting next event...";
+
+  mEventCount++;
+  mMacroCellCount = 0;
+
+  if(mRandomEventOrder) {
+    mRandEventIdGen.setStream(mEventCount);
+    mEntryCounter = (*mRandEventIdDist)(mRandEventIdGen);
+  }
+
+  readEntry(mEntryCounter, mEventDigits);
+
+  if(mRandomEventOrder == false) {
+    mEntryCounter++;
+
+    if(mEntryCounter == mNumEntries) {
+      mEntryCounter = 0;
+      //mMoreEventsLeft = false;
+    }
+  }
+
+  LOG(EVENT, DEBUG) << "Event size: " << mEventDigits->size();
+
+  return mEventDigits;
+}
+
+///@brief Calculate global chip id and chip row/column for macro cell hit coordinates
+///       The coordinates of the macro cells go from 0,0 (bottom left) to 3200,3200 (top right)
+///@param[in] macro_cell_x X coords of hit (in units of macro cells)
+///@param[in] macro_cell_y Y coords of hit (in units of macro cells)
+///@param[in] layer Focal layer (0 or 1)
+///@param[in] staves_per_qudrant Number of staves per quadrant in simulation
+///@param[out] global_chip_id Global chip ID of the chip at those coordinates
+///@param[out] chip_x_mm X-coordinate of hit in chip
+///@param[out] chip_y_mm Y-coordinate of hit in chip
+///@return True when the macro cell is within the detector plane, and the output coordinates are
+///       valid.
+bool macro_cell_coords_to_chip_coords(const unsigned int macro_cell_x, const unsigned int macro_cell_y,
+                                      const unsigned int layer, unsigned int staves_per_quadrant,
+                                      unsigned int& global_chip_id, double& chip_x_mm,
+                                      double& chip_y_mm)
+{
+  int i_macro_cell_x = macro_cell_x - 1600;
+  int i_macro_cell_y = macro_cell_y - 1600;
+
+  double macro_cell_x_mm = i_macro_cell_x * Focal::MACRO_CELL_SIZE_X_MM;
+  double macro_cell_y_mm = i_macro_cell_y * Focal::MACRO_CELL_SIZE_Y_MM;
+
+  unsigned int quadrant;
+
+  if(macro_cell_x_mm > 0 && macro_cell_y_mm > 0) {
+    quadrant = 0;
+  } else if(macro_cell_x_mm < 0 && macro_cell_y_mm > 0) {
+    quadrant = 1;
+  } else if(macro_cell_x_mm < 0 && macro_cell_y_mm < 0) {
+    quadrant = 2;
+  } else {
+    quadrant = 3;
+  }
+
+  macro_cell_x_mm = abs(macro_cell_x_mm);
+  macro_cell_y_mm = abs(macro_cell_y_mm);
+
+  // Skip hits that fall inside the gap (though the data set shouldn't really include hits there..)
+  if(abs(macro_cell_x_mm) < Focal::GAP_SIZE_X_MM/2 && abs(macro_cell_y_mm) < Focal::GAP_SIZE_Y_MM/2)
+    return false;
+
+  // Skip hit if its y-coord falls above or beyond detector plane
+  if(macro_cell_y_mm > Focal::STAVES_PER_QUADRANT*Focal::STAVE_SIZE_Y_MM)
+    return false;
+
+  // If the hit is in one of the two patches to the right or left of the gap,
+  // then subtract the half gap size to "align" them with the rest of the patches,
+  // which simplifies the calculations..
+  if(macro_cell_y_mm < Focal::STAVES_PER_HALF_PATCH*Focal::STAVE_SIZE_Y_MM) {
+    macro_cell_x_mm -= Focal::GAP_SIZE_X_MM/2;
+
+    // Just in case the value ended up being a "slightly negative zero"
+    // in case of some floating point gremlins
+    if(macro_cell_x_mm < 0)
+      macro_cell_x_mm = 0.0;
+  }
+
+  // Skip hit if its x-coord falls outside the detector plane
+  if(macro_cell_x_mm > Focal::STAVE_SIZE_X_MM)
+    return false;
+
+  unsigned int stave_num_in_quadrant = macro_cell_y_mm / Focal::STAVE_SIZE_Y_MM;
+
+  // Skip stave if it is not included in the simulation
+  if(stave_num_in_quadrant >= staves_per_quadrant)
+    return false;
+
+  double stave_y_mm = macro_cell_y_mm - stave_num_in_quadrant*Focal::STAVE_SIZE_Y_MM;
+  double stave_x_mm = macro_cell_x_mm;
+
+  unsigned int chip_num_in_stave = stave_x_mm / (CHIP_WIDTH_CM*10);
+
+  chip_x_mm = stave_x_mm - chip_num_in_stave*(CHIP_WIDTH_CM*10);
+  chip_y_mm = stave_y_mm;
+
+  // Calculate global chip id
+  global_chip_id = 0;
+
+  if(layer > 0)
+    global_chip_id += Focal::CHIPS_PER_LAYER;
+
+  global_chip_id += quadrant * Focal::CHIPS_PER_QUADRANT;
+  global_chip_id += stave_num_in_quadrant * Focal::CHIPS_PER_STAVE;
+  global_chip_id += chip_num_in_stave;
+
+  return true;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file   EventFocalBase.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Base class for handling Monte Carlo events for Focal, where the events
+ *         consist of hits in macro cells that are expanded to random pixel hits.
+ */
+
+#ifndef EVENT_FOCAL_BASE_H
+#define EVENT_FOCAL_BASE_H
+
+#include <cstdint>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include "Detector/Common/DetectorConfig.hpp"
+#include "EventDigits.hpp"
+#include "common/RandomEngine.hpp"
+
+
+class EventFocalBase {
+protected:
+  Detector::DetectorConfigBase mConfig;
+
+  Detector::t_global_chip_id_to_position_func mGlobalChipIdToPositionFunc;
+  Detector::t_position_to_global_chip_id_func mPositionToGlobalChipIdFunc;
+
+  EventDigits* mEventDigits = nullptr;
+
+  bool mRandomEventOrder;
+  bool mMoreEventsLeft = false; // Set by setNumEntries()
+  uint64_t mNumEntries = 0; // Number of events (entries in TTree)
+  uint64_t mEntryCounter = 0;
+
+  /// Number of staves per quadrant included in the simulation
+  const unsigned int mStavesPerQuadrant;
+
+  /// Number of events read so far, and number of macro cells expanded to hits in the
+  /// current event. Used as stream numbers for counter-based random numbers.
+  uint64_t mEventCount = 0;
+  uint32_t mMacroCellCount = 0;
+
+  RandomEngine mRandHitGen{RAND_PURPOSE_HIT_COORDS};
+  boost::random::uniform_real_distribution<double> *mRandHitMacroCellX, *mRandHitMacroCellY;
+
+  RandomEngine mRandEventIdGen{RAND_PURPOSE_EVENT_ID};
+  boost::random::uniform_int_distribution<int> *mRandEventIdDist = nullptr;
+
+  void setNumEntries(uint64_t num_entries);
+  void createHits(unsigned int macro_cell_col, unsigned int macro_cell_row,
+                  unsigned int num_hits, unsigned int layer, EventDigits* event);
+
+  ///@brief Read an event, and add pixel hits for its macro cells with createHits()
+  ///@param[in] entry Event number
+  ///@param[out] event Pointer to EventDigits object to add hits to
+  virtual void readEntry(uint64_t entry, EventDigits* event) = 0;
+
+public:
+  EventFocalBase(Detector::DetectorConfigBase config,
+                 Detector::t_global_chip_id_to_position_func global_chip_id_to_position_func,
+                 Detector::t_position_to_global_chip_id_func position_to_global_chip_id_func,
+                 unsigned int staves_per_quadrant,
+                 unsigned int random_seed,
+                 bool random_event_order = true);
+  virtual ~EventFocalBase();
+  /// Indicates if there are more events left, or if we reached the end
+  bool getMoreEventsLeft() const {return mMoreEventsLeft;}
+  EventDigits* getNextEvent(void);
+  void setCounterBasedRandom(bool counter_based);
+};
+
+
+#endif /* EVENT_FOCAL_BASE_H */
@@ -6,6 +6,7 @@
  */
 #include "EventGenBase.hpp"
 #include "Alpide/alpide_constants.hpp"
+#include <algorithm>
 #include <boost/random/random_device.hpp>
 
 EventGenBase::EventGenBase(sc_core::sc_module_name name,
@@ -22,6 +23,7 @@ EventGenBase::EventGenBase(sc_core::sc_module_name name,
   mPixelDeadTime = settings->value("alpide/pixel_shaping_dead_time_ns").toInt();
   mPixelActiveTime = settings->value("alpide/pixel_shaping_active_time_ns").toInt();
   mSingleChipSimulation = settings->value("simulation/single_chip").toBool();
+  mCounterBasedRandom = settings->value("simulation/random_counter_based").toBool();
 
   mTriggeredReadoutStats = std::make_shared<PixelReadoutStats>();
   mUntriggeredReadoutStats = std::make_shared<PixelReadoutStats>();
@@ -55,6 +57,37 @@ EventGenBase::createCluster(const PixelHit& pix,
   bool pixel_already_in_cluster;
   bool skip_pixel_outside_matrix;
 
+  if(mClusterShapes) {
+    // Place the whole cluster with one draw from the shape library. The first pixel
+    // in a shape is the "source" hit, pixels outside the matrix are skipped.
+    unsigned int shape = mClusterShapes->drawShape(mRandClusterSizeGen);
+    const ClusterPixelOffset* offset = mClusterShapes->getShapeBegin(shape);
+    const ClusterPixelOffset* offset_end = mClusterShapes->getShapeEnd(shape);
+
+    std::vector<std::shared_ptr<PixelHit>> pixel_cluster;
+    pixel_cluster.reserve(offset_end - offset);
+
+    PixelHit cluster_pixel(pix);
+
+    for(; offset != offset_end; offset++) {
+      int col = pix.getCol() + offset->col;
+      int row = pix.getRow() + offset->row;
+
+      if(col < 0 || col >= N_PIXEL_COLS || row < 0 || row >= N_PIXEL_ROWS)
+        continue;
+
+      cluster_pixel.setCol(col);
+      cluster_pixel.setRow(row);
+
+      pixel_cluster.emplace_back(std::make_shared<PixelHit>(cluster_pixel));
+      pixel_cluster.back()->setPixelReadoutStatsObj(readout_stats);
+      pixel_cluster.back()->setActiveTimeStart(start_time_ns + dead_time_ns);
+      pixel_cluster.back()->setActiveTimeEnd(start_time_ns + dead_time_ns + active_time_ns);
+    }
+
+    return pixel_cluster;
+  }
+
   // Cluster distribution is initialized with mean-1,
   // to account for there always being 1 pixel in a cluster
   int cluster_size = round((*mRandClusterSizeDist)(mRandClusterSizeGen)) + 1;
@@ -153,8 +186,67 @@ void EventGenBase::initRandomClusterGen(const QSettings* settings)
     mRandClusterXGen.seed(mRandomSeed);
     mRandClusterYGen.seed(mRandomSeed);
   }
+
+  mRandClusterSizeGen.setCounterBased(mCounterBasedRandom);
+  mRandClusterXGen.setCounterBased(mCounterBasedRandom);
+  mRandClusterYGen.setCounterBased(mCounterBasedRandom);
+
+  if(settings->value("event/random_cluster_shape_library").toBool()) {
+    QString shape_file = settings->value("event/random_cluster_shape_file").toString();
+
+    try {
+      if(shape_file.isEmpty()) {
+        unsigned int num_samples = settings->value("event/random_cluster_shape_samples").toUInt();
+        std::uint32_t seed = mRandClusterSizeGen();
+
+        mClusterShapes.reset(new ClusterShapeLibrary(cluster_size_mean, cluster_size_stddev,
+                                                     num_samples, seed));
+      } else {
+        mClusterShapes.reset(new ClusterShapeLibrary(shape_file.toStdString()));
+      }
+    } catch(const std::exception& e) {
+      std::cerr << "Error: " << e.what() << std::endl;
+      exit(-1);
+    }
+
+    std::cout << "Cluster shape library with " << mClusterShapes->getNumShapes();
+    std::cout << " shapes." << std::endl;
+  }
 }
 
+
+///@brief Select the random number stream used by createCluster(), when counter-based
+///       random numbers are used. Clusters created after this call only depend on the
+///       seed and the arguments, and not on clusters created earlier.
+///@param event Event number
+///@param sub_stream Sub stream within event, typically the hit number
+void EventGenBase::setClusterRandomStream(uint64_t event, uint32_t sub_stream)
+{
+  mRandClusterSizeGen.setStream(event, sub_stream);
+  mRandClusterXGen.setStream(event, sub_stream);
+  mRandClusterYGen.setStream(event, sub_stream);
+}
+
+///@brief Group the hits in an event by chip id, so that the detector can input each
+///       chip's hits with one call. The order of the hits for each chip is kept, so
+///       the chips get the same hits in the same order as before.
+///       In single chip simulations all hits go to the same chip, and are not reordered.
+///@param[in,out] hits Hits in event
+void EventGenBase::groupHitsByChip(std::vector<std::shared_ptr<PixelHit>>& hits) const
+{
+  if(mSingleChipSimulation)
+    return;
+
+  auto chip_id_less = [](const std::shared_ptr<PixelHit>& a, const std::shared_ptr<PixelHit>& b) {
+    return a->getChipId() < b->getChipId();
+  };
+
+  // Hits from MC event files are usually sorted by chip already
+  if(!std::is_sorted(hits.begin(), hits.end(), chip_id_less))
+    std::stable_sort(hits.begin(), hits.end(), chip_id_less);
+}
+
+
 void EventGenBase::writeSimulationStats(const std::string output_path) const
 {
   mTriggeredReadoutStats->writeToFile(output_path + std::string("/triggered_readout_stats.csv"));
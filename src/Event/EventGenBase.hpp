@@ -24,8 +24,9 @@
 #include <vector>
 #include <memory>
 #include <string>
-#include <boost/random/mersenne_twister.hpp>
 #include <boost/random/normal_distribution.hpp>
+#include "common/RandomEngine.hpp"
+#include "ClusterShapeLibrary.hpp"
 
 using std::uint64_t;
 
@@ -48,9 +49,9 @@ public: // SystemC signals
   sc_event E_untriggered_event;
 
 private:
-  boost::random::mt19937 mRandClusterSizeGen;
-  boost::random::mt19937 mRandClusterXGen;
-  boost::random::mt19937 mRandClusterYGen;
+  RandomEngine mRandClusterSizeGen{RAND_PURPOSE_CLUSTER_SIZE};
+  RandomEngine mRandClusterXGen{RAND_PURPOSE_CLUSTER_X};
+  RandomEngine mRandClusterYGen{RAND_PURPOSE_CLUSTER_Y};
 
   /// Distribution for size of random cluster (number of pixels in cluster)
   boost::random::normal_distribution<double> *mRandClusterSizeDist;
@@ -58,6 +59,10 @@ private:
   /// Distribution for coordinates among each axis for pixels in cluster
   boost::random::normal_distribution<double> *mRandClusterXDist, *mRandClusterYDist;
 
+  /// Cluster shapes to draw whole clusters from, instead of drawing each pixel.
+  /// Not used (nullptr) unless enabled in the settings.
+  std::unique_ptr<ClusterShapeLibrary> mClusterShapes;
+
 protected:
   int mNumChips = 0;
   int mRandomSeed;
@@ -67,6 +72,10 @@ protected:
   bool mStopEventGeneration = false;
   bool mQedNoiseGenEnable = false;
 
+  /// Use counter-based random number streams, keyed by event number, instead of
+  /// one sequential stream per generator (see RandomEngine.hpp)
+  bool mCounterBasedRandom = false;
+
   uint64_t mQedNoiseFeedRateNs = 0;
   uint64_t mQedNoiseEventRateNs = 0;
 
@@ -91,6 +100,8 @@ protected:
   std::shared_ptr<PixelReadoutStats> mUntriggeredReadoutStats = nullptr;
 
   void initRandomClusterGen(const QSettings* settings);
+  void setClusterRandomStream(uint64_t event, uint32_t sub_stream);
+  void groupHitsByChip(std::vector<std::shared_ptr<PixelHit>>& hits) const;
 
 public:
   EventGenBase(sc_core::sc_module_name name, const QSettings* settings, std::string output_path);
@@ -105,7 +116,17 @@ public:
                                                        nullptr);
   uint64_t getTriggeredEventCount(void) const {return mTriggeredEventCount;}
   uint64_t getUntriggeredEventCount(void) const {return mUntriggeredEventCount;}
+  const std::shared_ptr<PixelReadoutStats>& getTriggeredReadoutStats(void) const {
+    return mTriggeredReadoutStats;
+  }
+  const std::shared_ptr<PixelReadoutStats>& getUntriggeredReadoutStats(void) const {
+    return mUntriggeredReadoutStats;
+  }
   virtual void stopEventGeneration(void) = 0;
+
+  ///@brief Stop and join any threads used for event generation. Must be called before
+  ///       the log is stopped. No more events can be generated afterwards.
+  virtual void stopEventThreads(void) {}
   void writeSimulationStats(const std::string output_path) const;
 };
 
@@ -7,16 +7,23 @@
 
 
 
+#include <algorithm>
+#include <chrono>
 #include <stdexcept>
 #include <cmath>
 #include <map>
+#include <sstream>
 #include <boost/random/random_device.hpp>
 #include <QDir>
 #include "Alpide/alpide_constants.hpp"
+#include "common/Log.hpp"
+#include "common/ProcessProfiler.hpp"
 #include "../utils.hpp"
 #include "EventGenITS.hpp"
 #include "EventXMLITS.hpp"
 #include "EventBinaryITS.hpp"
+#include "EventStoreITS.hpp"
+#include "EventStoreFocal.hpp"
 #include "Detector/Focal/FocalDetectorConfig.hpp"
 
 #ifdef ROOT_ENABLED
@@ -41,10 +48,21 @@ EventGenITS::EventGenITS(sc_core::sc_module_name name,
                          const QSettings* settings,
                          std::string output_path)
   : EventGenBase(name, settings, output_path)
+  , mPipelineStop(false)
   , mDetectorConfig(config)
 {
+  mPipelineEvents = settings->value("event/pipeline_events").toUInt();
   mBunchCrossingRate_ns = settings->value("its/bunch_crossing_rate_ns").toInt();
   mAverageEventRate_ns = settings->value("event/average_event_rate_ns").toInt();
+  mRandomHitBatchGeneration = settings->value("event/random_hit_batch_generation").toBool();
+
+  if(mSimType == "focal") {
+    mChipHitCount.resize(Focal::N_LAYERS*Focal::CHIPS_PER_LAYER, 0);
+    mLayerHitCount.resize(Focal::N_LAYERS, 0);
+  } else {
+    mChipHitCount.resize(ITS::CHIP_COUNT_TOTAL, 0);
+    mLayerHitCount.resize(ITS::N_LAYERS, 0);
+  }
 
   if(mRandomHitGeneration) {
     initRandomHitGen(settings);
@@ -62,6 +80,9 @@ EventGenITS::EventGenITS(sc_core::sc_module_name name,
   if(mCreateCSVFile)
     initCsvEventFileHeader(settings);
 
+  if(settings->value("data_output/write_event_log").toBool())
+    initEventLog();
+
 
   //////////////////////////////////////////////////////////////////////////////
   // SystemC declarations / connections / etc.
@@ -76,6 +97,8 @@ EventGenITS::EventGenITS(sc_core::sc_module_name name,
 ///@brief Destructor for EventGenITS class
 EventGenITS::~EventGenITS()
 {
+  stopPipeline();
+
   if(mRandomHitGeneration) {
     for(unsigned int layer = 0; layer < ITS::N_LAYERS; layer++) {
       delete mRandChipID[layer];
@@ -200,6 +223,9 @@ void EventGenITS::initMonteCarloHitGen(const QSettings* settings)
   QDir monte_carlo_event_dir(monte_carlo_event_path_str);
   QStringList name_filters;
 
+  // Number of MC events to read ahead of time in a background thread
+  unsigned int prefetch_events = settings->value("event/monte_carlo_prefetch_events").toUInt();
+
   if(monte_carlo_file_type == "xml" && mSimType == "its") {
     name_filters << "*.xml";
     QStringList MC_files = monte_carlo_event_dir.entryList(name_filters);
@@ -216,7 +242,9 @@ void EventGenITS::initMonteCarloHitGen(const QSettings* settings)
                                        monte_carlo_event_path_str,
                                        MC_files,
                                        true,
-                                       mRandomSeed);
+                                       mRandomSeed,
+                                       false,
+                                       prefetch_events);
   }
   else if(monte_carlo_file_type == "binary" && mSimType == "its") {
     name_filters << "*.dat";
@@ -234,7 +262,29 @@ void EventGenITS::initMonteCarloHitGen(const QSettings* settings)
                                           monte_carlo_event_path_str,
                                           MC_files,
                                           true,
-                                          mRandomSeed);
+                                          mRandomSeed,
+                                          false,
+                                          prefetch_events);
+  }
+  else if(monte_carlo_file_type == "store" && mSimType == "its") {
+    name_filters << "*.evs";
+    QStringList MC_files = monte_carlo_event_dir.entryList(name_filters);
+
+    if(MC_files.size() != 1) {
+      std::cerr << "Error: Expected one event store .evs file in MC event path, found ";
+      std::cerr << MC_files.size() << std::endl;
+      exit(-1);
+    }
+
+    mMCPhysicsEvents = new EventStoreITS(mDetectorConfig,
+                                         &ITS::ITS_global_chip_id_to_position,
+                                         &ITS::ITS_position_to_global_chip_id,
+                                         monte_carlo_event_path_str,
+                                         MC_files.at(0),
+                                         true,
+                                         mRandomSeed,
+                                         false,
+                                         prefetch_events);
   }
   else if(monte_carlo_file_type == "root" && mSimType == "focal") {
 #ifdef ROOT_ENABLED
@@ -252,12 +302,29 @@ void EventGenITS::initMonteCarloHitGen(const QSettings* settings)
                                       mDetectorConfig.staves_per_quadrant,
                                       random_seed);
 #else
-    std::cerr << "Error: Simulation must be compiled with ROOT support for Focal simulation." << std::endl;
+    std::cerr << "Error: Simulation must be compiled with ROOT support for Focal simulation";
+    std::cerr << " with ROOT files. Use alpide_focal_store_convert and monte_carlo_file_type=store";
+    std::cerr << " to run without ROOT." << std::endl;
     exit(-1);
 #endif
   }
+  else if(monte_carlo_file_type == "store" && mSimType == "focal") {
+    unsigned int random_seed = mRandomSeed;
+
+    if(random_seed == 0) {
+      boost::random::random_device r;
+      random_seed = r();
+    }
+
+    mFocalEvents = new EventStoreFocal(mDetectorConfig,
+                                       &Focal::Focal_global_chip_id_to_position,
+                                       &Focal::Focal_position_to_global_chip_id,
+                                       monte_carlo_focal_data_file_str,
+                                       mDetectorConfig.staves_per_quadrant,
+                                       random_seed);
+  }
   else if(mSimType == "focal") {
-    std::cerr << "Error: Only monte carlo files in ROOT format supported for Focal simulation." << std::endl;
+    std::cerr << "Error: Only monte carlo files in ROOT or event store format supported for Focal simulation." << std::endl;
     exit(-1);
   }
   else if(monte_carlo_file_type == "root" && mSimType == "its") {
@@ -272,6 +339,11 @@ void EventGenITS::initMonteCarloHitGen(const QSettings* settings)
 
   mNumChips = 1;
 
+  if(mMCPhysicsEvents != nullptr)
+    mMCPhysicsEvents->setCounterBasedRandom(mCounterBasedRandom);
+  if(mFocalEvents != nullptr)
+    mFocalEvents->setCounterBasedRandom(mCounterBasedRandom);
+
   QString qed_noise_input = settings->value("event/qed_noise_input").toString();
   if(qed_noise_input == "true") {
     mQedNoiseGenEnable = true;
@@ -316,7 +388,9 @@ void EventGenITS::initMonteCarloHitGen(const QSettings* settings)
                                           qed_noise_event_path_str,
                                           QED_noise_event_files,
                                           true,
-                                          mRandomSeed);
+                                          mRandomSeed,
+                                          false,
+                                          prefetch_events);
     }
     else if(monte_carlo_file_type == "binary") {
       name_filters << "*.dat";
@@ -334,13 +408,37 @@ void EventGenITS::initMonteCarloHitGen(const QSettings* settings)
                                              qed_noise_event_path_str,
                                              QED_noise_event_files,
                                              true,
-                                             mRandomSeed);
+                                             mRandomSeed,
+                                             false,
+                                             prefetch_events);
+    }
+    else if(monte_carlo_file_type == "store") {
+      name_filters << "*.evs";
+      QStringList QED_noise_event_files = qed_noise_event_dir.entryList(name_filters);
+
+      if(QED_noise_event_files.size() != 1) {
+        std::cerr << "Error: Expected one event store .evs file in QED/noise event path, found ";
+        std::cerr << QED_noise_event_files.size() << std::endl;
+        exit(-1);
+      }
+
+      mMCQedNoiseEvents = new EventStoreITS(mDetectorConfig,
+                                            &ITS::ITS_global_chip_id_to_position,
+                                            &ITS::ITS_position_to_global_chip_id,
+                                            qed_noise_event_path_str,
+                                            QED_noise_event_files.at(0),
+                                            true,
+                                            mRandomSeed,
+                                            false,
+                                            prefetch_events);
     }
     else {
       std::cerr << "Error: Unknown MC event format \"";
       std::cerr << monte_carlo_file_type.toStdString() << "\"";
       exit(-1);
     }
+
+    mMCQedNoiseEvents->setCounterBasedRandom(mCounterBasedRandom);
   }
 }
 
@@ -387,20 +485,24 @@ void EventGenITS::initCsvEventFileHeader(const QSettings* settings)
 }
 
 
-void EventGenITS::addCsvEventLine(uint64_t t_delta,
-                                  unsigned int event_pixel_hit_count,
-                                  std::map<unsigned int, unsigned int> &chip_hits,
-                                  std::map<unsigned int, unsigned int> &layer_hits)
+///@brief Get the line for the current event in the CSV file
+///@param t_delta Time until next event
+///@param event_pixel_hit_count Total number of pixel hits for this event
+///@return Line with time to next event, and multiplicity for the event, layers and chips
+std::string EventGenITS::getCsvEventLine(uint64_t t_delta,
+                                         unsigned int event_pixel_hit_count) const
 {
+  std::ostringstream csv_line;
+
   // Write time to next event, and multiplicity for the whole event
-  mPhysicsEventsCSVFile << t_delta << ";" << event_pixel_hit_count;
+  csv_line << t_delta << ";" << event_pixel_hit_count;
 
 
   if(mSimType == "its") {
     // Write multiplicity for whole layers of detectors (of included layers)
     for(unsigned int layer = 0; layer < ITS::N_LAYERS; layer++) {
       if(mDetectorConfig.layer[layer].num_staves > 0)
-        mPhysicsEventsCSVFile << ";" << layer_hits[layer];
+        csv_line << ";" << mLayerHitCount[layer];
     }
 
     // Write multiplicity for the chips that were included in the simulation
@@ -408,7 +510,7 @@ void EventGenITS::addCsvEventLine(uint64_t t_delta,
       unsigned int chip_id = ITS::CUMULATIVE_CHIP_COUNT_AT_LAYER[layer];
       for(unsigned int stave = 0; stave < mDetectorConfig.layer[layer].num_staves; stave++) {
         for(unsigned int stave_chip = 0; stave_chip < ITS::CHIPS_PER_STAVE_IN_LAYER[layer]; stave_chip++) {
-          mPhysicsEventsCSVFile << ";" << chip_hits[chip_id];
+          csv_line << ";" << mChipHitCount[chip_id];
           chip_id++;
         }
       }
@@ -417,7 +519,7 @@ void EventGenITS::addCsvEventLine(uint64_t t_delta,
     // Write multiplicity for whole layers of detectors (of included layers)
     for(unsigned int layer = 0; layer < Focal::N_LAYERS; layer++) {
       if(mDetectorConfig.layer[layer].num_staves > 0)
-        mPhysicsEventsCSVFile << ";" << layer_hits[layer];
+        csv_line << ";" << mLayerHitCount[layer];
     }
 
     // Write multiplicity for the chips that were included in the simulation
@@ -425,14 +527,104 @@ void EventGenITS::addCsvEventLine(uint64_t t_delta,
       unsigned int chip_id = Focal::CUMULATIVE_CHIP_COUNT_AT_LAYER[layer];
       for(unsigned int stave = 0; stave < mDetectorConfig.layer[layer].num_staves; stave++) {
         for(unsigned int stave_chip = 0; stave_chip < Focal::CHIPS_PER_STAVE; stave_chip++) {
-          mPhysicsEventsCSVFile << ";" << chip_hits[chip_id];
+          csv_line << ";" << mChipHitCount[chip_id];
           chip_id++;
         }
       }
     }
   }
 
-  mPhysicsEventsCSVFile << std::endl;
+  csv_line << std::endl;
+
+  return csv_line.str();
+}
+
+
+///@brief Create the binary event log (see EventLogFormat.hpp), with the same layer
+///       and chip columns as the CSV file.
+void EventGenITS::initEventLog(void)
+{
+  std::string filename = mOutputPath + std::string("/physics_events_data.evl");
+  std::vector<unsigned int> chip_ids;
+
+  mEventLogChipColumn.assign(mChipHitCount.size(), -1);
+
+  for(unsigned int layer_id = 0; layer_id < mDetectorConfig.num_layers; layer_id++) {
+    if(mDetectorConfig.layer[layer_id].num_staves > 0)
+      mEventLogLayers.push_back(layer_id);
+  }
+
+  for(unsigned int layer_id = 0; layer_id < mDetectorConfig.num_layers; layer_id++) {
+    unsigned int chip_id;
+    unsigned int chips_per_stave;
+
+    if(mSimType == "its") {
+      chip_id = ITS::CUMULATIVE_CHIP_COUNT_AT_LAYER[layer_id];
+      chips_per_stave = ITS::CHIPS_PER_STAVE_IN_LAYER[layer_id];
+    } else if(mSimType == "focal") {
+      chip_id = Focal::CUMULATIVE_CHIP_COUNT_AT_LAYER[layer_id];
+      chips_per_stave = Focal::CHIPS_PER_STAVE;
+    } else {
+      throw std::runtime_error("Unknown sim type");
+    }
+
+    for(unsigned int stave = 0; stave < mDetectorConfig.layer[layer_id].num_staves; stave++) {
+      for(unsigned int stave_chip = 0; stave_chip < chips_per_stave; stave_chip++) {
+        mEventLogChipColumn[chip_id] = chip_ids.size();
+        chip_ids.push_back(chip_id);
+        chip_id++;
+      }
+    }
+  }
+
+  try {
+    mEventLog.reset(new EventLogWriter(filename, mEventLogLayers, chip_ids));
+  } catch(const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    exit(-1);
+  }
+}
+
+
+///@brief Get the layer and chip counts for the current event in the binary event log.
+///       Only the chips with hits in this event are included.
+///@param[out] layer_counts Hit count for each layer column in the event log
+///@param[out] chip_counts Hit counts for the chip columns with hits, sorted by column
+void EventGenITS::getEventLogCounts(std::vector<unsigned int>& layer_counts,
+                                    std::vector<EventLog::ChipCount>& chip_counts) const
+{
+  layer_counts.clear();
+  for(auto it = mEventLogLayers.begin(); it != mEventLogLayers.end(); it++)
+    layer_counts.push_back(mLayerHitCount[*it]);
+
+  chip_counts.clear();
+  for(auto it = mEventHitChips.begin(); it != mEventHitChips.end(); it++) {
+    int column = mEventLogChipColumn[*it];
+
+    if(column >= 0 && mChipHitCount[*it] > 0) {
+      EventLog::ChipCount chip_count = {std::uint32_t(column), mChipHitCount[*it]};
+      chip_counts.push_back(chip_count);
+    }
+  }
+
+  std::sort(chip_counts.begin(), chip_counts.end(),
+            [](const EventLog::ChipCount& a, const EventLog::ChipCount& b) {
+              return a.column < b.column;
+            });
+}
+
+
+///@brief Write the CSV line and event log record of a physics event. Called when the
+///       event is used by physicsEventMethod(), so that events generated ahead on the
+///       pipeline thread and discarded by stopPipeline() are not written.
+///@param event Physics event from generateNextPhysicsEvent()
+void EventGenITS::writePhysicsEventOutput(const PhysicsEvent& event)
+{
+  if(mCreateCSVFile)
+    mPhysicsEventsCSVFile << event.csv_line;
+
+  if(mEventLog)
+    mEventLog->writeEvent(event.t_delta, event.hit_count, event.log_layer_counts, event.log_chip_counts);
 }
 
 
@@ -443,7 +635,7 @@ void EventGenITS::addCsvEventLine(uint64_t t_delta,
 ///        contains the hits in the latest event.
 const std::vector<std::shared_ptr<PixelHit>>& EventGenITS::getTriggeredEvent(void) const
 {
-  return mEventHitVector;
+  return mTriggeredHitVector;
 }
 
 
@@ -487,11 +679,20 @@ void EventGenITS::initRandomNumGen(const QSettings* settings)
     random_seed = r();
     mRandEventTimeGen.seed(random_seed);
     std::cout << "Event rate generator random seed: " << random_seed << std::endl;
+
+    random_seed = r();
+    mFastRandHitGen.seed(random_seed);
+    std::cout << "Batch hit coordinates generator random seed: " << random_seed << std::endl;
   } else {
     mRandHitGen.seed(mRandomSeed);
+    mFastRandHitGen.seed(mRandomSeed);
     mRandHitMultiplicityGen.seed(mRandomSeed);
     mRandEventTimeGen.seed(mRandomSeed);
   }
+
+  mRandHitGen.setCounterBased(mCounterBasedRandom);
+  mRandHitMultiplicityGen.setCounterBased(mCounterBasedRandom);
+  mRandEventTimeGen.setCounterBased(mCounterBasedRandom);
 }
 
 
@@ -611,16 +812,181 @@ unsigned int EventGenITS::getRandomMultiplicity(void)
 }
 
 
+///@brief Clear the per chip and per layer hit counts for the previous event
+void EventGenITS::clearHitCounts(void)
+{
+  for(auto it = mEventHitChips.begin(); it != mEventHitChips.end(); it++)
+    mChipHitCount[*it] = 0;
+
+  mEventHitChips.clear();
+  std::fill(mLayerHitCount.begin(), mLayerHitCount.end(), 0);
+}
+
+
+///@brief Create a 2x2 pixel cluster for a random hit, and add the pixels to the hit vector
+///@param[in] x1 Column of the hit
+///@param[in] y1 Row of the hit
+///@param[in] chip_id Global chip id of the hit
+///@param[in] event_time_ns Time when event occured
+void EventGenITS::addClusterHits(unsigned int x1, unsigned int y1, unsigned int chip_id,
+                                 uint64_t event_time_ns)
+{
+  unsigned int x2, y2;
+
+  // Very simple and silly method for making 2x2 pixel cluster
+  // Makes sure that we don't get pixels below row/col 0, and not above
+  // row 511 or above column 1023
+  if(x1 < N_PIXEL_COLS/2) {
+    x2 = x1+1;
+  } else {
+    x2 = x1-1;
+  }
+
+  if(y1 < N_PIXEL_ROWS/2) {
+    y2 = y1+1;
+  } else {
+    y2 = y1-1;
+  }
+
+  // Create hit with timing information and pointer to readout stats object
+  std::shared_ptr<PixelHit> pix1_shared = std::make_shared<PixelHit>(x1, y1, chip_id);
+  std::shared_ptr<PixelHit> pix2_shared = std::make_shared<PixelHit>(x1, y2, chip_id);
+  std::shared_ptr<PixelHit> pix3_shared = std::make_shared<PixelHit>(x2, y1, chip_id);
+  std::shared_ptr<PixelHit> pix4_shared = std::make_shared<PixelHit>(x2, y2, chip_id);
+
+  pix1_shared->setActiveTimeStart(event_time_ns+mPixelDeadTime);
+  pix2_shared->setActiveTimeStart(event_time_ns+mPixelDeadTime);
+  pix3_shared->setActiveTimeStart(event_time_ns+mPixelDeadTime);
+  pix4_shared->setActiveTimeStart(event_time_ns+mPixelDeadTime);
+
+  pix1_shared->setActiveTimeEnd(event_time_ns+mPixelDeadTime+mPixelActiveTime);
+  pix2_shared->setActiveTimeEnd(event_time_ns+mPixelDeadTime+mPixelActiveTime);
+  pix3_shared->setActiveTimeEnd(event_time_ns+mPixelDeadTime+mPixelActiveTime);
+  pix4_shared->setActiveTimeEnd(event_time_ns+mPixelDeadTime+mPixelActiveTime);
+
+  pix1_shared->setPixelReadoutStatsObj(mTriggeredReadoutStats);
+  pix2_shared->setPixelReadoutStatsObj(mTriggeredReadoutStats);
+  pix3_shared->setPixelReadoutStatsObj(mTriggeredReadoutStats);
+  pix4_shared->setPixelReadoutStatsObj(mTriggeredReadoutStats);
+
+  mEventHitVector.push_back(pix1_shared);
+  mEventHitVector.push_back(pix2_shared);
+  mEventHitVector.push_back(pix3_shared);
+  mEventHitVector.push_back(pix4_shared);
+}
+
+
+///@brief Generate the hits for a random event in blocks. For each layer, the coordinates
+///       of all the hits are drawn into arrays with the fast generator, and pixels are
+///       only created for the hits on staves that are included in the simulation.
+///       The event is statistically the same as with the boost distributions in
+///       generateRandomEventData(), but the random sequence is different.
+///@param[in] event_time_ns Time when event occured
+///@param[in] n_particle_hits_unscaled Random multiplicity for the event
+///@param[out] event_pixel_hit_count Total number of pixel hits for this event
+void EventGenITS::generateRandomHitsBatch(uint64_t event_time_ns,
+                                          unsigned int n_particle_hits_unscaled,
+                                          unsigned int &event_pixel_hit_count)
+{
+  if(mSingleChipSimulation) {
+    unsigned int n_hits = n_particle_hits_unscaled * mSingleChipMultiplicityScaleFactor;
+
+    setHitRandomStream(0);
+
+    mBatchX.resize(n_hits);
+    mBatchY.resize(n_hits);
+    mFastRandHitGen.fillRange(mBatchX.data(), n_hits, N_PIXEL_COLS);
+    mFastRandHitGen.fillRange(mBatchY.data(), n_hits, N_PIXEL_ROWS);
+
+    for(unsigned int i = 0; i < n_hits; i++)
+      addClusterHits(mBatchX[i], mBatchY[i], 0, event_time_ns);
+
+    event_pixel_hit_count += 4*n_hits;
+    return;
+  }
+
+  for(unsigned int layer = 0; layer < ITS::N_LAYERS; layer++) {
+    const unsigned int num_staves = mDetectorConfig.layer[layer].num_staves;
+
+    // Skip this layer if no staves are configured for this
+    // layer in simulation settings file
+    if(num_staves == 0)
+      continue;
+
+    unsigned int n_hits = n_particle_hits_unscaled * mMultiplicityScaleFactor[layer];
+
+    setHitRandomStream(layer);
+
+    mBatchStave.resize(n_hits);
+    mFastRandHitGen.fillRange(mBatchStave.data(), n_hits, ITS::STAVES_PER_LAYER[layer]);
+
+    // Keep only the hits on the first N staves that were defined in the simulation
+    // settings file, the other coordinates are only drawn for those hits
+    unsigned int n_stave_hits = 0;
+    for(unsigned int i = 0; i < n_hits; i++) {
+      mBatchStave[n_stave_hits] = mBatchStave[i];
+      n_stave_hits += mBatchStave[i] < num_staves;
+    }
+
+    mBatchSubStave.assign(n_stave_hits, 0);
+    mBatchModule.assign(n_stave_hits, 0);
+    mBatchChip.resize(n_stave_hits);
+    mBatchX.resize(n_stave_hits);
+    mBatchY.resize(n_stave_hits);
+
+    if(layer > 2) { // Sub staves and modules are not used for IB layers
+      mFastRandHitGen.fillRange(mBatchSubStave.data(), n_stave_hits, ITS::SUB_STAVES_PER_STAVE[layer]);
+      mFastRandHitGen.fillRange(mBatchModule.data(), n_stave_hits, ITS::MODULES_PER_SUB_STAVE_IN_LAYER[layer]);
+    }
+
+    mFastRandHitGen.fillRange(mBatchChip.data(), n_stave_hits, ITS::CHIPS_PER_MODULE_IN_LAYER[layer]);
+    mFastRandHitGen.fillRange(mBatchX.data(), n_stave_hits, N_PIXEL_COLS);
+    mFastRandHitGen.fillRange(mBatchY.data(), n_stave_hits, N_PIXEL_ROWS);
+
+    for(unsigned int i = 0; i < n_stave_hits; i++) {
+      Detector::DetectorPosition pos = {layer,
+                                        mBatchStave[i],
+                                        mBatchSubStave[i],
+                                        mBatchModule[i],
+                                        mBatchChip[i]};
+
+      unsigned int global_chip_id = ITS::ITS_position_to_global_chip_id(pos);
+
+      countHits(global_chip_id, layer, 1);
+      addClusterHits(mBatchX[i], mBatchY[i], global_chip_id, event_time_ns);
+    }
+
+    event_pixel_hit_count += 4*n_stave_hits;
+  }
+}
+
+
+///@brief Select the random number streams used for the hit coordinates of the current
+///       event, when counter-based random numbers are used. The batch generator is
+///       sequential, so it is seeded from the counter-based stream.
+///@param sub_stream Sub stream within event (layer number)
+void EventGenITS::setHitRandomStream(uint32_t sub_stream)
+{
+  if(mCounterBasedRandom == false)
+    return;
+
+  mRandHitGen.setStream(mGeneratedEventCount, sub_stream);
+
+  if(mRandomHitBatchGeneration) {
+    uint64_t seed = mRandHitGen();
+    mFastRandHitGen.seed((seed << 32) | mRandHitGen());
+  }
+}
+
+
 ///@brief Generate a random event, and put it in the hit vector.
+///       The number of hits per chip and per layer are counted in mChipHitCount
+///       and mLayerHitCount.
 ///@param[out] event_time_ns Time when event occured
 ///@param[out] event_pixel_hit_count Total number of pixel hits for this event,
 ///            for all layers/chips, including chips/layers that are excluded from the simulation
-///@param[out] chip_hits Map with number of pixel hits for this event per chip ID
-///@param[out] layer_hits Map with number of pixel hits for this event per layer
 void EventGenITS::generateRandomEventData(uint64_t event_time_ns,
-                                          unsigned int &event_pixel_hit_count,
-                                          std::map<unsigned int, unsigned int> &chip_hits,
-                                          std::map<unsigned int, unsigned int> &layer_hits)
+                                          unsigned int &event_pixel_hit_count)
 {
   // Random number of hits directly from discrete multiplicity distribution
   unsigned int n_particle_hits_unscaled = 0;
@@ -634,57 +1000,21 @@ void EventGenITS::generateRandomEventData(uint64_t event_time_ns,
   // Generate an uncorrected random number of particle hits for this event
   n_particle_hits_unscaled = getRandomMultiplicity();
 
-  if(mSingleChipSimulation && n_particle_hits_unscaled > 0) {
+  if(mRandomHitBatchGeneration) {
+    generateRandomHitsBatch(event_time_ns, n_particle_hits_unscaled, event_pixel_hit_count);
+  } else if(mSingleChipSimulation && n_particle_hits_unscaled > 0) {
     n_particle_hits_scaled = n_particle_hits_unscaled * mSingleChipMultiplicityScaleFactor;
 
+    setHitRandomStream(0);
+
     for(unsigned int i = 0; i < n_particle_hits_scaled; i++) {
       unsigned int rand_x1 = (*mRandHitChipX)(mRandHitGen);
       unsigned int rand_y1 = (*mRandHitChipY)(mRandHitGen);
-      unsigned int rand_x2, rand_y2;
-
-      // Very simple and silly method for making 2x2 pixel cluster
-      // Makes sure that we don't get pixels below row/col 0, and not above
-      // row 511 or above column 1023
-      if(rand_x1 < N_PIXEL_COLS/2) {
-        rand_x2 = rand_x1+1;
-      } else {
-        rand_x2 = rand_x1-1;
-      }
-
-      if(rand_y1 < N_PIXEL_ROWS/2) {
-        rand_y2 = rand_y1+1;
-      } else {
-        rand_y2 = rand_y1-1;
-      }
 
       ///@todo USE createCluster method in EventGenBase here....
       event_pixel_hit_count += 4;
 
-      // Create hit with timing information and pointer to readout stats object
-      std::shared_ptr<PixelHit> pix1_shared = std::make_shared<PixelHit>(rand_x1, rand_y1, 0);
-      std::shared_ptr<PixelHit> pix2_shared = std::make_shared<PixelHit>(rand_x1, rand_y2, 0);
-      std::shared_ptr<PixelHit> pix3_shared = std::make_shared<PixelHit>(rand_x2, rand_y1, 0);
-      std::shared_ptr<PixelHit> pix4_shared = std::make_shared<PixelHit>(rand_x2, rand_y2, 0);
-
-      pix1_shared->setActiveTimeStart(event_time_ns+mPixelDeadTime);
-      pix2_shared->setActiveTimeStart(event_time_ns+mPixelDeadTime);
-      pix3_shared->setActiveTimeStart(event_time_ns+mPixelDeadTime);
-      pix4_shared->setActiveTimeStart(event_time_ns+mPixelDeadTime);
-
-      pix1_shared->setActiveTimeEnd(event_time_ns+mPixelDeadTime+mPixelActiveTime);
-      pix2_shared->setActiveTimeEnd(event_time_ns+mPixelDeadTime+mPixelActiveTime);
-      pix3_shared->setActiveTimeEnd(event_time_ns+mPixelDeadTime+mPixelActiveTime);
-      pix4_shared->setActiveTimeEnd(event_time_ns+mPixelDeadTime+mPixelActiveTime);
-
-      pix1_shared->setPixelReadoutStatsObj(mTriggeredReadoutStats);
-      pix2_shared->setPixelReadoutStatsObj(mTriggeredReadoutStats);
-      pix3_shared->setPixelReadoutStatsObj(mTriggeredReadoutStats);
-      pix4_shared->setPixelReadoutStatsObj(mTriggeredReadoutStats);
-
-      mEventHitVector.push_back(pix1_shared);
-      mEventHitVector.push_back(pix2_shared);
-      mEventHitVector.push_back(pix3_shared);
-      mEventHitVector.push_back(pix4_shared);
+      addClusterHits(rand_x1, rand_y1, 0, event_time_ns);
     }
   } else if(n_particle_hits_unscaled > 0) { // Generate hits for each layer in ITS detector simulation
     for(unsigned int layer = 0; layer < ITS::N_LAYERS; layer++) {
@@ -697,6 +1027,8 @@ void EventGenITS::generateRandomEventData(uint64_t event_time_ns,
 
       n_particle_hits_scaled = n_particle_hits_unscaled * mMultiplicityScaleFactor[layer];
 
+      setHitRandomStream(layer);
+
 #ifdef PIXEL_DEBUG
       std::cout << "@ " << event_time_ns << " ns: ";
       std::cout << "Generating " << n_particle_hits_scaled;
@@ -725,22 +1057,6 @@ void EventGenITS::generateRandomEventData(uint64_t event_time_ns,
 
         unsigned int rand_x1 = (*mRandHitChipX)(mRandHitGen);
         unsigned int rand_y1 = (*mRandHitChipY)(mRandHitGen);
-        unsigned int rand_x2, rand_y2;
-
-        // Very simple and silly method for making 2x2 pixel cluster
-        // Makes sure that we don't get pixels below row/col 0, and not above
-        // row 511 or above column 1023
-        if(rand_x1 < N_PIXEL_COLS/2) {
-          rand_x2 = rand_x1+1;
-        } else {
-          rand_x2 = rand_x1-1;
-        }
-
-        if(rand_y1 < N_PIXEL_ROWS/2) {
-          rand_y2 = rand_y1+1;
-        } else {
-          rand_y2 = rand_y1-1;
-        }
 
         Detector::DetectorPosition pos = {layer,
                                           rand_stave_id,
@@ -762,34 +1078,8 @@ void EventGenITS::generateRandomEventData(uint64_t event_time_ns,
         ///@todo Account for larger/bigger clusters here (when implemented)
         event_pixel_hit_count += 4;
 
-        layer_hits[layer]++;
-        chip_hits[global_chip_id]++;
-
-        // Create hit with timing information and pointer to readout stats object
-        std::shared_ptr<PixelHit> pix1_shared = std::make_shared<PixelHit>(rand_x1, rand_y1, global_chip_id);
-        std::shared_ptr<PixelHit> pix2_shared = std::make_shared<PixelHit>(rand_x1, rand_y2, global_chip_id);
-        std::shared_ptr<PixelHit> pix3_shared = std::make_shared<PixelHit>(rand_x2, rand_y1, global_chip_id);
-        std::shared_ptr<PixelHit> pix4_shared = std::make_shared<PixelHit>(rand_x2, rand_y2, global_chip_id);
-
-        pix1_shared->setActiveTimeStart(event_time_ns+mPixelDeadTime);
-        pix2_shared->setActiveTimeStart(event_time_ns+mPixelDeadTime);
-        pix3_shared->setActiveTimeStart(event_time_ns+mPixelDeadTime);
-        pix4_shared->setActiveTimeStart(event_time_ns+mPixelDeadTime);
-
-        pix1_shared->setActiveTimeEnd(event_time_ns+mPixelDeadTime+mPixelActiveTime);
-        pix2_shared->setActiveTimeEnd(event_time_ns+mPixelDeadTime+mPixelActiveTime);
-        pix3_shared->setActiveTimeEnd(event_time_ns+mPixelDeadTime+mPixelActiveTime);
-        pix4_shared->setActiveTimeEnd(event_time_ns+mPixelDeadTime+mPixelActiveTime);
-
-        pix1_shared->setPixelReadoutStatsObj(mTriggeredReadoutStats);
-        pix2_shared->setPixelReadoutStatsObj(mTriggeredReadoutStats);
-        pix3_shared->setPixelReadoutStatsObj(mTriggeredReadoutStats);
-        pix4_shared->setPixelReadoutStatsObj(mTriggeredReadoutStats);
-
-        mEventHitVector.push_back(pix1_shared);
-        mEventHitVector.push_back(pix2_shared);
-        mEventHitVector.push_back(pix3_shared);
-        mEventHitVector.push_back(pix4_shared);
+        countHits(global_chip_id, layer, 1);
+        addClusterHits(rand_x1, rand_y1, global_chip_id, event_time_ns);
       } // Hit generation loop
     } // Layer loop
   } // Detector simulation
@@ -797,15 +1087,13 @@ void EventGenITS::generateRandomEventData(uint64_t event_time_ns,
 
 
 ///@brief Generate a monte carlo event (ie. read it from file), and put it in the hit vector.
+///       The number of hits per chip and per layer are counted in mChipHitCount
+///       and mLayerHitCount.
 ///@param[out] event_time_ns Time when event occured
 ///@param[out] event_pixel_hit_count Total number of pixel hits for this event,
 ///            for all layers/chips, including chips/layers that are excluded from the simulation
-///@param[out] chip_hits Map with number of pixel hits for this event per chip ID
-///@param[out] layer_hits Map with number of pixel hits for this event per layer
 void EventGenITS::generateMonteCarloEventData(uint64_t event_time_ns,
-                                              unsigned int &event_pixel_hit_count,
-                                              std::map<unsigned int, unsigned int> &chip_hits,
-                                              std::map<unsigned int, unsigned int> &layer_hits)
+                                              unsigned int &event_pixel_hit_count)
 {
   // Clear old hit data
   mEventHitVector.clear();
@@ -814,13 +1102,9 @@ void EventGenITS::generateMonteCarloEventData(uint64_t event_time_ns,
 
   if(mSimType == "its")
     digits = mMCPhysicsEvents->getNextEvent();
-  else if(mSimType == "focal") {
-#ifdef ROOT_ENABLED
+  else if(mSimType == "focal")
     digits = mFocalEvents->getNextEvent();
-#else
-    throw std::runtime_error("EventGenITS::generateMonteCarloEventData(): Compile with ROOT for focal sim.");
-#endif
-  } else
+  else
     throw std::runtime_error("EventGenITS::generateMonteCarloEventData(): Invalid sim type.");
 
   if(digits == nullptr)
@@ -831,11 +1115,14 @@ void EventGenITS::generateMonteCarloEventData(uint64_t event_time_ns,
 
   event_pixel_hit_count = digits->size();
 
+  uint32_t hit_index = 0;
+
   while(digit_it != digit_end_it) {
     const PixelHit &pix = *digit_it;
 
     if(mRandomClusterGeneration) {
       // Create random cluster around pixel hit
+      setClusterRandomStream(mGeneratedEventCount, hit_index);
 
       std::vector<std::shared_ptr<PixelHit>> pix_cluster = createCluster(pix,
                                                                          event_time_ns,
@@ -853,8 +1140,7 @@ void EventGenITS::generateMonteCarloEventData(uint64_t event_time_ns,
       // if pixels are outside matrix boundaries then they are ignored. Hence it is sufficient
       // to add the number of pixels in the cluster, we don't have to check that they all
       // belong to the same chip.
-      layer_hits[pos.layer_id] += pix_cluster.size();
-      chip_hits[pix.getChipId()] += pix_cluster.size();
+      countHits(pix.getChipId(), pos.layer_id, pix_cluster.size());
 
       // Copy pixels from cluster over to the event hit vector
       mEventHitVector.insert(mEventHitVector.end(), pix_cluster.begin(), pix_cluster.end());
@@ -877,37 +1163,47 @@ void EventGenITS::generateMonteCarloEventData(uint64_t event_time_ns,
       else // Focal
         pos = Focal::Focal_global_chip_id_to_position(pix.getChipId());
 
-      layer_hits[pos.layer_id]++;
-      chip_hits[pix.getChipId()]++;
+      countHits(pix.getChipId(), pos.layer_id, 1);
     }
 
     digit_it++;
+    hit_index++;
   }
 }
 
 
 ///@brief Generate the next physics event (in the future).
 ///       1) Generate time till the next physics event
-///       2) Generate hits for the next event, and put them on the hit queue
+///       2) Generate hits for the next event, and put them in mEventHitVector
 ///       3) Update counters etc.
-///@return The number of clock cycles until this event will actually occur
-uint64_t EventGenITS::generateNextPhysicsEvent(void)
+///       4) Create the CSV line and event log counts for the event, which are
+///          written later by writePhysicsEventOutput()
+///       Only uses state that belongs to the event generation, so that it can run
+///       on the pipeline thread while the SystemC side uses earlier events.
+///@param[in] event_time_ns Time of the event
+///@param[out] event Time until the next event (ns), hit count, CSV line and event log
+///                  counts for the event. The hits are left in mEventHitVector.
+void EventGenITS::generateNextPhysicsEvent(uint64_t event_time_ns, PhysicsEvent& event)
 {
-  uint64_t time_now = sc_time_stamp().value();
   unsigned int event_pixel_hit_count = 0;
   uint64_t t_delta, t_delta_cycles;
 
-  std::map<unsigned int, unsigned int> layer_hits;
-  std::map<unsigned int, unsigned int> chip_hits;
+  mGeneratedEventCount++;
+
+  // Only has an effect with counter-based random numbers
+  mRandHitMultiplicityGen.setStream(mGeneratedEventCount);
+  mRandEventTimeGen.setStream(mGeneratedEventCount);
 
-  mTriggeredEventCount++;
+  clearHitCounts();
 
   if(mRandomHitGeneration == true) {
-    generateRandomEventData(time_now, event_pixel_hit_count, chip_hits, layer_hits);
+    generateRandomEventData(event_time_ns, event_pixel_hit_count);
   } else {
-    generateMonteCarloEventData(time_now, event_pixel_hit_count, chip_hits, layer_hits);
+    generateMonteCarloEventData(event_time_ns, event_pixel_hit_count);
   }
 
+  groupHitsByChip(mEventHitVector);
+
   // Generate random (exponential distributed) interval till next event/interaction
   // The exponential distribution only works with double float, that's why it is rounded
   // to nearest clock cycle. Which is okay, because events in LHC should be synchronous
@@ -917,19 +1213,23 @@ uint64_t EventGenITS::generateNextPhysicsEvent(void)
   t_delta_cycles = std::round((*mRandEventTime)(mRandEventTimeGen)) + 1;
   t_delta = t_delta_cycles * mBunchCrossingRate_ns;
 
-  // Write event rate and multiplicity numbers to CSV file
+  event.t_delta = t_delta;
+  event.hit_count = event_pixel_hit_count;
+
+  // Event rate and multiplicity numbers for the CSV file and event log
   if(mCreateCSVFile)
-    addCsvEventLine(t_delta, event_pixel_hit_count, chip_hits, layer_hits);
+    event.csv_line = getCsvEventLine(t_delta, event_pixel_hit_count);
+
+  if(mEventLog)
+    getEventLogCounts(event.log_layer_counts, event.log_chip_counts);
 
-  if(mTriggeredEventCount % 100 == 0) {
-    std::cout << "@ " << time_now << " ns: ";
-    std::cout << "\tPhysics event number: " << mTriggeredEventCount;
-    std::cout << "\tt_delta: " << t_delta;
-    std::cout << "\tt_delta_cycles: " << t_delta_cycles;
-    //std::cout << "\tmLastPhysicsEventTimeNs: " << mLastPhysicsEventTimeNs << std::endl;
+  if(mGeneratedEventCount % 100 == 0) {
+    LOG(EVENT, INFO) << "@ " << event_time_ns << " ns: "
+                     << "\tPhysics event number: " << mGeneratedEventCount
+                     << "\tt_delta: " << t_delta
+                     << "\tt_delta_cycles: " << t_delta_cycles;
   }
 
-  return t_delta;
 }
 
 
@@ -961,23 +1261,113 @@ void EventGenITS::generateNextQedNoiseEvent(uint64_t event_time_ns)
 
     digit_it++;
   }
+
+  groupHitsByChip(mQedNoiseHitVector);
 }
 
 
 ///@brief SystemC controlled method. Creates new physics events (hits)
 void EventGenITS::physicsEventMethod(void)
 {
+  PROFILE_PROCESS(EVENT_GEN);
+
   if(mStopEventGeneration == false) {
-    uint64_t t_delta = generateNextPhysicsEvent();
+    uint64_t t_delta;
+
+    if(mPipelineEvents > 0) {
+      // Events are generated from the time of the first event, since the time of each
+      // event is the time of the previous event plus its t_delta.
+      if(!mPipelineThread.joinable()) {
+        mPipelineQueue.reset(new SpscQueue<PhysicsEvent>(mPipelineEvents));
+        mPipelineThread = std::thread(&EventGenITS::pipelineThread, this,
+                                      sc_time_stamp().value());
+      }
+
+      PhysicsEvent event = mPipelineQueue->pop();
+
+      if(event.error)
+        std::rethrow_exception(event.error);
+
+      writePhysicsEventOutput(event);
+      t_delta = event.t_delta;
+      mTriggeredHitVector.swap(event.hits);
+    } else {
+      generateNextPhysicsEvent(sc_time_stamp().value(), mPhysicsEvent);
+      writePhysicsEventOutput(mPhysicsEvent);
+      t_delta = mPhysicsEvent.t_delta;
+      mTriggeredHitVector.swap(mEventHitVector);
+    }
+
+    mTriggeredEventCount++;
     E_triggered_event.notify();
     next_trigger(t_delta, SC_NS);
   }
 }
 
 
+///@brief Worker thread that generates physics events ahead of time into the pipeline
+///       queue. The thread is the only user of the physics event generation state
+///       (random number generators, MC event files and hit counters) while it runs,
+///       so the events are the same as when they are generated in
+///       physicsEventMethod(). The CSV file and event log are written on the SystemC
+///       side, when the events are taken from the queue.
+///@param start_time_ns Time of the first event
+void EventGenITS::pipelineThread(uint64_t start_time_ns)
+{
+  uint64_t event_time_ns = start_time_ns;
+
+  while(!mPipelineStop.load()) {
+    PhysicsEvent event;
+
+    try {
+      generateNextPhysicsEvent(event_time_ns, event);
+    } catch(...) {
+      event.error = std::current_exception();
+    }
+
+    event.hits.swap(mEventHitVector);
+    event_time_ns += event.t_delta;
+
+    bool last_event = bool(event.error);
+
+    while(!mPipelineQueue->tryPush(std::move(event))) {
+      if(mPipelineStop.load()) {
+        // Hits that were never used should not count in the readout stats
+        for(auto it = event.hits.begin(); it != event.hits.end(); it++)
+          (*it)->setPixelReadoutStatsObj(nullptr);
+        return;
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    if(last_event)
+      return;
+  }
+}
+
+
+///@brief Stop the pipeline thread, and discard the events it generated ahead
+void EventGenITS::stopPipeline(void)
+{
+  if(!mPipelineThread.joinable())
+    return;
+
+  mPipelineStop.store(true);
+  mPipelineThread.join();
+
+  PhysicsEvent event;
+  while(mPipelineQueue->tryPop(event)) {
+    for(auto it = event.hits.begin(); it != event.hits.end(); it++)
+      (*it)->setPixelReadoutStatsObj(nullptr);
+  }
+}
+
+
 ///@brief SystemC controlled method. Creates new QED/Noise events (hits)
 void EventGenITS::qedNoiseEventMethod(void)
 {
+  PROFILE_PROCESS(EVENT_GEN);
+
   if(mStopEventGeneration == false) {
     uint64_t time_now = sc_time_stamp().value();
 
@@ -991,6 +1381,23 @@ void EventGenITS::qedNoiseEventMethod(void)
 void EventGenITS::stopEventGeneration(void)
 {
   mStopEventGeneration = true;
+  stopPipeline();
   mEventHitVector.clear();
+  mTriggeredHitVector.clear();
   mQedNoiseHitVector.clear();
 }
+
+
+///@brief Stop the pipeline thread, and then the prefetch threads of the MC event
+///       sources that it reads from. Called when the simulation has ended, also
+///       when it ended without stopEventGeneration() being called.
+void EventGenITS::stopEventThreads(void)
+{
+  stopPipeline();
+
+  if(mMCPhysicsEvents != nullptr)
+    mMCPhysicsEvents->stopPrefetch();
+
+  if(mMCQedNoiseEvents != nullptr)
+    mMCQedNoiseEvents->stopPrefetch();
+}
@@ -10,6 +10,11 @@
 #ifndef EVENT_GEN_ITS_HPP
 #define EVENT_GEN_ITS_HPP
 
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <string>
 #include <boost/random/uniform_int_distribution.hpp>
 #include <boost/random/exponential_distribution.hpp>
 #include <boost/random/discrete_distribution.hpp>
@@ -17,10 +22,10 @@
 #include "Detector/ITS/ITSDetectorConfig.hpp"
 #include "EventGenBase.hpp"
 #include "EventBaseDiscrete.hpp"
-
-#ifdef ROOT_ENABLED
-#include "EventRootFocal.hpp"
-#endif
+#include "EventFocalBase.hpp"
+#include "common/FastRandom.hpp"
+#include "common/SpscQueue.hpp"
+#include "EventLog.hpp"
 
 
 ///@brief   A simple event generator for ITS simulation with Alpide SystemC simulation model.
@@ -38,18 +43,47 @@
 class EventGenITS : public EventGenBase
 {
 private:
+  /// Hits of the physics event being generated
   std::vector<std::shared_ptr<PixelHit>> mEventHitVector;
+
+  /// Hits of the current physics event, returned by getTriggeredEvent()
+  std::vector<std::shared_ptr<PixelHit>> mTriggeredHitVector;
+
   std::vector<std::shared_ptr<PixelHit>> mQedNoiseHitVector;
 
+  /// Number of physics events generated. Ahead of mTriggeredEventCount when
+  /// events are generated on the pipeline thread.
+  uint64_t mGeneratedEventCount = 0;
+
+  /// Physics event, with the line for the CSV file and the counts for the event log.
+  /// These are written by writePhysicsEventOutput() when the event is used.
+  struct PhysicsEvent {
+    uint64_t t_delta = 0;
+    unsigned int hit_count = 0;
+    std::vector<std::shared_ptr<PixelHit>> hits;
+    std::string csv_line;
+    std::vector<unsigned int> log_layer_counts;
+    std::vector<EventLog::ChipCount> log_chip_counts;
+    std::exception_ptr error;
+  };
+
+  /// Physics event generated in physicsEventMethod() when the pipeline is not used
+  PhysicsEvent mPhysicsEvent;
+
+  /// Number of physics events to generate ahead in a worker thread, 0 to generate
+  /// events in physicsEventMethod()
+  unsigned int mPipelineEvents;
+  std::unique_ptr<SpscQueue<PhysicsEvent>> mPipelineQueue;
+  std::thread mPipelineThread;
+  std::atomic<bool> mPipelineStop;
+
   int mBunchCrossingRate_ns;
   int mAverageEventRate_ns;
 
   EventBaseDiscrete* mMCPhysicsEvents = nullptr;
   EventBaseDiscrete* mMCQedNoiseEvents = nullptr;
 
-#ifdef ROOT_ENABLED
-  EventRootFocal* mFocalEvents = nullptr;
-#endif
+  EventFocalBase* mFocalEvents = nullptr;
 
   Detector::DetectorConfigBase mDetectorConfig;
 
@@ -63,9 +97,9 @@ private:
   double mSingleChipHitAverage;
   double mSingleChipMultiplicityScaleFactor;
 
-  boost::random::mt19937 mRandHitGen;
-  boost::random::mt19937 mRandHitMultiplicityGen;
-  boost::random::mt19937 mRandEventTimeGen;
+  RandomEngine mRandHitGen{RAND_PURPOSE_HIT_COORDS};
+  RandomEngine mRandHitMultiplicityGen{RAND_PURPOSE_HIT_MULTIPLICITY};
+  RandomEngine mRandEventTimeGen{RAND_PURPOSE_EVENT_TIME};
 
   /// Uniform distribution used generating hit coordinates
   boost::random::uniform_int_distribution<int> *mRandHitChipX, *mRandHitChipY;
@@ -81,19 +115,57 @@ private:
   /// Exponential distribution used for time between events
   boost::random::exponential_distribution<double> *mRandEventTime;
 
+  /// Draw the coordinates of random hits in blocks with a fast generator,
+  /// instead of one at a time with the boost distributions
+  bool mRandomHitBatchGeneration;
+  FastRandom mFastRandHitGen;
+
+  // Coordinates of a block of random hits, drawn by generateRandomHitsBatch()
+  std::vector<uint32_t> mBatchStave;
+  std::vector<uint32_t> mBatchSubStave;
+  std::vector<uint32_t> mBatchModule;
+  std::vector<uint32_t> mBatchChip;
+  std::vector<uint32_t> mBatchX;
+  std::vector<uint32_t> mBatchY;
+
+  /// Number of pixel hits in the current event per chip (indexed by global chip id),
+  /// and per layer. Only the chips in mEventHitChips are cleared between events.
+  std::vector<unsigned int> mChipHitCount;
+  std::vector<unsigned int> mLayerHitCount;
+  std::vector<unsigned int> mEventHitChips;
+
   std::ofstream mPhysicsEventsCSVFile;
 
+  /// Binary event log, with the same data as mPhysicsEventsCSVFile (nullptr if not enabled)
+  std::unique_ptr<EventLogWriter> mEventLog;
+
+  /// Layer ids of the layer columns in the event log, and column in the event log
+  /// for each chip (indexed by global chip id, -1 for chips that are not included)
+  std::vector<unsigned int> mEventLogLayers;
+  std::vector<int> mEventLogChipColumn;
+
+  void countHits(unsigned int chip_id, unsigned int layer, unsigned int num_hits) {
+    if(mChipHitCount[chip_id] == 0)
+      mEventHitChips.push_back(chip_id);
+    mChipHitCount[chip_id] += num_hits;
+    mLayerHitCount[layer] += num_hits;
+  }
+
+  void clearHitCounts(void);
+  void setHitRandomStream(uint32_t sub_stream);
+  void addClusterHits(unsigned int x1, unsigned int y1, unsigned int chip_id,
+                      uint64_t event_time_ns);
+  void generateRandomHitsBatch(uint64_t event_time_ns,
+                               unsigned int n_particle_hits_unscaled,
+                               unsigned int &event_pixel_hit_count);
   void generateRandomEventData(uint64_t event_time_ns,
-                               unsigned int &event_pixel_hit_count,
-                               std::map<unsigned int, unsigned int> &chip_hits,
-                               std::map<unsigned int, unsigned int> &layer_hits);
-
+                               unsigned int &event_pixel_hit_count);
   void generateMonteCarloEventData(uint64_t event_time_ns,
-                                   unsigned int &event_pixel_hit_count,
-                                   std::map<unsigned int, unsigned int> &chip_hits,
-                                   std::map<unsigned int, unsigned int> &layer_hits);
+                                   unsigned int &event_pixel_hit_count);
 
-  uint64_t generateNextPhysicsEvent(void);
+  void generateNextPhysicsEvent(uint64_t event_time_ns, PhysicsEvent& event);
+  void pipelineThread(uint64_t start_time_ns);
+  void stopPipeline(void);
   void generateNextQedNoiseEvent(uint64_t event_time_ns);
   void readDiscreteDistributionFile(const char* filename,
                                     std::vector<double> &dist_vector) const;
@@ -101,10 +173,12 @@ private:
   void initRandomNumGen(const QSettings* settings);
   void initMonteCarloHitGen(const QSettings* settings);
   void initCsvEventFileHeader(const QSettings* settings);
-  void addCsvEventLine(uint64_t t_delta,
-                       unsigned int event_pixel_hit_count,
-                       std::map<unsigned int, unsigned int> &chip_hits,
-                       std::map<unsigned int, unsigned int> &layer_hits);
+  std::string getCsvEventLine(uint64_t t_delta,
+                              unsigned int event_pixel_hit_count) const;
+  void initEventLog(void);
+  void getEventLogCounts(std::vector<unsigned int>& layer_counts,
+                         std::vector<EventLog::ChipCount>& chip_counts) const;
+  void writePhysicsEventOutput(const PhysicsEvent& event);
   double normalizeDiscreteDistribution(std::vector<double> &dist_vector);
   unsigned int getRandomMultiplicity(void);
   void physicsEventMethod(void);
@@ -118,6 +192,7 @@ public:
   ~EventGenITS();
   void setBunchCrossingRate(int rate_ns);
   void stopEventGeneration(void);
+  void stopEventThreads(void);
 
   const std::vector<std::shared_ptr<PixelHit>>& getTriggeredEvent(void) const;
   const std::vector<std::shared_ptr<PixelHit>>& getUntriggeredEvent(void) const;
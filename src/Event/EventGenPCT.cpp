@@ -8,6 +8,8 @@
 #include "EventGenPCT.hpp"
 #include "Alpide/alpide_constants.hpp"
 #include "Detector/PCT/PCT_constants.hpp"
+#include "common/Log.hpp"
+#include "common/ProcessProfiler.hpp"
 #include "../utils.hpp"
 #include <boost/random/random_device.hpp>
 #include <stdexcept>
@@ -166,6 +168,10 @@ void EventGenPCT::initRandomHitGen(const QSettings* settings)
     mRandHitCoordsXGen.seed(mRandomSeed);
     mRandHitCoordsYGen.seed(mRandomSeed);
   }
+
+  mRandParticleCountGen.setCounterBased(mCounterBasedRandom);
+  mRandHitCoordsXGen.setCounterBased(mCounterBasedRandom);
+  mRandHitCoordsYGen.setCounterBased(mCounterBasedRandom);
 }
 
 
@@ -207,6 +213,12 @@ void EventGenPCT::initMonteCarloHitGen(const QSettings* settings)
   // So we spread them out over the timeframe with a uniform distribution.
   int timeframe_length_ns = settings->value("pct/time_frame_length_ns").toInt();
   mRandHitTime = new boost::random::uniform_int_distribution<int>(0, timeframe_length_ns);
+
+  // The hit time generator uses the default seed in sequential mode
+  if(mCounterBasedRandom) {
+    mRandHitTimeGen.seed(mRandomSeed);
+    mRandHitTimeGen.setCounterBased(true);
+  }
 }
 
 
@@ -271,7 +283,7 @@ void EventGenPCT::generateRandomEventData(unsigned int &particle_count_out,
 
   unsigned int num_particles_total = (unsigned int)rand_particle_count;
 
-  std::cout << "EventGenPCT: generating " << num_particles_total << " particles" << std::endl;
+  LOG(EVENT, DEBUG) << "EventGenPCT: generating " << num_particles_total << " particles";
 
   for(unsigned int particle_num = 0; particle_num < num_particles_total; particle_num++) {
     // Todo: loop over the layers?
@@ -316,6 +328,8 @@ void EventGenPCT::generateRandomEventData(unsigned int &particle_count_out,
 #endif
 
     if(mRandomClusterGeneration) {
+      setClusterRandomStream(mUntriggeredEventCount, particle_num);
+
       std::vector<std::shared_ptr<PixelHit>> pix_cluster = createCluster(pixel,
                                                                          time_now,
                                                                          mPixelDeadTime,
@@ -374,11 +388,14 @@ bool EventGenPCT::generateMonteCarloEventData(unsigned int &particle_count_out,
   auto digit_it = digits->getDigitsIterator();
   auto digit_end_it = digits->getDigitsEndIterator();
 
+  uint32_t hit_index = 0;
+
   while(digit_it != digit_end_it) {
     const PixelHit &pixel = *digit_it;
 
     if(mRandomClusterGeneration) {
       hit_time = time_now + (*mRandHitTime)(mRandHitTimeGen);
+      setClusterRandomStream(mUntriggeredEventCount, hit_index);
 
       std::vector<std::shared_ptr<PixelHit>> pix_cluster = createCluster(pixel,
                                                                          hit_time,
@@ -435,6 +452,7 @@ bool EventGenPCT::generateMonteCarloEventData(unsigned int &particle_count_out,
     }
 
     digit_it++;
+    hit_index++;
   }
 
   // Sort the hits in the frame, because the Alpide front end code
@@ -466,6 +484,12 @@ bool EventGenPCT::generateEvent(void)
 
   mUntriggeredEventCount++;
 
+  // Only has an effect with counter-based random numbers
+  mRandParticleCountGen.setStream(mUntriggeredEventCount);
+  mRandHitCoordsXGen.setStream(mUntriggeredEventCount);
+  mRandHitCoordsYGen.setStream(mUntriggeredEventCount);
+  mRandHitTimeGen.setStream(mUntriggeredEventCount);
+
   if(mRandomHitGeneration == true) {
     generateRandomEventData(event_particle_count, event_pixel_hit_count,
                             chip_pixel_hits, layer_pixel_hits);
@@ -474,6 +498,9 @@ bool EventGenPCT::generateEvent(void)
                                              chip_pixel_hits, layer_pixel_hits);
   }
 
+  // Keeps the time order of the hits for each chip
+  groupHitsByChip(mEventHitVector);
+
   // Write event rate and multiplicity numbers to CSV file
   if(mCreateCSVFile)
     addCsvEventLine(time_now,
@@ -482,8 +509,7 @@ bool EventGenPCT::generateEvent(void)
                     chip_pixel_hits,
                     layer_pixel_hits);
 
-  std::cout << "@ " << time_now << " ns: ";
-  std::cout << "\tEvent number: " << mUntriggeredEventCount;
+  LOG(EVENT, INFO) << "@ " << time_now << " ns: " << "\tEvent number: " << mUntriggeredEventCount;
 
   return last_event;
 }
@@ -527,6 +553,8 @@ void EventGenPCT::updateBeamPosition(void)
 ///@brief SystemC controlled method. Creates new physics events (hits)
 void EventGenPCT::physicsEventMethod(void)
 {
+  PROFILE_PROCESS(EVENT_GEN);
+
   if(mStopEventGeneration == false && mBeamEndCoordsReached == false) {
     bool last_mc_event = generateEvent();
 
@@ -66,10 +66,10 @@ private:
 
   std::ofstream mPCTEventsCSVFile;
 
-  boost::random::mt19937 mRandParticleCountGen;
-  boost::random::mt19937 mRandHitCoordsXGen;
-  boost::random::mt19937 mRandHitCoordsYGen;
-  boost::random::mt19937 mRandHitTimeGen;
+  RandomEngine mRandParticleCountGen{RAND_PURPOSE_PARTICLE_COUNT};
+  RandomEngine mRandHitCoordsXGen{RAND_PURPOSE_HIT_COORDS_X};
+  RandomEngine mRandHitCoordsYGen{RAND_PURPOSE_HIT_COORDS_Y};
+  RandomEngine mRandHitTimeGen{RAND_PURPOSE_HIT_TIME};
 
   boost::random::normal_distribution<double> *mRandParticlesPerEventFrameDist;
   boost::random::normal_distribution<double> *mRandHitXDist, *mRandHitYDist;
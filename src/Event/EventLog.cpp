@@ -0,0 +1,184 @@
+/**
+ * @file   EventLog.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Buffered writer and reader for the binary physics event log (see EventLogFormat.hpp).
+ */
+
+#include "EventLog.hpp"
+#include "common/ColumnarFormat.hpp"
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+using Columnar::putVarint;
+using Columnar::getVarint;
+
+
+///@brief Create an event log file, and write the header
+///@param filename Path to file
+///@param layer_ids Layer id of each layer column
+///@param chip_ids Chip id of each chip column
+///@throw std::runtime_error if the file could not be created
+EventLogWriter::EventLogWriter(const std::string& filename,
+                               const std::vector<unsigned int>& layer_ids,
+                               const std::vector<unsigned int>& chip_ids)
+  : mFile(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc)
+  , mFilename(filename)
+  , mNumLayers(layer_ids.size())
+{
+  if(!mFile.is_open())
+    throw std::runtime_error("Error creating event log file " + filename);
+
+  mBuffer.reserve(EventLog::WRITE_BUFFER_SIZE + 1024);
+  mBuffer.insert(mBuffer.end(), EventLog::FILE_MAGIC, EventLog::FILE_MAGIC+8);
+
+  putVarint(mBuffer, layer_ids.size());
+  for(auto it = layer_ids.begin(); it != layer_ids.end(); it++)
+    putVarint(mBuffer, *it);
+
+  putVarint(mBuffer, chip_ids.size());
+  for(auto it = chip_ids.begin(); it != chip_ids.end(); it++)
+    putVarint(mBuffer, *it);
+}
+
+
+EventLogWriter::~EventLogWriter()
+{
+  try {
+    close();
+  } catch(const std::exception&) {
+    // Errors are reported when close() is called explicitly
+  }
+}
+
+
+///@brief Add an event record
+///@param t_delta Time until next event (ns)
+///@param hit_count Pixel hit count for the event
+///@param layer_counts Pixel hit count per layer column
+///@param chip_counts Pixel hit counts for the chip columns with hits, sorted by column
+void EventLogWriter::writeEvent(std::uint64_t t_delta,
+                                std::uint64_t hit_count,
+                                const std::vector<unsigned int>& layer_counts,
+                                const std::vector<EventLog::ChipCount>& chip_counts)
+{
+  if(layer_counts.size() != mNumLayers)
+    throw std::runtime_error("EventLogWriter: wrong number of layer counts");
+
+  putVarint(mBuffer, t_delta);
+  putVarint(mBuffer, hit_count);
+
+  for(auto it = layer_counts.begin(); it != layer_counts.end(); it++)
+    putVarint(mBuffer, *it);
+
+  putVarint(mBuffer, chip_counts.size());
+
+  std::uint32_t previous_column = 0;
+  for(auto it = chip_counts.begin(); it != chip_counts.end(); it++) {
+    putVarint(mBuffer, it->column - previous_column);
+    putVarint(mBuffer, it->count);
+    previous_column = it->column;
+  }
+
+  if(mBuffer.size() >= EventLog::WRITE_BUFFER_SIZE)
+    flush();
+}
+
+
+///@brief Write the buffer to file
+void EventLogWriter::flush(void)
+{
+  mFile.write((const char*) mBuffer.data(), mBuffer.size());
+  mBuffer.clear();
+
+  if(!mFile.good())
+    throw std::runtime_error("Error writing to event log file " + mFilename);
+}
+
+
+///@brief Write the remaining records and close the file
+void EventLogWriter::close(void)
+{
+  if(!mFile.is_open())
+    return;
+
+  flush();
+  mFile.close();
+}
+
+
+///@brief Open an event log file, and read the header
+///@param filename Path to file
+///@throw std::runtime_error if the file could not be read, or is not an event log file
+EventLogReader::EventLogReader(const std::string& filename)
+  : mFilename(filename)
+{
+  std::ifstream file(filename, std::ios_base::in | std::ios_base::binary);
+
+  if(!file.is_open())
+    throw std::runtime_error("Error opening event log file " + filename);
+
+  mData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+  mPos = mData.data();
+  mEnd = mData.data() + mData.size();
+
+  if(mData.size() < 8 || std::memcmp(mPos, EventLog::FILE_MAGIC, 8) != 0)
+    throw std::runtime_error(filename + " is not an event log file");
+
+  mPos += 8;
+
+  try {
+    uint64_t num_layers = getVarint(mPos, mEnd);
+    for(uint64_t i = 0; i < num_layers; i++)
+      mLayerIds.push_back(getVarint(mPos, mEnd));
+
+    uint64_t num_chips = getVarint(mPos, mEnd);
+    for(uint64_t i = 0; i < num_chips; i++)
+      mChipIds.push_back(getVarint(mPos, mEnd));
+  } catch(const std::runtime_error&) {
+    throw std::runtime_error(filename + " has a truncated event log header");
+  }
+}
+
+
+///@brief Read the next event record
+///@param[out] record Record to read into
+///@return True if a record was read, false at the end of the file
+///@throw std::runtime_error if the file ends in the middle of a record,
+///       or a record is invalid
+bool EventLogReader::readEvent(EventLogRecord& record)
+{
+  if(mPos == mEnd)
+    return false;
+
+  try {
+    record.t_delta = getVarint(mPos, mEnd);
+    record.hit_count = getVarint(mPos, mEnd);
+
+    record.layer_counts.resize(mLayerIds.size());
+    for(std::size_t i = 0; i < mLayerIds.size(); i++)
+      record.layer_counts[i] = getVarint(mPos, mEnd);
+
+    uint64_t num_chips = getVarint(mPos, mEnd);
+    uint64_t column = 0;
+
+    record.chip_counts.clear();
+    for(uint64_t i = 0; i < num_chips; i++) {
+      column += getVarint(mPos, mEnd);
+
+      if(column >= mChipIds.size())
+        throw std::runtime_error("invalid chip column");
+
+      EventLog::ChipCount chip_count;
+      chip_count.column = column;
+      chip_count.count = getVarint(mPos, mEnd);
+      record.chip_counts.push_back(chip_count);
+    }
+  } catch(const std::runtime_error& e) {
+    throw std::runtime_error(mFilename + ": invalid event log record (" + e.what() + ")");
+  }
+
+  return true;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file   EventLog.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Buffered writer and reader for the binary physics event log (see EventLogFormat.hpp).
+ */
+
+#ifndef EVENT_LOG_HPP
+#define EVENT_LOG_HPP
+
+#include "EventLogFormat.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+///@brief Write event records to an event log file. Records are encoded to a buffer,
+///       which is written to file when it is full and when the file is closed.
+class EventLogWriter {
+  std::ofstream mFile;
+  std::string mFilename;
+  std::size_t mNumLayers;
+  std::vector<std::uint8_t> mBuffer;
+
+  void flush(void);
+
+public:
+  EventLogWriter(const std::string& filename,
+                 const std::vector<unsigned int>& layer_ids,
+                 const std::vector<unsigned int>& chip_ids);
+  ~EventLogWriter();
+  void writeEvent(std::uint64_t t_delta,
+                  std::uint64_t hit_count,
+                  const std::vector<unsigned int>& layer_counts,
+                  const std::vector<EventLog::ChipCount>& chip_counts);
+  void close(void);
+};
+
+
+struct EventLogRecord {
+  std::uint64_t t_delta;
+  std::uint64_t hit_count;
+  std::vector<std::uint64_t> layer_counts;
+  std::vector<EventLog::ChipCount> chip_counts;
+};
+
+
+///@brief Read event records from an event log file
+class EventLogReader {
+  std::vector<std::uint8_t> mData;
+  const std::uint8_t* mPos;
+  const std::uint8_t* mEnd;
+
+  std::string mFilename;
+  std::vector<unsigned int> mLayerIds;
+  std::vector<unsigned int> mChipIds;
+
+public:
+  explicit EventLogReader(const std::string& filename);
+  const std::vector<unsigned int>& getLayerIds(void) const {return mLayerIds;}
+  const std::vector<unsigned int>& getChipIds(void) const {return mChipIds;}
+  bool readEvent(EventLogRecord& record);
+};
+
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file   EventLogFormat.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Definitions for the binary physics event log, a compact alternative to the
+ *         physics_events_data.csv file written by EventGenITS.
+ *
+ *         File format (varints are LEB128, see Columnar::putVarint()):
+ *
+ *         Header:
+ *           8 bytes: magic "ALPEVL01"
+ *           varint:  number of layer columns, followed by a varint layer id per column
+ *           varint:  number of chip columns, followed by a varint chip id per column
+ *
+ *         Followed by one record per event:
+ *           varint: time until next event (t_delta, ns)
+ *           varint: pixel hit count for the event
+ *           varint: pixel hit count for each layer column
+ *           varint: number of chip columns with hits, followed by a pair of varints
+ *                   for each of them, in increasing column order:
+ *                   - column index minus the column index of the previous pair
+ *                     (the first pair has the column index)
+ *                   - pixel hit count
+ *
+ *         Chips without hits are not stored, so an event with hits on a few chips
+ *         takes a few bytes regardless of the number of chips in the simulation.
+ *         The records have the same values as the lines in the CSV file, which can be
+ *         recreated with alpide_event_log_convert.
+ */
+
+#ifndef EVENT_LOG_FORMAT_HPP
+#define EVENT_LOG_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace EventLog {
+  const char FILE_MAGIC[8] = {'A', 'L', 'P', 'E', 'V', 'L', '0', '1'};
+
+  /// Size of write buffer, the buffer is written to file when it is full
+  const std::size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+  struct ChipCount {
+    std::uint32_t column;
+    std::uint32_t count;
+  };
+}
+
+
+#endif
@@ -12,14 +12,13 @@
 #include <TTree.h>
 #include <QString>
 #include <memory>
-#include <boost/random/mersenne_twister.hpp>
-#include <boost/random/uniform_int_distribution.hpp>
-#include <boost/random/uniform_real_distribution.hpp>
-#include "Detector/Common/DetectorConfig.hpp"
-#include "EventDigits.hpp"
+#include "EventFocalBase.hpp"
 
 #define C_MAX_HITS 1000000
 
+/// Size of the TTreeCache used when the events are read in sequential order
+#define FOCAL_TREE_CACHE_SIZE (64*1024*1024)
+
 typedef struct {
   Int_t iEvent;
   Int_t iFolder;
@@ -35,13 +34,8 @@ typedef struct {
   Int_t ampS3[C_MAX_HITS];
 } MacroPixelEvent;
 
-class EventRootFocal {
+class EventRootFocal : public EventFocalBase {
 private:
-  Detector::DetectorConfigBase mConfig;
-
-  Detector::t_global_chip_id_to_position_func mGlobalChipIdToPositionFunc;
-  Detector::t_position_to_global_chip_id_func mPositionToGlobalChipIdFunc;
-
   TFile* mRootFile;
   TTree* mTree;
 
@@ -59,24 +53,7 @@ private:
 
   MacroPixelEvent* mEvent;
 
-  EventDigits* mEventDigits = nullptr;
-
-  bool mRandomEventOrder;
-  bool mMoreEventsLeft = true;
-  uint64_t mNumEntries; // Number of entries in TTree
-  uint64_t mEntryCounter = 0;
-
-  /// Number of staves per quadrant included in the simulation
-  const unsigned int mStavesPerQuadrant;
-
-  boost::random::mt19937 mRandHitGen;
-  boost::random::uniform_real_distribution<double> *mRandHitMacroCellX, *mRandHitMacroCellY;
-
-  boost::random::mt19937 mRandEventIdGen;
-  boost::random::uniform_int_distribution<int> *mRandEventIdDist;
-
-  void createHits(unsigned int macro_cell_col, unsigned int macro_cell_row,
-                  unsigned int num_hits, unsigned int layer, EventDigits* event);
+  void readEntry(uint64_t entry, EventDigits* event);
 
 public:
   EventRootFocal(Detector::DetectorConfigBase config,
@@ -87,9 +64,8 @@ public:
                  unsigned int random_seed,
                  bool random_event_order = true);
   ~EventRootFocal();
-  /// Indicates if there are more events left, or if we reached the end
-  bool getMoreEventsLeft() const {return mMoreEventsLeft;}
-  EventDigits* getNextEvent(void);
+  const MacroPixelEvent& readMacroPixelEvent(uint64_t entry);
+  uint64_t getNumEntries(void) const {return mNumEntries;}
 };
 
 
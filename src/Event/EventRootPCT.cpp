@@ -5,6 +5,7 @@
  * @brief  Class for handling events for PCT stored in .root files
  */
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <cmath>
@@ -12,6 +13,7 @@
 #include "Alpide/alpide_constants.hpp"
 #include "Detector/PCT/PCT_constants.hpp"
 #include "EventRootPCT.hpp"
+#include "common/Log.hpp"
 
 
 // Hardcoded constants for ROOT file used
@@ -52,74 +54,161 @@ EventRootPCT::EventRootPCT(Detector::DetectorConfigBase config,
 
   mTree = (TTree*)mRootFile->Get("Hits");
 
+  if(mTree == nullptr) {
+    std::cerr << "Error: No Hits tree in \"" << event_filename.toStdString() << "\"." << std::endl;
+    exit(-1);
+  }
+
+  // Only read the branches that are used
+  mTree->SetBranchStatus("*", 0);
+  mTree->SetBranchStatus("posX", 1);
+  mTree->SetBranchStatus("posY", 1);
+  mTree->SetBranchStatus("posZ", 1);
+  mTree->SetBranchStatus("clockTime", 1);
+
   mTree->SetBranchAddress("posX", &mPosX);
   mTree->SetBranchAddress("posY", &mPosY);
   mTree->SetBranchAddress("posZ", &mPosZ);
   mTree->SetBranchAddress("clockTime", &mTime);
 
+  // The entries are read in sequential order, so the baskets of the
+  // branches are read in bulk for each cluster of entries
+  mTree->SetCacheSize(PCT_TREE_CACHE_SIZE);
+  mTree->AddBranchToCache("posX", kTRUE);
+  mTree->AddBranchToCache("posY", kTRUE);
+  mTree->AddBranchToCache("posZ", kTRUE);
+  mTree->AddBranchToCache("clockTime", kTRUE);
+  mTree->StopCacheLearningPhase();
+
   mNumEntries = mTree->GetEntries();
 
+  for(unsigned int layer = 0; layer < PCT::N_LAYERS; layer++) {
+    if(layer < mConfig.layer.size())
+      mLayerNumStaves.push_back(mConfig.layer[layer].num_staves);
+    else
+      mLayerNumStaves.push_back(0);
+  }
+
   if(mNumEntries == 0)
     mMoreEventsLeft = false;
 }
 
 
-///@brief Read a monte carlo event from a binary data file
-///@param event_num Event number
-///@return Pointer to EventDigits object with the event that was read from file
-std::shared_ptr<EventDigits> EventRootPCT::getNextEvent(void)
+///@brief Read a block of entries from the TTree into the entry buffers
+///@param first_entry First entry to read
+void EventRootPCT::readEntries(uint64_t first_entry)
 {
-  std::shared_ptr<EventDigits> event = std::make_shared<EventDigits>();
+  uint64_t num_entries = std::min<uint64_t>(PCT_READ_BLOCK_ENTRIES, mNumEntries - first_entry);
+
+  mBufferStart = first_entry;
+  mPosXBuffer.resize(num_entries);
+  mPosYBuffer.resize(num_entries);
+  mPosZBuffer.resize(num_entries);
+  mTimeBuffer.resize(num_entries);
+
+  for(uint64_t i = 0; i < num_entries; i++) {
+    mTree->GetEntry(first_entry + i);
+    mPosXBuffer[i] = mPosX;
+    mPosYBuffer[i] = mPosY;
+    mPosZBuffer[i] = mPosZ;
+    mTimeBuffer[i] = mTime;
+  }
+}
 
-  std::cout << "Getting next event..." << std::endl;
 
-  while(mEntryCounter < mNumEntries) {
-    mTree->GetEntry(mEntryCounter);
+///@brief Calculate chip id and pixel coordinates for a range of entries in the entry
+///       buffers, and add the hits that are on chips in the simulation to an event.
+///       The coordinates are calculated for the whole range in one loop without branches
+///       or function calls, so that the compiler can vectorize it, before the hits are added.
+///@param begin Index of first entry in buffers
+///@param end Index of last entry + 1 in buffers
+///@param event Pointer to EventDigits object to add hits to
+void EventRootPCT::addHits(std::size_t begin, std::size_t end, EventDigits* event)
+{
+  const std::size_t num_hits = end - begin;
+  const Float_t* pos_x = mPosXBuffer.data() + begin;
+  const Float_t* pos_y = mPosYBuffer.data() + begin;
+  const Float_t* pos_z = mPosZBuffer.data() + begin;
+  const unsigned int* layer_num_staves = mLayerNumStaves.data();
+
+  mHitChipId.resize(num_hits);
+  mHitCol.resize(num_hits);
+  mHitRow.resize(num_hits);
+
+  unsigned int* hit_chip_id = mHitChipId.data();
+  unsigned int* hit_col = mHitCol.data();
+  unsigned int* hit_row = mHitRow.data();
+
+  for(std::size_t i = 0; i < num_hits; i++) {
+    double z_mm = pos_z[i];
+    int layer = round(z_mm/c_event_layer_z_distance_mm);
+
+    // Simulation expects the 0,0 coord to be in the top left corner.
+    // In the ROOT files the center coord is in the middle of the detector plane,
+    // with positive y coords going upwards (simulation expects downwards)
+    double x_mm = pos_x[i] + c_event_x_max_mm;
+    double y_mm = (c_event_y_max_mm-c_event_y_min_mm) - (pos_y[i] + c_event_y_max_mm);
+
+    int stave_chip_id = floor(x_mm / (CHIP_WIDTH_CM*10));
+    int stave_id = floor(y_mm / (CHIP_HEIGHT_CM*10));
+
+    // Skip hits for layers and staves that are not included in detector configuration,
+    // and hits outside the staves
+    bool layer_valid = layer >= 0 && layer < int(PCT::N_LAYERS);
+    int num_staves = layer_valid ? layer_num_staves[layer] : 0;
+    bool valid = layer_valid && stave_id >= 0 && stave_id < num_staves &&
+      stave_chip_id >= 0 && stave_chip_id < int(PCT::CHIPS_PER_STAVE);
+
+    // Position of particle relative to the chip it will hit
+    double chip_x_mm = x_mm - (stave_chip_id*(CHIP_WIDTH_CM*10));
+    double chip_y_mm = y_mm - (stave_id*(CHIP_HEIGHT_CM*10));
+
+    hit_chip_id[i] = valid ? (layer*PCT::CHIPS_PER_LAYER) + (stave_id*PCT::CHIPS_PER_STAVE) + stave_chip_id
+                           : PCT::CHIP_COUNT_TOTAL;
+    hit_col[i] = valid ? round(chip_x_mm*(N_PIXEL_COLS/(CHIP_WIDTH_CM*10))) : 0;
+    hit_row[i] = valid ? round(chip_y_mm*(N_PIXEL_ROWS/(CHIP_HEIGHT_CM*10))) : 0;
+  }
 
-    // Time is in 25ns clock cycles
-    uint64_t time_ns = mTime*25;
+  for(std::size_t i = 0; i < num_hits; i++) {
+    if(hit_chip_id[i] != PCT::CHIP_COUNT_TOTAL)
+      event->addHit(hit_col[i], hit_row[i], hit_chip_id[i]);
+  }
+}
 
-    // Stop when we've reached last entry for this time frame
-    if(time_ns >= (mTimeFrameCounter*mTimeFrameLength_ns)+mTimeFrameLength_ns)
-      break;
 
-    double z_mm = mPosZ;
-    unsigned int layer = round(z_mm/c_event_layer_z_distance_mm);
+///@brief Read the hits for the next time frame from the ROOT file. The hits are stored
+///       in order of time, so the hits in the time frame are found with a binary search
+///       for the end of the frame in the block of entries that has been read to memory.
+///@return Pointer to EventDigits object with the hits in the time frame
+std::shared_ptr<EventDigits> EventRootPCT::getNextEvent(void)
+{
+  std::shared_ptr<EventDigits> event = std::make_shared<EventDigits>();
 
-    if(layer >= PCT::N_LAYERS) {
-      mEntryCounter++;
-      continue;
-    }
+  LOG(EVENT, DEBUG) << "Getting next event...";
 
-    // Skip hits for layers that are not included in detector configuration
-    if(mConfig.layer[layer].num_staves > 0) {
-      // Simulation expects the 0,0 coord to be in the top left corner.
-      // In the ROOT files the center coord is in the middle of the detector plane,
-      // with positive y coords going upwards (simulation expects downwards)
-      double x_mm = mPosX + c_event_x_max_mm;
-      double y_mm = (c_event_y_max_mm-c_event_y_min_mm) - (mPosY + c_event_y_max_mm);
+  const uint64_t frame_end_ns = (mTimeFrameCounter*mTimeFrameLength_ns)+mTimeFrameLength_ns;
 
-      unsigned int stave_chip_id =  x_mm / (CHIP_WIDTH_CM*10);
-      unsigned int stave_id = y_mm / (CHIP_HEIGHT_CM*10);
+  while(mEntryCounter < mNumEntries) {
+    if(mEntryCounter >= mBufferStart + mTimeBuffer.size())
+      readEntries(mEntryCounter);
 
-      // Skip hits for staves in this layer that are not included in detector configuration
-      if(stave_id < mConfig.layer[layer].num_staves) {
-        unsigned int global_chip_id = (layer*PCT::CHIPS_PER_LAYER)
-          + (stave_id*PCT::CHIPS_PER_STAVE)
-          + stave_chip_id;
+    auto begin_it = mTimeBuffer.begin() + (mEntryCounter - mBufferStart);
 
-        // Position of particle relative to the chip it will hit
-        double chip_x_mm = x_mm - (stave_chip_id*(CHIP_WIDTH_CM*10));
-        double chip_y_mm = y_mm - (stave_id*(CHIP_HEIGHT_CM*10));
+    // Find first entry that is after this time frame.
+    // Time is in 25ns clock cycles
+    auto end_it = std::partition_point(begin_it, mTimeBuffer.end(),
+                                       [frame_end_ns](Int_t time) {
+                                         uint64_t time_ns = time*25;
+                                         return time_ns < frame_end_ns;
+                                       });
 
-        unsigned int x_coord = round(chip_x_mm*(N_PIXEL_COLS/(CHIP_WIDTH_CM*10)));
-        unsigned int y_coord = round(chip_y_mm*(N_PIXEL_ROWS/(CHIP_HEIGHT_CM*10)));
+    addHits(begin_it - mTimeBuffer.begin(), end_it - mTimeBuffer.begin(), event.get());
 
-        event->addHit(x_coord, y_coord, global_chip_id);
-      }
-    }
+    mEntryCounter += end_it - begin_it;
 
-    mEntryCounter++;
+    // Stop when we've reached last entry for this time frame
+    if(end_it != mTimeBuffer.end())
+      break;
   }
 
   mTimeFrameCounter++;
@@ -127,7 +216,7 @@ std::shared_ptr<EventDigits> EventRootPCT::getNextEvent(void)
   if(mEntryCounter == mNumEntries)
     mMoreEventsLeft = false;
 
-  std::cout << "Event size: " << event->size() << std::endl;
+  LOG(EVENT, DEBUG) << "Event size: " << event->size();
 
   return event;
 }
@@ -12,11 +12,18 @@
 #include <TTree.h>
 #include <QString>
 #include <memory>
+#include <vector>
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 #include "Detector/Common/DetectorConfig.hpp"
 #include "EventDigits.hpp"
 
+/// Number of tree entries (hits) that are read to memory at a time
+#define PCT_READ_BLOCK_ENTRIES (64*1024)
+
+/// Size of the TTreeCache used for reading the hits
+#define PCT_TREE_CACHE_SIZE (32*1024*1024)
+
 
 class EventRootPCT {
 private:
@@ -40,6 +47,25 @@ private:
   Float_t mPosZ;
   Int_t mTime;
 
+  // Block of entries read from the TTree, starting at entry mBufferStart
+  uint64_t mBufferStart = 0;
+  std::vector<Float_t> mPosXBuffer;
+  std::vector<Float_t> mPosYBuffer;
+  std::vector<Float_t> mPosZBuffer;
+  std::vector<Int_t> mTimeBuffer;
+
+  // Chip id and pixel coordinates calculated for a range of entries, with the chip id
+  // set to PCT::CHIP_COUNT_TOTAL for hits outside the chips in the simulation
+  std::vector<unsigned int> mHitChipId;
+  std::vector<unsigned int> mHitCol;
+  std::vector<unsigned int> mHitRow;
+
+  /// Number of staves in each layer in the simulation
+  std::vector<unsigned int> mLayerNumStaves;
+
+  void readEntries(uint64_t first_entry);
+  void addHits(std::size_t begin, std::size_t end, EventDigits* event);
+
 public:
   EventRootPCT(Detector::DetectorConfigBase config,
                Detector::t_global_chip_id_to_position_func global_chip_id_to_position_func,
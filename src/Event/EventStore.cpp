@@ -0,0 +1,174 @@
+/**
+ * @file   EventStore.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Writer and memory mapped reader for the packed Monte Carlo event store
+ *         format (see EventStoreFormat.hpp).
+ */
+
+#include "EventStore.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+///@brief Get the file magic for a type of event store
+static const char* getFileMagic(EventStore::StoreType type)
+{
+  if(type == EventStore::STORE_FOCAL_MACRO_CELLS)
+    return EventStore::FOCAL_FILE_MAGIC;
+  else
+    return EventStore::FILE_MAGIC;
+}
+
+
+///@brief Create an event store file
+///@param filename File name
+///@param type Type of event store. Digits in ITS stores are sorted, macro cells in
+///            Focal stores are kept in the order they are added.
+///@throw std::runtime_error if the file could not be created
+EventStoreWriter::EventStoreWriter(const std::string& filename, EventStore::StoreType type)
+  : mFile(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc)
+  , mFilename(filename)
+  , mType(type)
+{
+  if(!mFile.is_open())
+    throw std::runtime_error("Error creating event store file " + filename);
+
+  // The header is written again with the number of events and
+  // the index offset when the file is closed
+  const std::uint64_t placeholder[2] = {0, 0};
+  mFile.write(getFileMagic(type), sizeof(EventStore::FILE_MAGIC));
+  mFile.write(reinterpret_cast<const char*>(placeholder), sizeof(placeholder));
+
+  mEventIndex.push_back(0);
+}
+
+
+EventStoreWriter::~EventStoreWriter()
+{
+  try {
+    close();
+  } catch(const std::exception&) {
+    // Errors are reported when close() is called explicitly
+  }
+}
+
+
+///@brief Add an event to the file
+///@param digits Packed digits of the event (see EventStore::packDigit()).
+///              They are sorted by chip id before they are written.
+///              For Focal stores: packed macro cells (see EventStore::packMacroCell()).
+void EventStoreWriter::addEvent(std::vector<std::uint64_t> digits)
+{
+  if(mType == EventStore::STORE_ITS_DIGITS)
+    std::sort(digits.begin(), digits.end());
+
+  mFile.write(reinterpret_cast<const char*>(digits.data()), digits.size()*sizeof(std::uint64_t));
+  mEventIndex.push_back(mEventIndex.back() + digits.size());
+
+  if(!mFile.good())
+    throw std::runtime_error("Error writing to event store file " + mFilename);
+}
+
+
+///@brief Write the event index and header, and close the file
+void EventStoreWriter::close(void)
+{
+  if(!mFile.is_open())
+    return;
+
+  std::uint64_t num_events = mEventIndex.size()-1;
+  std::uint64_t index_offset = EventStore::HEADER_SIZE + mEventIndex.back()*sizeof(std::uint64_t);
+
+  mFile.write(reinterpret_cast<const char*>(mEventIndex.data()),
+              mEventIndex.size()*sizeof(std::uint64_t));
+
+  mFile.seekp(sizeof(EventStore::FILE_MAGIC));
+  mFile.write(reinterpret_cast<const char*>(&num_events), sizeof(num_events));
+  mFile.write(reinterpret_cast<const char*>(&index_offset), sizeof(index_offset));
+
+  bool good = mFile.good();
+  mFile.close();
+
+  if(!good)
+    throw std::runtime_error("Error writing to event store file " + mFilename);
+}
+
+
+///@brief Map an event store file, and check the header and event index
+///@param filename File name
+///@param type Expected type of event store
+///@throw std::runtime_error if the file could not be mapped, or is not a valid event store
+///       file of the expected type
+EventStoreFile::EventStoreFile(const std::string& filename, EventStore::StoreType type)
+  : mFilename(filename)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+
+  if(fd < 0)
+    throw std::runtime_error("Error opening event store file " + filename);
+
+  struct stat file_stat;
+  if(fstat(fd, &file_stat) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Error getting size of event store file " + filename);
+  }
+
+  mSize = file_stat.st_size;
+
+  if(mSize < EventStore::HEADER_SIZE) {
+    ::close(fd);
+    throw std::runtime_error(filename + " is not an event store file");
+  }
+
+  void* addr = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping stays valid after the file descriptor is closed
+  ::close(fd);
+
+  if(addr == MAP_FAILED)
+    throw std::runtime_error("Error mapping event store file " + filename);
+
+  // Events are picked at random
+  madvise(addr, mSize, MADV_RANDOM);
+
+  mData = static_cast<const std::uint8_t*>(addr);
+
+  const std::uint64_t* header = reinterpret_cast<const std::uint64_t*>(mData);
+  mNumEvents = header[1];
+  std::uint64_t index_offset = header[2];
+
+  mDigits = reinterpret_cast<const std::uint64_t*>(mData + EventStore::HEADER_SIZE);
+  mEventIndex = reinterpret_cast<const std::uint64_t*>(mData + index_offset);
+
+  bool valid = std::memcmp(mData, getFileMagic(type), sizeof(EventStore::FILE_MAGIC)) == 0 &&
+               index_offset >= EventStore::HEADER_SIZE &&
+               index_offset % sizeof(std::uint64_t) == 0 &&
+               index_offset <= mSize &&
+               mNumEvents < (mSize - index_offset) / sizeof(std::uint64_t);
+
+  if(valid) {
+    std::uint64_t num_digits = (index_offset - EventStore::HEADER_SIZE) / sizeof(std::uint64_t);
+
+    valid = mEventIndex[0] == 0 && mEventIndex[mNumEvents] == num_digits;
+
+    for(std::uint64_t event = 0; valid && event < mNumEvents; event++)
+      valid = mEventIndex[event] <= mEventIndex[event+1];
+  }
+
+  if(!valid) {
+    munmap(const_cast<std::uint8_t*>(mData), mSize);
+    throw std::runtime_error(filename + " is not a valid event store file");
+  }
+}
+
+
+EventStoreFile::~EventStoreFile()
+{
+  munmap(const_cast<std::uint8_t*>(mData), mSize);
+}
@@ -0,0 +1,72 @@
+/**
+ * @file   EventStore.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Writer and memory mapped reader for the packed Monte Carlo event store
+ *         format (see EventStoreFormat.hpp).
+ */
+
+#ifndef EVENT_STORE_HPP
+#define EVENT_STORE_HPP
+
+#include "EventStoreFormat.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+///@brief Write a set of events to an event store file. The events are written as they
+///       are added, and the event index is written when the file is closed.
+class EventStoreWriter {
+  std::ofstream mFile;
+  std::string mFilename;
+  EventStore::StoreType mType;
+
+  ///@brief Index of first digit of each event, followed by the total number of digits
+  std::vector<std::uint64_t> mEventIndex;
+
+public:
+  explicit EventStoreWriter(const std::string& filename,
+                            EventStore::StoreType type = EventStore::STORE_ITS_DIGITS);
+  ~EventStoreWriter();
+  void addEvent(std::vector<std::uint64_t> digits);
+  void close(void);
+  std::uint64_t getNumEvents(void) const {return mEventIndex.size()-1;}
+};
+
+
+///@brief Read-only memory mapped view of an event store file. The events are accessed
+///       in place in the mapping, only the header and event index are checked when
+///       the file is opened. For Focal stores the "digits" are packed macro cell hits
+///       (see EventStore::packMacroCell()).
+class EventStoreFile {
+  const std::uint8_t* mData = nullptr;
+  std::size_t mSize = 0;
+  std::string mFilename;
+
+  std::uint64_t mNumEvents;
+  const std::uint64_t* mEventIndex;
+  const std::uint64_t* mDigits;
+
+public:
+  explicit EventStoreFile(const std::string& filename,
+                          EventStore::StoreType type = EventStore::STORE_ITS_DIGITS);
+  ~EventStoreFile();
+  EventStoreFile(const EventStoreFile&) = delete;
+  EventStoreFile& operator=(const EventStoreFile&) = delete;
+
+  std::uint64_t getNumEvents(void) const {return mNumEvents;}
+
+  std::uint64_t getNumDigits(std::uint64_t event) const {
+    return mEventIndex[event+1] - mEventIndex[event];
+  }
+
+  ///@brief Get pointer to the packed digits of an event (see EventStore::packDigit())
+  const std::uint64_t* getDigits(std::uint64_t event) const {
+    return mDigits + mEventIndex[event];
+  }
+};
+
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * @file   EventStoreFocal.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Class for handling events for Focal, stored as macro cell hits in a packed,
+ *         memory mapped event store file (see EventStoreFormat.hpp).
+ *
+ *         Focal event store files are created from the Focal ROOT files with the
+ *         alpide_focal_store_convert program, and can be used without ROOT.
+ */
+
+#include <iostream>
+#include <stdexcept>
+#include "EventStoreFocal.hpp"
+
+
+///@brief Constructor for EventStoreFocal class, which handles a set of Focal events
+///       stored in one event store file. The file is memory mapped, and events are read
+///       directly from the mapping when they are used.
+///@param config detectorConfig object which specifies which staves in Focal should
+///              be included.
+///@param global_chip_id_to_position_func Pointer to function used to determine global
+///                                       chip id based on position
+///@param position_to_global_chip_id_func Pointer to function used to determine position
+///                                       based on global chip id
+///@param event_filename Full path to event store file
+///@param staves_per_quadrant Number of staves per quadrant in simulation
+///@param random_seed Random seed used to generate random hits in macro cells
+///@param random_event_order Process monte carlo events in random order or not
+///@throw std::runtime_error if the store file could not be mapped
+EventStoreFocal::EventStoreFocal(Detector::DetectorConfigBase config,
+                                 Detector::t_global_chip_id_to_position_func global_chip_id_to_position_func,
+                                 Detector::t_position_to_global_chip_id_func position_to_global_chip_id_func,
+                                 const QString& event_filename,
+                                 unsigned int staves_per_quadrant,
+                                 unsigned int random_seed,
+                                 bool random_event_order)
+  : EventFocalBase(config,
+                   global_chip_id_to_position_func,
+                   position_to_global_chip_id_func,
+                   staves_per_quadrant,
+                   random_seed,
+                   random_event_order)
+{
+  mStoreFile.reset(new EventStoreFile(event_filename.toStdString(),
+                                      EventStore::STORE_FOCAL_MACRO_CELLS));
+
+  std::cout << "Mapped Focal event store file " << event_filename.toStdString() << " with ";
+  std::cout << mStoreFile->getNumEvents() << " events." << std::endl;
+
+  setNumEntries(mStoreFile->getNumEvents());
+}
+
+
+///@brief Read an event from the mapped store, and create pixel hits for its macro cells
+///@param[in] entry Event number
+///@param[out] event Pointer to EventDigits object to add hits to
+void EventStoreFocal::readEntry(uint64_t entry, EventDigits* event)
+{
+  const uint64_t* cell = mStoreFile->getDigits(entry);
+  const uint64_t* cells_end = cell + mStoreFile->getNumDigits(entry);
+
+  for(; cell != cells_end; cell++) {
+    createHits(EventStore::getMacroCellCol(*cell),
+               EventStore::getMacroCellRow(*cell),
+               EventStore::getMacroCellHits(*cell),
+               EventStore::getMacroCellLayer(*cell),
+               event);
+  }
+}
@@ -0,0 +1,34 @@
+/**
+ * @file   EventStoreFocal.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Class for handling events for Focal, stored as macro cell hits in a packed,
+ *         memory mapped event store file (see EventStoreFormat.hpp).
+ */
+
+#ifndef EVENT_STORE_FOCAL_H
+#define EVENT_STORE_FOCAL_H
+
+#include <memory>
+#include <QString>
+#include "EventFocalBase.hpp"
+#include "EventStore.hpp"
+
+
+class EventStoreFocal : public EventFocalBase {
+  std::unique_ptr<EventStoreFile> mStoreFile;
+
+  void readEntry(uint64_t entry, EventDigits* event);
+
+public:
+  EventStoreFocal(Detector::DetectorConfigBase config,
+                  Detector::t_global_chip_id_to_position_func global_chip_id_to_position_func,
+                  Detector::t_position_to_global_chip_id_func position_to_global_chip_id_func,
+                  const QString& event_filename,
+                  unsigned int staves_per_quadrant,
+                  unsigned int random_seed,
+                  bool random_event_order = true);
+};
+
+
+#endif /* EVENT_STORE_FOCAL_H */
@@ -0,0 +1,78 @@
+/**
+ * @file   EventStoreFormat.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Definitions for the packed Monte Carlo event store format, which holds a
+ *         whole set of MC events in one file (see EventStore.hpp and EventStoreITS.hpp).
+ *
+ *         The file is designed to be memory mapped and used in place, so all values
+ *         are 8 byte, 8 byte aligned and in native (little endian) byte order:
+ *
+ *         Header:
+ *           8 bytes:  magic "ALPEVS01"
+ *           uint64_t: number of events N
+ *           uint64_t: file offset of the event index
+ *
+ *         Digits (starting right after the header):
+ *           uint64_t: packed digit (see packDigit()), for all events back to back.
+ *                     The digits of each event are sorted by chip id, then row and column.
+ *
+ *         Event index (at the offset given in the header):
+ *           N+1 uint64_t: index of the first digit of each event, followed by the
+ *                         total number of digits. The digits of event i are the
+ *                         digits from index[i] to index[i+1].
+ *
+ *         Focal macro cell stores use the same layout with the magic "ALPFMC01".
+ *         Each 64-bit value is then a macro cell hit (see packMacroCell()), in the
+ *         same order as in the Focal ROOT tree, and the values are not sorted.
+ */
+
+#ifndef EVENT_STORE_FORMAT_HPP
+#define EVENT_STORE_FORMAT_HPP
+
+#include <cstdint>
+
+
+namespace EventStore {
+
+  const char FILE_MAGIC[8] = {'A', 'L', 'P', 'E', 'V', 'S', '0', '1'};
+  const char FOCAL_FILE_MAGIC[8] = {'A', 'L', 'P', 'F', 'M', 'C', '0', '1'};
+
+  /// Type of values in the store. ITS stores hold pixel digits, Focal stores hold
+  /// macro cell hits that are expanded to random pixel hits in the simulation.
+  enum StoreType {STORE_ITS_DIGITS, STORE_FOCAL_MACRO_CELLS};
+
+  /// Max number of pixel hits in a Focal macro cell that can be stored
+  const unsigned int MACRO_CELL_MAX_HITS = 0xFFFFFF;
+
+  const std::size_t HEADER_SIZE = 3*sizeof(std::uint64_t);
+
+  ///@brief Pack a digit (pixel hit) to one 64-bit value, with the chip id in the upper
+  ///       32 bits, the row in bits 16-31 and the column in bits 0-15. Sorting the packed
+  ///       values sorts the digits by chip id first.
+  inline std::uint64_t packDigit(unsigned int col, unsigned int row, unsigned int chip_id) {
+    return (std::uint64_t(chip_id) << 32) | (std::uint64_t(row & 0xFFFF) << 16) | (col & 0xFFFF);
+  }
+
+  inline unsigned int getDigitCol(std::uint64_t digit) {return digit & 0xFFFF;}
+  inline unsigned int getDigitRow(std::uint64_t digit) {return (digit >> 16) & 0xFFFF;}
+  inline unsigned int getDigitChipId(std::uint64_t digit) {return digit >> 32;}
+
+  ///@brief Pack a Focal macro cell hit to one 64-bit value, with the number of pixel hits
+  ///       in the upper 24 bits, the layer in bits 32-39, the macro cell row in bits
+  ///       16-31 and the macro cell column in bits 0-15.
+  inline std::uint64_t packMacroCell(unsigned int col, unsigned int row,
+                                     unsigned int num_hits, unsigned int layer) {
+    return (std::uint64_t(num_hits & MACRO_CELL_MAX_HITS) << 40) |
+      (std::uint64_t(layer & 0xFF) << 32) |
+      (std::uint64_t(row & 0xFFFF) << 16) | (col & 0xFFFF);
+  }
+
+  inline unsigned int getMacroCellCol(std::uint64_t cell) {return cell & 0xFFFF;}
+  inline unsigned int getMacroCellRow(std::uint64_t cell) {return (cell >> 16) & 0xFFFF;}
+  inline unsigned int getMacroCellLayer(std::uint64_t cell) {return (cell >> 32) & 0xFF;}
+  inline unsigned int getMacroCellHits(std::uint64_t cell) {return cell >> 40;}
+}
+
+
+#endif // EVENT_STORE_FORMAT_HPP
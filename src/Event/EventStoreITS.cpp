@@ -0,0 +1,131 @@
+/**
+ * @file   EventStoreITS.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Class for handling events from AliRoot MC simulations for ITS,
+ *         stored in a packed, memory mapped event store file (see EventStoreFormat.hpp).
+ *
+ *         Event store files are created from XML or binary event files with the
+ *         alpide_event_store_convert program.
+ */
+
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "EventStoreITS.hpp"
+
+
+///@brief Constructor for EventStoreITS class, which handles a set of events stored
+///       in one event store file. The file is memory mapped, and events are read
+///       directly from the mapping when they are used.
+///@param config detectorConfig object which specifies which staves in ITS should
+///              be included. Digits for chips that are not included are skipped.
+///@param global_chip_id_to_position_func Pointer to function used to determine global
+///                                       chip id based on position
+///@param position_to_global_chip_id_func Pointer to function used to determine position
+///                                       based on global chip id
+///@param path Path to event store file
+///@param store_filename File name of event store file
+///@param random_event_order True to randomize which event is used, false to get events
+///              in sequential order.
+///@param random_seed Random seed for event sequence randomizer.
+///@param load_all If set to true, decode all events into memory up front.
+///@param prefetch_events Number of events to read ahead in a background thread,
+///                       0 to read events when they are used (see EventBaseDiscrete).
+///@throw std::runtime_error if the store file could not be mapped, or has no events
+EventStoreITS::EventStoreITS(Detector::DetectorConfigBase config,
+                             Detector::t_global_chip_id_to_position_func global_chip_id_to_position_func,
+                             Detector::t_position_to_global_chip_id_func position_to_global_chip_id_func,
+                             const QString& path,
+                             const QString& store_filename,
+                             bool random_event_order,
+                             int random_seed,
+                             bool load_all,
+                             unsigned int prefetch_events)
+  : EventBaseDiscrete(config,
+                      global_chip_id_to_position_func,
+                      position_to_global_chip_id_func,
+                      path,
+                      QStringList(store_filename),
+                      random_event_order,
+                      random_seed,
+                      load_all,
+                      prefetch_events)
+{
+  std::string filename = (path + QString("/") + store_filename).toStdString();
+
+  mStoreFile.reset(new EventStoreFile(filename));
+
+  if(mStoreFile->getNumEvents() == 0 ||
+     mStoreFile->getNumEvents() > uint64_t(std::numeric_limits<int>::max())) {
+    throw std::runtime_error("unsupported number of events (" +
+                             std::to_string(mStoreFile->getNumEvents()) +
+                             ") in event store file " + filename);
+  }
+
+  std::cout << "Mapped event store file " << filename << " with ";
+  std::cout << mStoreFile->getNumEvents() << " events." << std::endl;
+
+  // The base class constructor created the distribution for one event (file)
+  createEventIdDistribution();
+
+  if(load_all)
+    readEventFiles();
+}
+
+
+EventStoreITS::~EventStoreITS()
+{
+  // Stop reading events ahead before this object is destroyed
+  stopPrefetch();
+}
+
+
+int EventStoreITS::getNumEvents(void) const
+{
+  return mStoreFile->getNumEvents();
+}
+
+
+///@brief Decode all the events in the store into memory
+void EventStoreITS::readEventFiles()
+{
+  for(int i = 0; i < getNumEvents(); i++)
+    mEvents.push_back(readEvent(i));
+}
+
+
+///@brief Not used, all the events are in one file
+///@throw std::logic_error always
+EventDigits* EventStoreITS::readEventFile(const QString& event_filename)
+{
+  throw std::logic_error("EventStoreITS::readEventFile() called for " +
+                         event_filename.toStdString() + ", events are read from the store.");
+}
+
+
+///@brief Read an event from the mapped store. The digits are sorted by chip id,
+///       so chips that are not included in the simulation are checked once per chip.
+///@param event_index Index of event
+///@return Pointer to EventDigits object with the event
+EventDigits* EventStoreITS::readEvent(int event_index)
+{
+  const uint64_t* digit = mStoreFile->getDigits(event_index);
+  const uint64_t* digits_end = digit + mStoreFile->getNumDigits(event_index);
+
+  EventDigits* event = new EventDigits();
+  event->reserve(digits_end - digit);
+
+  while(digit != digits_end) {
+    unsigned int chip_id = EventStore::getDigitChipId(*digit);
+    bool chip_included = mDetectorPositionList.find(chip_id) != mDetectorPositionList.end();
+
+    for(; digit != digits_end && EventStore::getDigitChipId(*digit) == chip_id; digit++) {
+      if(chip_included)
+        event->addHit(EventStore::getDigitCol(*digit), EventStore::getDigitRow(*digit), chip_id);
+    }
+  }
+
+  return event;
+}
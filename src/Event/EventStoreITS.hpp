@@ -0,0 +1,41 @@
+/**
+ * @file   EventStoreITS.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Class for handling events from AliRoot MC simulations for ITS,
+ *         stored in a packed, memory mapped event store file (see EventStoreFormat.hpp).
+ */
+
+#ifndef EVENT_STORE_ITS_H
+#define EVENT_STORE_ITS_H
+
+#include <memory>
+#include <QString>
+#include "EventBaseDiscrete.hpp"
+#include "EventStore.hpp"
+
+
+class EventStoreITS : public EventBaseDiscrete {
+  std::unique_ptr<EventStoreFile> mStoreFile;
+
+  void readEventFiles();
+  EventDigits* readEventFile(const QString& event_filename);
+  int getNumEvents(void) const;
+  EventDigits* readEvent(int event_index);
+
+public:
+  EventStoreITS(Detector::DetectorConfigBase config,
+                Detector::t_global_chip_id_to_position_func global_chip_id_to_position_func,
+                Detector::t_position_to_global_chip_id_func position_to_global_chip_id_func,
+                const QString& path,
+                const QString& store_filename,
+                bool random_event_order = true,
+                int random_seed = 0,
+                bool load_all = false,
+                unsigned int prefetch_events = 0);
+  ~EventStoreITS();
+};
+
+
+
+#endif /* EVENT_STORE_ITS_H */
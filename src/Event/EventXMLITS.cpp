@@ -12,7 +12,9 @@
 ///@defgroup event_xml Event XML Format
 ///@{
 ///   Loads a data pattern file, which is an .xml file with the W3C DOM Level 2 format.
-///   The data file should be organized in the tree format below.
+///   The data file should be organized in the tree format below. The file is read as a
+///   stream of XML tokens, and the ids of the currently open lay/sta/ssta/mod/chip
+///   elements determine which chip the digits belong to.
 ///   For the inner layers (0 to 2), there is only one sub stave and module entry, and they
 ///   are always 0 (since there are no sub staves or modules within an IB stave).
 ///
@@ -91,7 +93,12 @@
 ///@}
 
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <QFile>
+#include <QXmlStreamReader>
 #include "EventXMLITS.hpp"
+#include "common/Log.hpp"
 
 
 ///@brief Constructor for EventXMLITS class, which handles a set of events stored in XML files.
@@ -109,6 +116,8 @@
 ///@param random_seed Random seed for event sequence randomizer.
 ///@param load_all If set to true, load all event files into memory. If not they are read
 ///                from file as they are used, and do not persist in memory.
+///@param prefetch_events Number of events to read ahead in a background thread,
+///                       0 to read events when they are used (see EventBaseDiscrete).
 EventXMLITS::EventXMLITS(Detector::DetectorConfigBase config,
                          Detector::t_global_chip_id_to_position_func global_chip_id_to_position_func,
                          Detector::t_position_to_global_chip_id_func position_to_global_chip_id_func,
@@ -116,7 +125,8 @@ EventXMLITS::EventXMLITS(Detector::DetectorConfigBase config,
                          const QStringList& event_filenames,
                          bool random_event_order,
                          int random_seed,
-                         bool load_all)
+                         bool load_all,
+                         unsigned int prefetch_events)
   : EventBaseDiscrete(config,
                       global_chip_id_to_position_func,
                       position_to_global_chip_id_func,
@@ -124,31 +134,24 @@ EventXMLITS::EventXMLITS(Detector::DetectorConfigBase config,
                       event_filenames,
                       random_event_order,
                       random_seed,
-                      load_all)
+                      load_all,
+                      prefetch_events)
 {
+  for(auto it = mDetectorPositionList.begin(); it != mDetectorPositionList.end(); it++) {
+    const Detector::DetectorPosition& pos = it->second;
+    mChipIdByPosition[std::make_tuple(pos.layer_id, pos.stave_id, pos.sub_stave_id,
+                                      pos.module_id, pos.module_chip_id)] = it->first;
+  }
+
   if(load_all)
     readEventFiles();
 }
 
 
-///@brief Find an XML DOM node element in a list of elements, with the requested ID.
-///       This assumes that all the elements have an id attribute.
-///@param[in] list XML DOM node element list
-///@param[in] id Id of element to look for
-///@param[out] element_out Reference to QDomElement object, which is used as an output to store
-///            the element that was found
-///@return True if element with desired ID was found, false if not.
-bool EventXMLITS::findXMLElementInListById(const QDomNodeList& list, int id, QDomElement& element_out)
+EventXMLITS::~EventXMLITS()
 {
-  // Search for element in list
-  for(int i = 0; i < list.size(); i++) {
-    element_out = list.at(i).toElement();
-
-    if(element_out.attribute("id").toInt() == id)
-      return true;
-  }
-
-  return false;
+  // Stop reading events ahead before this object is destroyed
+  stopPrefetch();
 }
 
 
@@ -164,126 +167,125 @@ void EventXMLITS::readEventFiles()
 }
 
 
-///@brief Read a monte carlo event from an XML file
+///@brief Parse the text of a digit element, which is stored as col:row.
+///       The text may be split over several character tokens by the XML reader,
+///       so this function is called for each token with the state of the digit.
+///@param[in] text Characters from the digit element
+///@param[in,out] col Column value
+///@param[in,out] row Row value
+///@param[in,out] colon True if the colon separator has been seen
+///@return False if the text contains other characters than digits, one colon, and whitespace
+static bool parseDigitText(const QStringRef& text, int& col, int& row, bool& colon)
+{
+  for(auto it = text.begin(); it != text.end(); it++) {
+    if(it->isDigit()) {
+      int& value = colon ? row : col;
+      value = value*10 + it->digitValue();
+    } else if(*it == QLatin1Char(':') && colon == false) {
+      colon = true;
+    } else if(!it->isSpace()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+///@brief Read a monte carlo event from an XML file. The file is parsed as a stream of
+///       tokens with QXmlStreamReader, without building a DOM tree for the event,
+///       and hits are added as the digits for included chips are read.
 ///@param event_filename File name and path of .xml file
 ///@return Pointer to EventDigits object with the event that was read from file
+///@throw std::runtime_error if the file could not be opened or parsed
 EventDigits* EventXMLITS::readEventFile(const QString& event_filename)
 {
-  QDomDocument xml_dom_document;
   QFile event_file(event_filename);
-  QString qdom_error_msg;
-
-  EventDigits* event = new EventDigits();
-
 
   if (!event_file.open(QIODevice::ReadOnly))
   {
-    std::cerr<<"Cannot open xml file: "<< event_filename.toStdString() << std::endl;
-    delete event;
-    exit(-1);
-  }
-
-  if (!xml_dom_document.setContent(&event_file, &qdom_error_msg))
-  {
-    event_file.close();
-    std::cerr << "Cannot load xml file: "<< event_filename.toStdString() << std::endl;
-    std::cerr << "Error message: " << qdom_error_msg.toStdString() << std::endl;
-    delete event;
-    exit(-1);
+    throw std::runtime_error("Cannot open xml file: " + event_filename.toStdString());
   }
 
-  QDomElement xml_dom_root_element = xml_dom_document.documentElement();
-
-  for(auto it = mDetectorPositionList.begin(); it != mDetectorPositionList.end(); it++) {
-    int global_chip_id = it->first;
-
-    const Detector::DetectorPosition& chip_position = mDetectorPositionList[global_chip_id];
-
-    QDomElement chip_element; // Chip element is stored here by locateChipInEventXML().
-
-    if(locateChipInEventXML(chip_position, xml_dom_root_element, chip_element)) {
-      // Digit nodes use the <dig> tag
-      QDomNodeList digit_node_list = chip_element.elementsByTagName("dig");
-      int digit_count = digit_node_list.size();
-
-      for(int digit_it = 0; digit_it < digit_count; digit_it++)
-      {
-        QDomElement digit_element = digit_node_list.at(digit_it).toElement();
-
-        // Elements in a digit node are stored as: col:row
-        QStringList digit_entry = digit_element.text().split(":");
+  EventDigits* event = new EventDigits();
+  QXmlStreamReader xml(&event_file);
+
+  // Ids of the lay/sta/ssta/mod/chip elements that are currently open
+  unsigned int layer_id = 0;
+  unsigned int stave_id = 0;
+  unsigned int sub_stave_id = 0;
+  unsigned int module_id = 0;
+
+  // Global chip id of current chip element, -1 if the chip is not in the simulation
+  int global_chip_id = -1;
+  int digit_count = 0;
+
+  // State of the current digit element
+  bool in_digit = false;
+  bool digit_colon = false;
+  int col = 0;
+  int row = 0;
+
+  while(!xml.atEnd()) {
+    QXmlStreamReader::TokenType token = xml.readNext();
+
+    if(token == QXmlStreamReader::StartElement) {
+      QStringRef name = xml.name();
+
+      if(name == QLatin1String("dig")) {
+        in_digit = global_chip_id >= 0;
+        digit_colon = false;
+        col = 0;
+        row = 0;
+      } else if(name == QLatin1String("chip")) {
+        unsigned int module_chip_id = xml.attributes().value(QLatin1String("id")).toInt();
+        auto chip_it = mChipIdByPosition.find(std::make_tuple(layer_id, stave_id, sub_stave_id,
+                                                              module_id, module_chip_id));
+        global_chip_id = chip_it != mChipIdByPosition.end() ? int(chip_it->second) : -1;
+        digit_count = 0;
+      } else if(name == QLatin1String("mod")) {
+        module_id = xml.attributes().value(QLatin1String("id")).toInt();
+      } else if(name == QLatin1String("ssta")) {
+        sub_stave_id = xml.attributes().value(QLatin1String("id")).toInt();
+      } else if(name == QLatin1String("sta")) {
+        stave_id = xml.attributes().value(QLatin1String("id")).toInt();
+      } else if(name == QLatin1String("lay")) {
+        layer_id = xml.attributes().value(QLatin1String("id")).toInt();
+      }
+    } else if(token == QXmlStreamReader::Characters && in_digit) {
+      if(!parseDigitText(xml.text(), col, row, digit_colon))
+        break;
+    } else if(token == QXmlStreamReader::EndElement) {
+      QStringRef name = xml.name();
 
-        int col = digit_entry.at(0).toInt();
-        int row = digit_entry.at(1).toInt();
+      if(name == QLatin1String("dig") && in_digit) {
+        if(!digit_colon)
+          break;
 
         event->addHit(col, row, global_chip_id);
+        digit_count++;
+        in_digit = false;
+      } else if(name == QLatin1String("chip") && global_chip_id >= 0) {
+        LOG(EVENT, DEBUG) << "added " << digit_count << " hits to global chip id " << global_chip_id;
+        global_chip_id = -1;
       }
-
-      std::cout << "added " << digit_count << " hits to global chip id " << global_chip_id << std::endl;
-
     }
   }
 
-  return event;
-}
-
-
-///@brief Search for a chip in the event XML
-///@param[in] chip_position Chip position struct that defines the position of the chip in terms of
-///           layer, stave, module, module chip_id, and so on
-///@param[in] event_xml_dom_root Reference to the XML root object
-///@param[out] chip_element_out Reference to a QDomElement object, which is used as an output and
-///            set to the chip element in the XML DOM object (if it was found).
-///@return True if chip was found, false if not.
-bool EventXMLITS::locateChipInEventXML(const Detector::DetectorPosition& chip_position,
-                                       const QDomElement& event_xml_dom_root,
-                                       QDomElement& chip_element_out)
-{
-  // Search for layer in XML file
-  // ---------------------------------------------------------------------------
-  QDomNodeList layer_list = event_xml_dom_root.elementsByTagName("lay");
-  QDomElement layer_element;
-
-  if(findXMLElementInListById(layer_list, chip_position.layer_id, layer_element) == false)
-    return false;
-
-
-  // Search for stave in the layer element in the XML file
-  // ---------------------------------------------------------------------------
-  QDomNodeList stave_list = layer_element.elementsByTagName("sta");
-  QDomElement stave_element;
-
-  if(findXMLElementInListById(stave_list, chip_position.stave_id, stave_element) == false)
-    return false;
-
-
-  // Search for sub-stave in the stave element in the XML file
-  // ---------------------------------------------------------------------------
-  QDomNodeList sub_stave_list = layer_element.elementsByTagName("ssta");
-  QDomElement sub_stave_element;
-
-  if(findXMLElementInListById(sub_stave_list, chip_position.sub_stave_id, sub_stave_element) == false)
-    return false;
-
-
-  // Search for module in the layer element in the XML file
-  // ---------------------------------------------------------------------------
-  QDomNodeList module_list = sub_stave_element.elementsByTagName("mod");
-  QDomElement module_element;
-
-  if(findXMLElementInListById(module_list, chip_position.module_id, module_element) == false)
-    return false;
-
-
-  // Search for chip in the layer element in the XML file
-  // ---------------------------------------------------------------------------
-  QDomNodeList chip_list = module_element.elementsByTagName("chip");
-  QDomElement chip_element;
+  if (xml.hasError() || in_digit)
+  {
+    event_file.close();
+    delete event;
 
-  if(findXMLElementInListById(chip_list, chip_position.module_chip_id, chip_element) == false)
-    return false;
+    std::string error_msg = "Cannot load xml file: " + event_filename.toStdString() + ": ";
+    if(xml.hasError())
+      error_msg += xml.errorString().toStdString();
+    else
+      error_msg += "invalid digit, expected col:row";
+    error_msg += " (line " + std::to_string(xml.lineNumber()) + ")";
 
-  chip_element_out = chip_element;
+    throw std::runtime_error(error_msg);
+  }
 
-  return true;
+  return event;
 }
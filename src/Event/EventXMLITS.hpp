@@ -9,16 +9,18 @@
 #ifndef EVENT_XML_ITS_H
 #define EVENT_XML_ITS_H
 
+#include <map>
+#include <tuple>
 #include <QString>
-#include <QtXml/QtXml>
 #include "EventBaseDiscrete.hpp"
 
 
 class EventXMLITS : public EventBaseDiscrete {
-  bool findXMLElementInListById(const QDomNodeList& list, int id, QDomElement& element_out);
-  bool locateChipInEventXML(const Detector::DetectorPosition& chip_position,
-                            const QDomElement& event_xml_dom_root,
-                            QDomElement& chip_element_out);
+  typedef std::tuple<unsigned int, unsigned int, unsigned int, unsigned int, unsigned int> t_xml_chip_position;
+
+  /// Global chip id for each chip position (lay/sta/ssta/mod/chip ids) included in the simulation
+  std::map<t_xml_chip_position, unsigned int> mChipIdByPosition;
+
   void readEventFiles();
   EventDigits* readEventFile(const QString& event_filename);
 
@@ -30,7 +32,9 @@ public:
               const QStringList& event_filenames,
               bool random_event_order = true,
               int random_seed = 0,
-              bool load_all = false);
+              bool load_all = false,
+              unsigned int prefetch_events = 0);
+  ~EventXMLITS();
 };
 
 
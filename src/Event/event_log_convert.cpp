@@ -0,0 +1,102 @@
+/**
+ * @file   event_log_convert.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Converts a binary physics event log (physics_events_data.evl, see
+ *         EventLogFormat.hpp) to the physics_events_data.csv format.
+ */
+
+#include "Event/EventLog.hpp"
+#include "version.hpp"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+
+int main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("Alpide Event Log Converter");
+  QCoreApplication::setApplicationVersion(QString::number(VERSION_MAJOR) + "." +
+                                          QString::number(VERSION_MINOR));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("\nConvert a binary physics event log (.evl) to CSV");
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addPositionalArgument("event_log", "Binary event log file (.evl)");
+  parser.addPositionalArgument("output_file", "CSV file to create");
+  parser.process(app);
+
+  const QStringList args = parser.positionalArguments();
+
+  if(args.size() != 2) {
+    parser.showHelp(-1);
+  }
+
+  std::string input_filename = args.at(0).toStdString();
+  std::string output_filename = args.at(1).toStdString();
+
+  try {
+    EventLogReader reader(input_filename);
+    std::ofstream out(output_filename);
+
+    if(!out.is_open()) {
+      std::cerr << "Error: Could not create " << output_filename << std::endl;
+      return -1;
+    }
+
+    const std::vector<unsigned int>& layer_ids = reader.getLayerIds();
+    const std::vector<unsigned int>& chip_ids = reader.getChipIds();
+
+    out << "delta_t;event_pixel_hit_multiplicity";
+
+    for(auto it = layer_ids.begin(); it != layer_ids.end(); it++)
+      out << ";layer_" << *it;
+
+    for(auto it = chip_ids.begin(); it != chip_ids.end(); it++)
+      out << ";chip_" << *it;
+
+    out << "\n";
+
+    EventLogRecord record;
+    uint64_t num_events = 0;
+
+    while(reader.readEvent(record)) {
+      out << record.t_delta << ";" << record.hit_count;
+
+      for(auto it = record.layer_counts.begin(); it != record.layer_counts.end(); it++)
+        out << ";" << *it;
+
+      // Chips without hits are not stored in the log
+      auto chip_it = record.chip_counts.begin();
+      for(std::uint32_t column = 0; column < chip_ids.size(); column++) {
+        if(chip_it != record.chip_counts.end() && chip_it->column == column) {
+          out << ";" << chip_it->count;
+          chip_it++;
+        } else {
+          out << ";0";
+        }
+      }
+
+      out << "\n";
+      num_events++;
+    }
+
+    out.close();
+
+    if(!out) {
+      std::cerr << "Error: Writing to " << output_filename << " failed" << std::endl;
+      return -1;
+    }
+
+    std::cout << "Converted " << num_events << " events to " << output_filename << std::endl;
+  } catch(const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
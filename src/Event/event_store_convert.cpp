@@ -0,0 +1,126 @@
+/**
+ * @file   event_store_convert.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Converts a directory of ITS Monte Carlo event files, in the XML or binary
+ *         format, to one packed event store file (see EventStoreFormat.hpp).
+ *
+ *         The events are read for the full ITS detector, so the store can be used
+ *         for simulations with any detector configuration.
+ *         Use with monte_carlo_file_type=store in the simulation settings.
+ */
+
+#include "Event/EventXMLITS.hpp"
+#include "Event/EventBinaryITS.hpp"
+#include "Event/EventStore.hpp"
+#include "Detector/ITS/ITSDetectorConfig.hpp"
+#include "version.hpp"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+
+int sc_main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("Alpide Event Store Converter");
+  QCoreApplication::setApplicationVersion(QString::number(VERSION_MAJOR) + "." +
+                                          QString::number(VERSION_MINOR));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("\nConvert a directory of ITS MC event files in XML (.xml) or"
+                                   " binary (.dat) format to one event store (.evs) file");
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addPositionalArgument("format", "Format of the event files, xml or binary");
+  parser.addPositionalArgument("event_path", "Path to directory with event files");
+  parser.addPositionalArgument("output_file", "Event store file to create (.evs)");
+  parser.process(app);
+
+  const QStringList args = parser.positionalArguments();
+
+  if(args.size() != 3) {
+    parser.showHelp(-1);
+  }
+
+  QString file_type = args.at(0);
+  QString event_path = args.at(1);
+  std::string output_filename = args.at(2).toStdString();
+
+  QDir event_dir(event_path);
+  QStringList name_filters;
+
+  if(file_type == "xml")
+    name_filters << "*.xml";
+  else if(file_type == "binary")
+    name_filters << "*.dat";
+  else {
+    std::cerr << "Error: Unknown MC event format \"" << file_type.toStdString() << "\"" << std::endl;
+    return -1;
+  }
+
+  QStringList event_files = event_dir.entryList(name_filters);
+
+  if(event_files.isEmpty()) {
+    std::cerr << "Error: No " << name_filters.at(0).toStdString();
+    std::cerr << " files found in " << event_path.toStdString() << std::endl;
+    return -1;
+  }
+
+  // Read the events for all chips in ITS, in file name order
+  ITS::ITSDetectorConfig det_config;
+  std::unique_ptr<EventBaseDiscrete> events;
+
+  if(file_type == "xml") {
+    events.reset(new EventXMLITS(det_config,
+                                 &ITS::ITS_global_chip_id_to_position,
+                                 &ITS::ITS_position_to_global_chip_id,
+                                 event_path,
+                                 event_files,
+                                 false,
+                                 1));
+  } else {
+    events.reset(new EventBinaryITS(det_config,
+                                    &ITS::ITS_global_chip_id_to_position,
+                                    &ITS::ITS_position_to_global_chip_id,
+                                    event_path,
+                                    event_files,
+                                    false,
+                                    1));
+  }
+
+  uint64_t num_digits = 0;
+
+  try {
+    EventStoreWriter writer(output_filename);
+
+    for(int i = 0; i < event_files.size(); i++) {
+      std::unique_ptr<EventDigits> event(events->readEventFile(event_path + QString("/") + event_files.at(i)));
+
+      std::vector<uint64_t> digits;
+      digits.reserve(event->size());
+
+      for(auto it = event->getDigitsIterator(); it != event->getDigitsEndIterator(); it++)
+        digits.push_back(EventStore::packDigit(it->getCol(), it->getRow(), it->getChipId()));
+
+      num_digits += digits.size();
+      writer.addEvent(digits);
+
+      if((i+1) % 100 == 0 || i+1 == event_files.size())
+        std::cout << "Converted event " << i+1 << " of " << event_files.size() << std::endl;
+    }
+
+    writer.close();
+  } catch(const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return -1;
+  }
+
+  std::cout << "Wrote " << event_files.size() << " events with " << num_digits;
+  std::cout << " digits to " << output_filename << std::endl;
+
+  return 0;
+}
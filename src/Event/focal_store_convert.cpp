@@ -0,0 +1,115 @@
+/**
+ * @file   focal_store_convert.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Converts a Focal Monte Carlo ROOT file (pixTree) to a packed Focal event
+ *         store file with the macro cell hits of each event (see EventStoreFormat.hpp).
+ *
+ *         The tree is read once in sequential order through a TTreeCache. The macro
+ *         cells are stored as they are in the tree, and are expanded to random pixel
+ *         hits by the simulation, which then reads the events without ROOT.
+ *         Use with monte_carlo_file_type=store and focal/monte_carlo_file_path set to
+ *         the store file in the simulation settings.
+ */
+
+#include "Event/EventRootFocal.hpp"
+#include "Event/EventStore.hpp"
+#include "Detector/Focal/FocalDetectorConfig.hpp"
+#include "version.hpp"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <iostream>
+#include <stdexcept>
+
+
+///@brief Pack the macro cell hits of one layer (S1 or S3) in an event
+///@return False if a macro cell can not be stored in the packed format
+static bool packMacroCells(int num_cells, const Int_t* col, const Int_t* row, const Int_t* amp,
+                           unsigned int layer, std::vector<uint64_t>& cells)
+{
+  for(int i = 0; i < num_cells; i++) {
+    if(col[i] < 0 || col[i] > 0xFFFF || row[i] < 0 || row[i] > 0xFFFF ||
+       amp[i] < 0 || (unsigned int)amp[i] > EventStore::MACRO_CELL_MAX_HITS)
+      return false;
+
+    cells.push_back(EventStore::packMacroCell(col[i], row[i], amp[i], layer));
+  }
+
+  return true;
+}
+
+
+int sc_main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("Alpide Focal Event Store Converter");
+  QCoreApplication::setApplicationVersion(QString::number(VERSION_MAJOR) + "." +
+                                          QString::number(VERSION_MINOR));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("\nConvert a Focal MC event ROOT file to one Focal event"
+                                   " store (.evs) file");
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addPositionalArgument("root_file", "Focal MC event ROOT file (with pixTree)");
+  parser.addPositionalArgument("output_file", "Event store file to create (.evs)");
+  parser.process(app);
+
+  const QStringList args = parser.positionalArguments();
+
+  if(args.size() != 2) {
+    parser.showHelp(-1);
+  }
+
+  QString root_filename = args.at(0);
+  std::string output_filename = args.at(1).toStdString();
+
+  // The detector configuration is not used for reading the macro cells
+  Focal::FocalDetectorConfig det_config(Focal::STAVES_PER_QUADRANT);
+
+  EventRootFocal events(det_config,
+                        &Focal::Focal_global_chip_id_to_position,
+                        &Focal::Focal_position_to_global_chip_id,
+                        root_filename,
+                        Focal::STAVES_PER_QUADRANT,
+                        1,
+                        false);
+
+  uint64_t num_events = events.getNumEntries();
+  uint64_t num_cells = 0;
+
+  try {
+    EventStoreWriter writer(output_filename, EventStore::STORE_FOCAL_MACRO_CELLS);
+    std::vector<uint64_t> cells;
+
+    for(uint64_t entry = 0; entry < num_events; entry++) {
+      const MacroPixelEvent& event = events.readMacroPixelEvent(entry);
+
+      cells.clear();
+
+      // S1: Layer 0 in simulation, S3: Layer 1 in simulation
+      if(!packMacroCells(event.nPixS1, event.colS1, event.rowS1, event.ampS1, 0, cells) ||
+         !packMacroCells(event.nPixS3, event.colS3, event.rowS3, event.ampS3, 1, cells))
+      {
+        std::cerr << "Error: Macro cell out of range in event " << entry << std::endl;
+        return -1;
+      }
+
+      num_cells += cells.size();
+      writer.addEvent(cells);
+
+      if((entry+1) % 1000 == 0 || entry+1 == num_events)
+        std::cout << "Converted event " << entry+1 << " of " << num_events << std::endl;
+    }
+
+    writer.close();
+  } catch(const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return -1;
+  }
+
+  std::cout << "Wrote " << num_events << " events with " << num_cells;
+  std::cout << " macro cell hits to " << output_filename << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,220 @@
+/**
+ * @file   ParserEventSpill.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Spill file for events recorded by the readout unit's data link parsers.
+ */
+
+#include "ParserEventSpill.hpp"
+#include "common/StatsWriter.hpp"
+#include <cstdio>
+#include <iterator>
+#include <stdexcept>
+
+
+///@brief Number of words buffered before they are passed to the StatsWriter
+static const std::size_t SPILL_BUFFER_WORDS = 1 << 16;
+
+///@brief Number of events read from the spill file at a time by writeGroupedFile()
+static const std::size_t GROUPED_READ_EVENTS = 1 << 16;
+
+
+///@brief Constructor for ParserEventSpill. Creates the spill file.
+///@param[in] spill_filename Path to temporary spill file, removed when the object is destroyed
+///@param[in] num_words Number of 64-bit words per event
+///@throw std::runtime_error if the spill file could not be created
+ParserEventSpill::ParserEventSpill(const std::string& spill_filename, unsigned int num_words)
+  : mNumWords(num_words)
+  , mSpillFilename(spill_filename)
+  , mBuffer(std::make_shared<std::vector<uint64_t>>())
+{
+  mSpillFile = std::make_shared<std::ofstream>(mSpillFilename,
+                                               std::ios_base::out |
+                                               std::ios_base::binary |
+                                               std::ios_base::trunc);
+
+  if(!mSpillFile->is_open())
+    throw std::runtime_error("ParserEventSpill: could not open spill file " + mSpillFilename);
+}
+
+
+ParserEventSpill::~ParserEventSpill()
+{
+  // Make sure the writer thread is done with the file
+  try {
+    StatsWriter::waitIdle();
+  } catch(const std::exception&) {
+    // Write errors are reported by StatsWriter::stop()
+  }
+  mSpillFile->close();
+  std::remove(mSpillFilename.c_str());
+}
+
+
+///@brief Add an event. The event is written to the spill file later, by flush().
+///@param[in] link Data link number
+///@param[in] chip Chip ID, should be zero for events that are only grouped per link
+///@param[in] words Pointer to the event's words, getNumWords() words are copied
+void ParserEventSpill::addEvent(unsigned int link, unsigned int chip, const uint64_t* words)
+{
+  mBuffer->push_back((uint64_t(link) << 32) | chip);
+  mBuffer->insert(mBuffer->end(), words, words+mNumWords);
+  mCounts[std::make_pair(link, chip)]++;
+
+  if(mBuffer->size() >= SPILL_BUFFER_WORDS)
+    flush();
+}
+
+
+///@brief Pass the buffered events to the StatsWriter, which writes them to the
+///       spill file and frees them
+void ParserEventSpill::flush(void)
+{
+  if(mBuffer->empty())
+    return;
+
+  std::shared_ptr<std::ofstream> spill_file = mSpillFile;
+  std::shared_ptr<std::vector<uint64_t>> buffer = mBuffer;
+  mBuffer = std::make_shared<std::vector<uint64_t>>();
+
+  StatsWriter::post([spill_file, buffer]() {
+      spill_file->write((const char*)buffer->data(), buffer->size()*sizeof(uint64_t));
+
+      // Flush so that the file can be read back at any time
+      spill_file->flush();
+
+      if(!spill_file->good())
+        throw std::runtime_error("ParserEventSpill: error writing to spill file");
+    });
+}
+
+
+///@brief Call a function for each event, in the order the events were added
+///@param[in] func Function called with the link, chip and words of each event
+///@throw std::runtime_error if the spill file could not be read
+void ParserEventSpill::forEachEvent(const std::function<void(unsigned int link,
+                                                             unsigned int chip,
+                                                             const uint64_t* words)>& func) const
+{
+  // Wait for the writer thread to finish writing the spilled events
+  StatsWriter::waitIdle();
+
+  std::ifstream spill_file(mSpillFilename, std::ios_base::in | std::ios_base::binary);
+
+  if(!spill_file.is_open())
+    throw std::runtime_error("ParserEventSpill: could not open spill file " + mSpillFilename);
+
+  std::vector<uint64_t> event(1+mNumWords);
+
+  while(spill_file.read((char*)event.data(), event.size()*sizeof(uint64_t)))
+    func(event[0] >> 32, event[0] & 0xFFFFFFFF, &event[1]);
+
+  // The events that are not flushed yet are still in the buffer
+  for(std::size_t i = 0; i < mBuffer->size(); i += 1+mNumWords)
+    func((*mBuffer)[i] >> 32, (*mBuffer)[i] & 0xFFFFFFFF, &(*mBuffer)[i+1]);
+}
+
+
+///@brief Write all events to a file, grouped per link, and optionally per chip within
+///       each link. The file has the same format as the _busy_events.dat file
+///       (per_chip = false) or the _busyv_events.dat file (per_chip = true) written by
+///       ReadoutUnit::writeSimulationStats(). All events should be flushed first.
+///@param[in] filename Path to output file
+///@param[in] num_links Number of data links
+///@param[in] per_chip Group the events per chip within each link
+///@throw std::runtime_error if the output file could not be written
+void ParserEventSpill::writeGroupedFile(const std::string& filename,
+                                        unsigned int num_links,
+                                        bool per_chip) const
+{
+  if(!mBuffer->empty())
+    throw std::runtime_error("ParserEventSpill: events must be flushed before writeGroupedFile()");
+
+  std::ofstream out(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+  if(!out.is_open())
+    throw std::runtime_error("ParserEventSpill: could not create " + filename);
+
+  // Write the headers, and find the offset in the file of the first event for each
+  // link/chip. The space for the events is filled in below.
+  std::map<std::pair<unsigned int, unsigned int>, uint64_t> offsets;
+  uint64_t event_bytes = mNumWords*sizeof(uint64_t);
+  uint64_t pos = 0;
+
+  uint8_t num_data_links = num_links;
+  out.write((char*)&num_data_links, sizeof(uint8_t));
+  pos += sizeof(uint8_t);
+
+  for(unsigned int link = 0; link < num_links; link++) {
+    auto begin = mCounts.lower_bound(std::make_pair(link, 0U));
+    auto end = mCounts.lower_bound(std::make_pair(link+1, 0U));
+
+    if(per_chip) {
+      uint8_t num_chips_with_data = std::distance(begin, end);
+      out.write((char*)&num_chips_with_data, sizeof(uint8_t));
+      pos += sizeof(uint8_t);
+
+      for(auto it = begin; it != end; it++) {
+        uint8_t chip_id = it->first.second;
+        uint64_t num_events = it->second;
+        out.write((char*)&chip_id, sizeof(uint8_t));
+        out.write((char*)&num_events, sizeof(uint64_t));
+        pos += sizeof(uint8_t) + sizeof(uint64_t);
+
+        offsets[it->first] = pos;
+        pos += num_events*event_bytes;
+        out.seekp(pos);
+      }
+    } else {
+      uint64_t num_events = begin != end ? begin->second : 0;
+      out.write((char*)&num_events, sizeof(uint64_t));
+      pos += sizeof(uint64_t);
+
+      offsets[std::make_pair(link, 0U)] = pos;
+      pos += num_events*event_bytes;
+      out.seekp(pos);
+    }
+  }
+
+  // Wait for the writer thread to finish writing the spilled events
+  StatsWriter::waitIdle();
+
+  std::ifstream spill_file(mSpillFilename, std::ios_base::in | std::ios_base::binary);
+
+  if(!spill_file.is_open())
+    throw std::runtime_error("ParserEventSpill: could not open spill file " + mSpillFilename);
+
+  // Read the events in blocks, and write the events of each link/chip in a block
+  // together to their place in the file
+  std::vector<uint64_t> block(GROUPED_READ_EVENTS*(1+mNumWords));
+
+  while(spill_file) {
+    spill_file.read((char*)block.data(), block.size()*sizeof(uint64_t));
+    std::size_t num_words_read = spill_file.gcount() / sizeof(uint64_t);
+
+    std::map<std::pair<unsigned int, unsigned int>, std::vector<uint64_t>> groups;
+
+    for(std::size_t i = 0; i+mNumWords < num_words_read; i += 1+mNumWords) {
+      std::pair<unsigned int, unsigned int> key(block[i] >> 32, block[i] & 0xFFFFFFFF);
+      std::vector<uint64_t>& group = groups[key];
+      group.insert(group.end(), &block[i+1], &block[i+1+mNumWords]);
+    }
+
+    for(auto it = groups.begin(); it != groups.end(); it++) {
+      auto offset_it = offsets.find(it->first);
+
+      // Events for links that are not in the file
+      if(offset_it == offsets.end())
+        continue;
+
+      out.seekp(offset_it->second);
+      out.write((const char*)it->second.data(), it->second.size()*sizeof(uint64_t));
+      offset_it->second += it->second.size()*sizeof(uint64_t);
+    }
+  }
+
+  out.close();
+
+  if(!out)
+    throw std::runtime_error("ParserEventSpill: error writing to " + filename);
+}
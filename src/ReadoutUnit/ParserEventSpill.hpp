@@ -0,0 +1,60 @@
+/**
+ * @file   ParserEventSpill.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Spill file for events recorded by the readout unit's data link parsers
+ *         (busy events, and trigger IDs of busy violations, flushed incomplete,
+ *         readout abort and fatal events).
+ *
+ *         The readout unit moves finished events from the parsers to the spill during
+ *         the simulation, and the events are written to a temporary spill file by the
+ *         StatsWriter thread, in the order they were added. Only the number of events
+ *         per link and chip is kept in memory.
+ *
+ *         At the end of the simulation, writeGroupedFile() creates the normal
+ *         _busy_events.dat etc. files from the spill file. The events are grouped per
+ *         link (and chip), as in the files written from the parsers' data.
+ */
+
+#ifndef PARSER_EVENT_SPILL_HPP
+#define PARSER_EVENT_SPILL_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+class ParserEventSpill {
+private:
+  unsigned int mNumWords;
+  std::string mSpillFilename;
+  std::shared_ptr<std::ofstream> mSpillFile;
+
+  ///@brief Events not yet passed to the StatsWriter. Each event is stored as the
+  ///       link and chip (link << 32 | chip), followed by mNumWords words.
+  std::shared_ptr<std::vector<uint64_t>> mBuffer;
+
+  ///@brief Number of events per link and chip
+  std::map<std::pair<unsigned int, unsigned int>, uint64_t> mCounts;
+
+public:
+  ParserEventSpill(const std::string& spill_filename, unsigned int num_words);
+  ~ParserEventSpill();
+
+  void addEvent(unsigned int link, unsigned int chip, const uint64_t* words);
+  void flush(void);
+  void forEachEvent(const std::function<void(unsigned int link,
+                                             unsigned int chip,
+                                             const uint64_t* words)>& func) const;
+  void writeGroupedFile(const std::string& filename, unsigned int num_links, bool per_chip) const;
+
+  unsigned int getNumWords(void) const {return mNumWords;}
+};
+
+
+#endif
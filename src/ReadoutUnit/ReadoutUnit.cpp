@@ -12,6 +12,14 @@
 
 #include "ReadoutUnit.hpp"
 #include <misc/vcd_trace.hpp>
+#include "common/ProcessProfiler.hpp"
+#include "common/StatsWriter.hpp"
+#include "common/ColumnarWriter.hpp"
+#include "common/Log.hpp"
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
 
 
 #ifdef ROOT_ENABLED
@@ -61,7 +69,8 @@ ReadoutUnit::ReadoutUnit(sc_core::sc_module_name name,
   , mTriggerFilterTimeNs(trigger_filter_time)
   , mTriggerFilterEnabled(trigger_filter_enable)
   , mTriggersSentCount(n_ctrl_links)
-  , mTriggerActionMaps(n_ctrl_links)
+  , mTriggerActions(n_ctrl_links, std::string(this->name()))
+  , mLinkTriggerActions(n_ctrl_links)
   , mAlpideLinkBusySignals(n_data_links)
 {
   // This prevents the first trigger from being filtered
@@ -144,7 +153,8 @@ ReadoutUnit::ReadoutUnit(sc_core::sc_module_name name,
   , mTriggerFilterTimeNs(trigger_filter_time)
   , mTriggerFilterEnabled(trigger_filter_enable)
   , mTriggersSentCount(n_ctrl_links)
-  , mTriggerActionMaps(n_ctrl_links)
+  , mTriggerActions(n_ctrl_links, std::string(this->name()))
+  , mLinkTriggerActions(n_ctrl_links)
   , mAlpideLinkBusySignals(n_data_links)
 {
   // This prevents the first trigger from being filtered
@@ -192,6 +202,245 @@ void ReadoutUnit::end_of_elaboration(void)
   SC_METHOD(busyChainMethod);
   sensitive << s_busy_in->data_written_event();
   dont_initialize();
+
+  // Also used without the StatsWriter thread, to append busy events
+  // to the columnar statistics file as they finish
+  if(mDataRateStreamFile || mColumnarBusyEvents != nullptr) {
+    SC_METHOD(dataRateStreamMethod);
+  }
+}
+
+
+///@brief Write statistics that become final during the simulation (closed data rate
+///       intervals) to file while the simulation is running, using the StatsWriter thread.
+///       Should be called before the end of elaboration, with the same output path that
+///       will be used for writeSimulationStats(). finishStatsStreaming() must be
+///       called at the end of the simulation, before writeSimulationStats().
+///       Also creates this RU's tables in the columnar statistics file, named after the
+///       last part of the output path (e.g. "RU_0_1/data_rate"), if it is enabled.
+///       With the StatsWriter thread, busy and trigger events are also moved from the
+///       data link parsers to spill files during the simulation (see ParserEventSpill).
+///       Does nothing if neither the StatsWriter thread nor the columnar file is enabled.
+///@param output_path Path and prefix for output files
+void ReadoutUnit::setStreamingOutputPath(const std::string output_path)
+{
+  ColumnarWriter* columnar_writer = ColumnarWriter::getRunWriter();
+
+  if(columnar_writer != nullptr) {
+    std::string table_prefix = output_path.substr(output_path.find_last_of('/') + 1) + "/";
+    std::vector<Columnar::ColumnDef> data_rate_columns = {{"time_ns", Columnar::COLUMN_UINT64},
+                                                          {"total_bytes", Columnar::COLUMN_UINT64}};
+    std::vector<Columnar::ColumnDef> trigger_action_columns = {{"trigger_id", Columnar::COLUMN_UINT64}};
+
+    for(unsigned int i = 0; i < mDataLinkParsers.size(); i++)
+      data_rate_columns.push_back({"link_" + std::to_string(i) + "_bytes", Columnar::COLUMN_UINT64});
+
+    for(unsigned int i = 0; i < s_alpide_control_output.size(); i++)
+      trigger_action_columns.push_back({"link_" + std::to_string(i) + "_action", Columnar::COLUMN_UINT64});
+
+    mColumnarDataRate = &columnar_writer->addTable(table_prefix + "data_rate", data_rate_columns);
+    mColumnarTriggerActions = &columnar_writer->addTable(table_prefix + "trigger_actions",
+                                                         trigger_action_columns);
+    mColumnarBusyEvents = &columnar_writer->addTable(table_prefix + "busy_events",
+                                                     {{"link", Columnar::COLUMN_UINT64},
+                                                      {"busy_on_time_ns", Columnar::COLUMN_UINT64},
+                                                      {"busy_off_time_ns", Columnar::COLUMN_UINT64},
+                                                      {"busy_on_trigger_id", Columnar::COLUMN_UINT64},
+                                                      {"busy_off_trigger_id", Columnar::COLUMN_UINT64}});
+    mColumnarBusyEventCount.resize(mDataLinkParsers.size(), 0);
+  }
+
+  if(!StatsWriter::getEnabled())
+    return;
+
+  mDataRateStreamFilename = output_path + std::string("_Data_rate.csv");
+  mDataRateStreamFile = std::make_shared<std::ofstream>(mDataRateStreamFilename);
+
+  if(!mDataRateStreamFile->is_open()) {
+    std::string error_msg = "Error opening data rate stats file: " + mDataRateStreamFilename;
+    throw std::runtime_error(error_msg);
+  }
+
+  std::shared_ptr<std::ofstream> file = mDataRateStreamFile;
+  std::string header = getDataRateCsvHeader();
+
+  StatsWriter::post([file, header]() {
+      *file << header;
+    });
+
+  // Busy events and busy violation/flushed incomplete/readout abort/fatal events are
+  // moved from the parsers to spill files during the simulation, and the .dat files
+  // are created from the spill files by writeSimulationStats()
+  mBusyEventSpill.reset(new ParserEventSpill(output_path + "_busy_events.spill", 4));
+  mTriggerEventSpills[TRIGGER_EVENT_BUSYV].reset(
+    new ParserEventSpill(output_path + "_busyv_events.spill", 1));
+  mTriggerEventSpills[TRIGGER_EVENT_FLUSHED_INCOMPLETE].reset(
+    new ParserEventSpill(output_path + "_flush_events.spill", 1));
+  mTriggerEventSpills[TRIGGER_EVENT_ABORT].reset(
+    new ParserEventSpill(output_path + "_ro_abort_events.spill", 1));
+  mTriggerEventSpills[TRIGGER_EVENT_FATAL].reset(
+    new ParserEventSpill(output_path + "_fatal_events.spill", 1));
+}
+
+
+///@brief Get the map with trigger IDs per chip for a type of trigger event from a data
+///       link parser
+///@param[in] link Data link number
+///@param[in] type Type of trigger event, must be one of the types with trigger IDs per chip
+///                (not TRIGGER_EVENT_BUSY)
+///@return Reference to the parser's map of trigger IDs, with chip ID as key
+///@throw std::runtime_error for event types that are not stored as trigger IDs per chip
+std::map<unsigned int, std::vector<uint64_t>>& ReadoutUnit::getParserTriggerEvents(unsigned int link,
+                                                                                   ReadoutUnitEventType type) const
+{
+  switch(type) {
+  case TRIGGER_EVENT_BUSYV:
+    return mDataLinkParsers[link]->getBusyViolationTriggers();
+  case TRIGGER_EVENT_ABORT:
+    return mDataLinkParsers[link]->getReadoutAbortTriggers();
+  case TRIGGER_EVENT_FLUSHED_INCOMPLETE:
+    return mDataLinkParsers[link]->getFlushedIncomplTriggers();
+  case TRIGGER_EVENT_FATAL:
+    return mDataLinkParsers[link]->getFatalTriggers();
+  default:
+    throw std::runtime_error("ReadoutUnit: no trigger IDs stored for this event type");
+  }
+}
+
+
+///@brief Move finished busy events, and busy violation/flushed incomplete/readout abort/fatal
+///       trigger IDs from the data link parsers to the spill files, to free the memory used
+///       by the parsers. Busy events are also appended to the columnar busy_events table
+///       here, when it is enabled. Only used when the spill files were created by
+///       setStreamingOutputPath().
+///@param[in] end_of_simulation When false, a busy event that is not finished yet (no
+///                             BUSY_OFF received) is left in the parser. When true, all
+///                             events are moved.
+void ReadoutUnit::spillParserEvents(bool end_of_simulation)
+{
+  for(unsigned int link_id = 0; link_id < mDataLinkParsers.size(); link_id++) {
+    std::vector<BusyEvent>& busy_events = mDataLinkParsers[link_id]->getBusyEvents();
+    auto busy_events_end = busy_events.end();
+
+    if(!end_of_simulation && mDataLinkParsers[link_id]->getBusyStatus() && !busy_events.empty())
+      busy_events_end--;
+
+    for(auto busy_event_it = busy_events.begin(); busy_event_it != busy_events_end; busy_event_it++) {
+      uint64_t words[4] = {busy_event_it->mBusyOnTime,
+                           busy_event_it->mBusyOffTime,
+                           busy_event_it->mBusyOnTriggerId,
+                           busy_event_it->mBusyOffTriggerId};
+
+      mBusyEventSpill->addEvent(link_id, 0, words);
+
+      if(mColumnarBusyEvents != nullptr)
+        appendBusyEventColumnarRow(link_id, *busy_event_it);
+    }
+
+    busy_events.erase(busy_events.begin(), busy_events_end);
+
+    for(auto spill_it = mTriggerEventSpills.begin(); spill_it != mTriggerEventSpills.end(); spill_it++) {
+      std::map<unsigned int, std::vector<uint64_t>>& events =
+        getParserTriggerEvents(link_id, spill_it->first);
+
+      for(auto chip_it = events.begin(); chip_it != events.end(); chip_it++) {
+        for(auto event_it = chip_it->second.begin(); event_it != chip_it->second.end(); event_it++)
+          spill_it->second->addEvent(link_id, chip_it->first, &(*event_it));
+      }
+
+      events.clear();
+    }
+  }
+
+  mBusyEventSpill->flush();
+
+  for(auto spill_it = mTriggerEventSpills.begin(); spill_it != mTriggerEventSpills.end(); spill_it++)
+    spill_it->second->flush();
+}
+
+
+///@brief Add a busy event to the busy_events table in the columnar statistics file
+///@param[in] link_id Data link number
+///@param[in] busy_event Busy event to add
+void ReadoutUnit::appendBusyEventColumnarRow(uint64_t link_id, const BusyEvent& busy_event) const
+{
+  mColumnarBusyEvents->append(0, link_id);
+  mColumnarBusyEvents->append(1, busy_event.mBusyOnTime);
+  mColumnarBusyEvents->append(2, busy_event.mBusyOffTime);
+  mColumnarBusyEvents->append(3, busy_event.mBusyOnTriggerId);
+  mColumnarBusyEvents->append(4, busy_event.mBusyOffTriggerId);
+  mColumnarBusyEvents->endRow();
+}
+
+
+///@brief Append the finished busy events held by the data link parsers, that were not
+///       appended before, to the busy_events table in the columnar statistics file.
+///       Used when the busy events are not moved to spill files.
+void ReadoutUnit::appendBusyEventColumnarRows(void)
+{
+  if(mColumnarBusyEvents == nullptr)
+    return;
+
+  for(unsigned int link_id = 0; link_id < mDataLinkParsers.size(); link_id++) {
+    std::vector<BusyEvent>& busy_events = mDataLinkParsers[link_id]->getBusyEvents();
+    std::size_t num_finished = busy_events.size();
+
+    // The last busy event is not finished before BUSY_OFF is received
+    if(mDataLinkParsers[link_id]->getBusyStatus() && num_finished > 0)
+      num_finished--;
+
+    for(std::size_t i = mColumnarBusyEventCount[link_id]; i < num_finished; i++)
+      appendBusyEventColumnarRow(link_id, busy_events[i]);
+
+    mColumnarBusyEventCount[link_id] = std::max(mColumnarBusyEventCount[link_id], num_finished);
+  }
+}
+
+
+///@brief SystemC method that periodically passes the rows for the closed data rate
+///       intervals to the StatsWriter thread, and frees the interval counts in the
+///       data link parsers. Finished busy and trigger events are moved from the parsers
+///       to the spill files. Without the StatsWriter thread, only the finished busy events
+///       are appended to the columnar busy_events table.
+///       Only used when streaming is enabled with setStreamingOutputPath().
+void ReadoutUnit::dataRateStreamMethod(void)
+{
+  PROFILE_PROCESS(READOUT_UNIT);
+
+  // Number of data rate intervals per write to the stream
+  const uint64_t stream_intervals = 100;
+
+  uint64_t data_rate_interval_ns = mDataLinkParsers[0]->getDataIntervalNs();
+
+  if(mDataRateStreamFile) {
+    // The current interval is still being counted by the parsers,
+    // the intervals before it are closed.
+    uint64_t end_interval = sc_time_stamp().value() / data_rate_interval_ns;
+
+    std::string rows = getDataRateCsvRows(end_interval);
+
+    if(mColumnarDataRate != nullptr)
+      appendDataRateColumnarRows(end_interval);
+
+    for(unsigned int i = 0; i < mDataLinkParsers.size(); i++) {
+      std::map<uint64_t, unsigned int>& byte_counts = mDataLinkParsers[i]->getDataIntervalByteCounts();
+      byte_counts.erase(byte_counts.begin(), byte_counts.lower_bound(end_interval));
+    }
+
+    if(!rows.empty()) {
+      std::shared_ptr<std::ofstream> file = mDataRateStreamFile;
+      StatsWriter::post([file, rows]() {
+          *file << rows;
+        });
+    }
+  }
+
+  if(mBusyEventSpill)
+    spillParserEvents(false);
+  else
+    appendBusyEventColumnarRows();
+
+  next_trigger(stream_intervals*data_rate_interval_ns, SC_NS);
 }
 
 
@@ -237,21 +486,30 @@ void ReadoutUnit::sendTrigger(void)
   for(unsigned int i = 0; i < s_alpide_control_output.size(); i++) {
     if(mTriggerFilterEnabled && filter_trigger) {
       // Filter triggers that come too close in time
-      mTriggerActionMaps[i][mTriggerIdCount] = TRIGGER_FILTERED;
+      mLinkTriggerActions[i] = TRIGGER_FILTERED;
       mTriggersFilteredCount++;
     } else if(true) { ///@todo else if(link_busy[i] == false) {
       // If we are not busy, send trigger
       s_alpide_control_output[i]->transport(trigger_word);
       mTriggersSentCount[i]++;
-      mTriggerActionMaps[i][mTriggerIdCount] = TRIGGER_SENT;
+      mLinkTriggerActions[i] = TRIGGER_SENT;
       mPreviousTriggerId = mTriggerIdCount;
       mLastTriggerTime = time_now;
     } else {
-      mTriggerActionMaps[i][mTriggerIdCount] = TRIGGER_NOT_SENT_BUSY;
+      mLinkTriggerActions[i] = TRIGGER_NOT_SENT_BUSY;
       mLastTriggerTime = time_now;
     }
   }
 
+  mTriggerActions.addTrigger(mLinkTriggerActions);
+
+  if(mColumnarTriggerActions != nullptr) {
+    mColumnarTriggerActions->append(0, mTriggerIdCount);
+    for(unsigned int i = 0; i < mLinkTriggerActions.size(); i++)
+      mColumnarTriggerActions->append(i+1, uint64_t(mLinkTriggerActions[i]));
+    mColumnarTriggerActions->endRow();
+  }
+
   mTriggerIdCount++;
 }
 
@@ -259,11 +517,10 @@ void ReadoutUnit::sendTrigger(void)
 ///@brief Process trigger input events.
 void ReadoutUnit::triggerInputMethod(void)
 {
-  uint64_t time_now = sc_time_stamp().value();
+  PROFILE_PROCESS(READOUT_UNIT);
 
-  std::cout << "@" << time_now;
-  std::cout << ": RU " << mLayerId << ":" << mStaveId << " triggered.";
-  std::cout << std::endl;
+  LOG(READOUT_UNIT, DEBUG) << "@" << sc_time_stamp().value() << ": RU "
+                           << mLayerId << ":" << mStaveId << " triggered.";
 
   sendTrigger();
 }
@@ -274,6 +531,8 @@ void ReadoutUnit::triggerInputMethod(void)
 ///       local busy status.
 void ReadoutUnit::evaluateBusyStatusMethod(void)
 {
+  PROFILE_PROCESS(READOUT_UNIT);
+
   unsigned int busy_link_count = 0;
 
   for(unsigned int i = 0; i < mAlpideLinkBusySignals.size(); i++) {
@@ -311,6 +570,8 @@ void ReadoutUnit::evaluateBusyStatusMethod(void)
 ///       the chain, unless they originated from this readout unit.
 void ReadoutUnit::busyChainMethod(void)
 {
+  PROFILE_PROCESS(READOUT_UNIT);
+
   ///@todo Pass on busy event here, unless the busy event originated from this readout unit.
   ///@todo How can I implement a payload with these events? Maybe Matthias' structure is suitable for this?
 
@@ -318,11 +579,11 @@ void ReadoutUnit::busyChainMethod(void)
 
   if(s_busy_in->nb_read(busy_word)) {
 
-    uint64_t time_now = sc_time_stamp().value();
-    std::cout << "@" << time_now << ": RU " << mLayerId << ":" << mStaveId << " Got busy word." << std::endl;
-    std::cout << "Origin ID: " << busy_word.mOriginAddress << std::endl;
-    std::cout << "Timestamp : " << busy_word.mTimeStamp << std::endl;
-    std::cout << "Busy word type: " << busy_word.getString();
+    LOG(READOUT_UNIT, DEBUG) << "@" << sc_time_stamp().value() << ": RU "
+                             << mLayerId << ":" << mStaveId << " Got busy word.";
+    LOG(READOUT_UNIT, DEBUG) << "Origin ID: " << busy_word.mOriginAddress;
+    LOG(READOUT_UNIT, DEBUG) << "Timestamp : " << busy_word.mTimeStamp;
+    LOG(READOUT_UNIT, DEBUG) << "Busy word type: " << busy_word.getString();
 
     // Ignore (and discard) busy words that originated from this readout unit
     // (ie. it has made the roundtrip through the busy chain)
@@ -344,7 +605,7 @@ void ReadoutUnit::busyChainMethod(void)
       // }
 
       // Pass the busy word down the daisy chain link
-      std::cout << "Passing on busy word down the chain.." << std::endl;
+      LOG(READOUT_UNIT, DEBUG) << "Passing on busy word down the chain..";
       s_busy_fifo_out.nb_write(busy_word);
     }
   }
@@ -365,45 +626,44 @@ void ReadoutUnit::addTraces(sc_trace_file *wf, std::string name_prefix) const
 }
 
 
-///@brief Write simulation stats/data to file
-///@param[in] output_path Path to simulation output directory
-void ReadoutUnit::writeSimulationStats(const std::string output_path) const
+///@brief Get header line for the data rate CSV file
+///@return Header line, without newline
+std::string ReadoutUnit::getDataRateCsvHeader(void) const
 {
-  // ------------------------------------------------------
-  // Write data rate CSV file
-  // ------------------------------------------------------
+  std::ostringstream header;
 
-  std::string data_rate_csv_filename = output_path + std::string("_Data_rate.csv");
-  ofstream data_rate_csv_file(data_rate_csv_filename);
+  header << "Time (ns); RU total (Mbps)";
 
-  if(!data_rate_csv_file.is_open()) {
-    std::cerr << "Error opening data rate stats file: " << data_rate_csv_filename << std::endl;
-    return;
-  } else {
-    std::cout << "Writing data rate stats to file:\n\"";
-    std::cout << data_rate_csv_filename << "\"" << std::endl;
+  for(unsigned int i = 0; i < mDataLinkParsers.size(); i++) {
+    header << ";Link " << i << " (Mbps)";
   }
 
-  data_rate_csv_file << "Time (ns); RU total (Mbps)";
+  return header.str();
+}
 
-  for(unsigned int i = 0; i < mDataLinkParsers.size(); i++) {
-    data_rate_csv_file << ";Link " << i << " (Mbps)";
-  }
+
+///@brief Get rows for the data rate CSV file for the intervals held in the data link parsers
+///@param end_interval Only include intervals before this interval number
+///@return Rows with total and per link data rate. Each row starts with a newline.
+std::string ReadoutUnit::getDataRateCsvRows(uint64_t end_interval) const
+{
+  std::ostringstream rows;
 
   uint64_t data_rate_interval_ns = mDataLinkParsers[0]->getDataIntervalNs();
 
   // Assuming that each link parser has the recorded the same number of intervals, which should
   // hold true since they starts and stop at the same time, and use the same interval length
   for(auto interval_it = mDataLinkParsers[0]->getDataIntervalByteCounts().begin();
-      interval_it != mDataLinkParsers[0]->getDataIntervalByteCounts().end();
+      interval_it != mDataLinkParsers[0]->getDataIntervalByteCounts().end() &&
+        interval_it->first < end_interval;
       interval_it++)
   {
-    data_rate_csv_file << std::endl;
+    rows << std::endl;
 
     uint64_t interval_num = interval_it->first;
     uint64_t data_bytes_total = 0;
 
-    data_rate_csv_file << interval_num*data_rate_interval_ns << ";";
+    rows << interval_num*data_rate_interval_ns << ";";
 
     // Calculate total data rate (for readout unit)
     for(unsigned int i = 0; i < mDataLinkParsers.size(); i++) {
@@ -412,7 +672,7 @@ void ReadoutUnit::writeSimulationStats(const std::string output_path) const
 
     // Convert number of bytes in interval to Mbps
     double data_rate_total_mbps = 8*(data_bytes_total*(1E9/data_rate_interval_ns))/(1E6);
-    data_rate_csv_file << data_rate_total_mbps;
+    rows << data_rate_total_mbps;
 
     // Output data rate for each link
     for(unsigned int i = 0; i < mDataLinkParsers.size(); i++) {
@@ -420,10 +680,139 @@ void ReadoutUnit::writeSimulationStats(const std::string output_path) const
 
       // Convert number of bytes in interval to Mbps
       double data_rate_link_mbps = 8*(data_bytes_link*(1E9/data_rate_interval_ns))/(1E6);
-      data_rate_csv_file << ";" << data_rate_link_mbps;
+      rows << ";" << data_rate_link_mbps;
+    }
+  }
+
+  return rows.str();
+}
+
+
+///@brief Add the data rate intervals held in the data link parsers to the data rate table
+///       in the columnar statistics file, as number of bytes per interval
+///@param end_interval Only include intervals before this interval number
+void ReadoutUnit::appendDataRateColumnarRows(uint64_t end_interval) const
+{
+  uint64_t data_rate_interval_ns = mDataLinkParsers[0]->getDataIntervalNs();
+
+  for(auto interval_it = mDataLinkParsers[0]->getDataIntervalByteCounts().begin();
+      interval_it != mDataLinkParsers[0]->getDataIntervalByteCounts().end() &&
+        interval_it->first < end_interval;
+      interval_it++)
+  {
+    uint64_t interval_num = interval_it->first;
+    uint64_t data_bytes_total = 0;
+
+    for(unsigned int i = 0; i < mDataLinkParsers.size(); i++) {
+      data_bytes_total += mDataLinkParsers[i]->getDataIntervalByteCounts()[interval_num];
+    }
+
+    mColumnarDataRate->append(0, interval_num*data_rate_interval_ns);
+    mColumnarDataRate->append(1, data_bytes_total);
+
+    for(unsigned int i = 0; i < mDataLinkParsers.size(); i++) {
+      uint64_t data_bytes_link = mDataLinkParsers[i]->getDataIntervalByteCounts()[interval_num];
+      mColumnarDataRate->append(i+2, data_bytes_link);
+    }
+
+    mColumnarDataRate->endRow();
+  }
+}
+
+
+///@brief Get the memory used by the trigger action storage
+///@return Memory usage in bytes
+uint64_t ReadoutUnit::getTriggerActionMemoryUsage(void) const
+{
+  return mTriggerActions.getMemoryUsage() + mLinkTriggerActions.capacity();
+}
+
+
+///@brief Get an estimate of the memory used by the event frames etc. in the data link parsers
+///@return Memory usage in bytes
+uint64_t ReadoutUnit::getParserEventMemoryUsage(void) const
+{
+  uint64_t bytes = 0;
+
+  for(auto it = mDataLinkParsers.begin(); it != mDataLinkParsers.end(); it++)
+    bytes += (*it)->getEventMemoryUsage();
+
+  return bytes;
+}
+
+
+///@brief Get an estimate of the memory used by the data rate interval byte counts
+///       in the data link parsers
+///@return Memory usage in bytes
+uint64_t ReadoutUnit::getParserIntervalMemoryUsage(void) const
+{
+  uint64_t bytes = 0;
+
+  for(auto it = mDataLinkParsers.begin(); it != mDataLinkParsers.end(); it++)
+    bytes += (*it)->getIntervalMemoryUsage();
+
+  return bytes;
+}
+
+
+///@brief Move the events that are still held by the data link parsers to the spill
+///       files at the end of the simulation. Must be called before writeSimulationStats()
+///       when streaming was enabled with setStreamingOutputPath(). The parsers do not
+///       hold any busy or trigger events afterwards. Does nothing if streaming is not
+///       enabled, or if it was called before.
+void ReadoutUnit::finishStatsStreaming(void)
+{
+  if(mBusyEventSpill && !mStatsStreamingFinished)
+    spillParserEvents(true);
+
+  mStatsStreamingFinished = true;
+}
+
+
+///@brief Write simulation stats/data to file
+///@param[in] output_path Path to simulation output directory
+///@throw std::logic_error if streaming is enabled and finishStatsStreaming() was not called
+void ReadoutUnit::writeSimulationStats(const std::string output_path) const
+{
+  if(mBusyEventSpill && !mStatsStreamingFinished)
+    throw std::logic_error("ReadoutUnit: finishStatsStreaming() must be called before writeSimulationStats()");
+
+  // ------------------------------------------------------
+  // Write data rate CSV file
+  // ------------------------------------------------------
+
+  std::string remaining_rows = getDataRateCsvRows(std::numeric_limits<uint64_t>::max());
+
+  if(mColumnarDataRate != nullptr)
+    appendDataRateColumnarRows(std::numeric_limits<uint64_t>::max());
+
+  if(mDataRateStreamFile) {
+    // Header and closed intervals were written during the simulation,
+    // write the remaining intervals and close the file
+    std::cout << "Writing data rate stats to file:\n\"";
+    std::cout << mDataRateStreamFilename << "\"" << std::endl;
+
+    std::shared_ptr<std::ofstream> file = mDataRateStreamFile;
+    StatsWriter::post([file, remaining_rows]() {
+        *file << remaining_rows;
+        file->close();
+      });
+  } else {
+    std::string data_rate_csv_filename = output_path + std::string("_Data_rate.csv");
+    ofstream data_rate_csv_file(data_rate_csv_filename);
+
+    if(!data_rate_csv_file.is_open()) {
+      std::cerr << "Error opening data rate stats file: " << data_rate_csv_filename << std::endl;
+      return;
+    } else {
+      std::cout << "Writing data rate stats to file:\n\"";
+      std::cout << data_rate_csv_filename << "\"" << std::endl;
     }
+
+    data_rate_csv_file << getDataRateCsvHeader();
+    data_rate_csv_file << remaining_rows;
+    data_rate_csv_file.close();
   }
-  data_rate_csv_file.close();
 
 
   // ------------------------------------------------------
@@ -598,15 +987,68 @@ void ReadoutUnit::writeSimulationStats(const std::string output_path) const
   trig_actions_file.write((char*)&num_ctrl_links, sizeof(uint8_t));
 
   // Write action for each link, for each trigger
-  for(uint64_t trigger_id = 0; trigger_id < mTriggerIdCount; trigger_id++) {
-    for(uint64_t link_id = 0; link_id < mTriggerActionMaps.size(); link_id++) {
-      uint8_t link_action = mTriggerActionMaps[link_id].at(trigger_id);
-      trig_actions_file.write((char*)&link_action, sizeof(uint8_t));
-    }
-  }
+  mTriggerActions.writeActions(trig_actions_file);
   trig_actions_file.close();
 
 
+  // -----------------------------------------------------
+  // Write binary data files with busy events, and busy violation, flushed
+  // incomplete, readout abort and fatal events
+  // -----------------------------------------------------
+  if(mBusyEventSpill) {
+    // The events were moved from the parsers to spill files during the simulation,
+    // and the remaining ones by finishStatsStreaming()
+    writeSpilledEventFiles(output_path);
+  } else {
+    writeParserEventFiles(output_path);
+  }
+
+
+  // Write file with trigger summary
+  // -----------------------------------------------------
+  csv_filename = output_path + std::string("_Trigger_summary.csv");
+  ofstream trigger_summary_csv_file(csv_filename);
+
+  if(!trigger_summary_csv_file.is_open()) {
+    std::cerr << "Error opening trigger summary file: " << csv_filename << std::endl;
+    return;
+  } else {
+    std::cout << "Writing trigger summary to file:\n\"";
+    std::cout << csv_filename << "\"" << std::endl;
+  }
+
+  trigger_summary_csv_file << "Triggers received; Triggers filtered";
+  for(unsigned int i = 0; i < mTriggersSentCount.size(); i++) {
+    trigger_summary_csv_file << "; Link " << i << " triggers sent";
+  }
+  trigger_summary_csv_file << std::endl;
+
+  // Trigger id count is equivalent to number of triggers received
+  trigger_summary_csv_file << mTriggerIdCount << "; ";
+  trigger_summary_csv_file << mTriggersFilteredCount << "; ";
+
+  for(unsigned int i = 0; i < mTriggersSentCount.size(); i++) {
+    trigger_summary_csv_file << mTriggersSentCount[i] << "; ";
+  }
+  trigger_summary_csv_file << std::endl;
+  trigger_summary_csv_file.close();
+
+  ///@todo More ITS/RU stats here..
+
+  #ifdef ROOT_ENABLED
+    writeSimulationStatsROOT(output_path);
+  #endif
+}
+
+
+///@brief Write the binary data files with busy events, and busy violation, flushed
+///       incomplete, readout abort and fatal events, from the events held by the
+///       data link parsers.
+///@param[in] output_path Path and prefix for output files
+void ReadoutUnit::writeParserEventFiles(const std::string output_path) const
+{
+  uint8_t num_data_links = s_alpide_data_input.size();
+
   // -----------------------------------------------------
   // Write binary data file with busy events
   // -----------------------------------------------------
@@ -637,7 +1079,6 @@ void ReadoutUnit::writeSimulationStats(const std::string output_path) const
 
 
   // Write number of data links to file header
-  uint8_t num_data_links = s_alpide_data_input.size();
   busy_events_file.write((char*)&num_data_links, sizeof(uint8_t));
 
   // Write busy events for each link
@@ -654,6 +1095,12 @@ void ReadoutUnit::writeSimulationStats(const std::string output_path) const
       busy_events_file.write((char*)&(busy_event_it->mBusyOffTime), sizeof(uint64_t));
       busy_events_file.write((char*)&(busy_event_it->mBusyOnTriggerId), sizeof(uint64_t));
       busy_events_file.write((char*)&(busy_event_it->mBusyOffTriggerId), sizeof(uint64_t));
+
+      // Busy events that finished during the simulation were appended to the
+      // columnar table by dataRateStreamMethod()
+      std::size_t event_num = busy_event_it - busy_events.begin();
+      if(mColumnarBusyEvents != nullptr && event_num >= mColumnarBusyEventCount[link_id])
+        appendBusyEventColumnarRow(link_id, *busy_event_it);
     }
   }
   busy_events_file.close();
@@ -922,44 +1369,49 @@ void ReadoutUnit::writeSimulationStats(const std::string output_path) const
     }
   }
   fatal_event_file.close();
+}
 
 
-  // Write file with trigger summary
-  // -----------------------------------------------------
-  csv_filename = output_path + std::string("_Trigger_summary.csv");
-  ofstream trigger_summary_csv_file(csv_filename);
-
-  if(!trigger_summary_csv_file.is_open()) {
-    std::cerr << "Error opening trigger summary file: " << csv_filename << std::endl;
-    return;
-  } else {
-    std::cout << "Writing trigger summary to file:\n\"";
-    std::cout << csv_filename << "\"" << std::endl;
-  }
-
-  trigger_summary_csv_file << "Triggers received; Triggers filtered";
-  for(unsigned int i = 0; i < mTriggersSentCount.size(); i++) {
-    trigger_summary_csv_file << "; Link " << i << " triggers sent";
-  }
-  trigger_summary_csv_file << std::endl;
-
-  // Trigger id count is equivalent to number of triggers received
-  trigger_summary_csv_file << mTriggerIdCount << "; ";
-  trigger_summary_csv_file << mTriggersFilteredCount << "; ";
-
-  for(unsigned int i = 0; i < mTriggersSentCount.size(); i++) {
-    trigger_summary_csv_file << mTriggersSentCount[i] << "; ";
+///@brief Write the binary data files with busy events, and busy violation, flushed
+///       incomplete, readout abort and fatal events, from the spill files. The files
+///       have the same format as the ones written by writeParserEventFiles().
+///       All events should be moved to the spill files with finishStatsStreaming() first.
+///@param[in] output_path Path and prefix for output files
+void ReadoutUnit::writeSpilledEventFiles(const std::string output_path) const
+{
+  struct EventFile {
+    ReadoutUnitEventType type;
+    const char* suffix;
+    const char* description;
+  };
+
+  const std::vector<EventFile> event_files = {
+    {TRIGGER_EVENT_BUSY, "_busy_events.dat", "busy events"},
+    {TRIGGER_EVENT_BUSYV, "_busyv_events.dat", "busy violation events"},
+    {TRIGGER_EVENT_FLUSHED_INCOMPLETE, "_flush_events.dat", "flushed incomplete events"},
+    {TRIGGER_EVENT_ABORT, "_ro_abort_events.dat", "readout abort events"},
+    {TRIGGER_EVENT_FATAL, "_fatal_events.dat", "readout fatal events"}
+  };
+
+  for(auto it = event_files.begin(); it != event_files.end(); it++) {
+    std::string filename = output_path + it->suffix;
+    bool busy_events = it->type == TRIGGER_EVENT_BUSY;
+    const ParserEventSpill& spill = busy_events ? *mBusyEventSpill : *mTriggerEventSpills.at(it->type);
+
+    std::cout << "Writing " << it->description << " to file:\n\"";
+    std::cout << filename << "\"" << std::endl;
+
+    try {
+      // Busy events are grouped per link, the other events per link and chip
+      spill.writeGroupedFile(filename, s_alpide_data_input.size(), !busy_events);
+    } catch(const std::exception& e) {
+      std::cerr << "Error writing " << it->description << " file: " << e.what() << std::endl;
+      return;
+    }
   }
-  trigger_summary_csv_file << std::endl;
-  trigger_summary_csv_file.close();
-
-  ///@todo More ITS/RU stats here..
-
-  #ifdef ROOT_ENABLED
-    writeSimulationStatsROOT(output_path);
-  #endif
 }
 
+
 #ifdef ROOT_ENABLED
 
 ///@brief Write simulation stats/data to ROOT file
@@ -1001,6 +1453,18 @@ void ReadoutUnit::writeSimulationStatsROOT(const std::string output_path) const{
   busy_tree->Branch("busyOffTime",    &busyofftime);
   busy_tree->Branch("busyOnTriggerId",&busyontrigger);
   busy_tree->Branch("busyOffTriggerId",&busyofftrigger);
+  if(mBusyEventSpill) {
+    // The busy events were moved from the parsers to the spill file
+    mBusyEventSpill->forEachEvent([&](unsigned int link, unsigned int, const uint64_t* words) {
+        busylink = link;
+        busyontime = words[0];
+        busyofftime = words[1];
+        busyontrigger = words[2];
+        busyofftrigger = words[3];
+        busy_tree->Fill();
+      });
+  }
+
   // loop over links and fill tree with busy events
   for(uint64_t link_id = 0; link_id < mDataLinkParsers.size(); link_id++) {
     
@@ -1060,6 +1524,19 @@ void ReadoutUnit::writeTriggerEventTree(ReadoutUnitEventType type, TTree *tree)
   tree->Branch("chipId", &chipid);
   tree->Branch("triggerId", &triggerid);
 
+  auto spill_it = mTriggerEventSpills.find(type);
+
+  if(spill_it != mTriggerEventSpills.end()) {
+    // The events were moved from the parsers to the spill file
+    spill_it->second->forEachEvent([&](unsigned int link_id, unsigned int chip_id, const uint64_t* words) {
+        link = link_id;
+        chipid = chip_id;
+        triggerid = words[0];
+        tree->Fill();
+      });
+    return;
+  }
+
   // loop over links and fill tree with fatal trigger events
   for(uint64_t link_id = 0; link_id < mDataLinkParsers.size(); link_id++) {
     std::map<unsigned int, std::vector<uint64_t>> events;
@@ -20,9 +20,13 @@
 #pragma GCC diagnostic pop
 
 #include <vector>
+#include <map>
 #include <memory>
+#include <fstream>
 
 #include "BusyLinkWord.hpp"
+#include "TriggerActionStore.hpp"
+#include "ParserEventSpill.hpp"
 #include <Alpide/AlpideInterface.hpp>
 #include "../AlpideDataParser/AlpideDataParser.hpp"
 
@@ -30,6 +34,8 @@
 
 #define NUM_ALPIDE_DATA_LINKS 28
 
+class ColumnarTable;
+
 const uint8_t TRIGGER_SENT = 0;
 const uint8_t TRIGGER_NOT_SENT_BUSY = 1;
 const uint8_t TRIGGER_FILTERED = 2;
@@ -82,22 +88,58 @@ private:
   // Should be same size as s_alpide_control_output.
   std::vector<uint64_t> mTriggersSentCount;
 
-  // Map holds the trigger action taken per event ID per control link
-  // One map per control link in the vector
+  // Holds the trigger action taken per event ID per control link
   // Valid values for the uint8_t:
   // TRIGGER_SENT, TRIGGER_NOT_SENT_BUSY, TRIGGER_FILTERED.
-  std::vector<std::map<uint64_t, uint8_t>> mTriggerActionMaps;
+  TriggerActionStore mTriggerActions;
+
+  // Actions for the current trigger, one entry per control link
+  std::vector<uint8_t> mLinkTriggerActions;
 
 
   std::vector<std::shared_ptr<AlpideDataParser>> mDataLinkParsers;
   std::vector<sc_export<sc_signal<bool>>> mAlpideLinkBusySignals;
 
+  // Data rate CSV file written by the StatsWriter thread during the simulation.
+  // Null if the data rate CSV file is written at the end of the simulation.
+  std::shared_ptr<std::ofstream> mDataRateStreamFile;
+  std::string mDataRateStreamFilename;
+
+  // Busy events and trigger events (busy violation, flushed incomplete, readout abort
+  // and fatal) moved from the data link parsers to spill files during the simulation.
+  // Null/empty if the events are held by the parsers until the end of the simulation.
+  std::unique_ptr<ParserEventSpill> mBusyEventSpill;
+  std::map<ReadoutUnitEventType, std::unique_ptr<ParserEventSpill>> mTriggerEventSpills;
+
+  // Set by finishStatsStreaming(), when the remaining events have been moved to the spills
+  bool mStatsStreamingFinished = false;
+
+  // Tables in the run's columnar statistics file. Null if it is not enabled.
+  ColumnarTable* mColumnarDataRate = nullptr;
+  ColumnarTable* mColumnarTriggerActions = nullptr;
+  ColumnarTable* mColumnarBusyEvents = nullptr;
+
+  // Number of busy events per link appended to the columnar busy_events table during
+  // the simulation, when the busy events are held by the parsers
+  std::vector<std::size_t> mColumnarBusyEventCount;
+
   void sendTrigger(void);
   void alpideDataSocketInput(const DataPayload &pl);
 
   void evaluateBusyStatusMethod(void);
   void triggerInputMethod(void);
   void busyChainMethod(void);
+  void dataRateStreamMethod(void);
+  std::string getDataRateCsvHeader(void) const;
+  std::string getDataRateCsvRows(uint64_t end_interval) const;
+  void appendDataRateColumnarRows(uint64_t end_interval) const;
+  void spillParserEvents(bool end_of_simulation);
+  void appendBusyEventColumnarRow(uint64_t link_id, const BusyEvent& busy_event) const;
+  void appendBusyEventColumnarRows(void);
+  std::map<unsigned int, std::vector<uint64_t>>& getParserTriggerEvents(unsigned int link,
+                                                                        ReadoutUnitEventType type) const;
+  void writeParserEventFiles(const std::string output_path) const;
+  void writeSpilledEventFiles(const std::string output_path) const;
 //  void processInputData(void);
   void writeTriggerEventTree(ReadoutUnitEventType type, TTree *tree) const;
 
@@ -123,7 +165,13 @@ public:
   void end_of_elaboration();
   unsigned int numCtrlLinks(void) const { return s_alpide_control_output.size(); }
   unsigned int numDataLinks(void) const { return s_alpide_data_input.size(); }
+  uint64_t getTriggerIdCount(void) const { return mTriggerIdCount; }
   void addTraces(sc_trace_file *wf, std::string name_prefix) const;
+  void setStreamingOutputPath(const std::string output_path);
+  void finishStatsStreaming(void);
+  uint64_t getTriggerActionMemoryUsage(void) const;
+  uint64_t getParserEventMemoryUsage(void) const;
+  uint64_t getParserIntervalMemoryUsage(void) const;
   void writeSimulationStats(const std::string output_path) const;
   void writeSimulationStatsROOT(const std::string output_path) const;
 
@@ -0,0 +1,163 @@
+/**
+ * @file   TriggerActionStore.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Dense, append-only storage of the trigger action taken per control link
+ *         for each trigger in the ReadoutUnit.
+ */
+
+#include "TriggerActionStore.hpp"
+#include "common/StatsWriter.hpp"
+#include <cstdio>
+#include <stdexcept>
+
+
+std::string TriggerActionStore::mSpillDirectory = "";
+
+
+///@brief Constructor for TriggerActionStore
+///@param[in] num_links Number of control links
+///@param[in] spill_name Name used for the spill file, which is created in the spill
+///           directory (see setSpillDirectory()) if spilling is enabled
+///@param[in] chunk_triggers Number of triggers per chunk
+TriggerActionStore::TriggerActionStore(unsigned int num_links,
+                                       const std::string& spill_name,
+                                       uint64_t chunk_triggers)
+  : mNumLinks(num_links)
+  , mChunkTriggers(chunk_triggers)
+{
+  if(mChunkTriggers == 0)
+    throw std::runtime_error("TriggerActionStore: chunk size can not be zero");
+
+  if(!mSpillDirectory.empty() && !spill_name.empty())
+    mSpillFilename = mSpillDirectory + "/" + spill_name + "_trigger_actions.spill";
+}
+
+
+TriggerActionStore::~TriggerActionStore()
+{
+  if(mSpillFile) {
+    // Make sure the writer thread is done with the file
+    try {
+      StatsWriter::waitIdle();
+    } catch(const std::exception&) {
+      // Write errors are reported by StatsWriter::stop()
+    }
+    mSpillFile->close();
+    std::remove(mSpillFilename.c_str());
+  }
+}
+
+
+///@brief Add actions for the next trigger ID
+///@param[in] link_actions Action taken for each link. Should have one entry per link.
+void TriggerActionStore::addTrigger(const std::vector<uint8_t>& link_actions)
+{
+  if(link_actions.size() != mNumLinks)
+    throw std::runtime_error("TriggerActionStore: number of link actions does not match number of links");
+
+  // Readout units without control links have no actions to store
+  if(mNumLinks == 0) {
+    mNumTriggers++;
+    return;
+  }
+
+  if(mChunks.empty() || mChunks.back()->size() == mChunkTriggers*mNumLinks) {
+    if(!mSpillFilename.empty() && !mChunks.empty())
+      spillChunks();
+
+    mChunks.emplace_back(new std::vector<uint8_t>);
+    mChunks.back()->reserve(mChunkTriggers*mNumLinks);
+  }
+
+  mChunks.back()->insert(mChunks.back()->end(), link_actions.begin(), link_actions.end());
+  mNumTriggers++;
+}
+
+
+///@brief Write all chunks held in memory to the spill file, and free them.
+///       Should only be called when all chunks in memory are full.
+///       The chunks are freed by the StatsWriter once they have been written.
+void TriggerActionStore::spillChunks(void)
+{
+  if(!mSpillFile) {
+    mSpillFile = std::make_shared<std::ofstream>(mSpillFilename,
+                                                 std::ios_base::out |
+                                                 std::ios_base::binary |
+                                                 std::ios_base::trunc);
+
+    if(!mSpillFile->is_open())
+      throw std::runtime_error("TriggerActionStore: could not open spill file " + mSpillFilename);
+  }
+
+  // Only full chunks are spilled
+  mNumSpilledTriggers += mChunks.size() * mChunkTriggers;
+
+  std::shared_ptr<std::ofstream> spill_file = mSpillFile;
+  std::vector<std::shared_ptr<std::vector<uint8_t>>> chunks;
+  chunks.swap(mChunks);
+
+  StatsWriter::post([spill_file, chunks]() {
+      for(auto it = chunks.begin(); it != chunks.end(); it++)
+        spill_file->write((const char*)(*it)->data(), (*it)->size());
+
+      // Flush so that writeActions() can read the file back at any time
+      spill_file->flush();
+
+      if(!spill_file->good())
+        throw std::runtime_error("TriggerActionStore: error writing to spill file");
+    });
+}
+
+
+///@brief Get action for a trigger on a link. Only triggers that are still held in
+///       memory are available, throws std::out_of_range for triggers that were spilled
+///       to disk or do not exist.
+///@param[in] trigger_id Trigger ID
+///@param[in] link Control link number
+///@return Trigger action (TRIGGER_SENT, TRIGGER_NOT_SENT_BUSY or TRIGGER_FILTERED)
+uint8_t TriggerActionStore::getAction(uint64_t trigger_id, unsigned int link) const
+{
+  if(trigger_id < mNumSpilledTriggers || trigger_id >= mNumTriggers || link >= mNumLinks)
+    throw std::out_of_range("TriggerActionStore: trigger ID or link out of range");
+
+  uint64_t index = trigger_id - mNumSpilledTriggers;
+
+  return (*mChunks[index / mChunkTriggers])[(index % mChunkTriggers)*mNumLinks + link];
+}
+
+
+///@brief Write the actions for all triggers to a stream, in the order of trigger IDs,
+///       with one byte per link for each trigger. Triggers that were spilled to disk
+///       are read back from the spill file.
+///@param[out] out Output stream
+void TriggerActionStore::writeActions(std::ostream& out) const
+{
+  if(mNumSpilledTriggers > 0) {
+    // Wait for the writer thread to finish writing the spilled chunks
+    StatsWriter::waitIdle();
+
+    std::ifstream spill_file(mSpillFilename, std::ios_base::in | std::ios_base::binary);
+
+    if(!spill_file.is_open())
+      throw std::runtime_error("TriggerActionStore: could not open spill file " + mSpillFilename);
+
+    out << spill_file.rdbuf();
+  }
+
+  for(auto it = mChunks.begin(); it != mChunks.end(); it++)
+    out.write((const char*)(*it)->data(), (*it)->size());
+}
+
+
+///@brief Get memory used by the chunks held in memory
+///@return Memory usage in bytes
+uint64_t TriggerActionStore::getMemoryUsage(void) const
+{
+  uint64_t bytes = mChunks.capacity() * sizeof(std::shared_ptr<std::vector<uint8_t>>);
+
+  for(auto it = mChunks.begin(); it != mChunks.end(); it++)
+    bytes += sizeof(std::vector<uint8_t>) + (*it)->capacity();
+
+  return bytes;
+}
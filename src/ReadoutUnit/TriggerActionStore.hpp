@@ -0,0 +1,71 @@
+/**
+ * @file   TriggerActionStore.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Dense, append-only storage of the trigger action taken per control link
+ *         for each trigger in the ReadoutUnit.
+ *
+ *         Trigger IDs in the readout unit start at zero and increase by one for each
+ *         trigger, so instead of a map per link the actions are stored as one byte per
+ *         link per trigger, in the same order as they are written to the
+ *         _trigger_actions.dat file (all links for trigger 0, then all links for
+ *         trigger 1, etc.). The bytes are stored in fixed size chunks so that the
+ *         storage never has to be reallocated and copied as it grows.
+ *
+ *         Optionally, full chunks are spilled to a file on disk during the simulation,
+ *         so that only the last (partially filled) chunk is held in memory. The chunks
+ *         are written by the StatsWriter thread when it is enabled.
+ */
+
+#ifndef TRIGGER_ACTION_STORE_HPP
+#define TRIGGER_ACTION_STORE_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+class TriggerActionStore {
+private:
+  unsigned int mNumLinks;
+  uint64_t mChunkTriggers;
+  uint64_t mNumTriggers = 0;
+
+  ///@brief Number of triggers that were spilled to disk, and are not held in mChunks
+  uint64_t mNumSpilledTriggers = 0;
+
+  ///@brief Chunks held in memory. Each chunk holds mChunkTriggers*mNumLinks bytes,
+  ///       except the last one which may be partially filled.
+  std::vector<std::shared_ptr<std::vector<uint8_t>>> mChunks;
+
+  std::string mSpillFilename;
+  std::shared_ptr<std::ofstream> mSpillFile;
+
+  static std::string mSpillDirectory;
+
+  void spillChunks(void);
+
+public:
+  TriggerActionStore(unsigned int num_links,
+                     const std::string& spill_name = "",
+                     uint64_t chunk_triggers = 65536);
+  ~TriggerActionStore();
+
+  void addTrigger(const std::vector<uint8_t>& link_actions);
+  uint8_t getAction(uint64_t trigger_id, unsigned int link) const;
+  void writeActions(std::ostream& out) const;
+
+  uint64_t getNumTriggers(void) const {return mNumTriggers;}
+  unsigned int getNumLinks(void) const {return mNumLinks;}
+  uint64_t getNumSpilledTriggers(void) const {return mNumSpilledTriggers;}
+  uint64_t getMemoryUsage(void) const;
+
+  ///@brief Set directory where trigger actions are spilled to disk. Spilling is disabled
+  ///       if the directory is empty (default). Only affects stores created afterwards.
+  static void setSpillDirectory(const std::string& directory) {mSpillDirectory = directory;}
+};
+
+
+#endif
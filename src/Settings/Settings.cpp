@@ -62,8 +62,27 @@ void setDefaultSimSettings(QSettings *readoutSimSettings) {
   // Default settings map
   defaultSettings["data_output/write_vcd"] = DEFAULT_DATA_OUTPUT_WRITE_VCD;
   defaultSettings["data_output/write_vcd_clock"] = DEFAULT_DATA_OUTPUT_WRITE_VCD_CLOCK;
+  defaultSettings["data_output/vcd_format"] = DEFAULT_DATA_OUTPUT_VCD_FORMAT;
+  defaultSettings["data_output/vcd_include"] = DEFAULT_DATA_OUTPUT_VCD_INCLUDE;
+  defaultSettings["data_output/vcd_exclude"] = DEFAULT_DATA_OUTPUT_VCD_EXCLUDE;
+  defaultSettings["data_output/vcd_start_ns"] = DEFAULT_DATA_OUTPUT_VCD_START_NS;
+  defaultSettings["data_output/vcd_end_ns"] = DEFAULT_DATA_OUTPUT_VCD_END_NS;
+  defaultSettings["data_output/vcd_first_trigger_id"] = DEFAULT_DATA_OUTPUT_VCD_FIRST_TRIGGER_ID;
+  defaultSettings["data_output/vcd_last_trigger_id"] = DEFAULT_DATA_OUTPUT_VCD_LAST_TRIGGER_ID;
   defaultSettings["data_output/write_event_csv"] = DEFAULT_DATA_OUTPUT_WRITE_EVENT_CSV;
   defaultSettings["data_output/data_rate_interval_ns"] = DEFAULT_DATA_OUTPUT_DATA_RATE_INTERVAL_NS;
+  defaultSettings["data_output/write_process_profile"] = DEFAULT_DATA_OUTPUT_WRITE_PROCESS_PROFILE;
+  defaultSettings["data_output/write_memory_profile"] = DEFAULT_DATA_OUTPUT_WRITE_MEMORY_PROFILE;
+  defaultSettings["data_output/memory_profile_interval_ns"] = DEFAULT_DATA_OUTPUT_MEMORY_PROFILE_INTERVAL_NS;
+  defaultSettings["data_output/trigger_actions_spill"] = DEFAULT_DATA_OUTPUT_TRIGGER_ACTIONS_SPILL;
+  defaultSettings["data_output/stats_writer_thread"] = DEFAULT_DATA_OUTPUT_STATS_WRITER_THREAD;
+  defaultSettings["data_output/stats_writer_queue_size"] = DEFAULT_DATA_OUTPUT_STATS_WRITER_QUEUE_SIZE;
+  defaultSettings["data_output/write_columnar"] = DEFAULT_DATA_OUTPUT_WRITE_COLUMNAR;
+  defaultSettings["data_output/write_event_log"] = DEFAULT_DATA_OUTPUT_WRITE_EVENT_LOG;
+  defaultSettings["data_output/log_level"] = DEFAULT_DATA_OUTPUT_LOG_LEVEL;
+  defaultSettings["data_output/log_categories"] = DEFAULT_DATA_OUTPUT_LOG_CATEGORIES;
+  defaultSettings["data_output/log_writer_thread"] = DEFAULT_DATA_OUTPUT_LOG_WRITER_THREAD;
+  defaultSettings["data_output/log_queue_size"] = DEFAULT_DATA_OUTPUT_LOG_QUEUE_SIZE;
 
   defaultSettings["simulation/type"] = DEFAULT_SIMULATION_TYPE;
   defaultSettings["simulation/single_chip"] = DEFAULT_SIMULATION_SINGLE_CHIP;
@@ -71,6 +90,13 @@ void setDefaultSimSettings(QSettings *readoutSimSettings) {
   defaultSettings["simulation/system_continuous_mode"] = DEFAULT_SIMULATION_SYSTEM_CONTINUOUS_MODE;
   defaultSettings["simulation/system_continuous_period_ns"] = DEFAULT_SIMULATION_SYSTEM_CONTINUOUS_PERIOD_NS;
   defaultSettings["simulation/random_seed"] = DEFAULT_SIMULATION_RANDOM_SEED;
+  defaultSettings["simulation/random_counter_based"] = DEFAULT_SIMULATION_RANDOM_COUNTER_BASED;
+  defaultSettings["simulation/stop_ci_rel_width"] = DEFAULT_SIMULATION_STOP_CI_REL_WIDTH;
+  defaultSettings["simulation/stop_metrics"] = DEFAULT_SIMULATION_STOP_METRICS;
+  defaultSettings["simulation/stop_batch_events"] = DEFAULT_SIMULATION_STOP_BATCH_EVENTS;
+  defaultSettings["simulation/stop_min_batches"] = DEFAULT_SIMULATION_STOP_MIN_BATCHES;
+  defaultSettings["simulation/wall_clock_budget_s"] = DEFAULT_SIMULATION_WALL_CLOCK_BUDGET_S;
+  defaultSettings["simulation/compact_elaboration"] = DEFAULT_SIMULATION_COMPACT_ELABORATION;
 
   defaultSettings["alpide/data_long_enable"] = DEFAULT_ALPIDE_DATA_LONG_ENABLE;
   defaultSettings["alpide/dtu_delay"] = DEFAULT_ALPIDE_DTU_DELAY;
@@ -117,10 +143,16 @@ void setDefaultSimSettings(QSettings *readoutSimSettings) {
   defaultSettings["focal/staves_per_quadrant"] = DEFAULT_FOCAL_STAVES_PER_QUADRANT;
 
   defaultSettings["event/random_hit_generation"] = DEFAULT_EVENT_RANDOM_HIT_GENERATION;
+  defaultSettings["event/random_hit_batch_generation"] = DEFAULT_EVENT_RANDOM_HIT_BATCH_GENERATION;
   defaultSettings["event/random_cluster_generation"] = DEFAULT_EVENT_RANDOM_CLUSTER_GENERATION;
   defaultSettings["event/random_cluster_size_mean"] = DEFAULT_EVENT_RANDOM_CLUSTER_SIZE_MEAN;
   defaultSettings["event/random_cluster_size_stddev"] = DEFAULT_EVENT_RANDOM_CLUSTER_SIZE_STDDEV;
+  defaultSettings["event/random_cluster_shape_library"] = DEFAULT_EVENT_RANDOM_CLUSTER_SHAPE_LIBRARY;
+  defaultSettings["event/random_cluster_shape_file"] = DEFAULT_EVENT_RANDOM_CLUSTER_SHAPE_FILE;
+  defaultSettings["event/random_cluster_shape_samples"] = DEFAULT_EVENT_RANDOM_CLUSTER_SHAPE_SAMPLES;
   defaultSettings["event/monte_carlo_file_type"] = DEFAULT_EVENT_MONTE_CARLO_FILE_TYPE;
+  defaultSettings["event/monte_carlo_prefetch_events"] = DEFAULT_EVENT_MONTE_CARLO_PREFETCH_EVENTS;
+  defaultSettings["event/pipeline_events"] = DEFAULT_EVENT_PIPELINE_EVENTS;
   defaultSettings["event/qed_noise_path"] = DEFAULT_EVENT_QED_NOISE_PATH;
   defaultSettings["event/qed_noise_input"] = DEFAULT_EVENT_QED_NOISE_INPUT;
   defaultSettings["event/qed_noise_feed_rate_ns"] = DEFAULT_EVENT_QED_NOISE_FEED_RATE_NS;
@@ -22,8 +22,27 @@
 
 #define DEFAULT_DATA_OUTPUT_WRITE_VCD "false"
 #define DEFAULT_DATA_OUTPUT_WRITE_VCD_CLOCK "false"
+#define DEFAULT_DATA_OUTPUT_VCD_FORMAT "vcd"
+#define DEFAULT_DATA_OUTPUT_VCD_INCLUDE "*"
+#define DEFAULT_DATA_OUTPUT_VCD_EXCLUDE ""
+#define DEFAULT_DATA_OUTPUT_VCD_START_NS "0"
+#define DEFAULT_DATA_OUTPUT_VCD_END_NS "0"
+#define DEFAULT_DATA_OUTPUT_VCD_FIRST_TRIGGER_ID "-1"
+#define DEFAULT_DATA_OUTPUT_VCD_LAST_TRIGGER_ID "-1"
 #define DEFAULT_DATA_OUTPUT_WRITE_EVENT_CSV "true"
 #define DEFAULT_DATA_OUTPUT_DATA_RATE_INTERVAL_NS "10000"
+#define DEFAULT_DATA_OUTPUT_WRITE_PROCESS_PROFILE "false"
+#define DEFAULT_DATA_OUTPUT_WRITE_MEMORY_PROFILE "false"
+#define DEFAULT_DATA_OUTPUT_MEMORY_PROFILE_INTERVAL_NS "100000"
+#define DEFAULT_DATA_OUTPUT_TRIGGER_ACTIONS_SPILL "false"
+#define DEFAULT_DATA_OUTPUT_STATS_WRITER_THREAD "false"
+#define DEFAULT_DATA_OUTPUT_STATS_WRITER_QUEUE_SIZE "256"
+#define DEFAULT_DATA_OUTPUT_WRITE_COLUMNAR "false"
+#define DEFAULT_DATA_OUTPUT_WRITE_EVENT_LOG "false"
+#define DEFAULT_DATA_OUTPUT_LOG_LEVEL "info"
+#define DEFAULT_DATA_OUTPUT_LOG_CATEGORIES "all"
+#define DEFAULT_DATA_OUTPUT_LOG_WRITER_THREAD "false"
+#define DEFAULT_DATA_OUTPUT_LOG_QUEUE_SIZE "4096"
 
 #define DEFAULT_SIMULATION_TYPE "its"
 #define DEFAULT_SIMULATION_SINGLE_CHIP "true"
@@ -31,6 +50,13 @@
 #define DEFAULT_SIMULATION_SYSTEM_CONTINUOUS_MODE "false"
 #define DEFAULT_SIMULATION_SYSTEM_CONTINUOUS_PERIOD_NS "5000"
 #define DEFAULT_SIMULATION_RANDOM_SEED "0"
+#define DEFAULT_SIMULATION_RANDOM_COUNTER_BASED "false"
+#define DEFAULT_SIMULATION_STOP_CI_REL_WIDTH "0"
+#define DEFAULT_SIMULATION_STOP_METRICS "readout_efficiency;busy_violation_rate;data_rate"
+#define DEFAULT_SIMULATION_STOP_BATCH_EVENTS "100"
+#define DEFAULT_SIMULATION_STOP_MIN_BATCHES "10"
+#define DEFAULT_SIMULATION_WALL_CLOCK_BUDGET_S "0"
+#define DEFAULT_SIMULATION_COMPACT_ELABORATION "false"
 
 #define DEFAULT_ALPIDE_DATA_LONG_ENABLE "true"
 #define DEFAULT_ALPIDE_DTU_DELAY "10"
@@ -77,10 +103,16 @@
 #define DEFAULT_FOCAL_STAVES_PER_QUADRANT "3"
 
 #define DEFAULT_EVENT_RANDOM_HIT_GENERATION "true"
+#define DEFAULT_EVENT_RANDOM_HIT_BATCH_GENERATION "false"
 #define DEFAULT_EVENT_RANDOM_CLUSTER_GENERATION "false"
 #define DEFAULT_EVENT_RANDOM_CLUSTER_SIZE_MEAN "4"
 #define DEFAULT_EVENT_RANDOM_CLUSTER_SIZE_STDDEV "2"
+#define DEFAULT_EVENT_RANDOM_CLUSTER_SHAPE_LIBRARY "false"
+#define DEFAULT_EVENT_RANDOM_CLUSTER_SHAPE_FILE ""
+#define DEFAULT_EVENT_RANDOM_CLUSTER_SHAPE_SAMPLES "100000"
 #define DEFAULT_EVENT_MONTE_CARLO_FILE_TYPE "xml"
+#define DEFAULT_EVENT_MONTE_CARLO_PREFETCH_EVENTS "8"
+#define DEFAULT_EVENT_PIPELINE_EVENTS "0"
 #define DEFAULT_EVENT_QED_NOISE_PATH "config/monte_carlo_events/QED"
 #define DEFAULT_EVENT_QED_NOISE_INPUT "false"
 #define DEFAULT_EVENT_QED_NOISE_FEED_RATE_NS "250"
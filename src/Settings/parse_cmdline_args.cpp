@@ -47,6 +47,22 @@ QSettings* parseCommandLine(QCommandLineParser &parser,
   const QCommandLineOption writeCSVOption({"csv", "write_event_csv"},
                                           "Write event data to Comma Separated Value (CSV) file.");
 
+  const QCommandLineOption writeEventLogOption({"evl", "write_event_log"},
+                                               "Write event data to a compact binary event log "
+                                               "(physics_events_data.evl).");
+
+  const QCommandLineOption processProfileOption({"prof", "process_profile"},
+                                                "Count activations and wall time for each category of "
+                                                "SystemC processes, and write the profile to the output directory.");
+
+  const QCommandLineOption memoryProfileOption({"mem", "memory_profile"},
+                                               "Sample memory usage of chips and readout units, and resident set "
+                                               "size, and write the memory profile to the output directory.");
+
+  const QCommandLineOption writeColumnarOption({"col", "write_columnar"},
+                                               "Also write run statistics to a compact columnar binary file "
+                                               "(run_stats.acol) in the output directory.");
+
   const QCommandLineOption singleChipOption({"single", "single_chip"},
                                             "Run in single chip mode, using layer 0 hit density.");
 
@@ -118,6 +134,17 @@ QSettings* parseCommandLine(QCommandLineParser &parser,
                                                       "Strobe inactive time (in nanoseconds).",
                                                       "inactive time");
 
+  const QCommandLineOption stopCIRelWidthOption({"ci", "stop_ci_rel_width"},
+                                                "Stop simulation early when the relative width of the 95% "
+                                                "confidence interval of the stop metrics is below this value. "
+                                                "Use 0 to disable.",
+                                                "rel width");
+
+  const QCommandLineOption wallClockBudgetOption({"wt", "wall_clock_budget"},
+                                                 "Stop simulation when it has run for this many seconds "
+                                                 "(wall clock time). Use 0 to disable.",
+                                                 "seconds");
+
   const QCommandLineOption verboseOption({"V", "verbose"}, "Enable verbose output.");
 
   const QCommandLineOption outputDirPrefixOption({"o", "output_dir_prefix"},
@@ -133,6 +160,10 @@ QSettings* parseCommandLine(QCommandLineParser &parser,
   parser.addOption(writeVCDOption);
   parser.addOption(writeVCDClockOption);
   parser.addOption(writeCSVOption);
+  parser.addOption(writeEventLogOption);
+  parser.addOption(processProfileOption);
+  parser.addOption(memoryProfileOption);
+  parser.addOption(writeColumnarOption);
   parser.addOption(singleChipOption);
   parser.addOption(numEventsOption);
   parser.addOption(systemModeOption);
@@ -151,6 +182,8 @@ QSettings* parseCommandLine(QCommandLineParser &parser,
   parser.addOption(triggerFilterOption);
   parser.addOption(strobeActiveLengthOption);
   parser.addOption(strobeInactiveLengthOption);
+  parser.addOption(stopCIRelWidthOption);
+  parser.addOption(wallClockBudgetOption);
   parser.addOption(verboseOption);
   parser.addOption(outputDirPrefixOption);
 
@@ -197,6 +230,22 @@ QSettings* parseCommandLine(QCommandLineParser &parser,
       settings->setValue("data_output/write_event_csv", "true");
     }
 
+    if(parser.isSet(writeEventLogOption)) {
+      settings->setValue("data_output/write_event_log", "true");
+    }
+
+    if(parser.isSet(processProfileOption)) {
+      settings->setValue("data_output/write_process_profile", "true");
+    }
+
+    if(parser.isSet(memoryProfileOption)) {
+      settings->setValue("data_output/write_memory_profile", "true");
+    }
+
+    if(parser.isSet(writeColumnarOption)) {
+      settings->setValue("data_output/write_columnar", "true");
+    }
+
     if(parser.isSet(singleChipOption)) {
       settings->setValue("simulation/single_chip", "true");
     }
@@ -384,6 +433,28 @@ QSettings* parseCommandLine(QCommandLineParser &parser,
       }
     }
 
+    if(parser.isSet(stopCIRelWidthOption)) {
+      parser.value(stopCIRelWidthOption).toDouble(&conversion_ok);
+
+      if(conversion_ok == false) {
+        std::cout << "Error parsing stop criteria relative CI width." << std::endl;
+        start_program = false;
+      } else {
+        settings->setValue("simulation/stop_ci_rel_width", parser.value(stopCIRelWidthOption));
+      }
+    }
+
+    if(parser.isSet(wallClockBudgetOption)) {
+      parser.value(wallClockBudgetOption).toDouble(&conversion_ok);
+
+      if(conversion_ok == false) {
+        std::cout << "Error parsing wall clock budget." << std::endl;
+        start_program = false;
+      } else {
+        settings->setValue("simulation/wall_clock_budget_s", parser.value(wallClockBudgetOption));
+      }
+    }
+
     if(parser.isSet(verboseOption))
       settings->setValue("verbose", "true");
     else
@@ -0,0 +1,185 @@
+/**
+ * @file   ConvergenceMonitor.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Online batch means estimator used to stop a simulation early when the
+ *         statistics of interest have converged.
+ */
+
+#include "ConvergenceMonitor.hpp"
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+
+///@brief Two-sided 95% quantiles of Student's t-distribution, for 1 to 30 degrees of freedom.
+///       The normal quantile (1.96) is used for more than 30 degrees of freedom.
+static const double c_t_quantile_95[] = {12.706, 4.303, 3.182, 2.776, 2.571,
+                                         2.447, 2.365, 2.306, 2.262, 2.228,
+                                         2.201, 2.179, 2.160, 2.145, 2.131,
+                                         2.120, 2.110, 2.101, 2.093, 2.086,
+                                         2.080, 2.074, 2.069, 2.064, 2.060,
+                                         2.056, 2.052, 2.048, 2.045, 2.042};
+
+
+///@brief Constructor for ConvergenceMonitor
+///@param[in] target_rel_width Target width of the 95% confidence interval of the batch means,
+///           relative to the mean (e.g. 0.05 for +/- 2.5%)
+///@param[in] min_batches Minimum number of batches required before a metric is considered
+///           converged. Must be at least 2, since the variance can not be estimated otherwise.
+///@throw runtime_error If target_rel_width is not positive, or min_batches is less than 2
+ConvergenceMonitor::ConvergenceMonitor(double target_rel_width, unsigned int min_batches)
+  : mTargetRelWidth(target_rel_width)
+  , mMinBatches(min_batches)
+{
+  if(target_rel_width <= 0) {
+    throw std::runtime_error("Convergence target relative CI width must be positive.");
+  }
+  if(min_batches < 2) {
+    throw std::runtime_error("Convergence monitor needs a minimum of 2 batches.");
+  }
+}
+
+
+///@brief Add a metric to be monitored. Must be called before the first call to addBatch().
+///@param[in] name Name of metric, used in output file
+///@return Index of the metric, which is the index to use for it in addBatch()
+unsigned int ConvergenceMonitor::addMetric(const std::string& name)
+{
+  Metric metric;
+  metric.name = name;
+  mMetrics.push_back(metric);
+  return mMetrics.size()-1;
+}
+
+
+///@brief Add the values at the end of a batch for all metrics.
+///@param[in] numerators Cumulative numerator value for each metric
+///@param[in] denominators Cumulative denominator value for each metric
+///@throw runtime_error If the size of the vectors does not match the number of metrics
+void ConvergenceMonitor::addBatch(const std::vector<double>& numerators,
+                                  const std::vector<double>& denominators)
+{
+  if(numerators.size() != mMetrics.size() || denominators.size() != mMetrics.size()) {
+    throw std::runtime_error("Number of values in batch does not match number of metrics.");
+  }
+
+  for(unsigned int i = 0; i < mMetrics.size(); i++) {
+    Metric& metric = mMetrics[i];
+
+    double delta_num = numerators[i] - metric.last_numerator;
+    double delta_den = denominators[i] - metric.last_denominator;
+
+    if(delta_den > 0) {
+      metric.batch_values.push_back(delta_num/delta_den);
+      metric.last_numerator = numerators[i];
+      metric.last_denominator = denominators[i];
+    }
+  }
+
+  mBatchCount++;
+}
+
+
+double ConvergenceMonitor::getBatchMean(const Metric& metric) const
+{
+  if(metric.batch_values.empty())
+    return 0.0;
+
+  double sum = 0.0;
+  for(auto it = metric.batch_values.begin(); it != metric.batch_values.end(); it++)
+    sum += *it;
+
+  return sum / metric.batch_values.size();
+}
+
+
+///@brief Get width of the 95% confidence interval of the mean, relative to the mean.
+///@return Relative width. If the mean is zero and all batches were zero as well, the
+///        metric is considered exact and zero is returned. Infinity is returned if there
+///        are too few batches to estimate the variance.
+double ConvergenceMonitor::getRelativeWidth(const Metric& metric) const
+{
+  std::size_t n = metric.batch_values.size();
+
+  if(n < 2)
+    return std::numeric_limits<double>::infinity();
+
+  double mean = getBatchMean(metric);
+  double sum_sq = 0.0;
+
+  for(auto it = metric.batch_values.begin(); it != metric.batch_values.end(); it++)
+    sum_sq += (*it - mean)*(*it - mean);
+
+  double std_dev = std::sqrt(sum_sq / (n-1));
+
+  if(std_dev == 0.0)
+    return 0.0;
+  else if(mean == 0.0)
+    return std::numeric_limits<double>::infinity();
+
+  double t = (n-1) <= 30 ? c_t_quantile_95[n-2] : 1.96;
+  double half_width = t * std_dev / std::sqrt(n);
+
+  return 2 * half_width / std::fabs(mean);
+}
+
+
+bool ConvergenceMonitor::getMetricConverged(const Metric& metric) const
+{
+  return metric.batch_values.size() >= mMinBatches && getRelativeWidth(metric) <= mTargetRelWidth;
+}
+
+
+///@brief Check if all metrics have converged
+///@return True if the relative CI width for all metrics is within the target. Always false
+///        when no metrics have been added.
+bool ConvergenceMonitor::getConverged(void) const
+{
+  if(mMetrics.empty())
+    return false;
+
+  for(auto it = mMetrics.begin(); it != mMetrics.end(); it++) {
+    if(getMetricConverged(*it) == false)
+      return false;
+  }
+
+  return true;
+}
+
+
+double ConvergenceMonitor::getMean(unsigned int metric_index) const
+{
+  return getBatchMean(mMetrics.at(metric_index));
+}
+
+
+double ConvergenceMonitor::getRelativeWidth(unsigned int metric_index) const
+{
+  return getRelativeWidth(mMetrics.at(metric_index));
+}
+
+
+///@brief Write a CSV file with the batch means estimate and relative CI width for each metric
+///@param[in] filename Path/name of CSV file
+void ConvergenceMonitor::writeToFile(const std::string& filename) const
+{
+  std::ofstream file(filename);
+
+  if(!file.is_open()) {
+    std::cerr << "Error opening convergence stats file: " << filename << std::endl;
+    return;
+  }
+
+  file << "metric;batches;mean;rel_ci_width;converged" << std::endl;
+
+  for(auto it = mMetrics.begin(); it != mMetrics.end(); it++) {
+    file << it->name << ";";
+    file << it->batch_values.size() << ";";
+    file << getBatchMean(*it) << ";";
+    file << getRelativeWidth(*it) << ";";
+    file << (getMetricConverged(*it) ? "true" : "false") << std::endl;
+  }
+}
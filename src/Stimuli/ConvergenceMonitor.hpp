@@ -0,0 +1,66 @@
+/**
+ * @file   ConvergenceMonitor.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Online batch means estimator used to stop a simulation early when the
+ *         statistics of interest have converged.
+ */
+
+
+///@addtogroup testbench
+///@{
+#ifndef CONVERGENCE_MONITOR_HPP
+#define CONVERGENCE_MONITOR_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+///@brief   Keeps track of a set of ratio metrics (e.g. busy violations per trigger) using
+///         the method of batch means, and decides when the confidence interval for all of
+///         them is narrow enough that simulating more events would not change the result.
+///@details The metrics are supplied as cumulative numerator/denominator pairs at the end
+///         of each batch. The value of a metric for a batch is the ratio of the increments
+///         of numerator and denominator over that batch. Batches where the denominator did
+///         not increase carry no information for that metric and are skipped.
+class ConvergenceMonitor
+{
+private:
+  struct Metric {
+    std::string name;
+    double last_numerator = 0.0;
+    double last_denominator = 0.0;
+    std::vector<double> batch_values;
+  };
+
+  std::vector<Metric> mMetrics;
+
+  /// Target width of the confidence interval, relative to the mean
+  double mTargetRelWidth;
+
+  /// Minimum number of batches before a metric can be considered converged
+  unsigned int mMinBatches;
+
+  uint64_t mBatchCount = 0;
+
+  double getBatchMean(const Metric& metric) const;
+  double getRelativeWidth(const Metric& metric) const;
+  bool getMetricConverged(const Metric& metric) const;
+
+public:
+  ConvergenceMonitor(double target_rel_width, unsigned int min_batches);
+  unsigned int addMetric(const std::string& name);
+  void addBatch(const std::vector<double>& numerators,
+                const std::vector<double>& denominators);
+  bool getConverged(void) const;
+  uint64_t getBatchCount(void) const {return mBatchCount;}
+  unsigned int getNumMetrics(void) const {return mMetrics.size();}
+  double getMean(unsigned int metric_index) const;
+  double getRelativeWidth(unsigned int metric_index) const;
+  void writeToFile(const std::string& filename) const;
+};
+
+
+#endif
+///@}
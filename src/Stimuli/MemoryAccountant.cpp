@@ -0,0 +1,301 @@
+/**
+ * @file   MemoryAccountant.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Opt-in memory accounting for the simulation.
+ */
+
+#include "MemoryAccountant.hpp"
+#include "common/MemoryUsage.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sys/resource.h>
+#include <unistd.h>
+
+
+///@brief Number of chips and readout units listed in the summary file
+static const unsigned int SUMMARY_TOP_N = 10;
+
+
+SC_HAS_PROCESS(MemoryAccountant);
+///@brief Constructor for MemoryAccountant
+///@param[in] name SystemC module name
+///@param[in] output_path Path to directory where output files are written
+///@param[in] sample_interval_ns Interval between samples in simulation time [ns]
+///@param[in] chips Map of chip id vs Alpide chip object for the chips in the simulation
+///@param[in] readout_units Readout units in the simulation
+MemoryAccountant::MemoryAccountant(sc_core::sc_module_name name,
+                                   const std::string& output_path,
+                                   unsigned int sample_interval_ns,
+                                   const std::map<unsigned int, std::shared_ptr<Alpide>>& chips,
+                                   const std::vector<const ReadoutUnit*>& readout_units)
+  : sc_core::sc_module(name)
+  , mOutputPath(output_path)
+  , mSampleIntervalNs(sample_interval_ns)
+  , mSampleInterval(sample_interval_ns, SC_NS)
+{
+  if(sample_interval_ns == 0) {
+    std::string error_msg = "Memory profile interval can not be zero.";
+    throw std::runtime_error(error_msg);
+  }
+
+  // PixelHit objects are only counted when the memory profile is enabled
+  PixelHit::liveCountEnabled().store(true, std::memory_order_relaxed);
+
+  for(auto it = chips.begin(); it != chips.end(); it++) {
+    ChipPeak chip_peak;
+    chip_peak.chip_id = it->first;
+    chip_peak.chip = it->second;
+    mChips.push_back(chip_peak);
+  }
+
+  for(auto it = readout_units.begin(); it != readout_units.end(); it++) {
+    ReadoutUnitPeak ru_peak;
+    ru_peak.readout_unit = *it;
+    ru_peak.name = (*it)->name();
+    mReadoutUnits.push_back(ru_peak);
+  }
+
+  std::string filename = mOutputPath + std::string("/memory_profile.csv");
+  mTimeSeriesFile.open(filename);
+
+  if(!mTimeSeriesFile.is_open()) {
+    std::string error_msg = "Could not open " + filename + " for writing.";
+    throw std::runtime_error(error_msg);
+  }
+
+  mTimeSeriesFile << "time_ns;pixel_hits_live;pixel_hit_bytes;front_end_bytes;meb_bytes;";
+  mTimeSeriesFile << "trigger_action_bytes;parser_event_bytes;parser_interval_bytes;";
+  mTimeSeriesFile << "total_bytes;max_chip_id;max_chip_bytes;max_ru;max_ru_bytes;rss_kb" << std::endl;
+
+  SC_METHOD(sampleMethod);
+}
+
+
+///@brief Get current resident set size of the process
+///@return Resident set size in kilobytes, or 0 if it could not be determined
+uint64_t MemoryAccountant::getCurrentRSSKb(void)
+{
+  unsigned long size_pages = 0;
+  unsigned long resident_pages = 0;
+
+  FILE* fp = std::fopen("/proc/self/statm", "r");
+
+  if(fp == nullptr)
+    return 0;
+
+  int num_read = std::fscanf(fp, "%lu %lu", &size_pages, &resident_pages);
+  std::fclose(fp);
+
+  if(num_read != 2)
+    return 0;
+
+  return uint64_t(resident_pages) * uint64_t(sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+
+///@brief Get peak resident set size of the process since it was started
+///@return Peak resident set size in kilobytes
+uint64_t MemoryAccountant::getPeakRSSKb(void)
+{
+  struct rusage usage;
+
+  if(getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+  // ru_maxrss is in kilobytes on Linux
+  return usage.ru_maxrss;
+}
+
+
+void MemoryAccountant::updatePeak(const std::string& name, uint64_t value, uint64_t time_ns)
+{
+  auto it = mPeaks.find(name);
+
+  if(it == mPeaks.end())
+    mPeaks[name] = std::make_pair(value, time_ns);
+  else if(value > it->second.first)
+    it->second = std::make_pair(value, time_ns);
+}
+
+
+///@brief Take a sample of the memory usage of all chips and readout units,
+///       and update the per chip and per readout unit peak values
+///@return Memory sample with the totals, and the chip and readout unit
+///        with the highest usage
+MemorySample MemoryAccountant::takeSample(void)
+{
+  MemorySample sample;
+
+  sample.time_ns = sc_time_stamp().value();
+  sample.pixel_hits_live = PixelHit::liveCount().load(std::memory_order_relaxed);
+  sample.pixel_hit_bytes = sample.pixel_hits_live * shared_object_bytes<PixelHit>();
+
+  for(auto it = mChips.begin(); it != mChips.end(); it++) {
+    uint64_t front_end_bytes = it->chip->getHitQueueMemoryUsage();
+    uint64_t meb_bytes = it->chip->getMEBMemoryUsage();
+
+    sample.front_end_bytes += front_end_bytes;
+    sample.meb_bytes += meb_bytes;
+
+    if(front_end_bytes + meb_bytes > sample.max_chip_bytes) {
+      sample.max_chip_bytes = front_end_bytes + meb_bytes;
+      sample.max_chip_id = it->chip_id;
+    }
+
+    if(front_end_bytes + meb_bytes > it->front_end_bytes + it->meb_bytes) {
+      it->front_end_bytes = front_end_bytes;
+      it->meb_bytes = meb_bytes;
+    }
+  }
+
+  for(auto it = mReadoutUnits.begin(); it != mReadoutUnits.end(); it++) {
+    uint64_t trigger_action_bytes = it->readout_unit->getTriggerActionMemoryUsage();
+    uint64_t parser_event_bytes = it->readout_unit->getParserEventMemoryUsage();
+    uint64_t parser_interval_bytes = it->readout_unit->getParserIntervalMemoryUsage();
+
+    sample.trigger_action_bytes += trigger_action_bytes;
+    sample.parser_event_bytes += parser_event_bytes;
+    sample.parser_interval_bytes += parser_interval_bytes;
+
+    if(trigger_action_bytes + parser_event_bytes + parser_interval_bytes > sample.max_ru_bytes) {
+      sample.max_ru_bytes = trigger_action_bytes + parser_event_bytes + parser_interval_bytes;
+      sample.max_ru = it->name;
+    }
+
+    if(trigger_action_bytes + parser_event_bytes + parser_interval_bytes >
+       it->trigger_action_bytes + it->parser_event_bytes + it->parser_interval_bytes)
+    {
+      it->trigger_action_bytes = trigger_action_bytes;
+      it->parser_event_bytes = parser_event_bytes;
+      it->parser_interval_bytes = parser_interval_bytes;
+    }
+  }
+
+  sample.rss_kb = getCurrentRSSKb();
+
+  return sample;
+}
+
+
+///@brief SystemC method that samples the memory usage at a fixed interval in simulation time
+void MemoryAccountant::sampleMethod(void)
+{
+  recordSample();
+  next_trigger(mSampleInterval);
+}
+
+
+///@brief Take a sample, update the peak values and write the sample to the time series file
+void MemoryAccountant::recordSample(void)
+{
+  MemorySample sample = takeSample();
+
+  updatePeak("pixel_hits_live", sample.pixel_hits_live, sample.time_ns);
+  updatePeak("pixel_hit_bytes", sample.pixel_hit_bytes, sample.time_ns);
+  updatePeak("front_end_bytes", sample.front_end_bytes, sample.time_ns);
+  updatePeak("meb_bytes", sample.meb_bytes, sample.time_ns);
+  updatePeak("trigger_action_bytes", sample.trigger_action_bytes, sample.time_ns);
+  updatePeak("parser_event_bytes", sample.parser_event_bytes, sample.time_ns);
+  updatePeak("parser_interval_bytes", sample.parser_interval_bytes, sample.time_ns);
+  updatePeak("total_bytes", sample.getTotalBytes(), sample.time_ns);
+  updatePeak("rss_kb", sample.rss_kb, sample.time_ns);
+
+  mTimeSeriesFile << sample.time_ns << ";";
+  mTimeSeriesFile << sample.pixel_hits_live << ";";
+  mTimeSeriesFile << sample.pixel_hit_bytes << ";";
+  mTimeSeriesFile << sample.front_end_bytes << ";";
+  mTimeSeriesFile << sample.meb_bytes << ";";
+  mTimeSeriesFile << sample.trigger_action_bytes << ";";
+  mTimeSeriesFile << sample.parser_event_bytes << ";";
+  mTimeSeriesFile << sample.parser_interval_bytes << ";";
+  mTimeSeriesFile << sample.getTotalBytes() << ";";
+  mTimeSeriesFile << sample.max_chip_id << ";";
+  mTimeSeriesFile << sample.max_chip_bytes << ";";
+  mTimeSeriesFile << sample.max_ru << ";";
+  mTimeSeriesFile << sample.max_ru_bytes << ";";
+  mTimeSeriesFile << sample.rss_kb << "\n";
+
+  mNumSamples++;
+}
+
+
+///@brief SystemC callback at the end of the simulation. Takes a final sample and
+///       writes the summary files.
+void MemoryAccountant::end_of_simulation(void)
+{
+  recordSample();
+  mTimeSeriesFile.close();
+  writeSummary();
+}
+
+
+void MemoryAccountant::writeSummary(void)
+{
+  std::string summary_filename = mOutputPath + std::string("/memory_profile_summary.txt");
+  std::ofstream summary_file(summary_filename);
+
+  if(!summary_file.is_open()) {
+    std::cerr << "Error: Could not open " << summary_filename << " for writing." << std::endl;
+    return;
+  }
+
+  summary_file << "Memory profile summary" << std::endl;
+  summary_file << "Number of samples: " << mNumSamples << std::endl;
+  summary_file << "Sample interval (ns): " << mSampleIntervalNs << std::endl;
+  summary_file << "Peak RSS (kB): " << getPeakRSSKb() << std::endl;
+  summary_file << "Estimated bytes per PixelHit: " << shared_object_bytes<PixelHit>() << std::endl;
+  summary_file << std::endl;
+
+  summary_file << "Peak values (value @ time_ns):" << std::endl;
+  for(auto it = mPeaks.begin(); it != mPeaks.end(); it++) {
+    summary_file << "  " << it->first << ": " << it->second.first;
+    summary_file << " @ " << it->second.second << std::endl;
+  }
+
+  std::vector<ChipPeak> chips_sorted(mChips);
+  std::sort(chips_sorted.begin(), chips_sorted.end(),
+            [](const ChipPeak& a, const ChipPeak& b) {
+              return a.front_end_bytes + a.meb_bytes > b.front_end_bytes + b.meb_bytes;
+            });
+
+  summary_file << std::endl;
+  summary_file << "Chips with highest peak usage (chip id: front end bytes, MEB bytes):" << std::endl;
+  for(unsigned int i = 0; i < chips_sorted.size() && i < SUMMARY_TOP_N; i++) {
+    summary_file << "  " << chips_sorted[i].chip_id << ": ";
+    summary_file << chips_sorted[i].front_end_bytes << ", ";
+    summary_file << chips_sorted[i].meb_bytes << std::endl;
+  }
+
+  std::vector<ReadoutUnitPeak> rus_sorted(mReadoutUnits);
+  std::sort(rus_sorted.begin(), rus_sorted.end(),
+            [](const ReadoutUnitPeak& a, const ReadoutUnitPeak& b) {
+              return a.trigger_action_bytes + a.parser_event_bytes + a.parser_interval_bytes >
+                b.trigger_action_bytes + b.parser_event_bytes + b.parser_interval_bytes;
+            });
+
+  summary_file << std::endl;
+  summary_file << "Readout units with highest peak usage ";
+  summary_file << "(name: trigger action bytes, parser event bytes, parser interval bytes):" << std::endl;
+  for(unsigned int i = 0; i < rus_sorted.size() && i < SUMMARY_TOP_N; i++) {
+    summary_file << "  " << rus_sorted[i].name << ": ";
+    summary_file << rus_sorted[i].trigger_action_bytes << ", ";
+    summary_file << rus_sorted[i].parser_event_bytes << ", ";
+    summary_file << rus_sorted[i].parser_interval_bytes << std::endl;
+  }
+
+  std::ofstream chips_file(mOutputPath + std::string("/memory_profile_chips.csv"));
+  chips_file << "chip_id;peak_front_end_bytes;peak_meb_bytes" << std::endl;
+  for(auto it = mChips.begin(); it != mChips.end(); it++) {
+    chips_file << it->chip_id << ";" << it->front_end_bytes << ";" << it->meb_bytes << std::endl;
+  }
+
+  std::ofstream ru_file(mOutputPath + std::string("/memory_profile_readout_units.csv"));
+  ru_file << "readout_unit;peak_trigger_action_bytes;peak_parser_event_bytes;";
+  ru_file << "peak_parser_interval_bytes" << std::endl;
+  for(auto it = mReadoutUnits.begin(); it != mReadoutUnits.end(); it++) {
+    ru_file << it->name << ";" << it->trigger_action_bytes << ";";
+    ru_file << it->parser_event_bytes << ";" << it->parser_interval_bytes << std::endl;
+  }
+}
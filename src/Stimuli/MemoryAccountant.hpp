@@ -0,0 +1,121 @@
+/**
+ * @file   MemoryAccountant.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Opt-in memory accounting for the simulation.
+ *
+ *         Samples the number of live PixelHit objects, an estimate of the bytes
+ *         held by the major containers of the chips (front end hit queue, multi
+ *         event buffers) and readout units (trigger action maps, parser event
+ *         frames, data rate interval counts), and the resident set size of the
+ *         process, at a fixed interval in simulation time.
+ *
+ *         Live PixelHit objects are only counted once a MemoryAccountant has
+ *         been created, so runs without the memory profile do not pay for the
+ *         counter. Hits created before that (e.g. events generated ahead during
+ *         elaboration) are not included in the count.
+ *
+ *         The samples are written to memory_profile.csv in the output directory,
+ *         and a summary with the peak values, and the chips and readout units
+ *         with the highest memory usage, is written to memory_profile_summary.txt
+ *         at the end of the simulation. The peak usage per chip and per readout
+ *         unit is written to memory_profile_chips.csv and
+ *         memory_profile_readout_units.csv.
+ */
+
+///@addtogroup testbench
+///@{
+#ifndef MEMORY_ACCOUNTANT_HPP
+#define MEMORY_ACCOUNTANT_HPP
+
+// Ignore warnings about use of auto_ptr and unused parameters in SystemC library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#include <systemc.h>
+#pragma GCC diagnostic pop
+
+#include "Alpide/Alpide.hpp"
+#include "ReadoutUnit/ReadoutUnit.hpp"
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+struct MemorySample {
+  uint64_t time_ns = 0;
+  uint64_t pixel_hits_live = 0;
+  uint64_t pixel_hit_bytes = 0;
+  uint64_t front_end_bytes = 0;
+  uint64_t meb_bytes = 0;
+  uint64_t trigger_action_bytes = 0;
+  uint64_t parser_event_bytes = 0;
+  uint64_t parser_interval_bytes = 0;
+  uint64_t rss_kb = 0;
+
+  unsigned int max_chip_id = 0;
+  uint64_t max_chip_bytes = 0;
+  std::string max_ru = "-";
+  uint64_t max_ru_bytes = 0;
+
+  uint64_t getTotalBytes(void) const {
+    return pixel_hit_bytes + front_end_bytes + meb_bytes +
+      trigger_action_bytes + parser_event_bytes + parser_interval_bytes;
+  }
+};
+
+
+class MemoryAccountant : public sc_core::sc_module {
+private:
+  struct ChipPeak {
+    unsigned int chip_id;
+    std::shared_ptr<Alpide> chip;
+    uint64_t front_end_bytes = 0;
+    uint64_t meb_bytes = 0;
+  };
+
+  struct ReadoutUnitPeak {
+    const ReadoutUnit* readout_unit;
+    std::string name;
+    uint64_t trigger_action_bytes = 0;
+    uint64_t parser_event_bytes = 0;
+    uint64_t parser_interval_bytes = 0;
+  };
+
+  std::vector<ChipPeak> mChips;
+  std::vector<ReadoutUnitPeak> mReadoutUnits;
+
+  std::string mOutputPath;
+  unsigned int mSampleIntervalNs;
+  sc_time mSampleInterval;
+  std::ofstream mTimeSeriesFile;
+
+  uint64_t mNumSamples = 0;
+
+  ///@brief Peak value and time for each column in MemorySample. Key is column name.
+  std::map<std::string, std::pair<uint64_t, uint64_t>> mPeaks;
+
+  MemorySample takeSample(void);
+  void updatePeak(const std::string& name, uint64_t value, uint64_t time_ns);
+  void recordSample(void);
+  void sampleMethod(void);
+  void writeSummary(void);
+
+public:
+  MemoryAccountant(sc_core::sc_module_name name,
+                   const std::string& output_path,
+                   unsigned int sample_interval_ns,
+                   const std::map<unsigned int, std::shared_ptr<Alpide>>& chips,
+                   const std::vector<const ReadoutUnit*>& readout_units);
+  void end_of_simulation(void);
+
+  static uint64_t getCurrentRSSKb(void);
+  static uint64_t getPeakRSSKb(void);
+};
+
+
+#endif
+///@}
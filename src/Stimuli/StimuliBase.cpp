@@ -7,6 +7,7 @@
 
 #include "StimuliBase.hpp"
 #include <iostream>
+#include <set>
 
 ///@brief Constructor for stimuli base class.
 ///@param[in] settings QSettings object with simulation settings.
@@ -29,6 +30,15 @@ StimuliBase::StimuliBase(sc_core::sc_module_name name,
   mTriggerFilterTimeNs = settings->value("event/trigger_filter_time_ns").toUInt();
   mTriggerFilterEnabled = settings->value("event/trigger_filter_enable").toBool();
   mDataRateIntervalNs = settings->value("data_output/data_rate_interval_ns").toUInt();
+  mWriteMemoryProfile = settings->value("data_output/write_memory_profile").toBool();
+  mMemoryProfileIntervalNs = settings->value("data_output/memory_profile_interval_ns").toUInt();
+
+  mStopCIRelWidth = settings->value("simulation/stop_ci_rel_width").toDouble();
+  mStopBatchEvents = settings->value("simulation/stop_batch_events").toULongLong();
+  mStopMinBatches = settings->value("simulation/stop_min_batches").toUInt();
+  mStopMetricNames = settings->value("simulation/stop_metrics").toString().split(";", QString::SkipEmptyParts);
+  mWallClockBudgetS = settings->value("simulation/wall_clock_budget_s").toDouble();
+  mWallClockStart = std::chrono::steady_clock::now();
 
   mChipCfg.dtu_delay_cycles = settings->value("alpide/dtu_delay").toUInt();
   mChipCfg.strobe_length_ns = mStrobeActiveNs;
@@ -37,6 +47,7 @@ StimuliBase::StimuliBase(sc_core::sc_module_name name,
   mChipCfg.data_long_en = settings->value("alpide/data_long_enable").toBool();
   mChipCfg.chip_continuous_mode = settings->value("alpide/chip_continuous_mode").toBool();
   mChipCfg.matrix_readout_speed = settings->value("alpide/matrix_readout_speed_fast").toBool();
+  mChipCfg.compact_elaboration = settings->value("simulation/compact_elaboration").toBool();
 
   if((mStrobeActiveNs+mStrobeInactiveNs) > mSystemContinuousPeriodNs) {
     std::string error_msg = "Alpide strobe active + inactive time > system continuous period.";
@@ -51,6 +62,7 @@ StimuliBase::StimuliBase(sc_core::sc_module_name name,
   std::cout << "Single chip simulation: " << (mSingleChipSimulation ? "true" : "false") << std::endl;
   std::cout << "System continuous mode: " << (mSystemContinuousMode ? "continuous" : "triggered") << std::endl;
   std::cout << "System continuous period: " << mSystemContinuousPeriodNs << std::endl;
+  std::cout << "Compact elaboration: " << (mChipCfg.compact_elaboration ? "true" : "false") << std::endl;
   std::cout << "Chip continuous mode: " << (mChipCfg.chip_continuous_mode ? "continuous" : "triggered") << std::endl;
   std::cout << "Strobe active time (ns): " << mStrobeActiveNs << std::endl;
   std::cout << "Strobe inactive time (ns): " << mStrobeInactiveNs << std::endl;
@@ -63,10 +75,222 @@ StimuliBase::StimuliBase(sc_core::sc_module_name name,
   std::cout << "Strobe extension enabled: " << (mChipCfg.strobe_extension ? "true" : "false") << std::endl;
   std::cout << "Minimum busy cycles: " << mChipCfg.min_busy_cycles << std::endl;
   std::cout << "Data rate interval (ns): " << mDataRateIntervalNs << std::endl;
+  std::cout << "Memory profile interval (ns): " << mMemoryProfileIntervalNs;
+  std::cout << (mWriteMemoryProfile ? "" : " (disabled)") << std::endl;
+  std::cout << "Stop at relative CI width: " << mStopCIRelWidth;
+  std::cout << (mStopCIRelWidth > 0 ? "" : " (disabled)") << std::endl;
+  std::cout << "Stop metrics: " << mStopMetricNames.join(";").toStdString() << std::endl;
+  std::cout << "Stop batch size (events): " << mStopBatchEvents << std::endl;
+  std::cout << "Stop minimum number of batches: " << mStopMinBatches << std::endl;
+  std::cout << "Wall clock budget (s): " << mWallClockBudgetS;
+  std::cout << (mWallClockBudgetS > 0 ? "" : " (disabled)") << std::endl;
 
 
   if(mDataRateIntervalNs == 0) {
     std::string error_msg = "Data rate interval can not be zero.";
     throw std::runtime_error(error_msg);
   }
+
+  if(mStopCIRelWidth > 0 && mStopBatchEvents == 0) {
+    std::string error_msg = "Batch size for early stop criteria can not be zero.";
+    throw std::runtime_error(error_msg);
+  }
+}
+
+
+///@brief Set up the convergence monitor used by the early stop criteria.
+///       Should be called by the derived stimuli classes once the chips have been created.
+///       Does nothing if early stop on convergence is disabled.
+///@param[in] chips Map of chip id vs Alpide chip object for the chips in the simulation
+///@param[in] global_chip_id_to_position_func Pointer to function used to determine position
+///                                           (layer) based on global chip id
+///@param[in] readout_stats Pixel readout stats object used for readout efficiency
+///@throw runtime_error If an unknown stop metric was specified
+void StimuliBase::initStopCriteria(const std::map<unsigned int, std::shared_ptr<Alpide>>& chips,
+                                   Detector::t_global_chip_id_to_position_func global_chip_id_to_position_func,
+                                   const std::shared_ptr<PixelReadoutStats>& readout_stats)
+{
+  if(mStopCIRelWidth <= 0)
+    return;
+
+  mConvergenceMonitor = std::unique_ptr<ConvergenceMonitor>(new ConvergenceMonitor(mStopCIRelWidth,
+                                                                                   mStopMinBatches));
+  mStopReadoutStats = readout_stats;
+
+  std::vector<std::shared_ptr<Alpide>> all_chips;
+  std::map<unsigned int, std::vector<std::shared_ptr<Alpide>>> layer_chips;
+
+  for(auto it = chips.begin(); it != chips.end(); it++) {
+    all_chips.push_back(it->second);
+    layer_chips[global_chip_id_to_position_func(it->first).layer_id].push_back(it->second);
+  }
+
+  for(auto name_it = mStopMetricNames.begin(); name_it != mStopMetricNames.end(); name_it++) {
+    StopMetric metric;
+
+    if(*name_it == "readout_efficiency") {
+      metric.type = StopMetric::READOUT_EFFICIENCY;
+      mConvergenceMonitor->addMetric("readout_efficiency");
+      mStopMetrics.push_back(metric);
+    } else if(*name_it == "busy_violation_rate") {
+      metric.type = StopMetric::BUSY_VIOLATION_RATE;
+      metric.chips = all_chips;
+      mConvergenceMonitor->addMetric("busy_violation_rate");
+      mStopMetrics.push_back(metric);
+    } else if(*name_it == "data_rate") {
+      // One metric per layer, in Mbps
+      metric.type = StopMetric::DATA_RATE;
+      for(auto layer_it = layer_chips.begin(); layer_it != layer_chips.end(); layer_it++) {
+        metric.chips = layer_it->second;
+        mConvergenceMonitor->addMetric("data_rate_mbps_layer_" + std::to_string(layer_it->first));
+        mStopMetrics.push_back(metric);
+      }
+    } else {
+      std::string error_msg = "Unknown stop metric \"" + name_it->toStdString() + "\".";
+      throw std::runtime_error(error_msg);
+    }
+  }
+}
+
+
+///@brief Set up the memory accountant, which samples the memory usage of the chips
+///       and readout units periodically during the simulation. Should be called by the
+///       derived stimuli classes once the chips and readout units have been created.
+///       Does nothing if the memory profile is disabled.
+///@param[in] chips Map of chip id vs Alpide chip object for the chips in the simulation
+///@param[in] readout_units Readout units in the simulation
+void StimuliBase::initMemoryAccountant(const std::map<unsigned int, std::shared_ptr<Alpide>>& chips,
+                                       const std::vector<const ReadoutUnit*>& readout_units)
+{
+  if(!mWriteMemoryProfile)
+    return;
+
+  mMemoryAccountant = std::unique_ptr<MemoryAccountant>(new MemoryAccountant("MemoryAccountant",
+                                                                             mOutputPath,
+                                                                             mMemoryProfileIntervalNs,
+                                                                             chips,
+                                                                             readout_units));
+}
+
+
+///@brief Get the number of triggers sent to the detector so far
+///@return Trigger ID count of the first readout unit, or zero before the
+///        readout units are created
+uint64_t StimuliBase::getTriggerIdCount(void) const
+{
+  if(mTriggerReadoutUnit == nullptr)
+    return 0;
+
+  return mTriggerReadoutUnit->getTriggerIdCount();
+}
+
+
+///@brief Start measuring elaboration time and memory. Should be called by the derived
+///       stimuli classes right before the detector (chips and readout units) is created.
+void StimuliBase::beginElaboration(void)
+{
+  mElaborationStartRSSKb = MemoryAccountant::getCurrentRSSKb();
+  mElaborationStart = std::chrono::steady_clock::now();
+}
+
+
+///@brief Print time used and memory allocated (resident set size) while creating the
+///       detector, since beginElaboration() was called.
+///@param[in] num_chips Number of chips in the detector
+void StimuliBase::endElaboration(unsigned int num_chips) const
+{
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - mElaborationStart;
+  uint64_t rss_kb = MemoryAccountant::getCurrentRSSKb();
+  uint64_t rss_increase_kb = rss_kb > mElaborationStartRSSKb ? rss_kb - mElaborationStartRSSKb : 0;
+
+  std::cout << std::endl;
+  std::cout << "Elaborated " << num_chips << " chips";
+  std::cout << (mChipCfg.compact_elaboration ? " (compact)" : "") << " in ";
+  std::cout << elapsed.count() << " s." << std::endl;
+  std::cout << "Resident set size increase: " << rss_increase_kb << " kB";
+
+  if(num_chips > 0)
+    std::cout << " (" << rss_increase_kb / num_chips << " kB per chip)";
+
+  std::cout << std::endl;
+}
+
+
+///@brief Check if the simulation should be stopped before n_events is reached, because
+///       the wall clock budget was used up, or because the monitored metrics have converged.
+///       Should be called once for each new event.
+///@param[in] event_count Number of events simulated so far
+///@return True if the simulation should be stopped
+bool StimuliBase::checkStopCriteria(uint64_t event_count)
+{
+  if(mWallClockBudgetS > 0) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - mWallClockStart;
+
+    if(elapsed.count() >= mWallClockBudgetS) {
+      mStopReason = "Wall clock budget of " + std::to_string(mWallClockBudgetS) + " s used up";
+      return true;
+    }
+  }
+
+  if(mConvergenceMonitor && event_count > 0 && (event_count % mStopBatchEvents) == 0) {
+    std::vector<double> numerators;
+    std::vector<double> denominators;
+
+    for(auto metric_it = mStopMetrics.begin(); metric_it != mStopMetrics.end(); metric_it++) {
+      double num = 0.0;
+      double den = 0.0;
+
+      switch(metric_it->type) {
+      case StopMetric::READOUT_EFFICIENCY:
+        if(mStopReadoutStats) {
+          num = mStopReadoutStats->getReadOutCountTotal();
+          den = mStopReadoutStats->getHitCountTotal();
+        }
+        break;
+      case StopMetric::BUSY_VIOLATION_RATE:
+        for(auto chip_it = metric_it->chips.begin(); chip_it != metric_it->chips.end(); chip_it++) {
+          num += (*chip_it)->getBusyViolationCount();
+          den += (*chip_it)->getTriggersReceivedCount();
+        }
+        break;
+      case StopMetric::DATA_RATE:
+        for(auto chip_it = metric_it->chips.begin(); chip_it != metric_it->chips.end(); chip_it++) {
+          const Alpide& chip = **chip_it;
+          num += chip.getDataWordCount(ALPIDE_CHIP_HEADER) * DW_CHIP_HEADER_SIZE;
+          num += chip.getDataWordCount(ALPIDE_CHIP_TRAILER) * DW_CHIP_TRAILER_SIZE;
+          num += chip.getDataWordCount(ALPIDE_CHIP_EMPTY_FRAME) * DW_CHIP_EMPTY_FRAME_SIZE;
+          num += chip.getDataWordCount(ALPIDE_REGION_HEADER) * DW_REGION_HEADER_SIZE;
+          num += chip.getDataWordCount(ALPIDE_REGION_TRAILER) * DW_REGION_TRAILER_SIZE;
+          num += chip.getDataWordCount(ALPIDE_DATA_SHORT) * DW_DATA_SHORT_SIZE;
+          num += chip.getDataWordCount(ALPIDE_DATA_LONG) * DW_DATA_LONG_SIZE;
+          num += chip.getDataWordCount(ALPIDE_BUSY_ON) * DW_BUSY_ON_SIZE;
+          num += chip.getDataWordCount(ALPIDE_BUSY_OFF) * DW_BUSY_OFF_SIZE;
+        }
+        // Bytes to megabits, and nanoseconds to seconds
+        num = num * 8 / 1E6;
+        den = sc_time_stamp().value() / 1E9;
+        break;
+      }
+
+      numerators.push_back(num);
+      denominators.push_back(den);
+    }
+
+    mConvergenceMonitor->addBatch(numerators, denominators);
+
+    if(mConvergenceMonitor->getConverged()) {
+      mStopReason = "Stop metrics converged after " + std::to_string(event_count) + " events";
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+///@brief Write convergence stats for the stop metrics to file, if enabled.
+void StimuliBase::writeStopCriteriaStats(void) const
+{
+  if(mConvergenceMonitor)
+    mConvergenceMonitor->writeToFile(mOutputPath + std::string("/convergence_stats.csv"));
 }
@@ -19,7 +19,16 @@
 #pragma GCC diagnostic pop
 
 #include <QSettings>
+#include <QStringList>
+#include <map>
+#include <memory>
+#include <chrono>
+#include "Alpide/Alpide.hpp"
 #include "Alpide/AlpideConfig.hpp"
+#include "Alpide/PixelReadoutStats.hpp"
+#include "Detector/Common/DetectorConfig.hpp"
+#include "ConvergenceMonitor.hpp"
+#include "MemoryAccountant.hpp"
 
 class StimuliBase : public sc_core::sc_module
 {
@@ -45,9 +54,67 @@ protected:
 
   AlpideConfig mChipCfg;
 
+  ///@defgroup stop_criteria Early stop criteria
+  ///@{
+  /// Target relative width of confidence interval of the stop metrics. Zero disables.
+  double mStopCIRelWidth;
+
+  /// Number of (triggered/untriggered) events per batch in the batch means estimates
+  uint64_t mStopBatchEvents;
+
+  unsigned int mStopMinBatches;
+
+  /// Names of metrics to monitor for convergence
+  QStringList mStopMetricNames;
+
+  /// Wall clock budget for the simulation in seconds. Zero disables.
+  double mWallClockBudgetS;
+
+  std::chrono::steady_clock::time_point mWallClockStart;
+
+  /// Description of why the simulation was stopped before n_events was reached,
+  /// empty if it was not.
+  std::string mStopReason;
+
+  struct StopMetric {
+    enum {READOUT_EFFICIENCY, BUSY_VIOLATION_RATE, DATA_RATE} type;
+    std::vector<std::shared_ptr<Alpide>> chips;
+  };
+
+  std::vector<StopMetric> mStopMetrics;
+  std::shared_ptr<PixelReadoutStats> mStopReadoutStats;
+  std::unique_ptr<ConvergenceMonitor> mConvergenceMonitor;
+  ///@}
+
+  void initStopCriteria(const std::map<unsigned int, std::shared_ptr<Alpide>>& chips,
+                        Detector::t_global_chip_id_to_position_func global_chip_id_to_position_func,
+                        const std::shared_ptr<PixelReadoutStats>& readout_stats);
+  bool checkStopCriteria(uint64_t event_count);
+  void writeStopCriteriaStats(void) const;
+
+  bool mWriteMemoryProfile;
+  unsigned int mMemoryProfileIntervalNs;
+  std::unique_ptr<MemoryAccountant> mMemoryAccountant;
+
+  void initMemoryAccountant(const std::map<unsigned int, std::shared_ptr<Alpide>>& chips,
+                            const std::vector<const ReadoutUnit*>& readout_units);
+
+  ///@brief Readout unit whose trigger ID count is returned by getTriggerIdCount().
+  ///       All readout units get the same triggers from the stimuli.
+  const ReadoutUnit* mTriggerReadoutUnit = nullptr;
+
+  ///@brief Wall clock time and resident set size when elaboration of the detector started
+  std::chrono::steady_clock::time_point mElaborationStart;
+  uint64_t mElaborationStartRSSKb = 0;
+
+  void beginElaboration(void);
+  void endElaboration(unsigned int num_chips) const;
+
 public:
   StimuliBase(sc_core::sc_module_name name, QSettings* settings, std::string output_path);
   virtual void addTraces(sc_trace_file *wf) const = 0;
+  virtual void stopEventThreads(void) = 0;
+  uint64_t getTriggerIdCount(void) const;
 };
 
 
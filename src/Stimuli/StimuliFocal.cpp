@@ -7,6 +7,8 @@
 
 #include "StimuliFocal.hpp"
 #include "Detector/Common/DetectorSimulationStats.hpp"
+#include "common/Log.hpp"
+#include "common/ProcessProfiler.hpp"
 
 // Ignore warnings about use of auto_ptr and unused parameters in SystemC library
 #pragma GCC diagnostic push
@@ -49,6 +51,8 @@ StimuliFocal::StimuliFocal(sc_core::sc_module_name name, QSettings* settings, st
                                                                      settings,
                                                                      mOutputPath)));
 
+  beginElaboration();
+
   mFocal = std::move(std::unique_ptr<Focal::FocalDetector>(new Focal::FocalDetector("Focal",
                                                                                     config,
                                                                                     mTriggerFilterTimeNs,
@@ -57,6 +61,16 @@ StimuliFocal::StimuliFocal(sc_core::sc_module_name name, QSettings* settings, st
   mFocal->s_system_clk_in(clock);
   mFocal->s_detector_busy_out(s_focal_busy);
 
+  endElaboration(mFocal->getChipMap().size());
+
+  initStopCriteria(mFocal->getChipMap(),
+                   &Focal::Focal_global_chip_id_to_position,
+                   mEventGen->getTriggeredReadoutStats());
+
+  initMemoryAccountant(mFocal->getChipMap(), mFocal->getReadoutUnits());
+  mTriggerReadoutUnit = mFocal->getReadoutUnits().front();
+  mFocal->initStatsStreaming(mOutputPath);
+
   s_physics_event = false;
 
   if(mSystemContinuousMode == true) {
@@ -89,25 +103,28 @@ void StimuliFocal::stimuliMainMethod(void)
     sc_core::sc_stop();
 
     writeStimuliInfo();
+    mFocal->finishStatsStreaming();
     mFocal->writeSimulationStats(mOutputPath);
     mEventGen->writeSimulationStats(mOutputPath);
+    writeStopCriteriaStats();
   }
   // We want to stop at n_events, not n_events-1.
   else if(mEventGen->getTriggeredEventCount() <= mNumEvents) {
+    // Only the per-event work is profiled, not the statistics written at the end
+    PROFILE_PROCESS(STIMULI);
+
     //if((mEventGen->getPhysicsEventCount() % 100) == 0) {
-    int64_t time_now = sc_time_stamp().value();
-    std::cout << "@ " << time_now << " ns: \tPhysics event number ";
-    std::cout << mEventGen->getTriggeredEventCount() << std::endl;
+    LOG(STIMULI, INFO) << "@ " << sc_time_stamp().value() << " ns: \tPhysics event number "
+                       << mEventGen->getTriggeredEventCount();
     //}
 
-    std::cout << "Feeding " << mEventGen->getTriggeredEvent().size() << " pixels to Focal detector." << std::endl;
+    LOG(STIMULI, DEBUG) << "Feeding " << mEventGen->getTriggeredEvent().size() << " pixels to Focal detector.";
     // Get hits for this event, and "feed" them to the Focal detector
-    auto event_hits = mEventGen->getTriggeredEvent();
+    const auto& event_hits = mEventGen->getTriggeredEvent();
 
-    for(auto it = event_hits.begin(); it != event_hits.end(); it++)
-      mFocal->pixelInput(*it);
+    mFocal->pixelInput(event_hits);
 
-    std::cout << "Creating event for next trigger.." << std::endl;
+    LOG(STIMULI, DEBUG) << "Creating event for next trigger..";
 
     if(mSystemContinuousMode == false) {
       // Create an event for the next trigger, delayed by the
@@ -115,7 +132,12 @@ void StimuliFocal::stimuliMainMethod(void)
       mFocal->E_trigger_in.notify(mTriggerDelayNs, SC_NS);
     }
 
-    if(mEventGen->getTriggeredEventCount() == mNumEvents) {
+    bool stop_criteria_met = checkStopCriteria(mEventGen->getTriggeredEventCount());
+
+    if(stop_criteria_met)
+      std::cout << "Stopping simulation early: " << mStopReason << std::endl;
+
+    if(mEventGen->getTriggeredEventCount() == mNumEvents || stop_criteria_met) {
       // When we have reached the desired number of events, allow simulation to run for
       // another X us to allow readout of data remaining in MEBs, FIFOs etc.
       next_trigger(100, SC_US);
@@ -132,16 +154,16 @@ void StimuliFocal::stimuliMainMethod(void)
 ///       not associated with a trigger to the ALPIDE chips.
 void StimuliFocal::stimuliQedNoiseEventMethod(void)
 {
+  PROFILE_PROCESS(STIMULI);
+
     // Get hits for this event, and "feed" them to the ITS detector
-    auto event_hits = mEventGen->getUntriggeredEvent();
+    const auto& event_hits = mEventGen->getUntriggeredEvent();
 
     if(mSingleChipSimulation) {
-      for(auto it = event_hits.begin(); it != event_hits.end(); it++)
-        mAlpide->pixelInput(*it);
+      mAlpide->pixelInput(event_hits);
     }
     else {
-      for(auto it = event_hits.begin(); it != event_hits.end(); it++)
-        mFocal->pixelInput(*it);
+      mFocal->pixelInput(event_hits);
     }
 }
 
@@ -157,6 +179,8 @@ void StimuliFocal::stimuliQedNoiseEventMethod(void)
 ///       in the chip.
 void StimuliFocal::continuousTriggerMethod(void)
 {
+  PROFILE_PROCESS(STIMULI);
+
   if(mSingleChipSimulation)
     mReadoutUnit->E_trigger_in.notify(mTriggerDelayNs, SC_NS);
   else
@@ -171,6 +195,8 @@ void StimuliFocal::continuousTriggerMethod(void)
 ///       so that we can have a signal for this that we can add to the trace file.
 void StimuliFocal::physicsEventSignalMethod(void)
 {
+  PROFILE_PROCESS(STIMULI);
+
   if(s_physics_event.read() == true) {
     s_physics_event.write(false);
     next_trigger(mEventGen->E_triggered_event);
@@ -181,6 +207,14 @@ void StimuliFocal::physicsEventSignalMethod(void)
 }
 
 
+///@brief Stop the event generator's threads. Called from main() when the simulation
+///       has ended, before the log is stopped.
+void StimuliFocal::stopEventThreads(void)
+{
+  mEventGen->stopEventThreads();
+}
+
+
 ///@brief Add SystemC signals to log in VCD trace file.
 ///@param[in,out] wf VCD waveform file pointer
 void StimuliFocal::addTraces(sc_trace_file *wf) const
@@ -214,4 +248,7 @@ void StimuliFocal::writeStimuliInfo(void) const
   info_file << "Number of untriggered events requested: " << 0 << std::endl;
   info_file << "Number of untriggered events simulated: ";
   info_file << mEventGen->getUntriggeredEventCount() << std::endl;
+
+  if(mStopReason.empty() == false)
+    info_file << "Simulation stopped early: " << mStopReason << std::endl;
 }
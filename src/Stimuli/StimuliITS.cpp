@@ -7,6 +7,8 @@
 
 #include "StimuliITS.hpp"
 #include "Detector/Common/DetectorSimulationStats.hpp"
+#include "common/Log.hpp"
+#include "common/ProcessProfiler.hpp"
 
 // Ignore warnings about use of auto_ptr and unused parameters in SystemC library
 #pragma GCC diagnostic push
@@ -89,6 +91,8 @@ StimuliITS::StimuliITS(sc_core::sc_module_name name, QSettings* settings, std::s
                                                                      settings,
                                                                      mOutputPath)));
 
+  beginElaboration();
+
   if(mSingleChipSimulation) {
     mAlpide = std::move(std::unique_ptr<ITS::SingleChip>(new ITS::SingleChip("SingleChip",
                                                                              0,
@@ -112,6 +116,18 @@ StimuliITS::StimuliITS(sc_core::sc_module_name name, QSettings* settings, std::s
     mReadoutUnit->s_serial_data_trig_id[0](mAlpide->s_serial_data_trig_id_exp);
     mReadoutUnit->s_alpide_control_output[0].bind(mAlpide->socket_control_in[0]);
     mAlpide->socket_data_out[0].bind(mReadoutUnit->s_alpide_data_input[0]);
+
+    std::map<unsigned int, std::shared_ptr<Alpide>> chip_map;
+    chip_map[mAlpide->getChips()[0]->getGlobalChipId()] = mAlpide->getChips()[0];
+
+    endElaboration(chip_map.size());
+
+    initStopCriteria(chip_map,
+                     &ITS::ITS_global_chip_id_to_position,
+                     mEventGen->getTriggeredReadoutStats());
+
+    initMemoryAccountant(chip_map, {mReadoutUnit.get()});
+    mTriggerReadoutUnit = mReadoutUnit.get();
   }
   else { // ITS Detector Simulation
     mITS = std::move(std::unique_ptr<ITS::ITSDetector>(new ITS::ITSDetector("ITS", config,
@@ -120,6 +136,16 @@ StimuliITS::StimuliITS(sc_core::sc_module_name name, QSettings* settings, std::s
                                                                             mDataRateIntervalNs)));
     mITS->s_system_clk_in(clock);
     mITS->s_detector_busy_out(s_its_busy);
+
+    endElaboration(mITS->getChipMap().size());
+
+    initStopCriteria(mITS->getChipMap(),
+                     &ITS::ITS_global_chip_id_to_position,
+                     mEventGen->getTriggeredReadoutStats());
+
+    initMemoryAccountant(mITS->getChipMap(), mITS->getReadoutUnits());
+    mTriggerReadoutUnit = mITS->getReadoutUnits().front();
+    mITS->initStatsStreaming(mOutputPath);
   }
 
   s_physics_event = false;
@@ -165,28 +191,31 @@ void StimuliITS::stimuliMainMethod(void)
                                        chip_map,
                                        &ITS::ITS_global_chip_id_to_position);
     } else {
+      mITS->finishStatsStreaming();
       mITS->writeSimulationStats(mOutputPath);
     }
 
     mEventGen->writeSimulationStats(mOutputPath);
+    writeStopCriteriaStats();
   }
   // We want to stop at n_events, not n_events-1.
   else if(mEventGen->getTriggeredEventCount() <= mNumEvents) {
+    // Only the per-event work is profiled, not the statistics written at the end
+    PROFILE_PROCESS(STIMULI);
+
     //if((mEventGen->getPhysicsEventCount() % 100) == 0) {
-    int64_t time_now = sc_time_stamp().value();
-    std::cout << "@ " << time_now << " ns: \tPhysics event number ";
-    std::cout << mEventGen->getTriggeredEventCount() << std::endl;
+    LOG(STIMULI, INFO) << "@ " << sc_time_stamp().value() << " ns: \tPhysics event number "
+                       << mEventGen->getTriggeredEventCount();
     //}
 
-    std::cout << "Feeding " << mEventGen->getTriggeredEvent().size() << " pixels to ITS detector." << std::endl;
+    LOG(STIMULI, DEBUG) << "Feeding " << mEventGen->getTriggeredEvent().size() << " pixels to ITS detector.";
     // Get hits for this event, and "feed" them to the ITS detector
-    auto event_hits = mEventGen->getTriggeredEvent();
+    const auto& event_hits = mEventGen->getTriggeredEvent();
 
     if(mSingleChipSimulation) {
-      for(auto it = event_hits.begin(); it != event_hits.end(); it++)
-        mAlpide->pixelInput(*it);
+      mAlpide->pixelInput(event_hits);
 
-      std::cout << "Creating event for next trigger.." << std::endl;
+      LOG(STIMULI, DEBUG) << "Creating event for next trigger..";
 
       if(mSystemContinuousMode == false) {
         // Create an event for the next trigger, delayed by the
@@ -195,10 +224,9 @@ void StimuliITS::stimuliMainMethod(void)
       }
     }
     else {
-      for(auto it = event_hits.begin(); it != event_hits.end(); it++)
-        mITS->pixelInput(*it);
+      mITS->pixelInput(event_hits);
 
-      std::cout << "Creating event for next trigger.." << std::endl;
+      LOG(STIMULI, DEBUG) << "Creating event for next trigger..";
 
       if(mSystemContinuousMode == false) {
       // Create an event for the next trigger, delayed by the
@@ -207,7 +235,12 @@ void StimuliITS::stimuliMainMethod(void)
       }
     }
 
-    if(mEventGen->getTriggeredEventCount() == mNumEvents) {
+    bool stop_criteria_met = checkStopCriteria(mEventGen->getTriggeredEventCount());
+
+    if(stop_criteria_met)
+      std::cout << "Stopping simulation early: " << mStopReason << std::endl;
+
+    if(mEventGen->getTriggeredEventCount() == mNumEvents || stop_criteria_met) {
       // When we have reached the desired number of events, allow simulation to run for
       // another X us to allow readout of data remaining in MEBs, FIFOs etc.
       next_trigger(100, SC_US);
@@ -224,16 +257,16 @@ void StimuliITS::stimuliMainMethod(void)
 ///       not associated with a trigger to the ALPIDE chips.
 void StimuliITS::stimuliQedNoiseEventMethod(void)
 {
+  PROFILE_PROCESS(STIMULI);
+
     // Get hits for this event, and "feed" them to the ITS detector
-    auto event_hits = mEventGen->getUntriggeredEvent();
+    const auto& event_hits = mEventGen->getUntriggeredEvent();
 
     if(mSingleChipSimulation) {
-      for(auto it = event_hits.begin(); it != event_hits.end(); it++)
-        mAlpide->pixelInput(*it);
+      mAlpide->pixelInput(event_hits);
     }
     else {
-      for(auto it = event_hits.begin(); it != event_hits.end(); it++)
-        mITS->pixelInput(*it);
+      mITS->pixelInput(event_hits);
     }
 }
 
@@ -249,6 +282,8 @@ void StimuliITS::stimuliQedNoiseEventMethod(void)
 ///       in the chip.
 void StimuliITS::continuousTriggerMethod(void)
 {
+  PROFILE_PROCESS(STIMULI);
+
   if(mSingleChipSimulation)
     mReadoutUnit->E_trigger_in.notify(mTriggerDelayNs, SC_NS);
   else
@@ -263,6 +298,8 @@ void StimuliITS::continuousTriggerMethod(void)
 ///       so that we can have a signal for this that we can add to the trace file.
 void StimuliITS::physicsEventSignalMethod(void)
 {
+  PROFILE_PROCESS(STIMULI);
+
   if(s_physics_event.read() == true) {
     s_physics_event.write(false);
     next_trigger(mEventGen->E_triggered_event);
@@ -273,6 +310,14 @@ void StimuliITS::physicsEventSignalMethod(void)
 }
 
 
+///@brief Stop the event generator's threads. Called from main() when the simulation
+///       has ended, before the log is stopped.
+void StimuliITS::stopEventThreads(void)
+{
+  mEventGen->stopEventThreads();
+}
+
+
 ///@brief Add SystemC signals to log in VCD trace file.
 ///@param[in,out] wf VCD waveform file pointer
 void StimuliITS::addTraces(sc_trace_file *wf) const
@@ -306,4 +351,7 @@ void StimuliITS::writeStimuliInfo(void) const
   info_file << "Number of untriggered events requested: " << 0 << std::endl;
   info_file << "Number of untriggered events simulated: ";
   info_file << mEventGen->getUntriggeredEventCount() << std::endl;
+
+  if(mStopReason.empty() == false)
+    info_file << "Simulation stopped early: " << mStopReason << std::endl;
 }
@@ -7,6 +7,8 @@
 
 #include "StimuliPCT.hpp"
 #include "Detector/Common/DetectorSimulationStats.hpp"
+#include "common/Log.hpp"
+#include "common/ProcessProfiler.hpp"
 
 // Ignore warnings about use of auto_ptr and unused parameters in SystemC library
 #pragma GCC diagnostic push
@@ -117,6 +119,8 @@ StimuliPCT::StimuliPCT(sc_core::sc_module_name name, QSettings* settings, std::s
                                                                      config,
                                                                      mOutputPath)));
 
+  beginElaboration();
+
   if(mSingleChipSimulation) {
     mAlpide = std::move(std::unique_ptr<ITS::SingleChip>(new ITS::SingleChip("SingleChip",
                                                                              0,
@@ -139,6 +143,18 @@ StimuliPCT::StimuliPCT(sc_core::sc_module_name name, QSettings* settings, std::s
     mReadoutUnit->s_serial_data_input[0](mAlpide->s_alpide_data_out_exp);
     mReadoutUnit->s_alpide_control_output[0].bind(mAlpide->socket_control_in[0]);
     mAlpide->socket_data_out[0].bind(mReadoutUnit->s_alpide_data_input[0]);
+
+    std::map<unsigned int, std::shared_ptr<Alpide>> chip_map;
+    chip_map[mAlpide->getChips()[0]->getGlobalChipId()] = mAlpide->getChips()[0];
+
+    endElaboration(chip_map.size());
+
+    initStopCriteria(chip_map,
+                     &PCT::PCT_global_chip_id_to_position,
+                     mEventGen->getUntriggeredReadoutStats());
+
+    initMemoryAccountant(chip_map, {mReadoutUnit.get()});
+    mTriggerReadoutUnit = mReadoutUnit.get();
   }
   else { // ITS Detector Simulation
     mPCT = std::move(std::unique_ptr<PCT::PCTDetector>(new PCT::PCTDetector("PCT", config,
@@ -147,6 +163,16 @@ StimuliPCT::StimuliPCT(sc_core::sc_module_name name, QSettings* settings, std::s
                                                                             mDataRateIntervalNs)));
     mPCT->s_system_clk_in(clock);
     mPCT->s_detector_busy_out(s_pct_busy);
+
+    endElaboration(mPCT->getChipMap().size());
+
+    initStopCriteria(mPCT->getChipMap(),
+                     &PCT::PCT_global_chip_id_to_position,
+                     mEventGen->getUntriggeredReadoutStats());
+
+    initMemoryAccountant(mPCT->getChipMap(), mPCT->getReadoutUnits());
+    mTriggerReadoutUnit = mPCT->getReadoutUnits().front();
+    mPCT->initStatsStreaming(mOutputPath);
   }
 
   SC_METHOD(triggerMethod);
@@ -178,43 +204,51 @@ void StimuliPCT::stimuliMethod(void)
                                        chip_map,
                                        &PCT::PCT_global_chip_id_to_position);
     } else {
+      mPCT->finishStatsStreaming();
       mPCT->writeSimulationStats(mOutputPath);
     }
 
     mEventGen->writeSimulationStats(mOutputPath);
+    writeStopCriteriaStats();
   }
   else {
-    uint64_t time_now = sc_time_stamp().value();
-    std::cout << "@ " << time_now << " ns: \tEvent frame number ";
-    std::cout << mEventGen->getUntriggeredEventCount() << std::endl;
+    // Only the per-event work is profiled, not the statistics written at the end
+    PROFILE_PROCESS(STIMULI);
+
+    LOG(STIMULI, INFO) << "@ " << sc_time_stamp().value() << " ns: \tEvent frame number "
+                       << mEventGen->getUntriggeredEventCount();
 
     // Only print beam coords when we are generating random hits and
     // control the beam coords ourselves
     if(mRandomHitGen) {
-      std::cout << "\tBeam coords (mm): (";
-      std::cout << mEventGen->getBeamCenterCoordX() << ",";
-      std::cout << mEventGen->getBeamCenterCoordY() << ")" << std::endl;
+      LOG(STIMULI, DEBUG) << "\tBeam coords (mm): ("
+                          << mEventGen->getBeamCenterCoordX() << ","
+                          << mEventGen->getBeamCenterCoordY() << ")";
     }
 
     // Get hits for this event, and "feed" them to the PCT detector
-    auto event_hits = mEventGen->getUntriggeredEvent();
+    const auto& event_hits = mEventGen->getUntriggeredEvent();
 
     if(mSingleChipSimulation) {
-      std::cout << "Feeding " << event_hits.size() << " pixels to Alpide chip." << std::endl;
+      LOG(STIMULI, DEBUG) << "Feeding " << event_hits.size() << " pixels to Alpide chip.";
 
-      for(auto it = event_hits.begin(); it != event_hits.end(); it++)
-        mAlpide->pixelInput(*it);
+      mAlpide->pixelInput(event_hits);
     }
     else {
-      std::cout << "Feeding " << event_hits.size() << " pixels to PCT detector." << std::endl;
+      LOG(STIMULI, DEBUG) << "Feeding " << event_hits.size() << " pixels to PCT detector.";
 
-      for(auto it = event_hits.begin(); it != event_hits.end(); it++)
-        mPCT->pixelInput(*it);
+      mPCT->pixelInput(event_hits);
 
-      std::cout << "Creating event for next trigger.." << std::endl;
+      LOG(STIMULI, DEBUG) << "Creating event for next trigger..";
     }
 
-    if(mEventGen->getBeamEndCoordsReached() == true || g_terminate_program == true) {
+    bool stop_criteria_met = checkStopCriteria(mEventGen->getUntriggeredEventCount());
+
+    if(stop_criteria_met)
+      std::cout << "Stopping simulation early: " << mStopReason << std::endl;
+
+    if(mEventGen->getBeamEndCoordsReached() == true || g_terminate_program == true ||
+       stop_criteria_met) {
       // When the beam has reached the specified end position, the simulation should end.
       // But we allow the simulation to run for another X us to allow readout of data
       // remaining in MEBs, FIFOs etc.
@@ -231,6 +265,8 @@ void StimuliPCT::stimuliMethod(void)
 ///@brief SystemC method for generating triggers
 void StimuliPCT::triggerMethod(void)
 {
+  PROFILE_PROCESS(STIMULI);
+
   if(mSingleChipSimulation)
     mReadoutUnit->E_trigger_in.notify(mTriggerDelayNs, SC_NS);
   else
@@ -240,6 +276,14 @@ void StimuliPCT::triggerMethod(void)
 }
 
 
+///@brief Stop the event generator's threads. Called from main() when the simulation
+///       has ended, before the log is stopped.
+void StimuliPCT::stopEventThreads(void)
+{
+  mEventGen->stopEventThreads();
+}
+
+
 ///@brief Add SystemC signals to log in VCD trace file.
 ///@param[in,out] wf VCD waveform file pointer
 void StimuliPCT::addTraces(sc_trace_file *wf) const
@@ -272,4 +316,7 @@ void StimuliPCT::writeStimuliInfo(void) const
   info_file << "Number of untriggered events requested: " << 0 << std::endl;
   info_file << "Number of untriggered events simulated: ";
   info_file << mEventGen->getUntriggeredEventCount() << std::endl;
+
+  if(mStopReason.empty() == false)
+    info_file << "Simulation stopped early: " << mStopReason << std::endl;
 }
@@ -0,0 +1,89 @@
+/**
+ * @file   AliasTable.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Alias table (Walker/Vose alias method) for drawing from a discrete
+ *         distribution in constant time, with two 32-bit random numbers per draw.
+ */
+
+#ifndef ALIAS_TABLE_HPP
+#define ALIAS_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+
+class AliasTable {
+  // Probability (scaled to 2^32) of keeping bin i instead of using its alias
+  std::vector<std::uint64_t> mThreshold;
+  std::vector<std::uint32_t> mAlias;
+
+public:
+  AliasTable() {}
+
+  ///@brief Create table for a discrete distribution
+  ///@param weights Relative weight of each value. Must have at least one positive weight.
+  explicit AliasTable(const std::vector<double>& weights) {
+    const std::size_t n = weights.size();
+    double sum = 0;
+
+    for(std::size_t i = 0; i < n; i++) {
+      if(weights[i] < 0)
+        throw std::runtime_error("AliasTable: negative weight");
+      sum += weights[i];
+    }
+
+    if(n == 0 || n > 0xFFFFFFFF || sum <= 0)
+      throw std::runtime_error("AliasTable: no values with positive weight");
+
+    std::vector<double> prob(n);
+    std::vector<std::uint32_t> small, large;
+
+    for(std::size_t i = 0; i < n; i++) {
+      prob[i] = weights[i] * n / sum;
+      if(prob[i] < 1.0)
+        small.push_back(i);
+      else
+        large.push_back(i);
+    }
+
+    mThreshold.assign(n, std::uint64_t(1) << 32);
+    mAlias.resize(n);
+    for(std::size_t i = 0; i < n; i++)
+      mAlias[i] = i;
+
+    while(!small.empty() && !large.empty()) {
+      std::uint32_t s = small.back();
+      std::uint32_t l = large.back();
+      small.pop_back();
+
+      mThreshold[s] = std::uint64_t(prob[s] * 4294967296.0);
+      mAlias[s] = l;
+
+      prob[l] -= 1.0 - prob[s];
+      if(prob[l] < 1.0) {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+
+    // Bins left in either list have probability 1 (apart from rounding errors),
+    // and keep the default threshold of 2^32.
+  }
+
+  std::size_t size(void) const {return mAlias.size();}
+
+  ///@brief Draw a value
+  ///@param rng Random number generator returning uniformly distributed 32-bit numbers
+  ///@return Index of value, in the range [0, size())
+  template<class Rng>
+  std::uint32_t operator()(Rng& rng) const {
+    std::uint32_t bin = (std::uint64_t(std::uint32_t(rng())) * mAlias.size()) >> 32;
+    return std::uint32_t(rng()) < mThreshold[bin] ? bin : mAlias[bin];
+  }
+};
+
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @file   ClockedFifo.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Bounded FIFO as a plain ring buffer, with the same timing as tlm::tlm_fifo
+ *         for a FIFO that is written and read by one clocked process.
+ *
+ *         Values put in a clock cycle can not be read until the next cycle, and
+ *         space freed by get() can not be used by put() until the next cycle. The
+ *         owner calls update() at the end of each cycle where the FIFO was used,
+ *         which does what the update phase does for a tlm_fifo.
+ *
+ *         The storage grows on demand (in powers of two) up to the capacity, so
+ *         FIFOs that never hold more than a few values stay small.
+ */
+
+#ifndef CLOCKED_FIFO_HPP
+#define CLOCKED_FIFO_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+template<class T>
+class ClockedFifo {
+  std::vector<T> mBuffer;
+
+  // Maximum number of values in the FIFO
+  std::size_t mCapacity;
+
+  // Position of oldest value in mBuffer
+  std::size_t mHead = 0;
+
+  // Number of values in mBuffer, including values put and excluding values taken this cycle
+  std::size_t mCount = 0;
+
+  // Number of values that could be read at the start of this cycle
+  std::size_t mNumReadable = 0;
+
+  std::size_t mNumRead = 0;
+  std::size_t mNumWritten = 0;
+
+  void grow(void) {
+    std::size_t new_size = mBuffer.empty() ? 4 : 2*mBuffer.size();
+
+    if(new_size > mCapacity)
+      new_size = mCapacity;
+
+    std::vector<T> new_buffer(new_size);
+
+    for(std::size_t i = 0; i < mCount; i++)
+      new_buffer[i] = std::move(mBuffer[(mHead+i) % mBuffer.size()]);
+
+    mBuffer.swap(new_buffer);
+    mHead = 0;
+  }
+
+public:
+  explicit ClockedFifo(std::size_t capacity)
+    : mCapacity(capacity)
+    {
+    }
+
+  ///@return True if a value can be put this cycle
+  bool canPut(void) const {
+    return mNumReadable + mNumWritten < mCapacity;
+  }
+
+  ///@brief Put a value in the FIFO. It can be read after the next call to update().
+  ///@return False if the FIFO was full
+  bool put(const T& value) {
+    if(!canPut())
+      return false;
+
+    if(mCount == mBuffer.size())
+      grow();
+
+    mBuffer[(mHead+mCount) % mBuffer.size()] = value;
+    mCount++;
+    mNumWritten++;
+    return true;
+  }
+
+  ///@brief Take the oldest value that was in the FIFO at the start of this cycle
+  ///@return False if there was no value to take
+  bool get(T& value) {
+    if(used() == 0)
+      return false;
+
+    value = std::move(mBuffer[mHead]);
+    mHead = (mHead+1) % mBuffer.size();
+    mCount--;
+    mNumRead++;
+    return true;
+  }
+
+  ///@brief Copy the value that the next call to get() would return
+  ///@return False if there is no value to get
+  bool peek(T& value) const {
+    if(used() == 0)
+      return false;
+
+    value = mBuffer[mHead];
+    return true;
+  }
+
+  ///@return Number of values that can be taken with get() this cycle
+  std::size_t used(void) const {
+    return mNumReadable - mNumRead;
+  }
+
+  ///@brief End the cycle: make the values put readable, and the space freed usable
+  void update(void) {
+    mNumReadable = mCount;
+    mNumRead = 0;
+    mNumWritten = 0;
+  }
+
+  std::size_t capacity(void) const {return mCapacity;}
+
+  ///@return Number of values the storage has room for without growing
+  std::size_t allocated(void) const {return mBuffer.size();}
+};
+
+
+#endif
@@ -0,0 +1,197 @@
+/**
+ * @file   ColumnarFormat.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Definitions and encoding functions shared by the columnar output writer
+ *         and reader (see ColumnarWriter.hpp and ColumnarReader.hpp).
+ *
+ *         File format (all fixed size integers are little endian):
+ *
+ *         File header:
+ *           8 bytes: magic "ALPCOL01"
+ *
+ *         Followed by any number of blocks:
+ *           uint8_t:  block type (BLOCK_TABLE or BLOCK_CHUNK)
+ *           uint32_t: table id
+ *           uint64_t: payload size in bytes
+ *           payload
+ *
+ *         Table block payload (defines a table, written before its chunks):
+ *           varint: length of table name, followed by the name
+ *           varint: number of columns
+ *           For each column:
+ *             uint8_t: column type (COLUMN_UINT64, COLUMN_INT64 or COLUMN_DOUBLE)
+ *             varint:  length of column name, followed by the name
+ *
+ *         Chunk block payload (a number of rows for all columns of a table):
+ *           varint: number of rows
+ *           For each column:
+ *             uint8_t: encoding (ENCODING_RAW or ENCODING_DELTA_VARINT)
+ *             varint:  size of encoded column data in bytes
+ *             encoded column data
+ *
+ *         ENCODING_RAW stores the values as 8 byte little endian values (used for
+ *         doubles). ENCODING_DELTA_VARINT (used for integers) stores the difference
+ *         to the previous value in the chunk (the first value is stored as is),
+ *         zigzag encoded and written as an LEB128 varint. Counters, time stamps and
+ *         ids that increase slowly or stay constant take one byte per value.
+ */
+
+#ifndef COLUMNAR_FORMAT_HPP
+#define COLUMNAR_FORMAT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace Columnar {
+
+  const char FILE_MAGIC[8] = {'A', 'L', 'P', 'C', 'O', 'L', '0', '1'};
+
+  enum BlockType : uint8_t {
+    BLOCK_TABLE = 1,
+    BLOCK_CHUNK = 2
+  };
+
+  enum ColumnType : uint8_t {
+    COLUMN_UINT64 = 0,
+    COLUMN_INT64 = 1,
+    COLUMN_DOUBLE = 2
+  };
+
+  enum Encoding : uint8_t {
+    ENCODING_RAW = 0,
+    ENCODING_DELTA_VARINT = 1
+  };
+
+  struct ColumnDef {
+    std::string name;
+    ColumnType type;
+  };
+
+  inline void putVarint(std::vector<uint8_t>& out, uint64_t value)
+  {
+    while(value >= 0x80) {
+      out.push_back(uint8_t(value) | 0x80);
+      value >>= 7;
+    }
+    out.push_back(uint8_t(value));
+  }
+
+  ///@brief Read a varint from a buffer
+  ///@param[in,out] pos Position in buffer, advanced past the varint
+  ///@param[in] end End of buffer
+  inline uint64_t getVarint(const uint8_t*& pos, const uint8_t* end)
+  {
+    uint64_t value = 0;
+
+    for(unsigned int shift = 0; shift < 64; shift += 7) {
+      if(pos == end)
+        throw std::runtime_error("Columnar: truncated varint");
+
+      uint8_t byte = *pos++;
+      value |= uint64_t(byte & 0x7F) << shift;
+
+      if((byte & 0x80) == 0)
+        return value;
+    }
+
+    throw std::runtime_error("Columnar: invalid varint");
+  }
+
+  template<class T>
+  inline void putFixed(std::vector<uint8_t>& out, T value)
+  {
+    for(unsigned int i = 0; i < sizeof(T); i++)
+      out.push_back(uint8_t(uint64_t(value) >> (8*i)));
+  }
+
+  template<class T>
+  inline T getFixed(const uint8_t*& pos, const uint8_t* end)
+  {
+    if(end - pos < (std::ptrdiff_t) sizeof(T))
+      throw std::runtime_error("Columnar: truncated block");
+
+    uint64_t value = 0;
+    for(unsigned int i = 0; i < sizeof(T); i++)
+      value |= uint64_t(pos[i]) << (8*i);
+
+    pos += sizeof(T);
+    return T(value);
+  }
+
+  inline void putString(std::vector<uint8_t>& out, const std::string& str)
+  {
+    putVarint(out, str.size());
+    out.insert(out.end(), str.begin(), str.end());
+  }
+
+  inline std::string getString(const uint8_t*& pos, const uint8_t* end)
+  {
+    uint64_t length = getVarint(pos, end);
+
+    if(uint64_t(end - pos) < length)
+      throw std::runtime_error("Columnar: truncated string");
+
+    std::string str((const char*) pos, length);
+    pos += length;
+    return str;
+  }
+
+  inline uint64_t zigzagEncode(uint64_t delta)
+  {
+    return (delta << 1) ^ uint64_t(int64_t(delta) >> 63);
+  }
+
+  inline uint64_t zigzagDecode(uint64_t value)
+  {
+    return (value >> 1) ^ (~(value & 1) + 1);
+  }
+
+  ///@brief Delta and varint encode integer values (int64 values are passed as their
+  ///       two's complement uint64 representation)
+  inline void encodeDeltaVarint(std::vector<uint8_t>& out, const std::vector<uint64_t>& values)
+  {
+    uint64_t previous = 0;
+
+    for(auto it = values.begin(); it != values.end(); it++) {
+      putVarint(out, zigzagEncode(*it - previous));
+      previous = *it;
+    }
+  }
+
+  inline void decodeDeltaVarint(const uint8_t* pos, const uint8_t* end,
+                                uint64_t num_values, std::vector<uint64_t>& values)
+  {
+    uint64_t previous = 0;
+
+    for(uint64_t i = 0; i < num_values; i++) {
+      previous += zigzagDecode(getVarint(pos, end));
+      values.push_back(previous);
+    }
+
+    if(pos != end)
+      throw std::runtime_error("Columnar: unexpected data after column values");
+  }
+
+  inline uint64_t doubleToBits(double value)
+  {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  inline double bitsToDouble(uint64_t bits)
+  {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+}
+
+
+#endif
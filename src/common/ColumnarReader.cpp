@@ -0,0 +1,201 @@
+/**
+ * @file   ColumnarReader.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Reader for the compact columnar binary output format (see ColumnarFormat.hpp).
+ */
+
+#include "ColumnarReader.hpp"
+#include <fstream>
+#include <iterator>
+
+
+///@brief Open a columnar file, and read the table definitions and chunk index
+///@param[in] filename File name
+ColumnarReader::ColumnarReader(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios_base::in | std::ios_base::binary);
+
+  if(!file.is_open())
+    throw std::runtime_error("ColumnarReader: could not open " + filename);
+
+  mData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+  if(mData.size() < sizeof(Columnar::FILE_MAGIC) ||
+     std::memcmp(mData.data(), Columnar::FILE_MAGIC, sizeof(Columnar::FILE_MAGIC)) != 0)
+    throw std::runtime_error("ColumnarReader: " + filename + " is not a columnar file");
+
+  const uint8_t* begin = mData.data();
+  const uint8_t* end = begin + mData.size();
+  const uint8_t* pos = begin + sizeof(Columnar::FILE_MAGIC);
+
+  while(pos != end) {
+    uint8_t type = Columnar::getFixed<uint8_t>(pos, end);
+    uint32_t table_id = Columnar::getFixed<uint32_t>(pos, end);
+    uint64_t payload_size = Columnar::getFixed<uint64_t>(pos, end);
+
+    if(uint64_t(end - pos) < payload_size)
+      throw std::runtime_error("ColumnarReader: truncated block in " + filename);
+
+    const uint8_t* payload_end = pos + payload_size;
+
+    if(type == Columnar::BLOCK_TABLE) {
+      if(table_id != mTables.size())
+        throw std::runtime_error("ColumnarReader: unexpected table id in " + filename);
+
+      TableInfo table;
+      table.name = Columnar::getString(pos, payload_end);
+
+      uint64_t num_columns = Columnar::getVarint(pos, payload_end);
+      for(uint64_t i = 0; i < num_columns; i++) {
+        Columnar::ColumnDef column;
+        column.type = Columnar::ColumnType(Columnar::getFixed<uint8_t>(pos, payload_end));
+        column.name = Columnar::getString(pos, payload_end);
+        table.columns.push_back(column);
+      }
+
+      mTableIndex[table.name] = mTables.size();
+      mTables.push_back(table);
+    } else if(type == Columnar::BLOCK_CHUNK) {
+      if(table_id >= mTables.size())
+        throw std::runtime_error("ColumnarReader: chunk for unknown table in " + filename);
+
+      TableInfo& table = mTables[table_id];
+      ChunkInfo chunk;
+      chunk.num_rows = Columnar::getVarint(pos, payload_end);
+
+      for(unsigned int i = 0; i < table.columns.size(); i++) {
+        chunk.encodings.push_back(Columnar::Encoding(Columnar::getFixed<uint8_t>(pos, payload_end)));
+        uint64_t size = Columnar::getVarint(pos, payload_end);
+
+        if(uint64_t(payload_end - pos) < size)
+          throw std::runtime_error("ColumnarReader: truncated column in " + filename);
+
+        chunk.columns.push_back(std::make_pair(uint64_t(pos - begin), size));
+        pos += size;
+      }
+
+      table.num_rows += chunk.num_rows;
+      table.chunks.push_back(chunk);
+    }
+    // Unknown block types are skipped, for forward compatibility
+
+    pos = payload_end;
+  }
+}
+
+
+std::vector<std::string> ColumnarReader::getTableNames(void) const
+{
+  std::vector<std::string> names;
+
+  for(auto it = mTables.begin(); it != mTables.end(); it++)
+    names.push_back(it->name);
+
+  return names;
+}
+
+
+const ColumnarReader::TableInfo& ColumnarReader::getTable(const std::string& table) const
+{
+  auto it = mTableIndex.find(table);
+
+  if(it == mTableIndex.end())
+    throw std::runtime_error("ColumnarReader: no table named " + table);
+
+  return mTables[it->second];
+}
+
+
+unsigned int ColumnarReader::getColumnIndex(const TableInfo& table, const std::string& column) const
+{
+  for(unsigned int i = 0; i < table.columns.size(); i++) {
+    if(table.columns[i].name == column)
+      return i;
+  }
+
+  throw std::runtime_error("ColumnarReader: no column named " + column + " in table " + table.name);
+}
+
+
+uint64_t ColumnarReader::getNumRows(const std::string& table) const
+{
+  return getTable(table).num_rows;
+}
+
+
+std::vector<Columnar::ColumnDef> ColumnarReader::getColumns(const std::string& table) const
+{
+  return getTable(table).columns;
+}
+
+
+///@brief Decode all chunks of a column
+///@return Values, as uint64_t or the bit pattern of int64_t/double values
+std::vector<uint64_t> ColumnarReader::getColumnValues(const std::string& table,
+                                                      const std::string& column,
+                                                      Columnar::ColumnType type) const
+{
+  const TableInfo& table_info = getTable(table);
+  unsigned int column_index = getColumnIndex(table_info, column);
+
+  if(table_info.columns[column_index].type != type)
+    throw std::runtime_error("ColumnarReader: wrong type requested for column " + column);
+
+  std::vector<uint64_t> values;
+  values.reserve(table_info.num_rows);
+
+  for(auto it = table_info.chunks.begin(); it != table_info.chunks.end(); it++) {
+    const uint8_t* pos = mData.data() + it->columns[column_index].first;
+    const uint8_t* end = pos + it->columns[column_index].second;
+
+    switch(it->encodings[column_index]) {
+    case Columnar::ENCODING_RAW:
+      if(uint64_t(end - pos) != 8*it->num_rows)
+        throw std::runtime_error("ColumnarReader: wrong size of raw column " + column);
+
+      for(uint64_t i = 0; i < it->num_rows; i++)
+        values.push_back(Columnar::getFixed<uint64_t>(pos, end));
+      break;
+
+    case Columnar::ENCODING_DELTA_VARINT:
+      Columnar::decodeDeltaVarint(pos, end, it->num_rows, values);
+      break;
+
+    default:
+      throw std::runtime_error("ColumnarReader: unknown encoding for column " + column);
+    }
+  }
+
+  return values;
+}
+
+
+std::vector<uint64_t> ColumnarReader::getUInt64Column(const std::string& table,
+                                                      const std::string& column) const
+{
+  return getColumnValues(table, column, Columnar::COLUMN_UINT64);
+}
+
+
+std::vector<int64_t> ColumnarReader::getInt64Column(const std::string& table,
+                                                    const std::string& column) const
+{
+  std::vector<uint64_t> bits = getColumnValues(table, column, Columnar::COLUMN_INT64);
+
+  return std::vector<int64_t>(bits.begin(), bits.end());
+}
+
+
+std::vector<double> ColumnarReader::getDoubleColumn(const std::string& table,
+                                                    const std::string& column) const
+{
+  std::vector<uint64_t> bits = getColumnValues(table, column, Columnar::COLUMN_DOUBLE);
+  std::vector<double> values;
+  values.reserve(bits.size());
+
+  for(auto it = bits.begin(); it != bits.end(); it++)
+    values.push_back(Columnar::bitsToDouble(*it));
+
+  return values;
+}
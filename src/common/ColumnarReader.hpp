@@ -0,0 +1,66 @@
+/**
+ * @file   ColumnarReader.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Reader for the compact columnar binary output format (see ColumnarFormat.hpp).
+ *
+ *         The file is read into memory and indexed when opened, the columns are
+ *         decoded when they are requested.
+ *
+ *         Usage:
+ *           ColumnarReader reader("run_stats.acol");
+ *           std::vector<uint64_t> time_ns = reader.getUInt64Column("RU_0_0/data_rate", "time_ns");
+ */
+
+#ifndef COLUMNAR_READER_HPP
+#define COLUMNAR_READER_HPP
+
+#include "ColumnarFormat.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+
+class ColumnarReader {
+private:
+  struct ChunkInfo {
+    uint64_t num_rows;
+
+    ///@brief Offset and size of the encoded data for each column in mData
+    std::vector<std::pair<uint64_t, uint64_t>> columns;
+
+    std::vector<Columnar::Encoding> encodings;
+  };
+
+  struct TableInfo {
+    std::string name;
+    std::vector<Columnar::ColumnDef> columns;
+    std::vector<ChunkInfo> chunks;
+    uint64_t num_rows = 0;
+  };
+
+  std::vector<uint8_t> mData;
+  std::vector<TableInfo> mTables;
+  std::map<std::string, unsigned int> mTableIndex;
+
+  const TableInfo& getTable(const std::string& table) const;
+  unsigned int getColumnIndex(const TableInfo& table, const std::string& column) const;
+  std::vector<uint64_t> getColumnValues(const std::string& table,
+                                        const std::string& column,
+                                        Columnar::ColumnType type) const;
+
+public:
+  explicit ColumnarReader(const std::string& filename);
+
+  std::vector<std::string> getTableNames(void) const;
+  bool hasTable(const std::string& table) const {return mTableIndex.count(table) > 0;}
+  uint64_t getNumRows(const std::string& table) const;
+  std::vector<Columnar::ColumnDef> getColumns(const std::string& table) const;
+
+  std::vector<uint64_t> getUInt64Column(const std::string& table, const std::string& column) const;
+  std::vector<int64_t> getInt64Column(const std::string& table, const std::string& column) const;
+  std::vector<double> getDoubleColumn(const std::string& table, const std::string& column) const;
+};
+
+
+#endif
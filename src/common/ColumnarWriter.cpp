@@ -0,0 +1,196 @@
+/**
+ * @file   ColumnarWriter.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Writer for the compact columnar binary output format (see ColumnarFormat.hpp).
+ */
+
+#include "ColumnarWriter.hpp"
+#include "StatsWriter.hpp"
+
+
+std::shared_ptr<ColumnarWriter> ColumnarWriter::mRunWriter;
+
+
+ColumnarTable::ColumnarTable(ColumnarWriter& writer,
+                             uint32_t table_id,
+                             const std::string& name,
+                             const std::vector<Columnar::ColumnDef>& columns,
+                             uint64_t chunk_rows)
+  : mWriter(writer)
+  , mTableId(table_id)
+  , mName(name)
+  , mColumns(columns)
+  , mValues(columns.size())
+  , mChunkRows(chunk_rows)
+{
+  auto payload = std::make_shared<std::vector<uint8_t>>();
+
+  Columnar::putString(*payload, mName);
+  Columnar::putVarint(*payload, mColumns.size());
+
+  for(auto it = mColumns.begin(); it != mColumns.end(); it++) {
+    payload->push_back(it->type);
+    Columnar::putString(*payload, it->name);
+  }
+
+  mWriter.writeBlock(Columnar::BLOCK_TABLE, mTableId, payload);
+}
+
+
+void ColumnarTable::checkColumn(unsigned int column, Columnar::ColumnType type) const
+{
+  if(column >= mColumns.size())
+    throw std::runtime_error("ColumnarTable " + mName + ": column index out of range");
+
+  if(mColumns[column].type != type)
+    throw std::runtime_error("ColumnarTable " + mName + ": wrong type for column " +
+                             mColumns[column].name);
+}
+
+
+///@brief End the current row. All columns must have had a value appended for the row.
+///       Writes a chunk when the table has collected the number of rows per chunk.
+void ColumnarTable::endRow(void)
+{
+  for(auto it = mValues.begin(); it != mValues.end(); it++) {
+    if(it->size() != mNumRows+1)
+      throw std::runtime_error("ColumnarTable " + mName + ": row is missing values");
+  }
+
+  mNumRows++;
+
+  if(mNumRows == mChunkRows)
+    flush();
+}
+
+
+///@brief Encode the rows collected so far as a chunk and write it to file
+void ColumnarTable::flush(void)
+{
+  if(mNumRows == 0) {
+    for(auto it = mValues.begin(); it != mValues.end(); it++)
+      it->clear();
+    return;
+  }
+
+  auto payload = std::make_shared<std::vector<uint8_t>>();
+  std::vector<uint8_t> column_data;
+
+  Columnar::putVarint(*payload, mNumRows);
+
+  for(unsigned int i = 0; i < mColumns.size(); i++) {
+    column_data.clear();
+
+    // Drop values of an incomplete row
+    mValues[i].resize(mNumRows);
+
+    if(mColumns[i].type == Columnar::COLUMN_DOUBLE) {
+      payload->push_back(Columnar::ENCODING_RAW);
+      for(auto it = mValues[i].begin(); it != mValues[i].end(); it++)
+        Columnar::putFixed<uint64_t>(column_data, *it);
+    } else {
+      payload->push_back(Columnar::ENCODING_DELTA_VARINT);
+      Columnar::encodeDeltaVarint(column_data, mValues[i]);
+    }
+
+    Columnar::putVarint(*payload, column_data.size());
+    payload->insert(payload->end(), column_data.begin(), column_data.end());
+
+    // Free the memory used by the values
+    std::vector<uint64_t>().swap(mValues[i]);
+  }
+
+  mNumRows = 0;
+
+  mWriter.writeBlock(Columnar::BLOCK_CHUNK, mTableId, payload);
+}
+
+
+///@brief Constructor for ColumnarWriter. Creates the file and writes the file header.
+///@param[in] filename Output file name
+///@param[in] chunk_rows Number of rows per chunk
+ColumnarWriter::ColumnarWriter(const std::string& filename, uint64_t chunk_rows)
+  : mFilename(filename)
+  , mChunkRows(chunk_rows)
+{
+  if(mChunkRows == 0)
+    throw std::runtime_error("ColumnarWriter: number of rows per chunk can not be zero");
+
+  mFile = std::make_shared<std::ofstream>(mFilename, std::ios_base::out | std::ios_base::binary);
+
+  if(!mFile->is_open())
+    throw std::runtime_error("ColumnarWriter: could not open " + mFilename + " for writing");
+
+  mFile->write(Columnar::FILE_MAGIC, sizeof(Columnar::FILE_MAGIC));
+}
+
+
+ColumnarWriter::~ColumnarWriter()
+{
+  try {
+    close();
+  } catch(const std::exception&) {
+    // Write errors are reported by StatsWriter::stop() or by calling close() explicitly
+  }
+}
+
+
+///@brief Add a table to the file
+///@param[in] name Name of the table. Use e.g. "RU_0_1/data_rate" to group tables.
+///@param[in] columns Name and type of the columns
+///@return Reference to the table, valid for the lifetime of the ColumnarWriter
+ColumnarTable& ColumnarWriter::addTable(const std::string& name,
+                                        const std::vector<Columnar::ColumnDef>& columns)
+{
+  if(mClosed)
+    throw std::runtime_error("ColumnarWriter: can not add table to closed file");
+
+  mTables.emplace_back(new ColumnarTable(*this, mTables.size(), name, columns, mChunkRows));
+
+  return *mTables.back();
+}
+
+
+///@brief Write a block to the file, using the StatsWriter thread
+///@param[in] type Block type
+///@param[in] table_id Id of table the block belongs to
+///@param[in] payload Block payload
+void ColumnarWriter::writeBlock(Columnar::BlockType type, uint32_t table_id,
+                                std::shared_ptr<std::vector<uint8_t>> payload)
+{
+  std::shared_ptr<std::vector<uint8_t>> block = std::make_shared<std::vector<uint8_t>>();
+
+  block->push_back(type);
+  Columnar::putFixed<uint32_t>(*block, table_id);
+  Columnar::putFixed<uint64_t>(*block, payload->size());
+
+  std::shared_ptr<std::ofstream> file = mFile;
+
+  StatsWriter::post([file, block, payload]() {
+      file->write((const char*) block->data(), block->size());
+      file->write((const char*) payload->data(), payload->size());
+
+      if(!file->good())
+        throw std::runtime_error("ColumnarWriter: error writing to file");
+    });
+}
+
+
+///@brief Write the remaining rows of all tables, and close the file
+void ColumnarWriter::close(void)
+{
+  if(mClosed)
+    return;
+
+  mClosed = true;
+
+  for(auto it = mTables.begin(); it != mTables.end(); it++)
+    (*it)->flush();
+
+  std::shared_ptr<std::ofstream> file = mFile;
+
+  StatsWriter::post([file]() {
+      file->close();
+    });
+}
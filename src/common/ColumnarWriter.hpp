@@ -0,0 +1,108 @@
+/**
+ * @file   ColumnarWriter.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Writer for the compact columnar binary output format (see ColumnarFormat.hpp).
+ *
+ *         Rows are buffered per table, and written to file as an encoded chunk each
+ *         time a table has collected chunk_rows rows, so that the file is written
+ *         while the simulation runs. The chunks are written by the StatsWriter thread
+ *         when it is enabled.
+ *
+ *         Usage:
+ *           ColumnarTable& table = writer.addTable("my_table", {{"time_ns", Columnar::COLUMN_UINT64},
+ *                                                               {"rate", Columnar::COLUMN_DOUBLE}});
+ *           table.append(0, uint64_t(100));
+ *           table.append(1, 2.5);
+ *           table.endRow();
+ */
+
+#ifndef COLUMNAR_WRITER_HPP
+#define COLUMNAR_WRITER_HPP
+
+#include "ColumnarFormat.hpp"
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+class ColumnarWriter;
+
+
+class ColumnarTable {
+private:
+  ColumnarWriter& mWriter;
+  uint32_t mTableId;
+  std::string mName;
+  std::vector<Columnar::ColumnDef> mColumns;
+
+  ///@brief Values of the rows in the current chunk, one vector per column.
+  ///       Doubles are stored as their bit pattern.
+  std::vector<std::vector<uint64_t>> mValues;
+
+  uint64_t mNumRows = 0;
+  uint64_t mChunkRows;
+
+  void checkColumn(unsigned int column, Columnar::ColumnType type) const;
+
+public:
+  ColumnarTable(ColumnarWriter& writer,
+                uint32_t table_id,
+                const std::string& name,
+                const std::vector<Columnar::ColumnDef>& columns,
+                uint64_t chunk_rows);
+
+  void append(unsigned int column, uint64_t value) {
+    checkColumn(column, Columnar::COLUMN_UINT64);
+    mValues[column].push_back(value);
+  }
+
+  void append(unsigned int column, int64_t value) {
+    checkColumn(column, Columnar::COLUMN_INT64);
+    mValues[column].push_back(uint64_t(value));
+  }
+
+  void append(unsigned int column, double value) {
+    checkColumn(column, Columnar::COLUMN_DOUBLE);
+    mValues[column].push_back(Columnar::doubleToBits(value));
+  }
+
+  void endRow(void);
+  void flush(void);
+
+  const std::string& getName(void) const {return mName;}
+  uint64_t getNumRows(void) const {return mNumRows;}
+};
+
+
+class ColumnarWriter {
+private:
+  std::string mFilename;
+  std::shared_ptr<std::ofstream> mFile;
+  std::vector<std::unique_ptr<ColumnarTable>> mTables;
+  uint64_t mChunkRows;
+  bool mClosed = false;
+
+  static std::shared_ptr<ColumnarWriter> mRunWriter;
+
+public:
+  ColumnarWriter(const std::string& filename, uint64_t chunk_rows = 65536);
+  ~ColumnarWriter();
+
+  ColumnarTable& addTable(const std::string& name, const std::vector<Columnar::ColumnDef>& columns);
+  void writeBlock(Columnar::BlockType type, uint32_t table_id,
+                  std::shared_ptr<std::vector<uint8_t>> payload);
+  void close(void);
+
+  const std::string& getFilename(void) const {return mFilename;}
+
+  ///@brief Set the writer for the simulation run's statistics. Null disables the columnar output.
+  static void setRunWriter(std::shared_ptr<ColumnarWriter> writer) {mRunWriter = writer;}
+
+  ///@brief Get the writer for the simulation run's statistics, null if not enabled
+  static ColumnarWriter* getRunWriter(void) {return mRunWriter.get();}
+};
+
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @file   FastRandom.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Small and fast pseudo random number generator (xoshiro256**), with functions
+ *         for drawing whole arrays of uniformly distributed integers at a time.
+ *
+ *         Integers in a range are drawn with the multiply-shift method, which maps a
+ *         32-bit random number r to (r * range) >> 32 without division or rejection.
+ *         The bias is at most range/2^32, which is negligible for the ranges used for
+ *         pixel and chip coordinates (< 2^11).
+ */
+
+#ifndef FAST_RANDOM_HPP
+#define FAST_RANDOM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+
+class FastRandom {
+  std::uint64_t mState[4];
+
+  static std::uint64_t rotl(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+public:
+  explicit FastRandom(std::uint64_t seed = 0) {
+    this->seed(seed);
+  }
+
+  ///@brief Seed the generator. The state is initialized with splitmix64 from the seed,
+  ///       so that similar seeds give unrelated sequences, and the state is never zero.
+  void seed(std::uint64_t seed) {
+    for(unsigned int i = 0; i < 4; i++) {
+      seed += 0x9E3779B97F4A7C15ULL;
+      std::uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      mState[i] = z ^ (z >> 31);
+    }
+  }
+
+  ///@brief Get the next 64-bit random number
+  std::uint64_t operator()(void) {
+    const std::uint64_t result = rotl(mState[1] * 5, 7) * 9;
+    const std::uint64_t t = mState[1] << 17;
+
+    mState[2] ^= mState[0];
+    mState[3] ^= mState[1];
+    mState[1] ^= mState[2];
+    mState[0] ^= mState[3];
+    mState[2] ^= t;
+    mState[3] = rotl(mState[3], 45);
+
+    return result;
+  }
+
+  ///@brief Fill an array with uniformly distributed integers in the range [0, range).
+  ///       Each 64-bit random number gives two values.
+  ///@param out Array to fill
+  ///@param n Number of values
+  ///@param range Number of possible values (> 0)
+  void fillRange(std::uint32_t* out, std::size_t n, std::uint32_t range) {
+    std::size_t i = 0;
+
+    for(; i+1 < n; i += 2) {
+      std::uint64_t r = (*this)();
+      out[i] = (std::uint64_t(r & 0xFFFFFFFF) * range) >> 32;
+      out[i+1] = ((r >> 32) * range) >> 32;
+    }
+
+    if(i < n)
+      out[i] = (((*this)() >> 32) * range) >> 32;
+  }
+};
+
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file   Log.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Leveled logging for diagnostic output from the simulation.
+ */
+
+#include "Log.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+Log::Level Log::mMaxLevel[Log::NUM_CATEGORIES] = {
+  Log::LEVEL_INFO, Log::LEVEL_INFO, Log::LEVEL_INFO, Log::LEVEL_INFO, Log::LEVEL_INFO
+};
+
+std::unique_ptr<MpscQueue<std::string>> Log::mQueue;
+std::thread Log::mThread;
+std::atomic<bool> Log::mWriterEnabled(false);
+std::atomic<bool> Log::mStopRequested(false);
+
+// Maximum number of bytes the writer thread collects before writing to std::cout
+static const std::size_t WRITE_BLOCK_SIZE = 64*1024;
+
+
+const char* Log::getCategoryName(Category category)
+{
+  switch(category) {
+  case EVENT:
+    return "event";
+  case STIMULI:
+    return "stimuli";
+  case READOUT_UNIT:
+    return "readout_unit";
+  case ALPIDE:
+    return "alpide";
+  case DETECTOR:
+    return "detector";
+  default:
+    return "unknown";
+  }
+}
+
+
+///@brief Set the log levels from settings.
+///@param[in] level Name of the highest level to write: error, warning, info or debug
+///@param[in] categories "all", or a comma separated list of category names (e.g.
+///           "event,stimuli"). Other categories only write errors and warnings.
+///@throw std::runtime_error for unknown level or category names
+void Log::configure(const std::string& level, const std::string& categories)
+{
+  Level max_level;
+
+  if(level == "error")
+    max_level = LEVEL_ERROR;
+  else if(level == "warning")
+    max_level = LEVEL_WARNING;
+  else if(level == "info")
+    max_level = LEVEL_INFO;
+  else if(level == "debug")
+    max_level = LEVEL_DEBUG;
+  else
+    throw std::runtime_error("Unknown log level \"" + level + "\"");
+
+  Level other_level = max_level < LEVEL_WARNING ? max_level : LEVEL_WARNING;
+  std::vector<bool> selected(NUM_CATEGORIES, categories == "all");
+
+  std::stringstream ss(categories);
+  std::string name;
+
+  while(categories != "all" && std::getline(ss, name, ',')) {
+    int i = 0;
+    while(i < NUM_CATEGORIES && name != getCategoryName(Category(i)))
+      i++;
+
+    if(i == NUM_CATEGORIES)
+      throw std::runtime_error("Unknown log category \"" + name + "\"");
+
+    selected[i] = true;
+  }
+
+  for(int i = 0; i < NUM_CATEGORIES; i++)
+    mMaxLevel[i] = selected[i] ? max_level : other_level;
+}
+
+
+///@brief Start the writer thread. Info and debug lines are written by this thread
+///       until stop() is called, which is also done when the program exits.
+///@param[in] queue_size Number of lines that can be waiting in the queue
+void Log::start(std::size_t queue_size)
+{
+  if(mWriterEnabled)
+    throw std::runtime_error("Log: writer thread already started");
+
+  if(queue_size == 0)
+    throw std::runtime_error("Log: queue size can not be zero");
+
+  static bool stop_at_exit = false;
+
+  // Write the remaining lines if the simulation calls exit() on errors
+  if(!stop_at_exit) {
+    std::atexit(&Log::stop);
+    stop_at_exit = true;
+  }
+
+  mQueue.reset(new MpscQueue<std::string>(queue_size));
+  mStopRequested = false;
+  mWriterEnabled = true;
+  mThread = std::thread(&Log::writerThread);
+}
+
+
+///@brief Write the queued lines and stop the writer thread.
+///       Does nothing if the writer thread was not started.
+void Log::stop(void)
+{
+  if(!mWriterEnabled)
+    return;
+
+  // Lines written from now on go directly to std::cout
+  mWriterEnabled = false;
+  mStopRequested = true;
+  mThread.join();
+
+  // Lines pushed by other threads while the writer was stopping
+  std::string line;
+  while(mQueue->tryPop(line))
+    std::cout << line;
+
+  std::cout.flush();
+}
+
+
+///@brief Write a formatted line. Used by LogMessage.
+///@param[in] level Level of the line
+///@param[in] line Line to write, including newline
+void Log::write(Level level, std::string&& line)
+{
+  if(level <= LEVEL_WARNING)
+    std::cerr << line;
+  else if(mWriterEnabled)
+    mQueue->push(std::move(line));
+  else
+    std::cout << line;
+}
+
+
+void Log::writerThread(void)
+{
+  std::string line;
+  std::string block;
+
+  block.reserve(WRITE_BLOCK_SIZE + 1024);
+
+  while(true) {
+    // Check before emptying the queue, so that lines pushed before stop() are written
+    bool stop_requested = mStopRequested;
+
+    while(block.size() < WRITE_BLOCK_SIZE && mQueue->tryPop(line))
+      block += line;
+
+    if(!block.empty()) {
+      std::cout.write(block.data(), block.size());
+      std::cout.flush();
+      block.clear();
+    } else if(stop_requested) {
+      break;
+    } else {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+}
@@ -0,0 +1,108 @@
+/**
+ * @file   Log.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Leveled logging for diagnostic output from the simulation (event numbers,
+ *         triggers, busy words etc.), with a verbosity level per category.
+ *
+ *         Use the LOG macro to write a line, e.g.:
+ *           LOG(EVENT, INFO) << "MC Event number: " << event_index;
+ *
+ *         The line is only formatted if the level is enabled for the category, the
+ *         overhead for disabled messages is one check of the category's level.
+ *         Lines are not flushed one by one. Errors and warnings are written to
+ *         std::cerr right away. Info and debug lines are written to std::cout,
+ *         either directly or by a background writer thread which gets them through
+ *         a lock-free queue and writes them in blocks.
+ *
+ *         The levels must be configured before the simulation starts, they are read
+ *         without synchronization.
+ */
+
+#ifndef LOG_HPP
+#define LOG_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "MpscQueue.hpp"
+
+
+class Log {
+public:
+  enum Category {
+    EVENT = 0,
+    STIMULI,
+    READOUT_UNIT,
+    ALPIDE,
+    DETECTOR,
+    NUM_CATEGORIES
+  };
+
+  enum Level {
+    LEVEL_ERROR = 0,
+    LEVEL_WARNING,
+    LEVEL_INFO,
+    LEVEL_DEBUG
+  };
+
+private:
+  static Level mMaxLevel[NUM_CATEGORIES];
+
+  static std::unique_ptr<MpscQueue<std::string>> mQueue;
+  static std::thread mThread;
+  static std::atomic<bool> mWriterEnabled;
+  static std::atomic<bool> mStopRequested;
+
+  static void writerThread(void);
+
+public:
+  ///@brief Check if messages at a level are written for a category
+  static bool enabled(Category category, Level level) {
+    return level <= mMaxLevel[category];
+  }
+
+  static void setLevel(Category category, Level level) {mMaxLevel[category] = level;}
+  static void configure(const std::string& level, const std::string& categories);
+  static const char* getCategoryName(Category category);
+
+  static void start(std::size_t queue_size);
+  static void stop(void);
+  static void write(Level level, std::string&& line);
+};
+
+
+///@brief Formats one line of log output, and writes it when it goes out of scope.
+///       Used by the LOG macro.
+class LogMessage {
+  Log::Level mLevel;
+  std::ostringstream mStream;
+
+public:
+  explicit LogMessage(Log::Level level)
+    : mLevel(level)
+  {
+    if(level == Log::LEVEL_ERROR)
+      mStream << "Error: ";
+    else if(level == Log::LEVEL_WARNING)
+      mStream << "Warning: ";
+  }
+
+  ~LogMessage() {
+    mStream << '\n';
+    Log::write(mLevel, mStream.str());
+  }
+
+  std::ostream& stream(void) {return mStream;}
+};
+
+
+#define LOG(category, level) \
+  if(!Log::enabled(Log::category, Log::LEVEL_##level)) {} \
+  else LogMessage(Log::LEVEL_##level).stream()
+
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ * @file   MemoryUsage.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Approximate heap usage per element of the standard containers, for
+ *         the memory accounting (see MemoryAccountant.hpp). The numbers are for
+ *         libstdc++ on a 64-bit platform, and do not include allocator overhead.
+ */
+
+#ifndef MEMORY_USAGE_HPP
+#define MEMORY_USAGE_HPP
+
+#include <cstdint>
+
+
+///@brief Bytes per element in std::map/std::set (red-black tree node: color and 3 pointers)
+template<class T>
+constexpr uint64_t tree_node_bytes(void)
+{
+  return sizeof(T) + 4*sizeof(void*);
+}
+
+
+///@brief Bytes per element in std::list (two pointers)
+template<class T>
+constexpr uint64_t list_node_bytes(void)
+{
+  return sizeof(T) + 2*sizeof(void*);
+}
+
+
+///@brief Bytes per object allocated with std::make_shared (object and reference counts)
+template<class T>
+constexpr uint64_t shared_object_bytes(void)
+{
+  return sizeof(T) + 2*sizeof(void*);
+}
+
+
+#endif
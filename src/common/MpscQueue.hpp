@@ -0,0 +1,133 @@
+/**
+ * @file   MpscQueue.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Bounded lock-free queue for several producer threads and one consumer thread.
+ *
+ *         The queue is a ring buffer where each slot has a sequence number, which
+ *         tells whether the slot is free for the producer that claimed its position,
+ *         or holds a value for the consumer. Producers claim positions with a
+ *         compare-and-swap on the tail index, only the consumer writes the head index.
+ *         tryPush() and tryPop() never block, push() waits (yielding, then sleeping
+ *         briefly) until there is space in the queue.
+ */
+
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+
+template<class T>
+class MpscQueue {
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Slot[]> mSlots;
+
+  // Capacity is a power of two, positions are mapped to slots with a mask
+  std::size_t mMask;
+
+  // Padding keeps the producers' tail index and the consumer's head index on
+  // separate cache lines (see SpscQueue)
+  char mPadding1[64];
+
+  // Position of next free slot, claimed by the producers with compare-and-swap
+  std::atomic<std::size_t> mTail;
+
+  char mPadding2[64];
+
+  // Position of next value to pop, used by the consumer only
+  std::size_t mHead;
+
+  static void backOff(unsigned int& attempts) {
+    if(attempts++ < 64)
+      std::this_thread::yield();
+    else
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+
+public:
+  ///@brief Constructor
+  ///@param capacity Minimum number of values in the queue, rounded up to a power of two
+  explicit MpscQueue(std::size_t capacity)
+    : mTail(0)
+    , mHead(0)
+    {
+      std::size_t size = 1;
+      while(size < capacity)
+        size *= 2;
+
+      mSlots.reset(new Slot[size]);
+      mMask = size-1;
+
+      for(std::size_t i = 0; i < size; i++)
+        mSlots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  ///@brief Push a value if there is space in the queue. Safe to call from any thread.
+  ///       The value is only moved from if it was pushed.
+  ///@return True if the value was pushed, false if the queue was full
+  bool tryPush(T&& value) {
+    std::size_t pos = mTail.load(std::memory_order_relaxed);
+
+    while(true) {
+      Slot& slot = mSlots[pos & mMask];
+      std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      std::intptr_t diff = std::intptr_t(sequence) - std::intptr_t(pos);
+
+      if(diff == 0) {
+        // Slot is free, try to claim the position. On failure pos is updated.
+        if(mTail.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed)) {
+          slot.value = std::move(value);
+          slot.sequence.store(pos+1, std::memory_order_release);
+          return true;
+        }
+      } else if(diff < 0) {
+        // Slot still holds a value from the previous round, the queue is full
+        return false;
+      } else {
+        // Another producer claimed this position
+        pos = mTail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  ///@brief Pop a value if the queue is not empty. Consumer thread only.
+  ///@return True if a value was popped, false if the queue was empty
+  bool tryPop(T& value) {
+    Slot& slot = mSlots[mHead & mMask];
+    std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+    if(sequence != mHead+1)
+      return false;
+
+    value = std::move(slot.value);
+    slot.sequence.store(mHead + mMask + 1, std::memory_order_release);
+    mHead++;
+    return true;
+  }
+
+  ///@brief Push a value, waiting for space in the queue. Safe to call from any thread.
+  void push(T value) {
+    unsigned int attempts = 0;
+    while(!tryPush(std::move(value)))
+      backOff(attempts);
+  }
+
+  std::size_t capacity(void) const {return mMask+1;}
+};
+
+
+#endif
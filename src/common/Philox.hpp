@@ -0,0 +1,53 @@
+/**
+ * @file   Philox.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Philox4x32-10 counter-based pseudo random number generator, as described in
+ *         "Parallel Random Numbers: As Easy as 1, 2, 3" (Salmon et al., SC11).
+ *
+ *         The generator is a pure function of a 128-bit counter and a 64-bit key, so
+ *         any block of random numbers can be computed directly without drawing all the
+ *         numbers before it. Each (key, counter) pair gives four 32-bit random numbers.
+ */
+
+#ifndef PHILOX_HPP
+#define PHILOX_HPP
+
+#include <cstdint>
+
+
+class Philox4x32 {
+public:
+  struct Counter {
+    std::uint32_t v[4];
+  };
+
+  struct Key {
+    std::uint32_t v[2];
+  };
+
+  ///@brief Compute the four random numbers for a counter and key
+  static Counter generate(Counter ctr, Key key) {
+    for(unsigned int round = 0; round < 10; round++) {
+      if(round > 0) {
+        key.v[0] += 0x9E3779B9;
+        key.v[1] += 0xBB67AE85;
+      }
+
+      std::uint64_t prod0 = std::uint64_t(0xD2511F53) * ctr.v[0];
+      std::uint64_t prod1 = std::uint64_t(0xCD9E8D57) * ctr.v[2];
+
+      Counter next;
+      next.v[0] = std::uint32_t(prod1 >> 32) ^ ctr.v[1] ^ key.v[0];
+      next.v[1] = std::uint32_t(prod1);
+      next.v[2] = std::uint32_t(prod0 >> 32) ^ ctr.v[3] ^ key.v[1];
+      next.v[3] = std::uint32_t(prod0);
+      ctr = next;
+    }
+
+    return ctr;
+  }
+};
+
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file   ProcessProfiler.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Simple built-in profiler that counts activations and accumulates
+ *         wall time for the SystemC processes in the simulation.
+ */
+
+#include "ProcessProfiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+bool ProcessProfiler::mEnabled = false;
+uint64_t ProcessProfiler::mActivations[ProcessProfiler::NUM_CATEGORIES] = {0};
+std::chrono::steady_clock::duration ProcessProfiler::mWallTime[ProcessProfiler::NUM_CATEGORIES];
+
+
+const char* ProcessProfiler::getCategoryName(Category category)
+{
+  switch(category) {
+  case ALPIDE_STROBE_INPUT:
+    return "Alpide::mainMethod (strobeInput)";
+  case ALPIDE_FRAME_READOUT:
+    return "Alpide::mainMethod (frameReadout)";
+  case ALPIDE_DATA_TRANSMISSION:
+    return "Alpide::mainMethod (dataTransmission)";
+  case ALPIDE_BUSY_STATUS:
+    return "Alpide::mainMethod (updateBusyStatus)";
+  case ALPIDE_TRIGGER_AND_STROBE:
+    return "Alpide trigger/strobe/busy FIFO methods";
+  case REGION_READOUT_UNIT:
+    return "RegionReadoutUnit";
+  case TOP_READOUT_UNIT:
+    return "TopReadoutUnit";
+  case READOUT_UNIT:
+    return "ReadoutUnit";
+  case ALPIDE_DATA_PARSER:
+    return "AlpideDataParser";
+  case DETECTOR:
+    return "Detector";
+  case EVENT_GEN:
+    return "EventGen";
+  case STIMULI:
+    return "Stimuli";
+  default:
+    return "Unknown";
+  }
+}
+
+
+void ProcessProfiler::reset(void)
+{
+  for(unsigned int i = 0; i < NUM_CATEGORIES; i++) {
+    mActivations[i] = 0;
+    mWallTime[i] = std::chrono::steady_clock::duration::zero();
+  }
+}
+
+
+///@brief Write the profile to process_profile.csv, and a summary with the simulation
+///       speed to process_profile_summary.txt, in the output directory.
+///       The wall time that was not spent in any of the profiled processes
+///       (SystemC kernel, clock, signal updates etc.) is listed as "Other".
+///@param[in] output_path Path to simulation output directory
+///@param[in] sim_time_ns Simulation time at the end of the simulation
+///@param[in] total_wall_time_s Total wall time spent in the simulation (sc_start)
+void ProcessProfiler::writeToFile(const std::string& output_path,
+                                  uint64_t sim_time_ns,
+                                  double total_wall_time_s)
+{
+  std::string filename = output_path + "/process_profile.csv";
+  std::ofstream file(filename);
+
+  if(!file.is_open()) {
+    std::cerr << "Error opening process profile file: " << filename << std::endl;
+    return;
+  }
+
+  double profiled_wall_time_s = 0.0;
+
+  file << "category;activations;wall_time_s;wall_time_percent;avg_activation_ns" << std::endl;
+
+  for(unsigned int i = 0; i < NUM_CATEGORIES; i++) {
+    double wall_time_s = std::chrono::duration<double>(mWallTime[i]).count();
+    profiled_wall_time_s += wall_time_s;
+
+    file << getCategoryName(Category(i)) << ";";
+    file << mActivations[i] << ";";
+    file << wall_time_s << ";";
+    file << (total_wall_time_s > 0 ? 100.0*wall_time_s/total_wall_time_s : 0.0) << ";";
+    file << (mActivations[i] > 0 ? 1E9*wall_time_s/mActivations[i] : 0.0) << std::endl;
+  }
+
+  double other_wall_time_s = std::max(0.0, total_wall_time_s - profiled_wall_time_s);
+
+  file << "Other;;" << other_wall_time_s << ";";
+  file << (total_wall_time_s > 0 ? 100.0*other_wall_time_s/total_wall_time_s : 0.0) << ";" << std::endl;
+
+  double sim_rate = total_wall_time_s > 0 ? sim_time_ns/total_wall_time_s : 0.0;
+
+  std::ofstream summary_file(output_path + "/process_profile_summary.txt");
+
+  summary_file << "Simulated time [ns]: " << sim_time_ns << std::endl;
+  summary_file << "Wall time [s]: " << total_wall_time_s << std::endl;
+  summary_file << "Simulated ns per wall second: " << sim_rate << std::endl;
+  summary_file << "Wall time in profiled processes [s]: " << profiled_wall_time_s << std::endl;
+
+  std::cout << "Process profile written to " << filename << std::endl;
+  std::cout << "Simulated time: " << sim_time_ns << " ns in " << total_wall_time_s;
+  std::cout << " s wall time (" << sim_rate << " simulated ns per wall second)." << std::endl;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file   ProcessProfiler.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Simple built-in profiler that counts activations and accumulates
+ *         wall time for the SystemC processes in the simulation, grouped in
+ *         categories (Alpide, RRU, TRU, readout unit, parser, event generation etc.)
+ *
+ *         Profiling is disabled by default, in which case the overhead is one
+ *         check of a flag per process activation. Use the PROFILE_PROCESS macro
+ *         at the top of an SC_METHOD to include it in the profile, or at the top
+ *         of a branch in it to only profile that part of the method.
+ */
+
+#ifndef PROCESS_PROFILER_HPP
+#define PROCESS_PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+
+class ProcessProfiler {
+public:
+  enum Category {
+    ALPIDE_STROBE_INPUT = 0,
+    ALPIDE_FRAME_READOUT,
+    ALPIDE_DATA_TRANSMISSION,
+    ALPIDE_BUSY_STATUS,
+    ALPIDE_TRIGGER_AND_STROBE,
+    REGION_READOUT_UNIT,
+    TOP_READOUT_UNIT,
+    READOUT_UNIT,
+    ALPIDE_DATA_PARSER,
+    DETECTOR,
+    EVENT_GEN,
+    STIMULI,
+    NUM_CATEGORIES
+  };
+
+private:
+  static bool mEnabled;
+  static uint64_t mActivations[NUM_CATEGORIES];
+  static std::chrono::steady_clock::duration mWallTime[NUM_CATEGORIES];
+
+public:
+  static void setEnabled(bool enabled) {mEnabled = enabled;}
+  static bool getEnabled(void) {return mEnabled;}
+
+  static void addActivation(Category category, std::chrono::steady_clock::duration wall_time) {
+    mActivations[category]++;
+    mWallTime[category] += wall_time;
+  }
+
+  static const char* getCategoryName(Category category);
+  static void reset(void);
+  static void writeToFile(const std::string& output_path,
+                          uint64_t sim_time_ns,
+                          double total_wall_time_s);
+};
+
+
+///@brief Measures the wall time from construction to destruction, and adds it to a
+///       category in ProcessProfiler. Does nothing if profiling is disabled.
+class ProcessProfileScope {
+private:
+  ProcessProfiler::Category mCategory;
+  bool mEnabled;
+  std::chrono::steady_clock::time_point mStartTime;
+
+public:
+  ProcessProfileScope(ProcessProfiler::Category category)
+    : mCategory(category)
+    , mEnabled(ProcessProfiler::getEnabled())
+  {
+    if(mEnabled)
+      mStartTime = std::chrono::steady_clock::now();
+  }
+
+  ~ProcessProfileScope() {
+    if(mEnabled)
+      ProcessProfiler::addActivation(mCategory, std::chrono::steady_clock::now() - mStartTime);
+  }
+};
+
+
+#define PROFILE_PROCESS(category) \
+  ProcessProfileScope process_profile_scope(ProcessProfiler::category)
+
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file   RandomEngine.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Random number engine used by the event generators, which can be switched
+ *         between a sequential mt19937 stream and a counter-based Philox stream.
+ *
+ *         In counter-based mode the numbers drawn depend only on the seed, the
+ *         purpose of the engine, and the stream (event number and sub stream) that
+ *         was last selected with setStream(). An event can then be regenerated
+ *         without generating the events before it, which makes it possible to split
+ *         event generation between threads or processes with identical results.
+ *
+ *         In the default (sequential) mode the engine forwards to mt19937, and gives
+ *         exactly the same numbers as a plain boost::random::mt19937.
+ */
+
+#ifndef RANDOM_ENGINE_HPP
+#define RANDOM_ENGINE_HPP
+
+#include <cstdint>
+#include <boost/random/mersenne_twister.hpp>
+#include "Philox.hpp"
+
+
+///@brief Purpose of a random engine, used as part of the key in counter-based mode so
+///       that engines with the same seed and event number give independent numbers.
+enum RandomPurpose {
+  RAND_PURPOSE_CLUSTER_SIZE = 1,
+  RAND_PURPOSE_CLUSTER_X,
+  RAND_PURPOSE_CLUSTER_Y,
+  RAND_PURPOSE_HIT_MULTIPLICITY,
+  RAND_PURPOSE_HIT_COORDS,
+  RAND_PURPOSE_HIT_COORDS_X,
+  RAND_PURPOSE_HIT_COORDS_Y,
+  RAND_PURPOSE_HIT_TIME,
+  RAND_PURPOSE_EVENT_TIME,
+  RAND_PURPOSE_EVENT_ID,
+  RAND_PURPOSE_PARTICLE_COUNT
+};
+
+
+class RandomEngine {
+  boost::random::mt19937 mMersenneTwister;
+
+  bool mCounterBased = false;
+  Philox4x32::Key mKey;
+  Philox4x32::Counter mCounter;
+  Philox4x32::Counter mBlock;
+  unsigned int mBlockIndex = 4;
+
+public:
+  typedef std::uint32_t result_type;
+
+  ///@param purpose Purpose of this engine (used in counter-based mode)
+  explicit RandomEngine(RandomPurpose purpose) {
+    mKey.v[0] = 0;
+    mKey.v[1] = purpose;
+    setStream(0);
+  }
+
+  static constexpr result_type min BOOST_PREVENT_MACRO_SUBSTITUTION () {return 0;}
+  static constexpr result_type max BOOST_PREVENT_MACRO_SUBSTITUTION () {return 0xFFFFFFFF;}
+
+  ///@brief Seed the engine. Resets the counter-based stream to event 0.
+  void seed(result_type seed) {
+    mMersenneTwister.seed(seed);
+    mKey.v[0] = seed;
+    setStream(0);
+  }
+
+  ///@brief Enable or disable counter-based mode
+  void setCounterBased(bool counter_based) {mCounterBased = counter_based;}
+  bool getCounterBased(void) const {return mCounterBased;}
+
+  ///@brief Select the stream of random numbers for an event in counter-based mode.
+  ///       Calling this with the same arguments gives the same numbers again.
+  ///       Has no effect in sequential mode.
+  ///@param event Event number
+  ///@param sub_stream Sub stream within the event (e.g. layer, chip or hit number)
+  void setStream(std::uint64_t event, std::uint32_t sub_stream = 0) {
+    mCounter.v[0] = 0;
+    mCounter.v[1] = sub_stream;
+    mCounter.v[2] = std::uint32_t(event);
+    mCounter.v[3] = std::uint32_t(event >> 32);
+    mBlockIndex = 4;
+  }
+
+  result_type operator()(void) {
+    if(!mCounterBased)
+      return mMersenneTwister();
+
+    if(mBlockIndex == 4) {
+      mBlock = Philox4x32::generate(mCounter, mKey);
+      mCounter.v[0]++;
+      mBlockIndex = 0;
+    }
+
+    return mBlock.v[mBlockIndex++];
+  }
+};
+
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * @file   SpscQueue.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Bounded lock-free queue for one producer thread and one consumer thread.
+ *
+ *         The queue is a ring buffer where only the producer writes the tail index,
+ *         and only the consumer writes the head index. tryPush() and tryPop() never
+ *         block, push() and pop() wait (yielding, then sleeping briefly) until there
+ *         is space or a value available.
+ */
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+template<class T>
+class SpscQueue {
+  // One slot is left unused to tell a full queue from an empty one
+  std::vector<T> mSlots;
+
+  // Index of next value to pop, written by the consumer only
+  std::atomic<std::size_t> mHead;
+
+  // Keep the indices on separate cache lines, so the producer and consumer
+  // threads do not invalidate each other's line on every push/pop. Padding is
+  // used instead of alignas, since operator new does not honour extended
+  // alignment before C++17.
+  char mPadding[64];
+
+  // Index of next free slot, written by the producer only
+  std::atomic<std::size_t> mTail;
+
+  std::size_t next(std::size_t index) const {
+    return index+1 == mSlots.size() ? 0 : index+1;
+  }
+
+  ///@brief Back off while waiting for the other thread. Waits are expected to be
+  ///       short, but when the other thread is held up (e.g. by disk I/O) the
+  ///       waiting thread should not keep a core busy.
+  static void backOff(unsigned int& attempts) {
+    if(attempts++ < 64)
+      std::this_thread::yield();
+    else
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+
+public:
+  explicit SpscQueue(std::size_t capacity)
+    : mSlots(capacity+1)
+    , mHead(0)
+    , mTail(0)
+    {
+    }
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  ///@brief Push a value if there is space in the queue. Producer thread only.
+  ///@return True if the value was pushed, false if the queue was full
+  bool tryPush(T&& value) {
+    std::size_t tail = mTail.load(std::memory_order_relaxed);
+    std::size_t next_tail = next(tail);
+
+    if(next_tail == mHead.load(std::memory_order_acquire))
+      return false;
+
+    mSlots[tail] = std::move(value);
+    mTail.store(next_tail, std::memory_order_release);
+    return true;
+  }
+
+  ///@brief Pop a value if the queue is not empty. Consumer thread only.
+  ///@return True if a value was popped, false if the queue was empty
+  bool tryPop(T& value) {
+    std::size_t head = mHead.load(std::memory_order_relaxed);
+
+    if(head == mTail.load(std::memory_order_acquire))
+      return false;
+
+    value = std::move(mSlots[head]);
+    mHead.store(next(head), std::memory_order_release);
+    return true;
+  }
+
+  ///@brief Push a value, waiting for space in the queue. Producer thread only.
+  void push(T value) {
+    unsigned int attempts = 0;
+    while(!tryPush(std::move(value)))
+      backOff(attempts);
+  }
+
+  ///@brief Pop a value, waiting until a value is available. Consumer thread only.
+  T pop(void) {
+    T value;
+    unsigned int attempts = 0;
+    while(!tryPop(value))
+      backOff(attempts);
+    return value;
+  }
+
+  bool empty(void) const {
+    return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+  }
+
+  std::size_t capacity(void) const {return mSlots.size()-1;}
+};
+
+
+#endif
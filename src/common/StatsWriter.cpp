@@ -0,0 +1,143 @@
+/**
+ * @file   StatsWriter.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Background thread for writing simulation statistics to file while the
+ *         simulation is running.
+ */
+
+#include "StatsWriter.hpp"
+#include <exception>
+#include <stdexcept>
+
+
+std::thread StatsWriter::mThread;
+std::mutex StatsWriter::mMutex;
+std::condition_variable StatsWriter::mJobAvailable;
+std::condition_variable StatsWriter::mSpaceAvailable;
+std::condition_variable StatsWriter::mIdle;
+std::deque<std::function<void()>> StatsWriter::mJobs;
+std::size_t StatsWriter::mMaxQueuedJobs = 1;
+bool StatsWriter::mEnabled = false;
+bool StatsWriter::mStopRequested = false;
+bool StatsWriter::mJobRunning = false;
+std::string StatsWriter::mError;
+
+
+///@brief Start the writer thread
+///@param[in] max_queued_jobs Maximum number of jobs waiting in the queue
+void StatsWriter::start(std::size_t max_queued_jobs)
+{
+  if(mEnabled)
+    throw std::runtime_error("StatsWriter: writer thread already started");
+
+  if(max_queued_jobs == 0)
+    throw std::runtime_error("StatsWriter: queue size can not be zero");
+
+  mMaxQueuedJobs = max_queued_jobs;
+  mStopRequested = false;
+  mError.clear();
+  mEnabled = true;
+  mThread = std::thread(&StatsWriter::writerThread);
+}
+
+
+///@brief Finish all queued jobs and stop the writer thread. Throws std::runtime_error
+///       if any of the jobs failed. Does nothing if the writer thread was not started.
+void StatsWriter::stop(void)
+{
+  if(!mEnabled)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopRequested = true;
+  }
+  mJobAvailable.notify_one();
+  mThread.join();
+  mEnabled = false;
+
+  checkError();
+}
+
+
+///@brief Post a job to the writer thread. Blocks if the queue is full.
+///       If the writer thread is not started the job is executed immediately.
+///@param[in] job Function that writes statistics. Must own all the data it writes.
+void StatsWriter::post(std::function<void()> job)
+{
+  if(!mEnabled) {
+    job();
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mSpaceAvailable.wait(lock, []{return mJobs.size() < mMaxQueuedJobs;});
+    mJobs.push_back(std::move(job));
+  }
+  mJobAvailable.notify_one();
+}
+
+
+///@brief Wait until all jobs posted so far have been executed. Throws std::runtime_error
+///       if any of the jobs failed.
+void StatsWriter::waitIdle(void)
+{
+  if(!mEnabled)
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mIdle.wait(lock, []{return mJobs.empty() && !mJobRunning;});
+  }
+
+  checkError();
+}
+
+
+void StatsWriter::checkError(void)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  if(!mError.empty())
+    throw std::runtime_error("StatsWriter: " + mError);
+}
+
+
+void StatsWriter::writerThread(void)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+
+  while(true) {
+    mJobAvailable.wait(lock, []{return !mJobs.empty() || mStopRequested;});
+
+    if(mJobs.empty()) // Stop requested and all jobs done
+      break;
+
+    std::function<void()> job = std::move(mJobs.front());
+    mJobs.pop_front();
+    mJobRunning = true;
+    lock.unlock();
+    mSpaceAvailable.notify_one();
+
+    std::string error;
+    try {
+      job();
+    } catch(const std::exception& e) {
+      error = e.what();
+    }
+
+    // Free the job's data before taking the lock again
+    job = nullptr;
+
+    lock.lock();
+    mJobRunning = false;
+
+    if(!error.empty() && mError.empty())
+      mError = error;
+
+    if(mJobs.empty())
+      mIdle.notify_all();
+  }
+}
@@ -0,0 +1,60 @@
+/**
+ * @file   StatsWriter.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Background thread for writing simulation statistics to file while the
+ *         simulation is running.
+ *
+ *         The simulation posts write jobs as statistics become final (e.g. closed
+ *         data rate intervals, full chunks of trigger actions). The jobs must own the
+ *         data they write, and must not access any simulation objects. Jobs are
+ *         executed in the order they were posted, by a single thread.
+ *
+ *         The job queue is bounded, post() blocks when the queue is full so that the
+ *         simulation can not run too far ahead of the writer and build up memory.
+ *
+ *         The writer thread is disabled by default, in which case post() executes the
+ *         job immediately in the calling thread.
+ */
+
+#ifndef STATS_WRITER_HPP
+#define STATS_WRITER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+
+class StatsWriter {
+private:
+  static std::thread mThread;
+  static std::mutex mMutex;
+  static std::condition_variable mJobAvailable;
+  static std::condition_variable mSpaceAvailable;
+  static std::condition_variable mIdle;
+  static std::deque<std::function<void()>> mJobs;
+  static std::size_t mMaxQueuedJobs;
+  static bool mEnabled;
+  static bool mStopRequested;
+  static bool mJobRunning;
+
+  ///@brief Error message from the first job that failed, empty if no jobs failed
+  static std::string mError;
+
+  static void writerThread(void);
+  static void checkError(void);
+
+public:
+  static void start(std::size_t max_queued_jobs);
+  static void stop(void);
+  static void post(std::function<void()> job);
+  static void waitIdle(void);
+  static bool getEnabled(void) {return mEnabled;}
+};
+
+
+#endif
@@ -0,0 +1,485 @@
+/**
+ * @file   WaveformFile.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Writers for waveforms in the compact binary format (see WaveformFormat.hpp)
+ *         and in VCD, and a reader for the binary format.
+ */
+
+#include "WaveformFile.hpp"
+#include "ColumnarFormat.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using Columnar::putVarint;
+using Columnar::getVarint;
+using Columnar::putString;
+using Columnar::getString;
+
+
+///@brief Match a name against a pattern where '*' matches any sequence of characters
+///       (including periods), and '?' matches any single character.
+///@param pattern Pattern to match
+///@param name Name to check
+///@return True if the whole name matches the pattern
+bool Waveform::matchPattern(const std::string& pattern, const std::string& name)
+{
+  std::size_t p = 0;
+  std::size_t n = 0;
+
+  // Position in pattern after the last '*', and position in name it was matched from
+  std::size_t star_p = std::string::npos;
+  std::size_t star_n = 0;
+
+  while(n < name.size()) {
+    if(p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+      p++;
+      n++;
+    } else if(p < pattern.size() && pattern[p] == '*') {
+      star_p = ++p;
+      star_n = n;
+    } else if(star_p != std::string::npos) {
+      // Let the last '*' match one more character, and try again from there
+      p = star_p;
+      n = ++star_n;
+    } else {
+      return false;
+    }
+  }
+
+  while(p < pattern.size() && pattern[p] == '*')
+    p++;
+
+  return p == pattern.size();
+}
+
+
+///@brief Split a semicolon separated list of patterns. Empty patterns are removed.
+std::vector<std::string> Waveform::splitPatterns(const std::string& patterns)
+{
+  std::vector<std::string> pattern_list;
+  std::size_t start = 0;
+
+  while(start <= patterns.size()) {
+    std::size_t end = patterns.find(';', start);
+
+    if(end == std::string::npos)
+      end = patterns.size();
+
+    if(end > start)
+      pattern_list.push_back(patterns.substr(start, end-start));
+
+    start = end+1;
+  }
+
+  return pattern_list;
+}
+
+
+std::uint64_t Waveform::realToBits(double value)
+{
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+
+double Waveform::bitsToReal(std::uint64_t bits)
+{
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+
+///@brief Create a waveform file in the binary format
+///@param filename Path to file
+///@throw std::runtime_error if the file could not be created
+WaveformWriter::WaveformWriter(const std::string& filename)
+  : mFile(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc)
+  , mFilename(filename)
+{
+  if(!mFile.is_open())
+    throw std::runtime_error("Error creating waveform file " + filename);
+
+  mBuffer.reserve(Waveform::WRITE_BUFFER_SIZE + 1024);
+}
+
+
+WaveformWriter::~WaveformWriter()
+{
+  try {
+    close();
+  } catch(const std::exception&) {
+    // Errors are reported when close() is called explicitly
+  }
+}
+
+
+void WaveformWriter::writeHeader(const std::vector<Waveform::Variable>& variables,
+                                 std::uint64_t time_unit_fs)
+{
+  mBuffer.insert(mBuffer.end(), Waveform::FILE_MAGIC, Waveform::FILE_MAGIC+8);
+  putVarint(mBuffer, time_unit_fs);
+  putVarint(mBuffer, variables.size());
+
+  for(auto it = variables.begin(); it != variables.end(); it++) {
+    putVarint(mBuffer, it->type);
+    putVarint(mBuffer, it->width);
+    putString(mBuffer, it->name);
+    mVarTypes.push_back(it->type);
+  }
+}
+
+
+void WaveformWriter::writeTime(std::uint64_t time)
+{
+  putVarint(mBuffer, ((time - mPreviousTime) << 1) | 1);
+  mPreviousTime = time;
+}
+
+
+void WaveformWriter::writeValue(std::uint32_t var_index, std::uint64_t value)
+{
+  putVarint(mBuffer, std::uint64_t(var_index) << 1);
+
+  if(mVarTypes[var_index] == Waveform::VAR_REAL) {
+    for(int i = 0; i < 8; i++)
+      mBuffer.push_back(std::uint8_t(value >> (8*i)));
+  } else {
+    putVarint(mBuffer, value);
+  }
+
+  if(mBuffer.size() >= Waveform::WRITE_BUFFER_SIZE)
+    flush();
+}
+
+
+///@brief Write the buffer to file
+void WaveformWriter::flush(void)
+{
+  mFile.write((const char*) mBuffer.data(), mBuffer.size());
+  mBuffer.clear();
+
+  if(!mFile.good())
+    throw std::runtime_error("Error writing to waveform file " + mFilename);
+}
+
+
+///@brief Write the remaining records and close the file
+void WaveformWriter::close(void)
+{
+  if(!mFile.is_open())
+    return;
+
+  flush();
+  mFile.close();
+}
+
+
+///@brief Create a VCD file
+///@param filename Path to file
+///@throw std::runtime_error if the file could not be created
+VcdWriter::VcdWriter(const std::string& filename)
+  : mFile(filename, std::ios_base::out | std::ios_base::trunc)
+  , mFilename(filename)
+{
+  if(!mFile.is_open())
+    throw std::runtime_error("Error creating VCD file " + filename);
+}
+
+
+VcdWriter::~VcdWriter()
+{
+  try {
+    close();
+  } catch(const std::exception&) {
+    // Errors are reported when close() is called explicitly
+  }
+}
+
+
+void VcdWriter::writeHeader(const std::vector<Waveform::Variable>& variables,
+                            std::uint64_t time_unit_fs)
+{
+  mVariables = variables;
+
+  // Find the largest VCD time unit the time unit is a multiple of
+  const char* unit_names[] = {"s", "ms", "us", "ns", "ps", "fs"};
+  std::uint64_t unit_fs = 1000000000000000ULL;
+  unsigned int unit = 0;
+
+  while(unit < 5 && (time_unit_fs == 0 || time_unit_fs % unit_fs != 0)) {
+    unit_fs /= 1000;
+    unit++;
+  }
+
+  // Use a time scale of 1, 10 or 100 of that unit, with multiplier for the rest
+  std::uint64_t time_scale = 1;
+  mTimeMultiplier = time_unit_fs / unit_fs;
+
+  while(time_scale < 100 && mTimeMultiplier > 0 && mTimeMultiplier % 10 == 0) {
+    time_scale *= 10;
+    mTimeMultiplier /= 10;
+  }
+
+  if(mTimeMultiplier == 0)
+    mTimeMultiplier = 1;
+
+  mFile << "$version\n  Alpide Dataflow SystemC simulation\n$end\n\n";
+  mFile << "$timescale\n  " << time_scale << " " << unit_names[unit] << "\n$end\n\n";
+
+  // Identifiers are base 94 numbers, with the printable characters '!' to '~' as digits
+  mIdentifiers.clear();
+  for(std::size_t i = 0; i < variables.size(); i++) {
+    std::string id;
+    std::size_t n = i;
+
+    do {
+      id.push_back(char('!' + n % 94));
+      n /= 94;
+    } while(n > 0);
+
+    mIdentifiers.push_back(id);
+  }
+
+  // Sort the variables by scope, so that each scope is declared once
+  std::vector<std::vector<std::string>> names;
+  for(auto it = variables.begin(); it != variables.end(); it++) {
+    std::vector<std::string> levels;
+    std::size_t start = 0;
+    std::size_t end;
+
+    while((end = it->name.find('.', start)) != std::string::npos) {
+      levels.push_back(it->name.substr(start, end-start));
+      start = end+1;
+    }
+
+    levels.push_back(it->name.substr(start));
+    names.push_back(levels);
+  }
+
+  std::vector<std::size_t> order(variables.size());
+  for(std::size_t i = 0; i < order.size(); i++)
+    order[i] = i;
+
+  std::stable_sort(order.begin(), order.end(), [&names](std::size_t a, std::size_t b) {
+      return names[a] < names[b];
+    });
+
+  mFile << "$scope module SystemC $end\n";
+
+  std::vector<std::string> scope;
+
+  for(auto it = order.begin(); it != order.end(); it++) {
+    const std::vector<std::string>& levels = names[*it];
+    std::size_t common = 0;
+
+    while(common < scope.size() && common+1 < levels.size() && scope[common] == levels[common])
+      common++;
+
+    while(scope.size() > common) {
+      mFile << "$upscope $end\n";
+      scope.pop_back();
+    }
+
+    while(scope.size()+1 < levels.size()) {
+      scope.push_back(levels[scope.size()]);
+      mFile << "$scope module " << scope.back() << " $end\n";
+    }
+
+    const Waveform::Variable& var = variables[*it];
+
+    if(var.type == Waveform::VAR_REAL)
+      mFile << "$var real 64 ";
+    else
+      mFile << "$var wire " << var.width << " ";
+
+    mFile << mIdentifiers[*it] << " " << levels.back() << " $end\n";
+  }
+
+  for(std::size_t i = 0; i < scope.size(); i++)
+    mFile << "$upscope $end\n";
+
+  mFile << "$upscope $end\n";
+  mFile << "$enddefinitions $end\n\n";
+}
+
+
+void VcdWriter::writeTime(std::uint64_t time)
+{
+  mFile << "#" << time*mTimeMultiplier << "\n";
+}
+
+
+void VcdWriter::writeValue(std::uint32_t var_index, std::uint64_t value)
+{
+  const Waveform::Variable& var = mVariables[var_index];
+
+  if(var.type == Waveform::VAR_REAL) {
+    mFile.precision(std::numeric_limits<double>::max_digits10);
+    mFile << "r" << Waveform::bitsToReal(value);
+  } else if(var.width == 1) {
+    mFile << (value & 1);
+  } else {
+    // Binary value without leading zeros
+    char bits[64];
+    int num_bits = 0;
+
+    do {
+      bits[num_bits++] = (value & 1) ? '1' : '0';
+      value >>= 1;
+    } while(value != 0);
+
+    mFile << "b";
+    while(num_bits > 0)
+      mFile << bits[--num_bits];
+  }
+
+  if(var.type == Waveform::VAR_REAL || var.width > 1)
+    mFile << " ";
+
+  mFile << mIdentifiers[var_index] << "\n";
+}
+
+
+///@brief Close the file
+///@throw std::runtime_error if writing to the file failed
+void VcdWriter::close(void)
+{
+  if(!mFile.is_open())
+    return;
+
+  mFile.close();
+
+  if(!mFile)
+    throw std::runtime_error("Error writing to VCD file " + mFilename);
+}
+
+
+///@brief Open a waveform file in the binary format, and read the header
+///@param filename Path to file
+///@throw std::runtime_error if the file could not be read, or is not a waveform file
+WaveformReader::WaveformReader(const std::string& filename)
+  : mFilename(filename)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+
+  if(fd < 0)
+    throw std::runtime_error("Error opening waveform file " + filename);
+
+  struct stat file_stat;
+  if(fstat(fd, &file_stat) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Error getting size of waveform file " + filename);
+  }
+
+  mSize = file_stat.st_size;
+
+  // Also avoids mapping empty files, which is not possible
+  if(mSize < sizeof(Waveform::FILE_MAGIC)) {
+    ::close(fd);
+    throw std::runtime_error(filename + " is not a waveform file");
+  }
+
+  void* addr = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping stays valid after the file descriptor is closed
+  ::close(fd);
+
+  if(addr == MAP_FAILED)
+    throw std::runtime_error("Error mapping waveform file " + filename);
+
+  // The records are read from start to end
+  madvise(addr, mSize, MADV_SEQUENTIAL);
+
+  mData = static_cast<const std::uint8_t*>(addr);
+  mPos = mData;
+  mEnd = mData + mSize;
+
+  if(std::memcmp(mPos, Waveform::FILE_MAGIC, sizeof(Waveform::FILE_MAGIC)) != 0) {
+    munmap(const_cast<std::uint8_t*>(mData), mSize);
+    throw std::runtime_error(filename + " is not a waveform file");
+  }
+
+  mPos += 8;
+
+  try {
+    mTimeUnitFs = getVarint(mPos, mEnd);
+
+    uint64_t num_variables = getVarint(mPos, mEnd);
+    for(uint64_t i = 0; i < num_variables; i++) {
+      Waveform::Variable var;
+      var.type = Waveform::VarType(getVarint(mPos, mEnd));
+      uint64_t width = getVarint(mPos, mEnd);
+      var.width = width;
+      var.name = getString(mPos, mEnd);
+
+      if(var.type != Waveform::VAR_BITS && var.type != Waveform::VAR_REAL)
+        throw std::runtime_error("invalid variable type");
+
+      if(width < 1 || width > 64)
+        throw std::runtime_error("invalid variable width");
+
+      mVariables.push_back(var);
+    }
+  } catch(const std::runtime_error&) {
+    munmap(const_cast<std::uint8_t*>(mData), mSize);
+    throw std::runtime_error(filename + " has an invalid waveform header");
+  }
+}
+
+
+WaveformReader::~WaveformReader()
+{
+  munmap(const_cast<std::uint8_t*>(mData), mSize);
+}
+
+
+///@brief Read the next record
+///@param[out] record Record to read into
+///@return True if a record was read, false at the end of the file
+///@throw std::runtime_error if the file ends in the middle of a record,
+///       or a record is invalid
+bool WaveformReader::readRecord(WaveformRecord& record)
+{
+  if(mPos == mEnd)
+    return false;
+
+  try {
+    uint64_t tag = getVarint(mPos, mEnd);
+
+    if(tag & 1) {
+      mTime += tag >> 1;
+      record.type = WaveformRecord::TIME;
+      record.time = mTime;
+    } else {
+      if((tag >> 1) >= mVariables.size())
+        throw std::runtime_error("invalid variable index");
+
+      record.type = WaveformRecord::VALUE;
+      record.var_index = tag >> 1;
+
+      if(mVariables[record.var_index].type == Waveform::VAR_REAL) {
+        if(mEnd - mPos < 8)
+          throw std::runtime_error("truncated real value");
+
+        record.value = 0;
+        for(int i = 0; i < 8; i++)
+          record.value |= uint64_t(*mPos++) << (8*i);
+      } else {
+        record.value = getVarint(mPos, mEnd);
+      }
+    }
+  } catch(const std::runtime_error& e) {
+    throw std::runtime_error(mFilename + ": invalid waveform record (" + e.what() + ")");
+  }
+
+  return true;
+}
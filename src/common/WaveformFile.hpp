@@ -0,0 +1,131 @@
+/**
+ * @file   WaveformFile.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Writers for waveforms in the compact binary format (see WaveformFormat.hpp)
+ *         and in VCD, and a reader for the binary format. Does not depend on SystemC,
+ *         so that the files can be converted without the simulation.
+ */
+
+#ifndef WAVEFORM_FILE_HPP
+#define WAVEFORM_FILE_HPP
+
+#include "WaveformFormat.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+namespace Waveform {
+  bool matchPattern(const std::string& pattern, const std::string& name);
+  std::vector<std::string> splitPatterns(const std::string& patterns);
+  std::uint64_t realToBits(double value);
+  double bitsToReal(std::uint64_t bits);
+}
+
+
+///@brief Interface for writing waveforms. The header is written first, followed by
+///       time and value changes, in order of increasing time.
+class WaveformOutput {
+public:
+  virtual ~WaveformOutput() {}
+
+  ///@param variables Variables in the waveform. Values are written with the index
+  ///                 of the variable in this vector.
+  ///@param time_unit_fs Unit of the times passed to writeTime(), in femtoseconds
+  virtual void writeHeader(const std::vector<Waveform::Variable>& variables,
+                           std::uint64_t time_unit_fs) = 0;
+  virtual void writeTime(std::uint64_t time) = 0;
+
+  ///@param var_index Variable index
+  ///@param value Value for VAR_BITS variables, or the bits of the value
+  ///             (see Waveform::realToBits()) for VAR_REAL variables
+  virtual void writeValue(std::uint32_t var_index, std::uint64_t value) = 0;
+  virtual void close(void) = 0;
+};
+
+
+///@brief Write a waveform file in the binary format. Records are encoded to a
+///       buffer, which is written to file when it is full and when the file is closed.
+class WaveformWriter : public WaveformOutput {
+  std::ofstream mFile;
+  std::string mFilename;
+  std::vector<std::uint8_t> mBuffer;
+  std::vector<Waveform::VarType> mVarTypes;
+  std::uint64_t mPreviousTime = 0;
+
+  void flush(void);
+
+public:
+  explicit WaveformWriter(const std::string& filename);
+  ~WaveformWriter();
+  void writeHeader(const std::vector<Waveform::Variable>& variables,
+                   std::uint64_t time_unit_fs);
+  void writeTime(std::uint64_t time);
+  void writeValue(std::uint32_t var_index, std::uint64_t value);
+  void close(void);
+};
+
+
+///@brief Write a waveform as a Value Change Dump (VCD) file. The variables are put in
+///       VCD scopes according to the periods in their names.
+class VcdWriter : public WaveformOutput {
+  std::ofstream mFile;
+  std::string mFilename;
+  std::vector<Waveform::Variable> mVariables;
+  std::vector<std::string> mIdentifiers;
+
+  ///@brief VCD only allows time units of 1, 10 or 100 s/ms/us/ns/ps/fs. Times are
+  ///       multiplied by this to get the time in the unit used in the VCD file.
+  std::uint64_t mTimeMultiplier = 1;
+
+public:
+  explicit VcdWriter(const std::string& filename);
+  ~VcdWriter();
+  void writeHeader(const std::vector<Waveform::Variable>& variables,
+                   std::uint64_t time_unit_fs);
+  void writeTime(std::uint64_t time);
+  void writeValue(std::uint32_t var_index, std::uint64_t value);
+  void close(void);
+};
+
+
+struct WaveformRecord {
+  enum {TIME, VALUE} type;
+
+  ///@brief Time for TIME records
+  std::uint64_t time;
+
+  ///@brief Variable index and value for VALUE records
+  std::uint32_t var_index;
+  std::uint64_t value;
+};
+
+
+///@brief Read records from a waveform file in the binary format. The file is memory
+///       mapped and read from start to end, so files larger than memory can be read.
+class WaveformReader {
+  const std::uint8_t* mData = nullptr;
+  std::size_t mSize = 0;
+  const std::uint8_t* mPos;
+  const std::uint8_t* mEnd;
+
+  std::string mFilename;
+  std::uint64_t mTimeUnitFs;
+  std::vector<Waveform::Variable> mVariables;
+  std::uint64_t mTime = 0;
+
+public:
+  explicit WaveformReader(const std::string& filename);
+  ~WaveformReader();
+  WaveformReader(const WaveformReader&) = delete;
+  WaveformReader& operator=(const WaveformReader&) = delete;
+  std::uint64_t getTimeUnitFs(void) const {return mTimeUnitFs;}
+  const std::vector<Waveform::Variable>& getVariables(void) const {return mVariables;}
+  bool readRecord(WaveformRecord& record);
+};
+
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * @file   WaveformFormat.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Definitions for the compact binary waveform format, an alternative to VCD
+ *         for the simulation's signal traces (see WaveformTraceFile.hpp).
+ *
+ *         File format (varints are LEB128, see Columnar::putVarint()):
+ *
+ *         Header:
+ *           8 bytes: magic "ALPWAV01"
+ *           varint:  time unit in femtoseconds
+ *           varint:  number of variables, followed by for each variable:
+ *                    - varint: type (VAR_BITS or VAR_REAL)
+ *                    - varint: width in bits (1 to 64)
+ *                    - varint: length of the name, followed by the name. The name is
+ *                      the hierarchical trace name, with levels separated by periods.
+ *
+ *         Followed by records, each starting with a varint tag:
+ *           Tag bit 0 set:   time record, tag >> 1 is the time minus the time of the
+ *                            previous time record (or minus zero for the first one).
+ *                            The value changes that follow happened at this time.
+ *           Tag bit 0 clear: value change, tag >> 1 is the variable index. Followed by
+ *                            the value as a varint for VAR_BITS variables, or as an 8
+ *                            byte little-endian IEEE double for VAR_REAL variables.
+ *
+ *         When tracing starts (at the start of the simulation or of the trace window)
+ *         the values of all variables are written. Only changes are written after that.
+ *         Use alpide_waveform_convert to convert a file to VCD.
+ */
+
+#ifndef WAVEFORM_FORMAT_HPP
+#define WAVEFORM_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace Waveform {
+  const char FILE_MAGIC[8] = {'A', 'L', 'P', 'W', 'A', 'V', '0', '1'};
+
+  /// Size of write buffer, the buffer is written to file when it is full
+  const std::size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+  enum VarType {
+    VAR_BITS = 0,
+    VAR_REAL = 1
+  };
+
+  struct Variable {
+    std::string name;
+    VarType type;
+    std::uint32_t width;
+  };
+}
+
+
+#endif
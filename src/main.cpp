@@ -35,17 +35,29 @@
 #include "Stimuli/StimuliITS.hpp"
 #include "Stimuli/StimuliPCT.hpp"
 #include "Stimuli/StimuliFocal.hpp"
+#include "common/Log.hpp"
+#include "common/ProcessProfiler.hpp"
+#include "common/StatsWriter.hpp"
+#include "common/ColumnarWriter.hpp"
+#include "misc/WaveformTraceFile.hpp"
+#include "ReadoutUnit/TriggerActionStore.hpp"
 #include "version.hpp"
 
 
 void signal_callback_handler(int signum);
+void stop_writer_threads(void);
 bool create_output_dir(const QSettings* settings, std::string& output_path);
 double get_data_size_warning(const QSettings* settings);
 
 volatile bool g_terminate_program = false;
 
 
+#ifdef ALPIDE_BENCH
+// alpide_bench has its own sc_main, which calls this function to run a simulation
+int alpide_sim_main(int argc, char** argv)
+#else
 int sc_main(int argc, char** argv)
+#endif
 {
   boost::posix_time::ptime simulation_start_time = boost::posix_time::second_clock::local_time();
 
@@ -92,24 +104,69 @@ int sc_main(int argc, char** argv)
   // and not lose data if the user presses CTRL+C on the command line
   signal(SIGINT, signal_callback_handler);
 
+  // Log levels for diagnostic output. Verbose output (-V) enables debug output.
+  try {
+    QString log_level = simulation_settings->value("data_output/log_level").toString();
+
+    if(simulation_settings->value("verbose").toBool())
+      log_level = "debug";
+
+    Log::configure(log_level.toStdString(),
+                   simulation_settings->value("data_output/log_categories").toString().toStdString());
+  } catch(const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 0;
+  }
+
+  // Write info/debug log lines from a background thread during the simulation
+  if(simulation_settings->value("data_output/log_writer_thread").toBool())
+    Log::start(simulation_settings->value("data_output/log_queue_size").toUInt());
+
+  bool write_process_profile = simulation_settings->value("data_output/write_process_profile").toBool();
+  ProcessProfiler::setEnabled(write_process_profile);
+
+  bool stats_writer_thread = simulation_settings->value("data_output/stats_writer_thread").toBool();
+
+  // Spill the readout units' trigger actions to the output directory during the
+  // simulation, instead of holding them in memory until the end. Always done with the
+  // StatsWriter thread, which streams the other readout unit statistics.
+  if(simulation_settings->value("data_output/trigger_actions_spill").toBool() || stats_writer_thread)
+    TriggerActionStore::setSpillDirectory(output_dir_str);
+
+  // Write statistics that are final to file from a background thread during the simulation
+  if(stats_writer_thread)
+    StatsWriter::start(simulation_settings->value("data_output/stats_writer_queue_size").toUInt());
+
+  // Run statistics in compact columnar format, in addition to the normal output files
+  if(simulation_settings->value("data_output/write_columnar").toBool())
+    ColumnarWriter::setRunWriter(std::make_shared<ColumnarWriter>(output_dir_str + "/run_stats.acol"));
+
   // Setup SystemC simulation
   std::shared_ptr<StimuliBase> stimuli;
 
   QString sim_type = simulation_settings->value("simulation/type").toString();
 
-  if(sim_type == "its") {
-    stimuli = std::make_shared<StimuliITS>("stimuli", simulation_settings, output_dir_str);
-  } else if(sim_type == "pct") {
-    stimuli = std::make_shared<StimuliPCT>("stimuli", simulation_settings, output_dir_str);
-  } else if(sim_type == "focal") {
-    stimuli = std::make_shared<StimuliFocal>("stimuli", simulation_settings, output_dir_str);
-  } else {
-    std::cout << "Unknown simulation type " << sim_type.toStdString() << std::endl;
-    std::cout << "Exiting..." << std::endl;
-    return 0;
+  try {
+    if(sim_type == "its") {
+      stimuli = std::make_shared<StimuliITS>("stimuli", simulation_settings, output_dir_str);
+    } else if(sim_type == "pct") {
+      stimuli = std::make_shared<StimuliPCT>("stimuli", simulation_settings, output_dir_str);
+    } else if(sim_type == "focal") {
+      stimuli = std::make_shared<StimuliFocal>("stimuli", simulation_settings, output_dir_str);
+    } else {
+      std::cout << "Unknown simulation type " << sim_type.toStdString() << std::endl;
+      std::cout << "Exiting..." << std::endl;
+      stop_writer_threads();
+      return 0;
+    }
+  } catch(const std::exception& e) {
+    // E.g. errors reading the event files
+    std::cerr << "Error: " << e.what() << std::endl;
+    stop_writer_threads();
+    return -1;
   }
 
-  sc_trace_file *wf = NULL;
+  std::unique_ptr<WaveformTraceFile> wf;
   sc_core::sc_set_time_resolution(1, sc_core::SC_NS);
 
   // 25ns period, 0.5 duty cycle, first edge at 25 time units, first value is true
@@ -117,25 +174,105 @@ int sc_main(int argc, char** argv)
 
   stimuli->clock(clock_40MHz);
 
-  // Open VCD file
+  // Open VCD (or binary waveform) file
   if(simulation_settings->value("data_output/write_vcd").toBool() == true) {
-    std::string vcd_filename = output_dir_str + "/alpide_sim_traces";
-    wf = sc_create_vcd_trace_file(vcd_filename.c_str());
-    stimuli->addTraces(wf);
+    WaveformTraceFile::Options trace_options;
+    QString vcd_format = simulation_settings->value("data_output/vcd_format").toString();
+
+    if(vcd_format == "vcd") {
+      trace_options.format = WaveformTraceFile::FORMAT_VCD;
+    } else if(vcd_format == "wave") {
+      trace_options.format = WaveformTraceFile::FORMAT_WAVE;
+    } else {
+      std::cout << "Unknown waveform format " << vcd_format.toStdString() << std::endl;
+      std::cout << "Exiting..." << std::endl;
+      stop_writer_threads();
+      return 0;
+    }
+
+    trace_options.include = simulation_settings->value("data_output/vcd_include").toString().toStdString();
+    trace_options.exclude = simulation_settings->value("data_output/vcd_exclude").toString().toStdString();
+    trace_options.start_ns = simulation_settings->value("data_output/vcd_start_ns").toULongLong();
+    trace_options.end_ns = simulation_settings->value("data_output/vcd_end_ns").toULongLong();
+    trace_options.first_trigger_id = simulation_settings->value("data_output/vcd_first_trigger_id").toLongLong();
+    trace_options.last_trigger_id = simulation_settings->value("data_output/vcd_last_trigger_id").toLongLong();
+
+    try {
+      std::string vcd_filename = output_dir_str + "/alpide_sim_traces";
+      wf.reset(new WaveformTraceFile(vcd_filename, trace_options));
+    } catch(const std::exception& e) {
+      std::cerr << "Error: " << e.what() << std::endl;
+      stop_writer_threads();
+      return 0;
+    }
+
+    wf->setTriggerIdSource([&stimuli]() { return stimuli->getTriggerIdCount(); });
+    stimuli->addTraces(wf.get());
 
     if(simulation_settings->value("data_output/write_vcd_clock").toBool() == true)
-      sc_trace(wf, clock_40MHz, "clock");
+      sc_trace(wf.get(), clock_40MHz, "clock");
   }
 
 
   std::cout << "Starting simulation.." << std::endl;
 
-  sc_core::sc_start();
+  auto sc_start_time = std::chrono::steady_clock::now();
+
+  try {
+    sc_core::sc_start();
+  } catch(const std::exception& e) {
+    // Errors reading events during the simulation, also from the prefetch thread
+    std::cerr << "Error: " << e.what() << std::endl;
+    stimuli->stopEventThreads();
+    stop_writer_threads();
+    return -1;
+  }
+
+  std::chrono::duration<double> sc_wall_time = std::chrono::steady_clock::now() - sc_start_time;
+
+  // The prefetch and pipeline threads may still be running, for example when the
+  // simulation was stopped with CTRL+C, and they may write to the log
+  stimuli->stopEventThreads();
+
+  // Write the remaining log lines before the end of simulation output
+  Log::stop();
 
   std::cout << "Ending simulation.." << std::endl;
 
-  if(wf != NULL) {
-    sc_close_vcd_trace_file(wf);
+  // Write the last chunks of the columnar file
+  if(ColumnarWriter::getRunWriter() != nullptr) {
+    ColumnarWriter::getRunWriter()->close();
+    ColumnarWriter::setRunWriter(nullptr);
+  }
+
+  // Wait for the remaining statistics to be written. Errors from the writer thread,
+  // for example a failed spill or CSV file write, are reported here. The remaining
+  // outputs are still closed before exiting with an error.
+  int exit_code = 0;
+
+  try {
+    StatsWriter::stop();
+  } catch(const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    exit_code = -1;
+  }
+
+  if(write_process_profile) {
+    ProcessProfiler::writeToFile(output_dir_str, sc_time_stamp().value(), sc_wall_time.count());
+  }
+
+  if(wf) {
+    try {
+      wf->close();
+    } catch(const std::exception& e) {
+      std::cerr << "Error: " << e.what() << std::endl;
+    }
+    wf.reset();
+  }
+
+  if(exit_code != 0) {
+    delete simulation_settings;
+    return exit_code;
   }
 
 
@@ -152,6 +289,20 @@ int sc_main(int argc, char** argv)
 }
 
 
+///@brief Stop the log and statistics writer threads, when exiting because of an error.
+///       Errors from the statistics writer are ignored, the error that caused the
+///       exit is the one reported.
+void stop_writer_threads(void)
+{
+  Log::stop();
+
+  try {
+    StatsWriter::stop();
+  } catch(const std::exception&) {
+  }
+}
+
+
 ///@brief Callback function for CTRL+C (SIGINT) signal, used for exiting the simulation
 /// nicely and not lose data if the user presses CTRL+C on the command line.
 void signal_callback_handler(int signum)
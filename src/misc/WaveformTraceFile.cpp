@@ -0,0 +1,336 @@
+/**
+ * @file   WaveformTraceFile.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  SystemC trace file with selection of traces by name, a simulation time or
+ *         trigger ID window, and output to VCD or the compact binary waveform format.
+ */
+
+#include "WaveformTraceFile.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+///@brief Create trace file, and register it with the SystemC simulation context
+///@param filename_base Path and name of the file without extension. The extension is
+///                     .vcd for the VCD format, and .awf for the binary format.
+///@param options Trace selection, window and format
+///@throw std::runtime_error if the file could not be created
+WaveformTraceFile::WaveformTraceFile(const std::string& filename_base, const Options& options)
+  : mOptions(options)
+  , mIncludePatterns(Waveform::splitPatterns(options.include))
+  , mExcludePatterns(Waveform::splitPatterns(options.exclude))
+{
+  if(options.format == FORMAT_WAVE)
+    mOutput = std::unique_ptr<WaveformOutput>(new WaveformWriter(filename_base + ".awf"));
+  else
+    mOutput = std::unique_ptr<WaveformOutput>(new VcdWriter(filename_base + ".vcd"));
+
+  mStartTime = sc_core::sc_time(double(options.start_ns), sc_core::SC_NS).value();
+  mEndTime = sc_core::sc_time(double(options.end_ns), sc_core::SC_NS).value();
+
+  sc_core::sc_get_curr_simcontext()->add_trace_file(this);
+}
+
+
+WaveformTraceFile::~WaveformTraceFile()
+{
+  sc_core::sc_get_curr_simcontext()->remove_trace_file(this);
+}
+
+
+///@brief Set function that returns the number of triggers sent so far, used for the
+///       trigger ID window
+void WaveformTraceFile::setTriggerIdSource(std::function<uint64_t()> trigger_id_source)
+{
+  mTriggerIdSource = trigger_id_source;
+}
+
+
+///@brief Write the remaining waveform data and close the file
+///@throw std::runtime_error if writing to the file failed
+void WaveformTraceFile::close(void)
+{
+  mOutput->close();
+}
+
+
+void WaveformTraceFile::addTrace(const void* object, TraceKind kind, const std::string& name,
+                                 unsigned int width)
+{
+  // Tracing is set up before the simulation starts, the header is written in the first cycle
+  if(mHeaderWritten)
+    return;
+
+  bool included = false;
+  for(auto it = mIncludePatterns.begin(); it != mIncludePatterns.end() && !included; it++)
+    included = Waveform::matchPattern(*it, name);
+
+  for(auto it = mExcludePatterns.begin(); it != mExcludePatterns.end() && included; it++)
+    included = !Waveform::matchPattern(*it, name);
+
+  if(!included)
+    return;
+
+  Waveform::Variable var;
+  var.name = name;
+  var.type = (kind == KIND_FLOAT || kind == KIND_DOUBLE) ? Waveform::VAR_REAL : Waveform::VAR_BITS;
+  var.width = std::max(1U, std::min(width, 64U));
+
+  Trace trace;
+  trace.object = object;
+  trace.kind = kind;
+  trace.mask = var.width == 64 ? ~uint64_t(0) : (uint64_t(1) << var.width) - 1;
+  trace.value = 0;
+
+  mVariables.push_back(var);
+  mTraces.push_back(trace);
+}
+
+
+///@brief Read current value of a trace, masked to the width of the trace. Values of sc_lv
+///       traces with bits that are not 0 or 1 are read as zero.
+uint64_t WaveformTraceFile::readValue(const Trace& trace) const
+{
+  uint64_t value = 0;
+
+  switch(trace.kind) {
+  case KIND_BOOL:
+    value = *static_cast<const bool*>(trace.object);
+    break;
+  case KIND_BIT:
+    value = static_cast<const sc_dt::sc_bit*>(trace.object)->to_bool();
+    break;
+  case KIND_LOGIC:
+    value = static_cast<const sc_dt::sc_logic*>(trace.object)->value() == sc_dt::Log_1;
+    break;
+  case KIND_UCHAR:
+    value = *static_cast<const unsigned char*>(trace.object);
+    break;
+  case KIND_USHORT:
+    value = *static_cast<const unsigned short*>(trace.object);
+    break;
+  case KIND_UINT:
+    value = *static_cast<const unsigned int*>(trace.object);
+    break;
+  case KIND_ULONG:
+    value = *static_cast<const unsigned long*>(trace.object);
+    break;
+  case KIND_CHAR:
+    value = *static_cast<const char*>(trace.object);
+    break;
+  case KIND_SHORT:
+    value = *static_cast<const short*>(trace.object);
+    break;
+  case KIND_INT:
+    value = *static_cast<const int*>(trace.object);
+    break;
+  case KIND_LONG:
+    value = *static_cast<const long*>(trace.object);
+    break;
+  case KIND_INT64:
+    value = *static_cast<const sc_dt::int64*>(trace.object);
+    break;
+  case KIND_UINT64:
+    value = *static_cast<const sc_dt::uint64*>(trace.object);
+    break;
+  case KIND_FLOAT:
+    value = Waveform::realToBits(*static_cast<const float*>(trace.object));
+    break;
+  case KIND_DOUBLE:
+    value = Waveform::realToBits(*static_cast<const double*>(trace.object));
+    break;
+  case KIND_INT_BASE:
+    value = static_cast<const sc_dt::sc_int_base*>(trace.object)->to_int64();
+    break;
+  case KIND_UINT_BASE:
+    value = static_cast<const sc_dt::sc_uint_base*>(trace.object)->to_uint64();
+    break;
+  case KIND_SIGNED:
+    value = static_cast<const sc_dt::sc_signed*>(trace.object)->to_int64();
+    break;
+  case KIND_UNSIGNED:
+    value = static_cast<const sc_dt::sc_unsigned*>(trace.object)->to_uint64();
+    break;
+  case KIND_BV:
+    value = static_cast<const sc_dt::sc_bv_base*>(trace.object)->to_uint64();
+    break;
+  case KIND_LV:
+    {
+      const sc_dt::sc_lv_base* lv = static_cast<const sc_dt::sc_lv_base*>(trace.object);
+      value = lv->is_01() ? lv->to_uint64() : 0;
+    }
+    break;
+  }
+
+  // Reals have a width of 64 bits, so the mask keeps all their bits
+  return value & trace.mask;
+}
+
+
+///@brief Check if the current simulation time is in the time window, and the
+///       number of triggers sent is in the trigger ID window
+bool WaveformTraceFile::inWindow(void) const
+{
+  uint64_t time_now = sc_core::sc_time_stamp().value();
+
+  if(time_now < mStartTime || (mEndTime != 0 && time_now >= mEndTime))
+    return false;
+
+  if(mOptions.first_trigger_id >= 0 && mTriggerIdSource) {
+    uint64_t trigger_id_count = mTriggerIdSource();
+
+    if(trigger_id_count <= uint64_t(mOptions.first_trigger_id))
+      return false;
+
+    if(mOptions.last_trigger_id >= 0 && trigger_id_count > uint64_t(mOptions.last_trigger_id)+1)
+      return false;
+  }
+
+  return true;
+}
+
+
+///@brief Called by the SystemC kernel at the end of each time step. Writes the header in
+///       the first call, and after that the values that changed, when in the window.
+///       All values are written when the window is entered.
+///@param delta_cycle True when called after a delta cycle, which is ignored
+void WaveformTraceFile::cycle(bool delta_cycle)
+{
+  if(delta_cycle)
+    return;
+
+  if(!mHeaderWritten) {
+    double time_unit_fs = sc_core::sc_get_time_resolution().to_seconds() * 1E15;
+    mOutput->writeHeader(mVariables, std::llround(time_unit_fs));
+    mHeaderWritten = true;
+  }
+
+  if(!inWindow()) {
+    mInWindow = false;
+    return;
+  }
+
+  bool entered_window = !mInWindow;
+  bool time_written = false;
+  mInWindow = true;
+
+  for(uint32_t i = 0; i < mTraces.size(); i++) {
+    uint64_t value = readValue(mTraces[i]);
+
+    if(value != mTraces[i].value || entered_window) {
+      if(!time_written) {
+        mOutput->writeTime(sc_core::sc_time_stamp().value());
+        time_written = true;
+      }
+      mOutput->writeValue(i, value);
+      mTraces[i].value = value;
+    }
+  }
+}
+
+
+void WaveformTraceFile::trace(const bool& object, const std::string& name)
+{
+  addTrace(&object, KIND_BOOL, name, 1);
+}
+
+void WaveformTraceFile::trace(const sc_dt::sc_bit& object, const std::string& name)
+{
+  addTrace(&object, KIND_BIT, name, 1);
+}
+
+void WaveformTraceFile::trace(const sc_dt::sc_logic& object, const std::string& name)
+{
+  addTrace(&object, KIND_LOGIC, name, 1);
+}
+
+void WaveformTraceFile::trace(const unsigned char& object, const std::string& name, int width)
+{
+  addTrace(&object, KIND_UCHAR, name, width);
+}
+
+void WaveformTraceFile::trace(const unsigned short& object, const std::string& name, int width)
+{
+  addTrace(&object, KIND_USHORT, name, width);
+}
+
+void WaveformTraceFile::trace(const unsigned int& object, const std::string& name, int width)
+{
+  addTrace(&object, KIND_UINT, name, width);
+}
+
+void WaveformTraceFile::trace(const unsigned long& object, const std::string& name, int width)
+{
+  addTrace(&object, KIND_ULONG, name, width);
+}
+
+void WaveformTraceFile::trace(const char& object, const std::string& name, int width)
+{
+  addTrace(&object, KIND_CHAR, name, width);
+}
+
+void WaveformTraceFile::trace(const short& object, const std::string& name, int width)
+{
+  addTrace(&object, KIND_SHORT, name, width);
+}
+
+void WaveformTraceFile::trace(const int& object, const std::string& name, int width)
+{
+  addTrace(&object, KIND_INT, name, width);
+}
+
+void WaveformTraceFile::trace(const long& object, const std::string& name, int width)
+{
+  addTrace(&object, KIND_LONG, name, width);
+}
+
+void WaveformTraceFile::trace(const sc_dt::int64& object, const std::string& name, int width)
+{
+  addTrace(&object, KIND_INT64, name, width);
+}
+
+void WaveformTraceFile::trace(const sc_dt::uint64& object, const std::string& name, int width)
+{
+  addTrace(&object, KIND_UINT64, name, width);
+}
+
+void WaveformTraceFile::trace(const float& object, const std::string& name)
+{
+  addTrace(&object, KIND_FLOAT, name, 64);
+}
+
+void WaveformTraceFile::trace(const double& object, const std::string& name)
+{
+  addTrace(&object, KIND_DOUBLE, name, 64);
+}
+
+void WaveformTraceFile::trace(const sc_dt::sc_int_base& object, const std::string& name)
+{
+  addTrace(&object, KIND_INT_BASE, name, object.length());
+}
+
+void WaveformTraceFile::trace(const sc_dt::sc_uint_base& object, const std::string& name)
+{
+  addTrace(&object, KIND_UINT_BASE, name, object.length());
+}
+
+void WaveformTraceFile::trace(const sc_dt::sc_signed& object, const std::string& name)
+{
+  addTrace(&object, KIND_SIGNED, name, object.length());
+}
+
+void WaveformTraceFile::trace(const sc_dt::sc_unsigned& object, const std::string& name)
+{
+  addTrace(&object, KIND_UNSIGNED, name, object.length());
+}
+
+void WaveformTraceFile::trace(const sc_dt::sc_bv_base& object, const std::string& name)
+{
+  addTrace(&object, KIND_BV, name, object.length());
+}
+
+void WaveformTraceFile::trace(const sc_dt::sc_lv_base& object, const std::string& name)
+{
+  addTrace(&object, KIND_LV, name, object.length());
+}
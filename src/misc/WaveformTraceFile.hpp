@@ -0,0 +1,145 @@
+/**
+ * @file   WaveformTraceFile.hpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  SystemC trace file with selection of traces by name, a simulation time or
+ *         trigger ID window, and output to VCD or the compact binary waveform format.
+ *
+ *         It is used in place of the trace file from sc_create_vcd_trace_file(), so the
+ *         existing addTraces()/sc_trace() calls are used as they are. Traces whose names
+ *         do not match the include patterns (or match an exclude pattern) are dropped when
+ *         they are added, and cost nothing during the simulation.
+ */
+
+
+///@addtogroup misc
+///@{
+#ifndef WAVEFORM_TRACE_FILE_HPP
+#define WAVEFORM_TRACE_FILE_HPP
+
+// Ignore warnings about use of auto_ptr and unused parameters in SystemC library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#include <systemc.h>
+#pragma GCC diagnostic pop
+
+#include "common/WaveformFile.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+class WaveformTraceFile : public sc_core::sc_trace_file {
+public:
+  enum Format {FORMAT_VCD, FORMAT_WAVE};
+
+  struct Options {
+    Format format = FORMAT_VCD;
+
+    ///@brief Semicolon separated name patterns of traces to include/exclude,
+    ///       see Waveform::matchPattern()
+    std::string include = "*";
+    std::string exclude = "";
+
+    ///@brief Simulation time window in ns. Zero end time means no end.
+    uint64_t start_ns = 0;
+    uint64_t end_ns = 0;
+
+    ///@brief Trigger ID window. Tracing starts when the first trigger ID is sent, and
+    ///       stops when the trigger after the last trigger ID is sent. A negative first
+    ///       trigger ID disables the window, a negative last trigger ID means no end.
+    int64_t first_trigger_id = -1;
+    int64_t last_trigger_id = -1;
+  };
+
+private:
+  enum TraceKind {
+    KIND_BOOL, KIND_BIT, KIND_LOGIC,
+    KIND_UCHAR, KIND_USHORT, KIND_UINT, KIND_ULONG,
+    KIND_CHAR, KIND_SHORT, KIND_INT, KIND_LONG, KIND_INT64, KIND_UINT64,
+    KIND_FLOAT, KIND_DOUBLE,
+    KIND_INT_BASE, KIND_UINT_BASE, KIND_SIGNED, KIND_UNSIGNED,
+    KIND_BV, KIND_LV
+  };
+
+  struct Trace {
+    const void* object;
+    TraceKind kind;
+    uint64_t mask;
+    uint64_t value;
+  };
+
+  Options mOptions;
+  std::vector<std::string> mIncludePatterns;
+  std::vector<std::string> mExcludePatterns;
+
+  std::unique_ptr<WaveformOutput> mOutput;
+  std::vector<Waveform::Variable> mVariables;
+  std::vector<Trace> mTraces;
+
+  std::function<uint64_t()> mTriggerIdSource;
+
+  bool mHeaderWritten = false;
+  bool mInWindow = false;
+  uint64_t mStartTime;
+  uint64_t mEndTime;
+
+  void addTrace(const void* object, TraceKind kind, const std::string& name,
+                unsigned int width);
+  uint64_t readValue(const Trace& trace) const;
+  bool inWindow(void) const;
+
+protected:
+  void cycle(bool delta_cycle);
+
+public:
+  WaveformTraceFile(const std::string& filename_base, const Options& options);
+  ~WaveformTraceFile();
+  void setTriggerIdSource(std::function<uint64_t()> trigger_id_source);
+  void close(void);
+
+  unsigned int getNumTraces(void) const {return mTraces.size();}
+
+  void trace(const bool& object, const std::string& name);
+  void trace(const sc_dt::sc_bit& object, const std::string& name);
+  void trace(const sc_dt::sc_logic& object, const std::string& name);
+
+  void trace(const unsigned char& object, const std::string& name, int width);
+  void trace(const unsigned short& object, const std::string& name, int width);
+  void trace(const unsigned int& object, const std::string& name, int width);
+  void trace(const unsigned long& object, const std::string& name, int width);
+  void trace(const char& object, const std::string& name, int width);
+  void trace(const short& object, const std::string& name, int width);
+  void trace(const int& object, const std::string& name, int width);
+  void trace(const long& object, const std::string& name, int width);
+  void trace(const sc_dt::int64& object, const std::string& name, int width);
+  void trace(const sc_dt::uint64& object, const std::string& name, int width);
+
+  void trace(const float& object, const std::string& name);
+  void trace(const double& object, const std::string& name);
+  void trace(const sc_dt::sc_int_base& object, const std::string& name);
+  void trace(const sc_dt::sc_uint_base& object, const std::string& name);
+  void trace(const sc_dt::sc_signed& object, const std::string& name);
+  void trace(const sc_dt::sc_unsigned& object, const std::string& name);
+  void trace(const sc_dt::sc_bv_base& object, const std::string& name);
+  void trace(const sc_dt::sc_lv_base& object, const std::string& name);
+
+  // Fixed point types, enums, events and times are not supported, and are ignored
+  void trace(const sc_dt::sc_fxval&, const std::string&) {}
+  void trace(const sc_dt::sc_fxval_fast&, const std::string&) {}
+  void trace(const sc_dt::sc_fxnum&, const std::string&) {}
+  void trace(const sc_dt::sc_fxnum_fast&, const std::string&) {}
+  void trace(const unsigned int&, const std::string&, const char**) {}
+  void trace(const sc_core::sc_event&, const std::string&) {}
+  void trace(const sc_core::sc_time&, const std::string&) {}
+
+  void write_comment(const std::string&) {}
+  void set_time_unit(double, sc_core::sc_time_unit) {}
+};
+
+
+#endif
+///@}
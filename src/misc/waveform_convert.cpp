@@ -0,0 +1,69 @@
+/**
+ * @file   waveform_convert.cpp
+ * @author Simon Voigt Nesbo
+ * @date   October 19, 2026
+ * @brief  Converts a binary waveform file (alpide_sim_traces.awf, see WaveformFormat.hpp)
+ *         to a Value Change Dump (VCD) file.
+ */
+
+#include "common/WaveformFile.hpp"
+#include "version.hpp"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <iostream>
+#include <stdexcept>
+
+
+int main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("Alpide Waveform Converter");
+  QCoreApplication::setApplicationVersion(QString::number(VERSION_MAJOR) + "." +
+                                          QString::number(VERSION_MINOR));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("\nConvert a binary waveform file (.awf) to VCD");
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addPositionalArgument("waveform_file", "Binary waveform file (.awf)");
+  parser.addPositionalArgument("output_file", "VCD file to create");
+  parser.process(app);
+
+  const QStringList args = parser.positionalArguments();
+
+  if(args.size() != 2) {
+    parser.showHelp(-1);
+  }
+
+  std::string input_filename = args.at(0).toStdString();
+  std::string output_filename = args.at(1).toStdString();
+
+  try {
+    WaveformReader reader(input_filename);
+    VcdWriter writer(output_filename);
+
+    writer.writeHeader(reader.getVariables(), reader.getTimeUnitFs());
+
+    WaveformRecord record;
+    uint64_t num_changes = 0;
+
+    while(reader.readRecord(record)) {
+      if(record.type == WaveformRecord::TIME) {
+        writer.writeTime(record.time);
+      } else {
+        writer.writeValue(record.var_index, record.value);
+        num_changes++;
+      }
+    }
+
+    writer.close();
+
+    std::cout << "Converted " << reader.getVariables().size() << " signals with ";
+    std::cout << num_changes << " value changes to " << output_filename << std::endl;
+  } catch(const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
@@ -12,6 +12,7 @@
  *         4) Creates an event with some hits, and feeds it to the alpide
  *         5) Starts the SystemC simulation and lets it run for a little while
  *         6) Verifies that the parser has received the event and that the hits are the same
+ *         Run with --compact to test the chip in compact elaboration mode.
  */
 
 #include "Alpide/Alpide.hpp"
@@ -21,6 +22,7 @@
 #include <boost/random/uniform_int_distribution.hpp>
 #include <vector>
 #include <iostream>
+#include <string>
 
 
 int sc_main(int argc, char** argv)
@@ -53,6 +55,7 @@ int sc_main(int argc, char** argv)
   alpidecfg.data_long_en = enable_data_long;
   alpidecfg.chip_continuous_mode = continuous_mode;
   alpidecfg.matrix_readout_speed  = matrix_readout_speed;
+  alpidecfg.compact_elaboration = (argc > 1 && std::string(argv[1]) == "--compact");
   
   Alpide alpide(sc_core::sc_module_name("alpide"),64,128,alpidecfg, false, false, 0);
   AlpideDataParser parser(sc_core::sc_module_name("parser"), enable_data_long, 100000, false);
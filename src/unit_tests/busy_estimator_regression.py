@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""Regression test for the analytic busy estimator (alpide_busy_estimator).
+
+Runs short single chip simulations with alpide_dataflow_sim for a few event
+rates, in triggered and continuous mode, and compares the fraction of
+triggers that were read out completely (not busy violations or flushed
+incomplete) with the estimate. The estimator is only an approximation, so
+the tolerance is loose. The test is meant to catch the estimator drifting
+away from the chip model, not to validate the model in detail.
+
+Usage: busy_estimator_regression.py <alpide_dataflow_sim> <alpide_busy_estimator>
+
+Must be run from the top directory of the repository (uses config/settings.txt).
+"""
+
+import csv
+import glob
+import os
+import subprocess
+import sys
+import tempfile
+
+NUM_EVENTS = 2000
+TOLERANCE = 0.1
+
+# (system/chip mode, event rate in ns, strobe active length in ns)
+SCENARIOS = [("triggered", 10000, 100),
+             ("triggered", 2000, 100),
+             ("triggered", 500, 100),
+             ("continuous", 2000, 4900),
+             ("continuous", 500, 4900)]
+
+
+def common_args(mode, rate, strobe):
+    return ["-single",
+            "-sm", mode,
+            "-cm", mode,
+            "-r", str(rate),
+            "-sa", str(strobe),
+            "-si", "100"]
+
+
+def simulated_efficiency(sim, mode, rate, strobe, work_dir):
+    output_prefix = os.path.join(work_dir, "sim_{}_{}".format(mode, rate))
+    subprocess.run([sim] + common_args(mode, rate, strobe) +
+                   ["-n", str(NUM_EVENTS), "-o", output_prefix],
+                   check=True, stdout=subprocess.DEVNULL)
+
+    stats_file = glob.glob(os.path.join(output_prefix, "run_*", "Alpide_stats.csv"))[0]
+
+    with open(stats_file) as f:
+        reader = csv.reader(f, delimiter=";")
+        header = [col.strip() for col in next(reader)]
+        row = next(reader)
+
+    received = int(row[header.index("Received triggers")])
+    busy_violations = int(row[header.index("Busy violations")])
+    flushed = int(row[header.index("Flushed Incompletes")])
+
+    return 1.0 - float(busy_violations + flushed) / received
+
+
+def estimated_efficiency(estimator, mode, rate, strobe, work_dir):
+    output_file = os.path.join(work_dir, "estimate_{}_{}.csv".format(mode, rate))
+    subprocess.run([estimator] + common_args(mode, rate, strobe) + ["-f", output_file],
+                   check=True, stdout=subprocess.DEVNULL)
+
+    with open(output_file) as f:
+        row = next(csv.DictReader(f, delimiter=";"))
+
+    return float(row["trigger_efficiency"])
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__)
+        return 1
+
+    sim, estimator = sys.argv[1], sys.argv[2]
+    failed = False
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        for mode, rate, strobe in SCENARIOS:
+            sim_eff = simulated_efficiency(sim, mode, rate, strobe, work_dir)
+            est_eff = estimated_efficiency(estimator, mode, rate, strobe, work_dir)
+            ok = abs(sim_eff - est_eff) <= TOLERANCE
+
+            print("{:<10} rate {:>6} ns: simulated {:.3f}, estimated {:.3f} {}".format(
+                mode, rate, sim_eff, est_eff, "OK" if ok else "FAILED"))
+
+            failed = failed or not ok
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,118 @@
+#include "Estimator/BusyEstimator.hpp"
+#define BOOST_TEST_MODULE BusyEstimatorTest
+#include <boost/test/included/unit_test.hpp>
+#include <cmath>
+#include <stdexcept>
+
+
+BOOST_AUTO_TEST_CASE( busy_estimator_erlang_loss_test )
+{
+  BOOST_TEST_MESSAGE("M/G/1/1 blocking probability matches Erlang loss formula (insensitive to service distribution).");
+  double rate = 0.01;
+  std::vector<double> first_service(81, 0.0);
+  std::vector<double> service(51, 0.0);
+  first_service[80] = 1.0;
+  service[50] = 1.0;
+
+  std::vector<double> occupancy = BusyEstimator::solveMG1K(rate, first_service, service, 1);
+
+  BOOST_REQUIRE_EQUAL(occupancy.size(), 2);
+  BOOST_CHECK_CLOSE(occupancy[1], 0.8/1.8, 1E-6);
+  BOOST_CHECK_CLOSE(occupancy[0]+occupancy[1], 1.0, 1E-6);
+}
+
+
+BOOST_AUTO_TEST_CASE( busy_estimator_mm1k_test )
+{
+  BOOST_TEST_MESSAGE("M/G/1/K with (nearly) exponential service matches closed form M/M/1/K result.");
+  const unsigned int K = 3;
+  const double q = 0.01;
+  const double rate = 0.008;
+  std::vector<double> service(20000, 0.0);
+
+  // Geometric distribution with mean 1/q
+  for(unsigned int t = 1; t < service.size(); t++)
+    service[t] = q*std::pow(1-q, t-1);
+
+  std::vector<double> occupancy = BusyEstimator::solveMG1K(rate, service, service, K);
+
+  double rho = rate/q;
+  for(unsigned int j = 0; j <= K; j++) {
+    double expected = (1-rho)*std::pow(rho, j)/(1-std::pow(rho, K+1));
+    BOOST_CHECK_CLOSE(occupancy[j], expected, 2.0);
+  }
+
+  BOOST_CHECK_THROW(BusyEstimator::solveMG1K(rate, service, service, 0), std::runtime_error);
+}
+
+
+BOOST_AUTO_TEST_CASE( busy_estimator_periodic_test )
+{
+  BOOST_TEST_MESSAGE("Periodic strobes with deterministic readout time.");
+  std::vector<double> short_service(11, 0.0);
+  short_service[10] = 1.0;
+
+  PeriodicQueueResult result = BusyEstimator::solvePeriodic(100, 0, short_service, 3, false);
+  BOOST_CHECK_CLOSE(result.epoch_occupancy[0], 1.0, 1E-6);
+  BOOST_CHECK_SMALL(result.reject_prob, 1E-9);
+  BOOST_CHECK_CLOSE(result.time_occupancy[1], 0.1, 1E-6);
+
+  // Readout takes 2.5 strobe periods, so only 1 of 2.5 strobes can be accepted in the long run
+  std::vector<double> long_service(251, 0.0);
+  long_service[250] = 1.0;
+
+  result = BusyEstimator::solvePeriodic(100, 0, long_service, 3, false);
+  BOOST_CHECK_CLOSE(result.reject_prob, 0.6, 1.0);
+  BOOST_CHECK_SMALL(result.flush_prob, 1E-9);
+
+  // With flushing, the oldest frame is discarded instead and strobes are not rejected
+  result = BusyEstimator::solvePeriodic(100, 0, long_service, 3, true);
+  BOOST_CHECK_SMALL(result.reject_prob, 1E-9);
+  BOOST_CHECK(result.flush_prob > 0.5);
+}
+
+
+BOOST_AUTO_TEST_CASE( busy_estimator_config_test )
+{
+  BOOST_TEST_MESSAGE("Efficiency decreases with event rate, and invalid configurations are rejected.");
+  BusyEstimatorConfig config;
+  config.chip_cfg.dtu_delay_cycles = 10;
+  config.chip_cfg.strobe_length_ns = 100;
+  config.chip_cfg.min_busy_cycles = 8;
+  config.chip_cfg.strobe_extension = false;
+  config.chip_cfg.data_long_en = true;
+  config.chip_cfg.chip_continuous_mode = false;
+  config.chip_cfg.matrix_readout_speed = true;
+  config.system_continuous_mode = false;
+  config.system_continuous_period_ns = 10000;
+  config.trigger_filter_enable = false;
+  config.trigger_filter_time_ns = 0;
+  config.pixel_shaping_active_time_ns = 5000;
+  config.hits_per_event = 18.6*4.5;
+  config.cluster_size = 4;
+  config.chips_per_link = 1;
+  config.link_bytes_per_cycle = 3;
+
+  double prev_efficiency = 1.0;
+
+  for(unsigned int rate_ns = 10000; rate_ns > 0; rate_ns -= 2500) {
+    config.average_event_rate_ns = rate_ns;
+    BusyEstimate est = BusyEstimator(config).estimate();
+
+    double occupancy_sum = 0.0;
+    for(auto it = est.meb_occupancy.begin(); it != est.meb_occupancy.end(); it++)
+      occupancy_sum += *it;
+
+    BOOST_CHECK_CLOSE(occupancy_sum, 1.0, 1E-6);
+    BOOST_CHECK(est.trigger_efficiency <= prev_efficiency);
+    BOOST_CHECK(est.trigger_efficiency >= 0.0);
+    prev_efficiency = est.trigger_efficiency;
+  }
+
+  config.average_event_rate_ns = 0;
+  BOOST_CHECK_THROW(BusyEstimator estimator(config), std::runtime_error);
+
+  config.average_event_rate_ns = 1000;
+  config.cluster_size = 0;
+  BOOST_CHECK_THROW(BusyEstimator estimator(config), std::runtime_error);
+}
@@ -0,0 +1,81 @@
+#include "Detector/Common/ChipIndex.hpp"
+#define BOOST_TEST_MODULE ChipIndexTest
+#include <boost/test/included/unit_test.hpp>
+#include <memory>
+#include <vector>
+
+
+struct TestHit {
+  unsigned int mChipId;
+  unsigned int mIndex;
+
+  TestHit(unsigned int chip_id, unsigned int index) : mChipId(chip_id), mIndex(index) {}
+  unsigned int getChipId(void) const {return mChipId;}
+};
+
+typedef std::vector<std::shared_ptr<TestHit>> TestHitVector;
+
+
+///@brief Records the hits and the number of calls, like PixelFrontEnd::pixelFrontEndInput()
+struct TestChip {
+  std::vector<unsigned int> mHitIndexes;
+  unsigned int mCalls = 0;
+
+  void pixelFrontEndInput(TestHitVector::const_iterator begin, TestHitVector::const_iterator end) {
+    for(auto it = begin; it != end; it++)
+      mHitIndexes.push_back((*it)->mIndex);
+    mCalls++;
+  }
+};
+
+
+BOOST_AUTO_TEST_CASE( chip_index_lookup_test )
+{
+  BOOST_TEST_MESSAGE("Only chips that were added are found, also for ids beyond the end of the index.");
+  Detector::ChipIndex<TestChip> index;
+  TestChip chip_a, chip_b;
+
+  index.add(0, &chip_a);
+  index.add(24119, &chip_b);
+
+  BOOST_CHECK(index.get(0) == &chip_a);
+  BOOST_CHECK(index.get(24119) == &chip_b);
+  BOOST_CHECK(index.contains(1) == false);
+  BOOST_CHECK(index.contains(64) == false);
+  BOOST_CHECK(index.get(24118) == nullptr);
+  BOOST_CHECK(index.get(24120) == nullptr);
+  BOOST_CHECK(index.get(1000000) == nullptr);
+}
+
+
+BOOST_AUTO_TEST_CASE( chip_index_pixel_input_test )
+{
+  BOOST_TEST_MESSAGE("Each range of hits for a chip is passed in one call, in order, and hits for missing chips are counted.");
+  Detector::ChipIndex<TestChip> index;
+  TestChip chips[3];
+
+  index.add(5, &chips[0]);
+  index.add(70, &chips[1]);
+  index.add(71, &chips[2]);
+
+  TestHitVector hits;
+  const unsigned int chip_ids[] = {5, 5, 5, 6, 6, 70, 71, 71, 5};
+
+  for(unsigned int i = 0; i < sizeof(chip_ids)/sizeof(chip_ids[0]); i++)
+    hits.push_back(std::make_shared<TestHit>(chip_ids[i], i));
+
+  unsigned int skipped_hits = index.pixelInput(hits.cbegin(), hits.cend());
+
+  BOOST_CHECK_EQUAL(skipped_hits, 2);
+
+  BOOST_CHECK_EQUAL(chips[0].mCalls, 2);
+  BOOST_CHECK(chips[0].mHitIndexes == std::vector<unsigned int>({0, 1, 2, 8}));
+
+  BOOST_CHECK_EQUAL(chips[1].mCalls, 1);
+  BOOST_CHECK(chips[1].mHitIndexes == std::vector<unsigned int>({5}));
+
+  BOOST_CHECK_EQUAL(chips[2].mCalls, 1);
+  BOOST_CHECK(chips[2].mHitIndexes == std::vector<unsigned int>({6, 7}));
+
+  BOOST_CHECK_EQUAL(index.pixelInput(hits.cend(), hits.cend()), 0);
+}
@@ -0,0 +1,109 @@
+#include "common/ClockedFifo.hpp"
+#define BOOST_TEST_MODULE ClockedFifoTest
+#include <boost/test/included/unit_test.hpp>
+
+
+BOOST_AUTO_TEST_CASE( clocked_fifo_timing_test )
+{
+  BOOST_TEST_MESSAGE("Values put in a cycle can only be read after update().");
+  ClockedFifo<int> fifo(4);
+  int value = -1;
+
+  BOOST_CHECK_EQUAL(fifo.used(), 0);
+  BOOST_CHECK(fifo.get(value) == false);
+
+  BOOST_CHECK(fifo.put(1));
+  BOOST_CHECK(fifo.put(2));
+  BOOST_CHECK_EQUAL(fifo.used(), 0);
+  BOOST_CHECK(fifo.peek(value) == false);
+  BOOST_CHECK(fifo.get(value) == false);
+
+  fifo.update();
+  BOOST_CHECK_EQUAL(fifo.used(), 2);
+  BOOST_REQUIRE(fifo.peek(value));
+  BOOST_CHECK_EQUAL(value, 1);
+
+  // A value put in the same cycle as a get is not readable in that cycle
+  BOOST_REQUIRE(fifo.get(value));
+  BOOST_CHECK_EQUAL(value, 1);
+  BOOST_CHECK(fifo.put(3));
+  BOOST_REQUIRE(fifo.get(value));
+  BOOST_CHECK_EQUAL(value, 2);
+  BOOST_CHECK(fifo.get(value) == false);
+
+  fifo.update();
+  BOOST_CHECK_EQUAL(fifo.used(), 1);
+  BOOST_REQUIRE(fifo.get(value));
+  BOOST_CHECK_EQUAL(value, 3);
+}
+
+
+BOOST_AUTO_TEST_CASE( clocked_fifo_full_test )
+{
+  BOOST_TEST_MESSAGE("Space freed by get() can only be used after update().");
+  ClockedFifo<int> fifo(3);
+  int value = -1;
+
+  for(int i = 0; i < 3; i++)
+    BOOST_CHECK(fifo.put(i));
+
+  BOOST_CHECK(fifo.canPut() == false);
+  BOOST_CHECK(fifo.put(3) == false);
+
+  fifo.update();
+  BOOST_REQUIRE(fifo.get(value));
+  BOOST_CHECK_EQUAL(value, 0);
+  BOOST_CHECK(fifo.canPut() == false);
+
+  fifo.update();
+  BOOST_CHECK(fifo.canPut());
+  BOOST_CHECK(fifo.put(3));
+  BOOST_CHECK(fifo.canPut() == false);
+
+  // Wrap around the end of the ring buffer a few times
+  for(int i = 4; i < 20; i++) {
+    fifo.update();
+    BOOST_REQUIRE(fifo.get(value));
+    BOOST_CHECK_EQUAL(value, i-3);
+    fifo.update();
+    BOOST_REQUIRE(fifo.put(i));
+  }
+
+  BOOST_CHECK_EQUAL(fifo.allocated(), 3);
+}
+
+
+BOOST_AUTO_TEST_CASE( clocked_fifo_growth_test )
+{
+  BOOST_TEST_MESSAGE("Storage only grows to the number of values held, and keeps the order.");
+  ClockedFifo<int> fifo(128);
+  int value = -1;
+
+  BOOST_CHECK_EQUAL(fifo.capacity(), 128);
+  BOOST_CHECK_EQUAL(fifo.allocated(), 0);
+
+  // Keep at most 2 values in the FIFO, with the head moving around the buffer
+  for(int i = 0; i < 100; i++) {
+    BOOST_REQUIRE(fifo.put(i));
+    fifo.update();
+    if(i > 0) {
+      BOOST_REQUIRE(fifo.get(value));
+      BOOST_CHECK_EQUAL(value, i-1);
+    }
+  }
+
+  BOOST_CHECK_EQUAL(fifo.allocated(), 4);
+
+  // Grow while the head is not at the start of the buffer
+  for(int i = 100; i < 110; i++)
+    BOOST_REQUIRE(fifo.put(i));
+
+  fifo.update();
+  BOOST_CHECK_EQUAL(fifo.used(), 11);
+  BOOST_CHECK_EQUAL(fifo.allocated(), 16);
+
+  for(int i = 99; i < 110; i++) {
+    BOOST_REQUIRE(fifo.get(value));
+    BOOST_CHECK_EQUAL(value, i);
+  }
+}
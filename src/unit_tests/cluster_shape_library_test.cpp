@@ -0,0 +1,99 @@
+#include "Event/ClusterShapeLibrary.hpp"
+#define BOOST_TEST_MODULE ClusterShapeLibraryTest
+#include <boost/test/included/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+
+BOOST_AUTO_TEST_CASE( alias_table_test )
+{
+  BOOST_TEST_MESSAGE("Values are drawn from the alias table with the given frequencies.");
+  std::vector<double> weights = {1, 0, 3, 6};
+  AliasTable table(weights);
+  boost::random::mt19937 rand_gen(1337);
+
+  const unsigned int n = 1000000;
+  std::vector<unsigned int> counts(weights.size(), 0);
+
+  for(unsigned int i = 0; i < n; i++)
+    counts[table(rand_gen)]++;
+
+  BOOST_CHECK_EQUAL(counts[1], 0);
+  BOOST_CHECK_CLOSE(double(counts[0])/n, 0.1, 2.0);
+  BOOST_CHECK_CLOSE(double(counts[2])/n, 0.3, 2.0);
+  BOOST_CHECK_CLOSE(double(counts[3])/n, 0.6, 2.0);
+
+  BOOST_CHECK_THROW(AliasTable(std::vector<double>{0, 0}), std::runtime_error);
+}
+
+
+BOOST_AUTO_TEST_CASE( cluster_shape_library_sampled_test )
+{
+  BOOST_TEST_MESSAGE("Sampled shapes start with the hit pixel, have no duplicate pixels, and the expected mean size.");
+  ClusterShapeLibrary library(4, 1, 100000, 1337);
+
+  BOOST_REQUIRE(library.getNumShapes() > 1);
+
+  double total_frequency = 0;
+  double total_pixels = 0;
+  bool valid = true;
+
+  for(unsigned int shape = 0; shape < library.getNumShapes(); shape++) {
+    const ClusterPixelOffset* begin = library.getShapeBegin(shape);
+    const ClusterPixelOffset* end = library.getShapeEnd(shape);
+
+    valid = valid && begin != end && begin->col == 0 && begin->row == 0;
+    for(const ClusterPixelOffset* a = begin; a != end; a++)
+      for(const ClusterPixelOffset* b = a+1; b != end; b++)
+        valid = valid && !(*a == *b);
+
+    total_frequency += library.getShapeFrequency(shape);
+    total_pixels += library.getShapeFrequency(shape) * (end - begin);
+  }
+
+  BOOST_CHECK(valid);
+  BOOST_CHECK_EQUAL(total_frequency, 100000);
+  BOOST_CHECK_CLOSE(total_pixels / total_frequency, 4.0, 2.0);
+}
+
+
+BOOST_AUTO_TEST_CASE( cluster_shape_library_file_test )
+{
+  BOOST_TEST_MESSAGE("Shapes are loaded from file with offsets relative to the hit pixel.");
+  const char* filename = "cluster_shape_library_test.txt";
+
+  {
+    std::ofstream out(filename);
+    out << "# Test shapes\n";
+    out << "3\n";
+    out << ".X.\n";
+    out << "XOX\n";
+    out << "\n";
+    out << "1\n";
+    out << "O\n";
+  }
+
+  ClusterShapeLibrary library{std::string(filename)};
+
+  BOOST_REQUIRE_EQUAL(library.getNumShapes(), 2);
+  BOOST_CHECK_EQUAL(library.getShapeFrequency(0), 3);
+  BOOST_CHECK_EQUAL(library.getShapeFrequency(1), 1);
+
+  std::vector<ClusterPixelOffset> expected = {{0, 0}, {0, -1}, {-1, 0}, {1, 0}};
+  std::vector<ClusterPixelOffset> shape(library.getShapeBegin(0), library.getShapeEnd(0));
+  BOOST_CHECK(shape == expected);
+  BOOST_CHECK_EQUAL(library.getShapeEnd(1) - library.getShapeBegin(1), 1);
+
+  {
+    std::ofstream out(filename);
+    out << "2\n";
+    out << "XX\n";
+  }
+
+  BOOST_CHECK_THROW(ClusterShapeLibrary{std::string(filename)}, std::runtime_error);
+
+  std::remove(filename);
+}
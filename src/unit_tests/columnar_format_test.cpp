@@ -0,0 +1,148 @@
+#include "common/ColumnarWriter.hpp"
+#include "common/ColumnarReader.hpp"
+#include "common/StatsWriter.hpp"
+#define BOOST_TEST_MODULE ColumnarFormatTest
+#include <boost/test/included/unit_test.hpp>
+#include <cstdio>
+#include <limits>
+#include <stdexcept>
+
+
+static const char* test_filename = "columnar_format_test.acol";
+
+
+///@brief Write two tables with a few chunks each, and values that exercise the encoding
+static void write_test_file(const std::string& filename, uint64_t num_rows)
+{
+  ColumnarWriter writer(filename, 100);
+
+  ColumnarTable& values = writer.addTable("values", {{"counter", Columnar::COLUMN_UINT64},
+                                                     {"signed", Columnar::COLUMN_INT64},
+                                                     {"ratio", Columnar::COLUMN_DOUBLE}});
+  ColumnarTable& limits = writer.addTable("RU_0_0/limits", {{"u", Columnar::COLUMN_UINT64},
+                                                            {"i", Columnar::COLUMN_INT64}});
+  writer.addTable("empty", {{"x", Columnar::COLUMN_UINT64}});
+
+  for(uint64_t row = 0; row < num_rows; row++) {
+    values.append(0, uint64_t(1000 + 3*row));
+    values.append(1, int64_t(row % 2 ? -int64_t(row) : int64_t(row)));
+    values.append(2, row / 7.0);
+    values.endRow();
+  }
+
+  limits.append(0, uint64_t(0));
+  limits.append(1, std::numeric_limits<int64_t>::min());
+  limits.endRow();
+  limits.append(0, std::numeric_limits<uint64_t>::max());
+  limits.append(1, std::numeric_limits<int64_t>::max());
+  limits.endRow();
+  limits.append(0, uint64_t(0));
+  limits.append(1, int64_t(-1));
+  limits.endRow();
+
+  writer.close();
+}
+
+
+static void check_test_file(const std::string& filename, uint64_t num_rows)
+{
+  ColumnarReader reader(filename);
+
+  BOOST_REQUIRE_EQUAL(reader.getTableNames().size(), 3);
+  BOOST_CHECK(reader.hasTable("RU_0_0/limits"));
+  BOOST_CHECK_EQUAL(reader.getNumRows("values"), num_rows);
+  BOOST_CHECK_EQUAL(reader.getNumRows("empty"), 0);
+  BOOST_CHECK_EQUAL(reader.getUInt64Column("empty", "x").size(), 0);
+
+  std::vector<uint64_t> counter = reader.getUInt64Column("values", "counter");
+  std::vector<int64_t> signed_values = reader.getInt64Column("values", "signed");
+  std::vector<double> ratio = reader.getDoubleColumn("values", "ratio");
+
+  BOOST_REQUIRE_EQUAL(counter.size(), num_rows);
+  BOOST_REQUIRE_EQUAL(signed_values.size(), num_rows);
+  BOOST_REQUIRE_EQUAL(ratio.size(), num_rows);
+
+  for(uint64_t row = 0; row < num_rows; row++) {
+    BOOST_REQUIRE_EQUAL(counter[row], 1000 + 3*row);
+    BOOST_REQUIRE_EQUAL(signed_values[row], row % 2 ? -int64_t(row) : int64_t(row));
+    BOOST_REQUIRE_EQUAL(ratio[row], row / 7.0);
+  }
+
+  std::vector<uint64_t> u = reader.getUInt64Column("RU_0_0/limits", "u");
+  std::vector<int64_t> i = reader.getInt64Column("RU_0_0/limits", "i");
+
+  BOOST_REQUIRE_EQUAL(u.size(), 3);
+  BOOST_CHECK_EQUAL(u[0], 0);
+  BOOST_CHECK_EQUAL(u[1], std::numeric_limits<uint64_t>::max());
+  BOOST_CHECK_EQUAL(u[2], 0);
+  BOOST_CHECK_EQUAL(i[0], std::numeric_limits<int64_t>::min());
+  BOOST_CHECK_EQUAL(i[1], std::numeric_limits<int64_t>::max());
+  BOOST_CHECK_EQUAL(i[2], -1);
+
+  BOOST_CHECK_THROW(reader.getDoubleColumn("values", "counter"), std::runtime_error);
+  BOOST_CHECK_THROW(reader.getUInt64Column("values", "missing"), std::runtime_error);
+  BOOST_CHECK_THROW(reader.getUInt64Column("missing", "x"), std::runtime_error);
+}
+
+
+BOOST_AUTO_TEST_CASE( columnar_format_roundtrip_test )
+{
+  BOOST_TEST_MESSAGE("Values read back are identical across chunk boundaries and for edge values.");
+  const uint64_t num_rows = 1234;
+
+  write_test_file(test_filename, num_rows);
+  check_test_file(test_filename, num_rows);
+
+  // Slowly increasing counters take one byte per value
+  ColumnarWriter writer(test_filename);
+  ColumnarTable& table = writer.addTable("time", {{"time_ns", Columnar::COLUMN_UINT64}});
+  for(uint64_t row = 0; row < 10000; row++) {
+    table.append(0, uint64_t(100000 + 25*row));
+    table.endRow();
+  }
+  writer.close();
+
+  std::ifstream file(test_filename, std::ios_base::binary | std::ios_base::ate);
+  BOOST_CHECK(file.tellg() < 10000 + 100);
+
+  std::remove(test_filename);
+}
+
+
+BOOST_AUTO_TEST_CASE( columnar_format_stats_writer_test )
+{
+  BOOST_TEST_MESSAGE("Files written with the StatsWriter thread are identical to files written directly.");
+  const uint64_t num_rows = 5000;
+
+  StatsWriter::start(4);
+  write_test_file(test_filename, num_rows);
+  StatsWriter::stop();
+
+  check_test_file(test_filename, num_rows);
+  std::remove(test_filename);
+}
+
+
+BOOST_AUTO_TEST_CASE( columnar_format_error_test )
+{
+  BOOST_TEST_MESSAGE("Incomplete rows, wrong types and invalid files are rejected.");
+  {
+    ColumnarWriter writer(test_filename);
+    ColumnarTable& table = writer.addTable("t", {{"a", Columnar::COLUMN_UINT64},
+                                                 {"b", Columnar::COLUMN_DOUBLE}});
+
+    BOOST_CHECK_THROW(table.append(1, uint64_t(1)), std::runtime_error);
+    BOOST_CHECK_THROW(table.append(2, 1.0), std::runtime_error);
+
+    table.append(0, uint64_t(1));
+    BOOST_CHECK_THROW(table.endRow(), std::runtime_error);
+  }
+
+  {
+    std::ofstream file(test_filename);
+    file << "not a columnar file";
+  }
+  BOOST_CHECK_THROW(ColumnarReader reader(test_filename), std::runtime_error);
+
+  std::remove(test_filename);
+}
@@ -0,0 +1,82 @@
+#include "Stimuli/ConvergenceMonitor.hpp"
+#define BOOST_TEST_MODULE ConvergenceMonitorTest
+#include <boost/test/included/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/bernoulli_distribution.hpp>
+#include <stdexcept>
+
+
+BOOST_AUTO_TEST_CASE( convergence_monitor_constant_metric_test )
+{
+  BOOST_TEST_MESSAGE("Metric with constant batch values converges after minimum number of batches.");
+  ConvergenceMonitor monitor(0.01, 5);
+  monitor.addMetric("constant");
+
+  std::vector<double> num(1), den(1);
+
+  for(unsigned int batch = 1; batch < 5; batch++) {
+    num[0] = batch * 10.0;
+    den[0] = batch * 100.0;
+    monitor.addBatch(num, den);
+    BOOST_CHECK(monitor.getConverged() == false);
+  }
+
+  num[0] = 50.0;
+  den[0] = 500.0;
+  monitor.addBatch(num, den);
+  BOOST_CHECK(monitor.getConverged() == true);
+  BOOST_CHECK_CLOSE(monitor.getMean(0), 0.1, 1E-9);
+  BOOST_CHECK_EQUAL(monitor.getRelativeWidth(0), 0.0);
+}
+
+
+BOOST_AUTO_TEST_CASE( convergence_monitor_noisy_metric_test )
+{
+  BOOST_TEST_MESSAGE("Noisy metric converges, and the estimate is close to the true value.");
+  ConvergenceMonitor monitor(0.05, 10);
+  monitor.addMetric("noisy");
+
+  boost::random::mt19937 rand_gen(1337);
+  boost::random::bernoulli_distribution<double> hit_dist(0.3);
+
+  std::vector<double> num(1, 0.0), den(1, 0.0);
+  unsigned int batches = 0;
+
+  while(monitor.getConverged() == false && batches < 10000) {
+    for(unsigned int i = 0; i < 100; i++) {
+      num[0] += hit_dist(rand_gen) ? 1 : 0;
+      den[0] += 1;
+    }
+    monitor.addBatch(num, den);
+    batches++;
+  }
+
+  BOOST_CHECK(monitor.getConverged() == true);
+  BOOST_CHECK(batches > 10);
+  BOOST_CHECK(monitor.getRelativeWidth(0) <= 0.05);
+  BOOST_CHECK_CLOSE(monitor.getMean(0), 0.3, 5.0);
+}
+
+
+BOOST_AUTO_TEST_CASE( convergence_monitor_multiple_metrics_test )
+{
+  BOOST_TEST_MESSAGE("Batches with no new denominator are skipped, and all metrics must converge.");
+  ConvergenceMonitor monitor(0.01, 3);
+  monitor.addMetric("converges");
+  monitor.addMetric("no_data");
+
+  std::vector<double> num(2, 0.0), den(2, 0.0);
+
+  for(unsigned int batch = 1; batch <= 10; batch++) {
+    num[0] = batch;
+    den[0] = batch * 2.0;
+    monitor.addBatch(num, den);
+  }
+
+  BOOST_CHECK_EQUAL(monitor.getBatchCount(), 10);
+  BOOST_CHECK(monitor.getConverged() == false);
+
+  BOOST_CHECK_THROW(monitor.addBatch(std::vector<double>(1), std::vector<double>(1)), std::runtime_error);
+  BOOST_CHECK_THROW(ConvergenceMonitor(0.0, 3), std::runtime_error);
+  BOOST_CHECK_THROW(ConvergenceMonitor(0.1, 1), std::runtime_error);
+}
@@ -0,0 +1,99 @@
+#include "Event/EventLog.hpp"
+#define BOOST_TEST_MODULE EventLogTest
+#include <boost/test/included/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+
+static const char* test_filename = "event_log_test.evl";
+
+
+BOOST_AUTO_TEST_CASE( event_log_roundtrip_test )
+{
+  BOOST_TEST_MESSAGE("Event records read back from the log are identical to the records written.");
+  const unsigned int num_events = 300;
+  const std::vector<unsigned int> layer_ids = {0, 1, 2, 5};
+  std::vector<unsigned int> chip_ids;
+
+  for(unsigned int i = 0; i < 500; i++)
+    chip_ids.push_back(i*7);
+
+  {
+    EventLogWriter writer(test_filename, layer_ids, chip_ids);
+
+    for(unsigned int event = 0; event < num_events; event++) {
+      std::vector<unsigned int> layer_counts = {event, event*1000, 0, 100000+event};
+      std::vector<EventLog::ChipCount> chip_counts;
+
+      // Every 10th event has no chips with hits
+      for(unsigned int column = event % 13; event % 10 != 0 && column < chip_ids.size(); column += 1+event)
+        chip_counts.push_back(EventLog::ChipCount{column, event+column});
+
+      writer.writeEvent(uint64_t(event)*1000000007ULL, event*3, layer_counts, chip_counts);
+    }
+
+    writer.close();
+  }
+
+  EventLogReader reader(test_filename);
+  EventLogRecord record;
+
+  BOOST_CHECK(reader.getLayerIds() == layer_ids);
+  BOOST_CHECK(reader.getChipIds() == chip_ids);
+
+  for(unsigned int event = 0; event < num_events; event++) {
+    BOOST_REQUIRE(reader.readEvent(record));
+    BOOST_CHECK_EQUAL(record.t_delta, uint64_t(event)*1000000007ULL);
+    BOOST_CHECK_EQUAL(record.hit_count, event*3);
+    BOOST_REQUIRE_EQUAL(record.layer_counts.size(), 4);
+    BOOST_CHECK_EQUAL(record.layer_counts[1], event*1000);
+    BOOST_CHECK_EQUAL(record.layer_counts[3], 100000+event);
+
+    std::size_t i = 0;
+    for(unsigned int column = event % 13; event % 10 != 0 && column < chip_ids.size(); column += 1+event, i++) {
+      BOOST_REQUIRE(i < record.chip_counts.size());
+      BOOST_CHECK_EQUAL(record.chip_counts[i].column, column);
+      BOOST_CHECK_EQUAL(record.chip_counts[i].count, event+column);
+    }
+    BOOST_CHECK_EQUAL(record.chip_counts.size(), i);
+  }
+
+  BOOST_CHECK(reader.readEvent(record) == false);
+
+  std::remove(test_filename);
+}
+
+
+BOOST_AUTO_TEST_CASE( event_log_invalid_file_test )
+{
+  BOOST_TEST_MESSAGE("Truncated event logs and files with wrong magic are rejected.");
+
+  {
+    EventLogWriter writer(test_filename, {0}, {0, 1, 2});
+    writer.writeEvent(100000, 50, {50}, {EventLog::ChipCount{1, 30}, EventLog::ChipCount{2, 20}});
+  }
+
+  // Remove the last byte, which is part of the last record
+  std::ifstream in(test_filename, std::ios_base::binary);
+  std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+
+  {
+    std::ofstream out(test_filename, std::ios_base::binary | std::ios_base::trunc);
+    out << data.substr(0, data.size()-1);
+  }
+
+  EventLogReader reader(test_filename);
+  EventLogRecord record;
+  BOOST_CHECK_THROW(reader.readEvent(record), std::runtime_error);
+
+  {
+    std::ofstream out(test_filename, std::ios_base::binary | std::ios_base::trunc);
+    out << "NOTALOG!" << data.substr(8);
+  }
+
+  BOOST_CHECK_THROW(EventLogReader reader2(test_filename), std::runtime_error);
+
+  std::remove(test_filename);
+}
@@ -0,0 +1,149 @@
+#include "Event/EventStore.hpp"
+#define BOOST_TEST_MODULE EventStoreTest
+#include <boost/test/included/unit_test.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+
+static const char* test_filename = "event_store_test.evs";
+
+
+BOOST_AUTO_TEST_CASE( event_store_roundtrip_test )
+{
+  BOOST_TEST_MESSAGE("Events read back from the mapped store have the same digits, sorted by chip.");
+  const unsigned int num_events = 50;
+
+  {
+    EventStoreWriter writer(test_filename);
+
+    for(unsigned int event = 0; event < num_events; event++) {
+      std::vector<uint64_t> digits;
+
+      // Every 10th event is empty, digits are added with chip ids in descending order
+      for(unsigned int i = 0; event % 10 != 0 && i < event*3; i++)
+        digits.push_back(EventStore::packDigit(i % 1024, (event+i) % 512, 24119 - i % 7));
+
+      writer.addEvent(digits);
+    }
+
+    BOOST_CHECK_EQUAL(writer.getNumEvents(), num_events);
+  }
+
+  EventStoreFile store(test_filename);
+
+  BOOST_REQUIRE_EQUAL(store.getNumEvents(), num_events);
+
+  for(unsigned int event = 0; event < num_events; event++) {
+    uint64_t num_digits = event % 10 != 0 ? event*3 : 0;
+    BOOST_REQUIRE_EQUAL(store.getNumDigits(event), num_digits);
+
+    const uint64_t* digits = store.getDigits(event);
+    std::vector<unsigned int> chip_count(7, 0);
+
+    for(uint64_t i = 0; i < num_digits; i++) {
+      unsigned int chip_id = EventStore::getDigitChipId(digits[i]);
+
+      BOOST_REQUIRE(chip_id > 24119-7 && chip_id <= 24119);
+      BOOST_REQUIRE(EventStore::getDigitCol(digits[i]) < 1024);
+      BOOST_REQUIRE(EventStore::getDigitRow(digits[i]) < 512);
+      if(i > 0)
+        BOOST_REQUIRE(chip_id >= EventStore::getDigitChipId(digits[i-1]));
+
+      chip_count[24119 - chip_id]++;
+    }
+
+    for(unsigned int chip = 0; chip < 7; chip++)
+      BOOST_CHECK_EQUAL(chip_count[chip], num_digits/7 + (chip < num_digits % 7 ? 1 : 0));
+  }
+
+  std::remove(test_filename);
+}
+
+
+BOOST_AUTO_TEST_CASE( event_store_digit_packing_test )
+{
+  BOOST_TEST_MESSAGE("Packed digits keep column, row and chip id, and sort by chip id first.");
+  uint64_t digit = EventStore::packDigit(1023, 511, 24119);
+
+  BOOST_CHECK_EQUAL(EventStore::getDigitCol(digit), 1023);
+  BOOST_CHECK_EQUAL(EventStore::getDigitRow(digit), 511);
+  BOOST_CHECK_EQUAL(EventStore::getDigitChipId(digit), 24119);
+
+  BOOST_CHECK(EventStore::packDigit(1023, 511, 5) < EventStore::packDigit(0, 0, 6));
+  BOOST_CHECK(EventStore::packDigit(1023, 10, 5) < EventStore::packDigit(0, 11, 5));
+}
+
+
+BOOST_AUTO_TEST_CASE( event_store_error_test )
+{
+  BOOST_TEST_MESSAGE("Invalid and truncated files are rejected.");
+  {
+    std::ofstream file(test_filename);
+    file << "not an event store file";
+  }
+  BOOST_CHECK_THROW(EventStoreFile store(test_filename), std::runtime_error);
+
+  {
+    EventStoreWriter writer(test_filename);
+    writer.addEvent({EventStore::packDigit(1, 2, 3), EventStore::packDigit(4, 5, 6)});
+  }
+  BOOST_CHECK_NO_THROW(EventStoreFile store(test_filename));
+
+  // Remove the last entry in the event index
+  {
+    std::ifstream file(test_filename, std::ios_base::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    data.resize(data.size() - sizeof(uint64_t));
+    std::ofstream truncated(test_filename, std::ios_base::binary | std::ios_base::trunc);
+    truncated.write(data.data(), data.size());
+  }
+  BOOST_CHECK_THROW(EventStoreFile store(test_filename), std::runtime_error);
+
+  BOOST_CHECK_THROW(EventStoreFile store("does_not_exist.evs"), std::runtime_error);
+
+  std::remove(test_filename);
+}
+
+
+BOOST_AUTO_TEST_CASE( event_store_focal_test )
+{
+  BOOST_TEST_MESSAGE("Focal macro cells are kept in order, and the store types can not be mixed up.");
+  const std::vector<uint64_t> cells = {EventStore::packMacroCell(3200, 17, 5, 1),
+                                       EventStore::packMacroCell(1600, 1600, 1, 0),
+                                       EventStore::packMacroCell(0, 3200, EventStore::MACRO_CELL_MAX_HITS, 1)};
+
+  {
+    EventStoreWriter writer(test_filename, EventStore::STORE_FOCAL_MACRO_CELLS);
+    writer.addEvent(cells);
+    writer.addEvent({});
+  }
+
+  BOOST_CHECK_THROW(EventStoreFile store(test_filename), std::runtime_error);
+
+  EventStoreFile store(test_filename, EventStore::STORE_FOCAL_MACRO_CELLS);
+
+  BOOST_REQUIRE_EQUAL(store.getNumEvents(), 2);
+  BOOST_REQUIRE_EQUAL(store.getNumDigits(0), cells.size());
+  BOOST_CHECK_EQUAL(store.getNumDigits(1), 0);
+  BOOST_CHECK(std::equal(cells.begin(), cells.end(), store.getDigits(0)));
+
+  BOOST_CHECK_EQUAL(EventStore::getMacroCellCol(cells[0]), 3200);
+  BOOST_CHECK_EQUAL(EventStore::getMacroCellRow(cells[0]), 17);
+  BOOST_CHECK_EQUAL(EventStore::getMacroCellHits(cells[0]), 5);
+  BOOST_CHECK_EQUAL(EventStore::getMacroCellLayer(cells[0]), 1);
+  BOOST_CHECK_EQUAL(EventStore::getMacroCellHits(cells[2]), EventStore::MACRO_CELL_MAX_HITS);
+  BOOST_CHECK_EQUAL(EventStore::getMacroCellLayer(cells[1]), 0);
+
+  std::remove(test_filename);
+
+  {
+    EventStoreWriter writer(test_filename);
+    writer.addEvent({EventStore::packDigit(1, 2, 3)});
+  }
+  BOOST_CHECK_THROW(EventStoreFile store(test_filename, EventStore::STORE_FOCAL_MACRO_CELLS),
+                    std::runtime_error);
+
+  std::remove(test_filename);
+}
@@ -0,0 +1,60 @@
+#include "common/FastRandom.hpp"
+#define BOOST_TEST_MODULE FastRandomTest
+#include <boost/test/included/unit_test.hpp>
+#include <vector>
+
+
+BOOST_AUTO_TEST_CASE( fast_random_seed_test )
+{
+  BOOST_TEST_MESSAGE("Same seed gives the same sequence, different seeds give different sequences.");
+  FastRandom gen_a(1337);
+  FastRandom gen_b(1337);
+  FastRandom gen_c(1338);
+
+  bool all_equal = true;
+  bool all_equal_c = true;
+
+  for(int i = 0; i < 1000; i++) {
+    uint64_t a = gen_a();
+    all_equal = all_equal && a == gen_b();
+    all_equal_c = all_equal_c && a == gen_c();
+  }
+
+  BOOST_CHECK(all_equal);
+  BOOST_CHECK(!all_equal_c);
+}
+
+
+BOOST_AUTO_TEST_CASE( fast_random_fill_range_test )
+{
+  BOOST_TEST_MESSAGE("fillRange() gives all values in the range, and none outside it.");
+  FastRandom gen(1);
+
+  // Odd number of values and ranges, to test the last value and non power of 2 ranges
+  const std::size_t n = 1000001;
+  const std::uint32_t ranges[] = {1, 3, 12, 512, 1024};
+
+  for(std::uint32_t range : ranges) {
+    std::vector<std::uint32_t> values(n+1, 0xFFFFFFFF);
+    std::vector<unsigned int> counts(range, 0);
+
+    gen.fillRange(values.data(), n, range);
+
+    bool in_range = true;
+    for(std::size_t i = 0; i < n; i++) {
+      in_range = in_range && values[i] < range;
+      if(values[i] < range)
+        counts[values[i]]++;
+    }
+
+    BOOST_CHECK(in_range);
+    BOOST_CHECK_EQUAL(values[n], 0xFFFFFFFF);
+
+    // Roughly uniform: each value within 25% of the expected count
+    double expected = double(n)/range;
+    for(std::uint32_t v = 0; v < range; v++) {
+      BOOST_CHECK_GT(counts[v], 0.75*expected);
+      BOOST_CHECK_LT(counts[v], 1.25*expected);
+    }
+  }
+}
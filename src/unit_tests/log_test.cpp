@@ -0,0 +1,93 @@
+#include "common/Log.hpp"
+#define BOOST_TEST_MODULE LogTest
+#include <boost/test/included/unit_test.hpp>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+///@brief Redirects std::cout to a string stream while in scope
+struct CoutCapture {
+  std::stringstream mOutput;
+  std::streambuf* mOldBuf;
+
+  CoutCapture() : mOldBuf(std::cout.rdbuf(mOutput.rdbuf())) {}
+  ~CoutCapture() {std::cout.rdbuf(mOldBuf);}
+};
+
+
+BOOST_AUTO_TEST_CASE( log_configure_test )
+{
+  BOOST_TEST_MESSAGE("Levels are set for the selected categories, others only get errors and warnings.");
+
+  Log::configure("debug", "event,readout_unit");
+  BOOST_CHECK(Log::enabled(Log::EVENT, Log::LEVEL_DEBUG));
+  BOOST_CHECK(Log::enabled(Log::READOUT_UNIT, Log::LEVEL_DEBUG));
+  BOOST_CHECK(Log::enabled(Log::STIMULI, Log::LEVEL_WARNING));
+  BOOST_CHECK(Log::enabled(Log::STIMULI, Log::LEVEL_INFO) == false);
+
+  Log::configure("error", "all");
+  BOOST_CHECK(Log::enabled(Log::ALPIDE, Log::LEVEL_ERROR));
+  BOOST_CHECK(Log::enabled(Log::ALPIDE, Log::LEVEL_WARNING) == false);
+
+  BOOST_CHECK_THROW(Log::configure("verbose", "all"), std::runtime_error);
+  BOOST_CHECK_THROW(Log::configure("info", "event,chips"), std::runtime_error);
+
+  Log::configure("info", "all");
+}
+
+
+BOOST_AUTO_TEST_CASE( log_disabled_test )
+{
+  BOOST_TEST_MESSAGE("Disabled messages are not written, and their arguments are not evaluated.");
+  CoutCapture capture;
+  int evaluated = 0;
+
+  Log::configure("info", "all");
+  LOG(EVENT, DEBUG) << "not written " << ++evaluated;
+  LOG(EVENT, INFO) << "written " << ++evaluated;
+
+  BOOST_CHECK_EQUAL(evaluated, 1);
+  BOOST_CHECK_EQUAL(capture.mOutput.str(), "written 1\n");
+}
+
+
+BOOST_AUTO_TEST_CASE( log_writer_thread_test )
+{
+  BOOST_TEST_MESSAGE("Lines from several threads are all written by the writer thread before stop() returns.");
+  const unsigned int num_threads = 3;
+  const unsigned int num_lines = 10000;
+  CoutCapture capture;
+
+  Log::configure("info", "all");
+  Log::start(16);
+
+  std::vector<std::thread> threads;
+  for(unsigned int t = 0; t < num_threads; t++) {
+    threads.emplace_back([t]() {
+      for(unsigned int i = 0; i < num_lines; i++)
+        LOG(STIMULI, INFO) << "thread " << t << " line " << i;
+    });
+  }
+
+  for(auto it = threads.begin(); it != threads.end(); it++)
+    it->join();
+
+  Log::stop();
+
+  std::vector<unsigned int> next_line(num_threads, 0);
+  std::string word;
+  unsigned int t, i;
+  bool in_order = true;
+
+  while(capture.mOutput >> word >> t >> word >> i) {
+    in_order = in_order && t < num_threads && next_line[t] == i;
+    next_line[t < num_threads ? t : 0]++;
+  }
+
+  BOOST_CHECK(in_order);
+  for(t = 0; t < num_threads; t++)
+    BOOST_CHECK_EQUAL(next_line[t], num_lines);
+}
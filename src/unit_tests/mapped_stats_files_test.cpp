@@ -0,0 +1,66 @@
+#include "../../analysis/MappedStatsFiles.hpp"
+#define BOOST_TEST_MODULE MappedStatsFilesTest
+#include <boost/test/included/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+
+static const char* test_filename = "mapped_stats_files_test_trigger_actions.dat";
+
+
+///@brief Write a trigger actions file with the format written by the ReadoutUnit
+static void write_trig_actions_file(uint64_t num_triggers, uint8_t num_ctrl_links,
+                                    uint64_t num_action_bytes)
+{
+  std::ofstream file(test_filename, std::ios_base::out | std::ios_base::binary);
+  file.write((char*)&num_triggers, sizeof(uint64_t));
+  file.write((char*)&num_ctrl_links, sizeof(uint8_t));
+
+  for(uint64_t i = 0; i < num_action_bytes; i++) {
+    uint8_t action = i % 3;
+    file.write((char*)&action, sizeof(uint8_t));
+  }
+}
+
+
+BOOST_AUTO_TEST_CASE( trig_actions_file_view_test )
+{
+  BOOST_TEST_MESSAGE("Trigger actions are read in place, one byte per control link per trigger.");
+  write_trig_actions_file(100, 3, 300);
+
+  TrigActionsFileView view(test_filename);
+  BOOST_CHECK_EQUAL(view.getNumTriggers(), 100);
+  BOOST_CHECK_EQUAL(view.getNumCtrlLinks(), 3);
+  BOOST_CHECK_EQUAL(view.getTriggerActions(0)[1], 1);
+  BOOST_CHECK_EQUAL(view.getTriggerActions(99)[2], (99*3+2) % 3);
+
+  std::remove(test_filename);
+}
+
+
+BOOST_AUTO_TEST_CASE( trig_actions_file_view_no_ctrl_links_test )
+{
+  BOOST_TEST_MESSAGE("A file for an RU without control links only has the header.");
+  write_trig_actions_file(100, 0, 0);
+
+  TrigActionsFileView view(test_filename);
+  BOOST_CHECK_EQUAL(view.getNumTriggers(), 100);
+  BOOST_CHECK_EQUAL(view.getNumCtrlLinks(), 0);
+
+  std::remove(test_filename);
+}
+
+
+BOOST_AUTO_TEST_CASE( trig_actions_file_view_truncated_test )
+{
+  BOOST_TEST_MESSAGE("Truncated files throw when they are opened.");
+  write_trig_actions_file(100, 3, 299);
+  BOOST_CHECK_THROW(TrigActionsFileView view(test_filename), std::runtime_error);
+
+  // Empty file, without header
+  std::ofstream(test_filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  BOOST_CHECK_THROW(TrigActionsFileView view(test_filename), std::runtime_error);
+
+  std::remove(test_filename);
+}
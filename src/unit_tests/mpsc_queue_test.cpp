@@ -0,0 +1,75 @@
+#include "common/MpscQueue.hpp"
+#define BOOST_TEST_MODULE MpscQueueTest
+#include <boost/test/included/unit_test.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+BOOST_AUTO_TEST_CASE( mpsc_queue_bounds_test )
+{
+  BOOST_TEST_MESSAGE("Capacity is rounded up to a power of two, and values are returned in order.");
+  MpscQueue<int> queue(3);
+  int value = 0;
+
+  BOOST_CHECK_EQUAL(queue.capacity(), 4);
+  BOOST_CHECK(queue.tryPop(value) == false);
+
+  for(int i = 0; i < 4; i++)
+    BOOST_CHECK(queue.tryPush(int(i)));
+
+  BOOST_CHECK(queue.tryPush(4) == false);
+
+  // Wrap around the end of the ring buffer a few times
+  for(int i = 0; i < 10; i++) {
+    BOOST_REQUIRE(queue.tryPop(value));
+    BOOST_CHECK_EQUAL(value, i);
+    BOOST_REQUIRE(queue.tryPush(int(i+4)));
+  }
+
+  for(int i = 10; i < 14; i++) {
+    BOOST_REQUIRE(queue.tryPop(value));
+    BOOST_CHECK_EQUAL(value, i);
+  }
+
+  BOOST_CHECK(queue.tryPop(value) == false);
+}
+
+
+BOOST_AUTO_TEST_CASE( mpsc_queue_threads_test )
+{
+  BOOST_TEST_MESSAGE("All values pushed by several producer threads are popped once, in order per producer.");
+  const unsigned int num_producers = 4;
+  const unsigned int num_values = 50000;
+  MpscQueue<std::unique_ptr<unsigned int>> queue(8);
+  std::vector<std::thread> producers;
+
+  for(unsigned int p = 0; p < num_producers; p++) {
+    producers.emplace_back([&queue, p]() {
+      for(unsigned int i = 0; i < num_values; i++)
+        queue.push(std::unique_ptr<unsigned int>(new unsigned int(p*num_values + i)));
+    });
+  }
+
+  std::vector<unsigned int> next_value(num_producers, 0);
+  bool in_order = true;
+
+  for(unsigned int n = 0; n < num_producers*num_values; ) {
+    std::unique_ptr<unsigned int> value;
+
+    if(queue.tryPop(value)) {
+      unsigned int p = *value / num_values;
+      in_order = in_order && *value % num_values == next_value[p];
+      next_value[p]++;
+      n++;
+    }
+  }
+
+  for(auto it = producers.begin(); it != producers.end(); it++)
+    it->join();
+
+  std::unique_ptr<unsigned int> value;
+
+  BOOST_CHECK(in_order);
+  BOOST_CHECK(queue.tryPop(value) == false);
+}
@@ -0,0 +1,171 @@
+#include "ReadoutUnit/ParserEventSpill.hpp"
+#include "common/StatsWriter.hpp"
+#define BOOST_TEST_MODULE ParserEventSpillTest
+#include <boost/test/included/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+
+static const char* test_filename = "parser_event_spill_test.dat";
+
+
+///@brief Events per link and chip, as held by the data link parsers
+typedef std::map<unsigned int, std::map<unsigned int, std::vector<uint64_t>>> LinkChipEvents;
+
+
+///@brief Write events grouped per link (and chip), the same way as
+///       ReadoutUnit::writeParserEventFiles() writes them from the parsers' data
+static std::string reference_file(const LinkChipEvents& events, unsigned int num_links,
+                                  unsigned int num_words, bool per_chip)
+{
+  std::ostringstream out;
+  uint8_t num_data_links = num_links;
+  out.write((char*)&num_data_links, sizeof(uint8_t));
+
+  for(unsigned int link = 0; link < num_links; link++) {
+    std::map<unsigned int, std::vector<uint64_t>> chip_events;
+    if(events.count(link))
+      chip_events = events.at(link);
+
+    if(per_chip) {
+      uint8_t num_chips_with_data = chip_events.size();
+      out.write((char*)&num_chips_with_data, sizeof(uint8_t));
+    }
+
+    if(!per_chip && chip_events.empty()) {
+      uint64_t num_events = 0;
+      out.write((char*)&num_events, sizeof(uint64_t));
+    }
+
+    for(auto chip_it = chip_events.begin(); chip_it != chip_events.end(); chip_it++) {
+      uint8_t chip_id = chip_it->first;
+      uint64_t num_events = chip_it->second.size() / num_words;
+
+      if(per_chip)
+        out.write((char*)&chip_id, sizeof(uint8_t));
+      out.write((char*)&num_events, sizeof(uint64_t));
+      out.write((char*)chip_it->second.data(), chip_it->second.size()*sizeof(uint64_t));
+    }
+  }
+
+  return out.str();
+}
+
+
+static std::string read_file(const std::string& filename)
+{
+  std::ifstream in(filename, std::ios_base::binary);
+  return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+
+///@brief Add events in interleaved order over links and chips to the spill, and to the
+///       reference map
+static void add_test_events(ParserEventSpill& spill, LinkChipEvents& events,
+                            unsigned int num_events, unsigned int num_links, bool per_chip)
+{
+  unsigned int num_words = spill.getNumWords();
+  std::vector<uint64_t> words(num_words);
+
+  for(unsigned int i = 0; i < num_events; i++) {
+    // Link 1 never has events
+    unsigned int link = (i*7) % num_links;
+    if(link == 1)
+      continue;
+
+    unsigned int chip = per_chip ? (i*3) % 5 : 0;
+
+    for(unsigned int w = 0; w < num_words; w++)
+      words[w] = uint64_t(i)*10 + w;
+
+    spill.addEvent(link, chip, words.data());
+
+    std::vector<uint64_t>& ref = events[link][chip];
+    ref.insert(ref.end(), words.begin(), words.end());
+
+    // Flush now and then, as the readout unit does during the simulation
+    if(i % 1000 == 0)
+      spill.flush();
+  }
+
+  spill.flush();
+}
+
+
+BOOST_AUTO_TEST_CASE( parser_event_spill_per_link_test )
+{
+  BOOST_TEST_MESSAGE("Busy events grouped per link have the same format as _busy_events.dat.");
+  const unsigned int num_links = 9;
+  LinkChipEvents events;
+
+  ParserEventSpill spill("parser_event_spill_test_busy.spill", 4);
+  add_test_events(spill, events, 100000, num_links, false);
+
+  spill.writeGroupedFile(test_filename, num_links, false);
+  BOOST_CHECK(read_file(test_filename) == reference_file(events, num_links, 4, false));
+
+  std::remove(test_filename);
+}
+
+
+BOOST_AUTO_TEST_CASE( parser_event_spill_per_chip_test )
+{
+  BOOST_TEST_MESSAGE("Trigger events grouped per link and chip have the same format as _busyv_events.dat.");
+  const unsigned int num_links = 28;
+  LinkChipEvents events;
+
+  StatsWriter::start(2);
+
+  {
+    ParserEventSpill spill("parser_event_spill_test_busyv.spill", 1);
+    add_test_events(spill, events, 200000, num_links, true);
+
+    spill.writeGroupedFile(test_filename, num_links, true);
+    BOOST_CHECK(read_file(test_filename) == reference_file(events, num_links, 1, true));
+
+    // All events are read back in the order they were added
+    uint64_t num_events = 0;
+    uint64_t last_word = 0;
+    bool in_order = true;
+    spill.forEachEvent([&](unsigned int, unsigned int, const uint64_t* words) {
+        if(num_events > 0 && words[0] <= last_word)
+          in_order = false;
+        last_word = words[0];
+        num_events++;
+      });
+
+    uint64_t expected_events = 0;
+    for(auto link_it = events.begin(); link_it != events.end(); link_it++)
+      for(auto chip_it = link_it->second.begin(); chip_it != link_it->second.end(); chip_it++)
+        expected_events += chip_it->second.size();
+
+    BOOST_CHECK(in_order);
+    BOOST_CHECK_EQUAL(num_events, expected_events);
+  }
+
+  BOOST_CHECK_NO_THROW(StatsWriter::stop());
+  std::remove(test_filename);
+}
+
+
+BOOST_AUTO_TEST_CASE( parser_event_spill_empty_test )
+{
+  BOOST_TEST_MESSAGE("Without events, the file only has the headers with zero counts.");
+  LinkChipEvents events;
+  ParserEventSpill spill("parser_event_spill_test_empty.spill", 1);
+
+  spill.writeGroupedFile(test_filename, 3, true);
+  BOOST_CHECK(read_file(test_filename) == reference_file(events, 3, 1, true));
+
+  // Events must be flushed before the file is written
+  uint64_t word = 1;
+  spill.addEvent(0, 0, &word);
+  BOOST_CHECK_THROW(spill.writeGroupedFile(test_filename, 3, true), std::runtime_error);
+
+  std::remove(test_filename);
+}
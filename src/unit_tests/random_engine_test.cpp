@@ -0,0 +1,95 @@
+#include "common/RandomEngine.hpp"
+#define BOOST_TEST_MODULE RandomEngineTest
+#include <boost/test/included/unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <vector>
+
+
+BOOST_AUTO_TEST_CASE( philox_known_answer_test )
+{
+  BOOST_TEST_MESSAGE("Philox4x32-10 gives the known answers from the Random123 test vectors.");
+  Philox4x32::Counter ctr = {{0, 0, 0, 0}};
+  Philox4x32::Key key = {{0, 0}};
+  Philox4x32::Counter res = Philox4x32::generate(ctr, key);
+
+  BOOST_CHECK_EQUAL(res.v[0], 0x6627e8d5);
+  BOOST_CHECK_EQUAL(res.v[1], 0xe169c58d);
+  BOOST_CHECK_EQUAL(res.v[2], 0xbc57ac4c);
+  BOOST_CHECK_EQUAL(res.v[3], 0x9b00dbd8);
+
+  Philox4x32::Counter ctr2 = {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}};
+  Philox4x32::Key key2 = {{0xa4093822, 0x299f31d0}};
+  res = Philox4x32::generate(ctr2, key2);
+
+  BOOST_CHECK_EQUAL(res.v[0], 0xd16cfe09);
+  BOOST_CHECK_EQUAL(res.v[1], 0x94fdcceb);
+  BOOST_CHECK_EQUAL(res.v[2], 0x5001e420);
+  BOOST_CHECK_EQUAL(res.v[3], 0x24126ea1);
+}
+
+
+BOOST_AUTO_TEST_CASE( random_engine_sequential_test )
+{
+  BOOST_TEST_MESSAGE("Sequential mode gives the same numbers as boost::random::mt19937.");
+  RandomEngine engine(RAND_PURPOSE_HIT_COORDS);
+  boost::random::mt19937 mt;
+  engine.seed(1337);
+  mt.seed(1337);
+
+  boost::random::normal_distribution<double> dist_a(0, 2), dist_b(0, 2);
+  bool all_equal = true;
+
+  for(int i = 0; i < 1000; i++) {
+    // setStream() has no effect in sequential mode
+    engine.setStream(i);
+    all_equal = all_equal && dist_a(engine) == dist_b(mt);
+  }
+
+  BOOST_CHECK(all_equal);
+}
+
+
+BOOST_AUTO_TEST_CASE( random_engine_counter_based_test )
+{
+  BOOST_TEST_MESSAGE("Counter-based mode gives the same numbers for a stream regardless of earlier draws.");
+  RandomEngine engine(RAND_PURPOSE_HIT_COORDS);
+  engine.seed(1337);
+  engine.setCounterBased(true);
+
+  boost::random::uniform_int_distribution<int> dist(0, 1023);
+  std::vector<int> first, second, other_event, other_sub_stream;
+
+  engine.setStream(42, 3);
+  for(int i = 0; i < 100; i++)
+    first.push_back(dist(engine));
+
+  // Draw some numbers from other streams in between
+  engine.setStream(41, 3);
+  for(int i = 0; i < 37; i++)
+    other_event.push_back(dist(engine));
+  engine.setStream(42, 4);
+  for(int i = 0; i < 100; i++)
+    other_sub_stream.push_back(dist(engine));
+
+  engine.setStream(42, 3);
+  for(int i = 0; i < 100; i++)
+    second.push_back(dist(engine));
+
+  BOOST_CHECK(first == second);
+  BOOST_CHECK(first != other_sub_stream);
+  BOOST_CHECK(!std::equal(other_event.begin(), other_event.end(), first.begin()));
+
+  // Engines with another purpose give other numbers for the same stream
+  RandomEngine engine_time(RAND_PURPOSE_HIT_TIME);
+  engine_time.seed(1337);
+  engine_time.setCounterBased(true);
+  engine_time.setStream(42, 3);
+
+  std::vector<int> other_purpose;
+  for(int i = 0; i < 100; i++)
+    other_purpose.push_back(dist(engine_time));
+
+  BOOST_CHECK(first != other_purpose);
+}
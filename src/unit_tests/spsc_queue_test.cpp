@@ -0,0 +1,59 @@
+#include "common/SpscQueue.hpp"
+#define BOOST_TEST_MODULE SpscQueueTest
+#include <boost/test/included/unit_test.hpp>
+#include <memory>
+#include <thread>
+
+
+BOOST_AUTO_TEST_CASE( spsc_queue_bounds_test )
+{
+  BOOST_TEST_MESSAGE("Queue holds capacity values, and returns them in order.");
+  SpscQueue<int> queue(4);
+  int value = 0;
+
+  BOOST_CHECK(queue.empty());
+  BOOST_CHECK(queue.tryPop(value) == false);
+
+  for(int i = 0; i < 4; i++)
+    BOOST_CHECK(queue.tryPush(int(i)));
+
+  BOOST_CHECK(queue.tryPush(4) == false);
+
+  // Wrap around the end of the ring buffer a few times
+  for(int i = 0; i < 10; i++) {
+    BOOST_REQUIRE(queue.tryPop(value));
+    BOOST_CHECK_EQUAL(value, i);
+    BOOST_REQUIRE(queue.tryPush(int(i+4)));
+  }
+
+  for(int i = 10; i < 14; i++) {
+    BOOST_REQUIRE(queue.tryPop(value));
+    BOOST_CHECK_EQUAL(value, i);
+  }
+
+  BOOST_CHECK(queue.empty());
+}
+
+
+BOOST_AUTO_TEST_CASE( spsc_queue_threads_test )
+{
+  BOOST_TEST_MESSAGE("All values pushed by a producer thread are popped in order by the consumer.");
+  const unsigned int num_values = 200000;
+  SpscQueue<std::unique_ptr<unsigned int>> queue(8);
+
+  std::thread producer([&]() {
+    for(unsigned int i = 0; i < num_values; i++)
+      queue.push(std::unique_ptr<unsigned int>(new unsigned int(i)));
+  });
+
+  bool in_order = true;
+  for(unsigned int i = 0; i < num_values; i++) {
+    std::unique_ptr<unsigned int> value = queue.pop();
+    in_order = in_order && value && *value == i;
+  }
+
+  producer.join();
+
+  BOOST_CHECK(in_order);
+  BOOST_CHECK(queue.empty());
+}
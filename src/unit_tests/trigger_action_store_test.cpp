@@ -0,0 +1,159 @@
+#include "ReadoutUnit/TriggerActionStore.hpp"
+#include "common/StatsWriter.hpp"
+#define BOOST_TEST_MODULE TriggerActionStoreTest
+#include <boost/test/included/unit_test.hpp>
+#include <sstream>
+#include <stdexcept>
+
+
+///@brief Action for a trigger/link in the tests, cycles through the valid values
+static uint8_t test_action(uint64_t trigger_id, unsigned int link)
+{
+  return (trigger_id + link) % 3;
+}
+
+
+static void add_test_triggers(TriggerActionStore& store, uint64_t num_triggers)
+{
+  std::vector<uint8_t> link_actions(store.getNumLinks());
+
+  for(uint64_t trigger_id = 0; trigger_id < num_triggers; trigger_id++) {
+    for(unsigned int link = 0; link < link_actions.size(); link++)
+      link_actions[link] = test_action(trigger_id, link);
+    store.addTrigger(link_actions);
+  }
+}
+
+
+///@brief Check that the output has the trigger major layout used in _trigger_actions.dat
+static void check_output(const std::string& data, uint64_t num_triggers, unsigned int num_links)
+{
+  BOOST_REQUIRE_EQUAL(data.size(), num_triggers*num_links);
+
+  for(uint64_t trigger_id = 0; trigger_id < num_triggers; trigger_id++) {
+    for(unsigned int link = 0; link < num_links; link++) {
+      BOOST_REQUIRE_EQUAL(uint8_t(data[trigger_id*num_links + link]),
+                          test_action(trigger_id, link));
+    }
+  }
+}
+
+
+BOOST_AUTO_TEST_CASE( trigger_action_store_in_memory_test )
+{
+  BOOST_TEST_MESSAGE("Actions are stored densely across chunk boundaries and written in trigger order.");
+  const unsigned int num_links = 28;
+  const uint64_t num_triggers = 1000;
+  TriggerActionStore store(num_links, "", 64);
+
+  add_test_triggers(store, num_triggers);
+
+  BOOST_CHECK_EQUAL(store.getNumTriggers(), num_triggers);
+  BOOST_CHECK_EQUAL(store.getNumSpilledTriggers(), 0);
+  BOOST_CHECK_EQUAL(store.getAction(0, 0), test_action(0, 0));
+  BOOST_CHECK_EQUAL(store.getAction(64, 27), test_action(64, 27));
+  BOOST_CHECK_EQUAL(store.getAction(999, 5), test_action(999, 5));
+  BOOST_CHECK_THROW(store.getAction(1000, 0), std::out_of_range);
+  BOOST_CHECK_THROW(store.getAction(0, 28), std::out_of_range);
+
+  // 16 chunks of 64 triggers, roughly one byte per link per trigger
+  BOOST_CHECK(store.getMemoryUsage() < 16*64*num_links + 1024);
+
+  std::ostringstream out;
+  store.writeActions(out);
+  check_output(out.str(), num_triggers, num_links);
+}
+
+
+BOOST_AUTO_TEST_CASE( trigger_action_store_spill_test )
+{
+  BOOST_TEST_MESSAGE("Full chunks are spilled to disk, and the output is the same as without spilling.");
+  const unsigned int num_links = 9;
+  const uint64_t num_triggers = 1000;
+
+  TriggerActionStore::setSpillDirectory(".");
+  TriggerActionStore store(num_links, "trigger_action_store_test", 100);
+  TriggerActionStore::setSpillDirectory("");
+
+  add_test_triggers(store, num_triggers);
+
+  // The last chunk is full but not spilled until the next trigger is added
+  BOOST_CHECK_EQUAL(store.getNumSpilledTriggers(), 900);
+  BOOST_CHECK(store.getMemoryUsage() < 2*100*num_links);
+  BOOST_CHECK_THROW(store.getAction(899, 0), std::out_of_range);
+  BOOST_CHECK_EQUAL(store.getAction(900, 3), test_action(900, 3));
+
+  std::ostringstream out;
+  store.writeActions(out);
+  check_output(out.str(), num_triggers, num_links);
+}
+
+
+BOOST_AUTO_TEST_CASE( trigger_action_store_stats_writer_test )
+{
+  BOOST_TEST_MESSAGE("Spilled chunks are written by the StatsWriter thread, with the same output.");
+  const unsigned int num_links = 28;
+  const uint64_t num_triggers = 100000;
+
+  StatsWriter::start(2);
+
+  {
+    TriggerActionStore::setSpillDirectory(".");
+    TriggerActionStore store(num_links, "trigger_action_store_stats_writer_test", 1000);
+    TriggerActionStore::setSpillDirectory("");
+
+    add_test_triggers(store, num_triggers);
+    BOOST_CHECK_EQUAL(store.getNumSpilledTriggers(), num_triggers-1000);
+
+    std::ostringstream out;
+    store.writeActions(out);
+    check_output(out.str(), num_triggers, num_links);
+  }
+
+  BOOST_CHECK_NO_THROW(StatsWriter::stop());
+  BOOST_CHECK(StatsWriter::getEnabled() == false);
+}
+
+
+BOOST_AUTO_TEST_CASE( trigger_action_store_no_links_test )
+{
+  BOOST_TEST_MESSAGE("Readout units without control links only count the triggers, with and without spilling.");
+  const uint64_t num_triggers = 1000;
+
+  TriggerActionStore store(0, "", 10);
+
+  add_test_triggers(store, num_triggers);
+
+  BOOST_CHECK_EQUAL(store.getNumTriggers(), num_triggers);
+  BOOST_CHECK_EQUAL(store.getNumSpilledTriggers(), 0);
+  BOOST_CHECK(store.getMemoryUsage() == 0);
+  BOOST_CHECK_THROW(store.getAction(0, 0), std::out_of_range);
+
+  std::ostringstream out;
+  store.writeActions(out);
+  BOOST_CHECK(out.str().empty());
+
+  TriggerActionStore::setSpillDirectory(".");
+  TriggerActionStore spill_store(0, "trigger_action_store_no_links_test", 10);
+  TriggerActionStore::setSpillDirectory("");
+
+  add_test_triggers(spill_store, num_triggers);
+
+  BOOST_CHECK_EQUAL(spill_store.getNumTriggers(), num_triggers);
+  BOOST_CHECK_EQUAL(spill_store.getNumSpilledTriggers(), 0);
+  BOOST_CHECK(spill_store.getMemoryUsage() == 0);
+
+  std::ostringstream spill_out;
+  spill_store.writeActions(spill_out);
+  BOOST_CHECK(spill_out.str().empty());
+}
+
+
+BOOST_AUTO_TEST_CASE( trigger_action_store_link_count_test )
+{
+  TriggerActionStore store(4);
+  std::vector<uint8_t> link_actions(3);
+
+  BOOST_CHECK_THROW(store.addTrigger(link_actions), std::runtime_error);
+  BOOST_CHECK_THROW(TriggerActionStore(4, "", 0), std::runtime_error);
+}
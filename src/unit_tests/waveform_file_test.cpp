@@ -0,0 +1,228 @@
+#include "common/WaveformFile.hpp"
+#define BOOST_TEST_MODULE WaveformFileTest
+#include <boost/test/included/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+
+static const char* test_filename = "waveform_file_test.awf";
+static const char* test_vcd_filename = "waveform_file_test.vcd";
+
+
+BOOST_AUTO_TEST_CASE( waveform_pattern_test )
+{
+  BOOST_TEST_MESSAGE("Trace names are matched against patterns with * and ? wildcards.");
+  const std::string name = "ITS.IB_0_3.Chip_2.alpide_27.busy_status";
+
+  BOOST_CHECK(Waveform::matchPattern("*", name));
+  BOOST_CHECK(Waveform::matchPattern(name, name));
+  BOOST_CHECK(Waveform::matchPattern("*.alpide_27.*", name));
+  BOOST_CHECK(Waveform::matchPattern("ITS.IB_?_3.*busy*", name));
+  BOOST_CHECK(Waveform::matchPattern("*status", name));
+  BOOST_CHECK(Waveform::matchPattern("*.alpide_2.*", name) == false);
+  BOOST_CHECK(Waveform::matchPattern("ITS", name) == false);
+  BOOST_CHECK(Waveform::matchPattern("", name) == false);
+  BOOST_CHECK(Waveform::matchPattern("*busy", name) == false);
+
+  std::vector<std::string> patterns = Waveform::splitPatterns("*.alpide_27.*;;ITS.OB*;");
+  BOOST_REQUIRE_EQUAL(patterns.size(), 2);
+  BOOST_CHECK_EQUAL(patterns[0], "*.alpide_27.*");
+  BOOST_CHECK_EQUAL(patterns[1], "ITS.OB*");
+  BOOST_CHECK(Waveform::splitPatterns("").empty());
+}
+
+
+BOOST_AUTO_TEST_CASE( waveform_roundtrip_test )
+{
+  BOOST_TEST_MESSAGE("Times and values read back from the waveform file are identical to the ones written.");
+  const std::vector<Waveform::Variable> variables = {
+    {"ITS.RU_0_0.busy", Waveform::VAR_BITS, 1},
+    {"ITS.RU_0_0.trigger_id", Waveform::VAR_BITS, 64},
+    {"ITS.IB_0_0.Chip_0.alpide_0.rate", Waveform::VAR_REAL, 64},
+    {"ITS.IB_0_0.Chip_0.alpide_0.frame_count", Waveform::VAR_BITS, 12}
+  };
+
+  std::vector<WaveformRecord> records;
+
+  for(uint64_t t = 0; t < 2000; t++) {
+    WaveformRecord time_record;
+    time_record.type = WaveformRecord::TIME;
+    time_record.time = t*t*25;
+    records.push_back(time_record);
+
+    for(uint32_t var = 0; var < variables.size(); var++) {
+      if((t+var) % 3 == 0)
+        continue;
+
+      WaveformRecord value_record;
+      value_record.type = WaveformRecord::VALUE;
+      value_record.var_index = var;
+
+      if(var == 0)
+        value_record.value = t % 2;
+      else if(var == 1)
+        value_record.value = ~uint64_t(0) - t;
+      else if(var == 2)
+        value_record.value = Waveform::realToBits(t * -0.1);
+      else
+        value_record.value = (t*31) & 0xFFF;
+
+      records.push_back(value_record);
+    }
+  }
+
+  {
+    WaveformWriter writer(test_filename);
+    writer.writeHeader(variables, 1000000);
+
+    for(auto it = records.begin(); it != records.end(); it++) {
+      if(it->type == WaveformRecord::TIME)
+        writer.writeTime(it->time);
+      else
+        writer.writeValue(it->var_index, it->value);
+    }
+
+    writer.close();
+  }
+
+  WaveformReader reader(test_filename);
+  BOOST_CHECK_EQUAL(reader.getTimeUnitFs(), 1000000);
+  BOOST_REQUIRE_EQUAL(reader.getVariables().size(), variables.size());
+
+  for(unsigned int i = 0; i < variables.size(); i++) {
+    BOOST_CHECK_EQUAL(reader.getVariables()[i].name, variables[i].name);
+    BOOST_CHECK_EQUAL(reader.getVariables()[i].type, variables[i].type);
+    BOOST_CHECK_EQUAL(reader.getVariables()[i].width, variables[i].width);
+  }
+
+  WaveformRecord record;
+  for(auto it = records.begin(); it != records.end(); it++) {
+    BOOST_REQUIRE(reader.readRecord(record));
+    BOOST_REQUIRE_EQUAL(record.type, it->type);
+
+    if(it->type == WaveformRecord::TIME) {
+      BOOST_CHECK_EQUAL(record.time, it->time);
+    } else {
+      BOOST_CHECK_EQUAL(record.var_index, it->var_index);
+      BOOST_CHECK_EQUAL(record.value, it->value);
+    }
+  }
+
+  BOOST_CHECK(reader.readRecord(record) == false);
+  BOOST_CHECK_EQUAL(Waveform::bitsToReal(Waveform::realToBits(-12.5)), -12.5);
+
+  std::remove(test_filename);
+}
+
+
+BOOST_AUTO_TEST_CASE( waveform_vcd_test )
+{
+  BOOST_TEST_MESSAGE("VCD output has one scope per name level, and value changes in VCD syntax.");
+  const std::vector<Waveform::Variable> variables = {
+    {"ITS.RU_0_0.busy", Waveform::VAR_BITS, 1},
+    {"clock", Waveform::VAR_BITS, 1},
+    {"ITS.RU_0_0.count", Waveform::VAR_BITS, 8},
+    {"ITS.IB_0_0.rate", Waveform::VAR_REAL, 64}
+  };
+
+  {
+    VcdWriter writer(test_vcd_filename);
+    writer.writeHeader(variables, 1000000);
+    writer.writeTime(0);
+    writer.writeValue(0, 1);
+    writer.writeValue(2, 5);
+    writer.writeTime(3);
+    writer.writeValue(2, 0);
+    writer.writeValue(3, Waveform::realToBits(0.5));
+    writer.close();
+  }
+
+  std::ifstream vcd_file(test_vcd_filename);
+  std::stringstream vcd;
+  vcd << vcd_file.rdbuf();
+
+  const std::string expected_definitions =
+    "$timescale\n  1 ns\n$end\n\n"
+    "$scope module SystemC $end\n"
+    "$scope module ITS $end\n"
+    "$scope module IB_0_0 $end\n"
+    "$var real 64 $ rate $end\n"
+    "$upscope $end\n"
+    "$scope module RU_0_0 $end\n"
+    "$var wire 1 ! busy $end\n"
+    "$var wire 8 # count $end\n"
+    "$upscope $end\n"
+    "$upscope $end\n"
+    "$var wire 1 \" clock $end\n"
+    "$upscope $end\n"
+    "$enddefinitions $end\n\n";
+
+  const std::string expected_values =
+    "#0\n1!\nb101 #\n#3\nb0 #\nr0.5 $\n";
+
+  BOOST_CHECK(vcd.str().find(expected_definitions) != std::string::npos);
+  BOOST_CHECK(vcd.str().find(expected_definitions + expected_values) != std::string::npos);
+
+  std::remove(test_vcd_filename);
+}
+
+
+BOOST_AUTO_TEST_CASE( waveform_truncated_test )
+{
+  BOOST_TEST_MESSAGE("Reading a truncated waveform file throws, and does not return bad records.");
+  const std::vector<Waveform::Variable> variables = {{"value", Waveform::VAR_REAL, 64}};
+
+  {
+    WaveformWriter writer(test_filename);
+    writer.writeHeader(variables, 1);
+    writer.writeTime(10);
+    writer.writeValue(0, Waveform::realToBits(1.0));
+    writer.close();
+  }
+
+  // Remove the last byte of the real value
+  std::ifstream in(test_filename, std::ios_base::binary);
+  std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+
+  std::ofstream out(test_filename, std::ios_base::binary | std::ios_base::trunc);
+  out.write(data.data(), data.size()-1);
+  out.close();
+
+  WaveformReader reader(test_filename);
+  WaveformRecord record;
+
+  BOOST_REQUIRE(reader.readRecord(record));
+  BOOST_CHECK_EQUAL(record.time, 10);
+  BOOST_CHECK_THROW(reader.readRecord(record), std::runtime_error);
+
+  std::remove(test_filename);
+}
+
+
+BOOST_AUTO_TEST_CASE( waveform_invalid_header_test )
+{
+  BOOST_TEST_MESSAGE("Variables with a width outside 1 to 64 bits, and files that are not waveform files, are rejected.");
+
+  for(std::uint32_t width : {0U, 65U}) {
+    {
+      WaveformWriter writer(test_filename);
+      writer.writeHeader({{"value", Waveform::VAR_BITS, width}}, 1);
+      writer.close();
+    }
+
+    BOOST_CHECK_THROW(WaveformReader reader(test_filename), std::runtime_error);
+  }
+
+  {
+    std::ofstream out(test_filename, std::ios_base::binary | std::ios_base::trunc);
+    out << "ALPW";
+  }
+
+  BOOST_CHECK_THROW(WaveformReader reader(test_filename), std::runtime_error);
+
+  std::remove(test_filename);
+  BOOST_CHECK_THROW(WaveformReader reader(test_filename), std::runtime_error);
+}